@@ -0,0 +1,87 @@
+/* 引擎内存分配：块式bump分配器 + 按尺寸分级的slab复用（整体释放为O(块数)） */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARENA_DEFAULT_CHUNK   (256 * 1024)   // 默认块大小 (字节)
+#define ARENA_DEFAULT_ALIGN   16
+
+#define SLAB_MIN_SHIFT        6              // 最小尺寸级 64 字节
+#define SLAB_NUM_CLASSES      8              // 64 .. 8192 字节
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;       // 更早分配的块
+    size_t size;                   // 数据区字节数
+    size_t used;
+} ArenaChunk;
+
+/* bump分配器：从当前块顺序切分，块用完后再申请新块 */
+typedef struct {
+    ArenaChunk *head;              // 当前块
+    size_t chunk_size;
+    size_t bytes_used;             // 已切出字节数（含对齐填充）
+    size_t bytes_reserved;         // 所有块数据区总字节数
+    uint32_t num_chunks;
+} Arena;
+
+/* 回退点 */
+typedef struct {
+    ArenaChunk *chunk;
+    size_t used;
+    size_t bytes_used;
+} ArenaMark;
+
+/* 超出最大尺寸级的空闲块（按精确尺寸复用） */
+typedef struct SlabLargeBlock {
+    struct SlabLargeBlock *next;
+    size_t size;
+} SlabLargeBlock;
+
+/* slab分配器：在arena之上为每个尺寸级维护空闲链表，释放的对象原地复用 */
+typedef struct SlabAllocator {
+    Arena arena;
+    void *free_lists[SLAB_NUM_CLASSES];
+    SlabLargeBlock *large_free;
+    size_t live_bytes;             // 当前在用字节数（按尺寸级取整）
+} SlabAllocator;
+
+/* ==================== Arena接口 ==================== */
+
+/* 初始化（不立即申请内存），chunk_size 为0时取默认值 */
+void arena_init(Arena *arena, size_t chunk_size);
+
+/* 分配 size 字节，align 必须是2的幂，失败返回NULL */
+void* arena_alloc(Arena *arena, size_t size, size_t align);
+
+/* 分配并清零 */
+void* arena_calloc(Arena *arena, size_t count, size_t size);
+
+ArenaMark arena_mark(const Arena *arena);
+void arena_rewind(Arena *arena, ArenaMark mark);
+
+/* 清空全部分配；多块时合并为一个足够大的块，稳态下不再申请内存 */
+void arena_reset(Arena *arena);
+
+/* 释放所有块 */
+void arena_destroy(Arena *arena);
+
+/* ==================== Slab接口 ==================== */
+
+void slab_init(SlabAllocator *slab, size_t chunk_size);
+
+/* 分配 size 字节（16字节对齐），优先复用同尺寸级的空闲对象 */
+void* slab_alloc(SlabAllocator *slab, size_t size);
+void* slab_calloc(SlabAllocator *slab, size_t size);
+
+/* 归还对象，size 必须与分配时一致 */
+void slab_free(SlabAllocator *slab, void *ptr, size_t size);
+
+/* 一次释放所有对象（不逐个归还） */
+void slab_destroy(SlabAllocator *slab);
+
+#endif /* ARENA_H */
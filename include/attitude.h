@@ -5,6 +5,8 @@
 #include "vector3.h"
 #include "quaternion.h"
 
+#define ATTITUDE_POINTING_TOLERANCE  1e-3   // 指向误差容差 (rad)，低于此值视为已稳定（死区）
+
 /* ==================== 姿态初始化 ==================== */
 
 /* 创建姿态跟踪器 */
@@ -30,7 +32,7 @@ void attitude_tracker_reset(AttitudeTracker *tracker);
 
 /* ==================== 姿态更新 ==================== */
 
-/* 单步更新：使机体轴指向目标位置 */
+/* 单步更新：使机体轴指向目标位置（等同于以 target_pos - current_pos 调用 attitude_tracker_slew_step） */
 int attitude_tracker_step_towards(
     AttitudeTracker *tracker,
     Vector3 current_pos,
@@ -38,6 +40,19 @@ int attitude_tracker_step_towards(
     double dt_sec
 );
 
+/* 判断是否处于机动中（机体轴与目标方向夹角超过容差） */
+int attitude_tracker_is_slewing(const AttitudeTracker *tracker, Vector3 target_direction);
+
+/**
+ * 机动子步：饱和PD律（ATT_CONTROL_KP/KD）驱动机体轴转向目标方向，
+ * 角加速度和角速度限幅后以 quat_integrate 积分姿态四元数
+ * @param tracker 姿态跟踪器
+ * @param target_direction 目标方向（世界系）
+ * @param dt 子步长 (秒)
+ * @return 仍在机动返回1，已稳定返回0，参数错误返回-1
+ */
+int attitude_tracker_slew_step(AttitudeTracker *tracker, Vector3 target_direction, double dt);
+
 /* 直接设置姿态 */
 void attitude_tracker_set_quaternion(AttitudeTracker *tracker, Quaternion q);
 
@@ -115,12 +130,24 @@ void attitude_tracker_get_euler_angles_xyz(
 
 /* ==================== 旋转矩阵 ==================== */
 
-/* 获取旋转矩阵 */
+/* 获取旋转矩阵（体→世界）：按 q 缓存，q 改变后首次调用时重建 */
 Matrix3x3 attitude_tracker_get_rotation_matrix(AttitudeTracker *tracker);
 
 /* 从旋转矩阵设置姿态 */
 int attitude_tracker_set_rotation_matrix(AttitudeTracker *tracker, Matrix3x3 m);
 
+/* 使旋转矩阵缓存失效（直接改写 q 以外的场合，如重新初始化） */
+static inline void attitude_tracker_invalidate_rotation(AttitudeTracker *tracker) {
+    tracker->rotation_q = (Quaternion){0, 0, 0, 0};   // 零四元数不是合法姿态，必不命中
+}
+
+/**
+ * 用缓存的旋转矩阵把一组体坐标系向量转到世界系（机体轴、传感器视轴等）
+ * @param out 可与 in 相同
+ * @return 0 成功，参数无效返回-1
+ */
+int attitude_tracker_rotate_vectors(AttitudeTracker *tracker, const Vector3 *in, Vector3 *out, int count);
+
 /* ==================== 角速度约束 ==================== */
 
 /* 设置最大角速度 */
@@ -149,21 +176,124 @@ Vector3 attitude_saturate_angular_acceleration(
 
 /* ==================== 姿态指令生成 ==================== */
 
-/* PD控制律：计算所需角速度 */
+/* PD控制律：指令角加速度 kp·θ·axis - kd·ω（未限幅） */
 Vector3 attitude_pd_control(
-    Vector3 error_axis,    // 误差轴
-    double error_angle,    // 误差角
-    double kp,             // 比例增益
-    double kd              // 微分增益
+    Vector3 error_axis,    // 误差轴（单位向量）
+    double error_angle,    // 误差角 (rad)
+    Vector3 omega,         // 当前角速度 (rad/s)
+    double kp,             // 比例增益 (1/s²)
+    double kd              // 微分增益 (1/s)
 );
 
-/* 计算到达姿态所需时间 */
+/* ==================== 机动规划（特征轴 bang-coast-bang） ==================== */
+
+/* 静止到静止的特征轴机动剖面：以 max_accel 加速 → 以 peak_rate 匀速 → 以 max_accel 减速；
+   机动角不足以加速到 max_rate 时无匀速段（bang-bang） */
+typedef struct {
+    Vector3 axis;              // 特征轴（世界系单位向量）
+    double angle;              // 机动角 (rad)
+    double max_accel;          // 加/减速段角加速度 (rad/s²)
+    double peak_rate;          // 峰值角速度 (rad/s)
+    double accel_time;         // 加速段时长 = 减速段时长 (s)
+    double coast_time;         // 匀速段时长 (s)
+    double total_time;         // 总时长 (s)
+} AttitudeSlewProfile;
+
+/**
+ * 闭式机动时间：θ ≤ ω²/α 时 2√(θ/α)，否则 θ/ω + ω/α
+ * @return 时间 (s)；θ≤0 返回0，约束非正返回 HUGE_VAL
+ */
+double attitude_slew_time(double angle, double max_rate, double max_accel);
+
+/* 计算到达姿态所需时间：current 到 target 的最短转角代入 attitude_slew_time */
 double attitude_time_to_reach(
     Quaternion current,
     Quaternion target,
-    double max_rate
+    double max_rate,
+    double max_accel
 );
 
+/**
+ * 规划从 current 到 target 的特征轴机动（取最短转角）
+ * @return 0 成功，参数无效返回-1
+ */
+int attitude_plan_slew(Quaternion current, Quaternion target, double max_rate, double max_accel,
+                       AttitudeSlewProfile *profile);
+
+/**
+ * 规划机体轴转向目标方向的机动（按跟踪器自身的角速度/角加速度约束）
+ * @param target_direction 目标方向（世界系，无需单位化）
+ * @return 0 成功，参数无效返回-1
+ */
+int attitude_plan_pointing(AttitudeTracker *tracker, Vector3 target_direction, AttitudeSlewProfile *profile);
+
+/**
+ * 剖面采样：t 时刻已转过的角度（t 超出剖面时取端点）
+ * @param rate 可为NULL，输出该时刻角速度 (rad/s)
+ */
+double attitude_slew_profile_angle(const AttitudeSlewProfile *profile, double t, double *rate);
+
+/* 剖面采样：从 start 出发 t 时刻的姿态 */
+Quaternion attitude_slew_profile_attitude(const AttitudeSlewProfile *profile, Quaternion start, double t);
+
+/**
+ * 批量机动时间：每颗红星机体轴（当前姿态）转向每颗蓝星所需时间，不做姿态仿真
+ * @param times 输出 [红 x 蓝]，times[r * num_blue + b]
+ * @return 0 成功，参数无效返回-1
+ */
+int attitude_slew_time_matrix(Satellite **red_satellites, int num_red,
+                              Satellite **blue_satellites, int num_blue, double *times);
+
+/* ==================== 全队批量步进（SoA） ==================== */
+
+/* 全队姿态按分量分列存放：指向误差一遍扫描全部卫星（无分支，可向量化），
+   只对死区外的卫星做PD和四元数积分，结束后写回各 AttitudeTracker */
+typedef struct {
+    int count;
+    int capacity;
+    double *qx, *qy, *qz, *qw;        // 姿态四元数
+    double *wx, *wy, *wz;             // 角速度 (rad/s)
+    double *ax, *ay, *az;             // 角加速度 (rad/s²)
+    double *bx, *by, *bz;             // 机体指向轴（体坐标系，单位向量）
+    double *dx, *dy, *dz;             // 目标方向（世界系，单位向量）
+    double *max_rate, *max_accel;
+    double *err_cos;                  // 扫描结果：指向误差余弦
+    double *ex, *ey, *ez;             // 扫描结果：当前指向 × 目标方向
+    uint32_t *steps;                  // 本轮子步数
+    int *active;                      // 本子步死区外的下标
+    int num_active;
+    AttitudeTracker **trackers;       // 写回目标
+    void *block;                      // 所有分列共用一块内存
+} AttitudeFleet;
+
+void attitude_fleet_init(AttitudeFleet *fleet);
+void attitude_fleet_free(AttitudeFleet *fleet);
+
+/* 清空（保留容量），开始新一轮装载 */
+void attitude_fleet_clear(AttitudeFleet *fleet);
+
+/**
+ * 装载一颗卫星的姿态和目标方向
+ * @return 下标，内存不足返回-1
+ */
+int attitude_fleet_add(AttitudeFleet *fleet, AttitudeTracker *tracker, Vector3 target_direction);
+
+/**
+ * 扫描全部卫星的指向误差，死区外的下标写入 active；
+ * 已步进过且已在死区内的卫星清零角速度和角加速度
+ * @return 死区外卫星数
+ */
+int attitude_fleet_scan(AttitudeFleet *fleet, double tolerance);
+
+/**
+ * 全队一个子步：扫描 + 死区外卫星的饱和PD和四元数积分（进入死区后角速度清零）
+ * @return 本子步推进的卫星数（为0时全队已稳定）
+ */
+int attitude_fleet_step(AttitudeFleet *fleet, double dt);
+
+/* 补一次扫描后写回各 AttitudeTracker（q/ω/α/步数），与逐星 attitude_tracker_slew_step 逐位一致 */
+void attitude_fleet_store(AttitudeFleet *fleet);
+
 /* ==================== 调试和信息 ==================== */
 
 /* 打印姿态信息 */
@@ -0,0 +1,62 @@
+/* 场景分支：fork() 复制引擎（写时复制），并发评估多种红方策略 */
+
+#ifndef BRANCH_H
+#define BRANCH_H
+
+#include "types.h"
+#include "kinematics.h"
+
+#define BRANCH_MAX_BRANCHES  256
+
+/* ==================== 数据结构 ==================== */
+
+/* 分支结果（位于 MAP_SHARED 共享内存，由子进程填写） */
+typedef struct {
+    char strategy[32];             // 分支使用的策略
+    int status;                    // 0=成功，-1=失败或子进程异常退出
+    int exit_status;               // 子进程退出码（被信号终止为 128+信号号，未启动为-1）
+    uint32_t steps_run;            // 实际运行步数
+    double final_time;             // 结束时仿真时间 (秒)
+    double elapsed_seconds;        // 墙钟耗时 (秒)
+
+    double red_fuel_used;          // 分支内红方燃料消耗 (kg)
+    double mean_target_distance;   // 红星到目标平均距离 (km)
+    double min_target_distance;    // 红星到目标最小距离 (km)
+    int red_within_warning;        // 处于监视距离内的红星数
+    int formation_counts[5];       // 各编队类型红星数（巡视/环绕/环视/撤离/自由）
+} BranchOutcome;
+
+/* 分支选项 */
+typedef struct {
+    uint32_t num_steps;            // 每个分支运行步数
+    int max_concurrent;            // 最大并发子进程数（<=0 表示CPU核数）
+    int quiet;                     // 子进程关闭标准输出
+} BranchOptions;
+
+/* ==================== 分支接口 ==================== */
+
+/**
+ * 从引擎当前状态分出多个分支并发运行，每个分支使用不同红方策略
+ * 子进程通过 fork() 继承引擎（卫星和历史按页写时复制），父进程状态不变
+ * @param engine 源引擎
+ * @param strategies 策略数组 (如 "GJ"/"ZC"/"FY")
+ * @param num_branches 分支数
+ * @param options 分支选项
+ * @param outcomes_out 输出分支结果（长度 num_branches）
+ * @return 成功完成的分支数，失败返回-1
+ */
+int kinematics_engine_branch(
+    KinematicsEngine *engine,
+    const char **strategies,
+    int num_branches,
+    const BranchOptions *options,
+    BranchOutcome *outcomes_out
+);
+
+/* 统计引擎当前红方指标，填入结果结构（分支内和单机运行通用） */
+void branch_collect_outcome(KinematicsEngine *engine, BranchOutcome *outcome);
+
+/* 打印分支结果对比表 */
+void branch_print_outcomes(const BranchOutcome *outcomes, int num_branches);
+
+#endif /* BRANCH_H */
@@ -0,0 +1,91 @@
+/* 引擎检查点：带版本号的二进制快照格式（节表 + 64字节对齐的数据节，可直接mmap） */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include "types.h"
+#include "kinematics.h"
+
+#define CHECKPOINT_MAGIC        "SATCKPT"   // 8字节（含结尾0）
+#define CHECKPOINT_VERSION      3
+#define CHECKPOINT_ALIGN        64          // 数据节对齐字节数
+
+#define CHECKPOINT_FOURCC(a, b, c, d) \
+    ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+/* ==================== 数据节标签 ==================== */
+
+typedef enum {
+    CKPT_TAG_ENGINE     = CHECKPOINT_FOURCC('E', 'N', 'G', 'N'),  // 时间/步数/配置/时钟
+    CKPT_TAG_SATELLITES = CHECKPOINT_FOURCC('S', 'A', 'T', 'S'),  // Satellite数组（指针清零）
+    CKPT_TAG_HISTORY    = CHECKPOINT_FOURCC('H', 'I', 'S', 'T'),  // 各卫星分层历史（按卫星ID）
+    CKPT_TAG_AROUND     = CHECKPOINT_FOURCC('F', 'A', 'R', 'D'),  // 围观编队状态
+    CKPT_TAG_INSPECT    = CHECKPOINT_FOURCC('F', 'I', 'N', 'S'),  // 巡视编队状态
+    CKPT_TAG_CIRCUM     = CHECKPOINT_FOURCC('F', 'C', 'I', 'R'),  // 环视编队状态
+    CKPT_TAG_RETREAT    = CHECKPOINT_FOURCC('F', 'R', 'E', 'T'),  // 撤退编队状态
+    CKPT_TAG_TRIGGERS   = CHECKPOINT_FOURCC('F', 'M', 'T', 'G'),  // 编队管理器触发器
+    CKPT_TAG_RULES      = CHECKPOINT_FOURCC('F', 'M', 'R', 'L'),  // 编队转换规则
+    CKPT_TAG_RELLINKS   = CHECKPOINT_FOURCC('R', 'E', 'L', 'L'),  // 相对运动链接
+    CKPT_TAG_RNG        = CHECKPOINT_FOURCC('R', 'N', 'G', 'S')   // 引擎随机数状态
+} CheckpointTag;
+
+/* ==================== 文件布局 ==================== */
+
+/* 文件头（位于偏移0，随后紧跟节表） */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_sections;
+    uint64_t file_size;
+} CheckpointHeader;
+
+/* 节表项：record_size 为元素大小，用于检测结构布局变化 */
+typedef struct {
+    uint32_t tag;
+    uint32_t record_size;
+    uint64_t offset;
+    uint64_t size;
+} CheckpointSection;
+
+/* ENGINE节 */
+typedef struct {
+    SimulationConfig config;
+    StrategyThresholds strategy_thresholds;
+    double current_time;
+    double dt_seconds;
+    uint32_t step_count;
+    uint32_t total_maneuvers;
+    double total_fuel_consumed;
+    int32_t satellite_count;
+    int32_t formation_count;
+
+    uint32_t perturbation_flags;    // 当前启用的内置摄动项
+    double srp_cr;
+    double srp_area_to_mass;
+
+    SimClock clocks[SIM_CLOCK_COUNT];
+    char strategy[32];
+    uint32_t attitude_substeps;
+} CheckpointEngineRecord;
+
+/* HIST节：每颗有历史的卫星一个头部，随后紧跟 history_serialize 的字节流 */
+typedef struct {
+    int32_t sat_id;
+    uint32_t size;
+} CheckpointHistoryHeader;
+
+/* RNGS节 */
+typedef struct {
+    uint64_t seed;
+    Rng rng;
+} CheckpointRngRecord;
+
+/* RELL节 */
+typedef struct {
+    int32_t chief_id;
+    int32_t deputy_id;
+    RelativePropagator prop;
+} CheckpointRelativeLinkRecord;
+
+#endif /* CHECKPOINT_H */
@@ -0,0 +1,82 @@
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include "types.h"
+#include "constants.h"
+#include "kinematics.h"
+#include "thread_pool.h"
+
+/* ==================== 外部编目导入 ====================
+ *
+ * 从本地 TLE 两行根数（可带第0行名称）或 CCSDS OEM 星历 (KVN) 文件读取真实目标：
+ *   TLE：平运动换算半长轴，e/i/Ω/ω/M 直接取用（SGP4平根数按二体密切根数近似）；
+ *   OEM：每个 META 段取第一条星历（km, km/s）换算六根数，参考中心须为 EARTH。
+ * 文件 mmap 后按字节切块，在线程池上并行解析；块只处理起点落在块内的记录
+ * （TLE 为第1行，OEM 为 META_START），跨块的记录由起点所在块读完，结果按文件顺序合并。
+ * 半长轴筛选在解析时完成，带外目标不做根数换算也不分配条目。
+ * 各记录历元不同，导入后按二体平运动把平近点角推到共同历元，作为仿真零时刻的初始状态。
+ */
+
+#define CATALOG_GEO_A_MIN       ((GEO_SEMIMAJOR - 200.0) * 1000.0)  // GEO保护带下沿 (m)
+#define CATALOG_GEO_A_MAX       ((GEO_SEMIMAJOR + 200.0) * 1000.0)  // GEO保护带上沿 (m)
+#define CATALOG_DEFAULT_CHUNK   (256 * 1024)                       // 默认切块字节数
+#define CATALOG_NAME_LEN        25
+
+typedef enum {
+    CATALOG_FORMAT_AUTO = 0,    // 按内容识别（CCSDS_OEM_VERS 开头为OEM，否则TLE）
+    CATALOG_FORMAT_TLE,
+    CATALOG_FORMAT_OEM
+} CatalogFormat;
+
+/* 导入参数（全零为合法默认：自动识别格式、不筛选、CPU核数线程） */
+typedef struct {
+    CatalogFormat format;
+    double a_min;               // 半长轴筛选下沿 (m)
+    double a_max;               // 半长轴筛选上沿 (m)，<=0 不筛选
+    double epoch_jd;            // 共同历元（儒略日），<=0 取文件中最晚的记录历元
+    int num_threads;            // 工作线程数（<=0 表示CPU核数，pool 非空时忽略）
+    ThreadPool *pool;           // 复用已有线程池，NULL 则临时创建
+    size_t chunk_size;          // 切块字节数（0 取 CATALOG_DEFAULT_CHUNK）
+} CatalogOptions;
+
+/* 编目条目：根数单位同 OrbitalElements (m, 度)，state 为共同历元的初始状态 (m, m/s) */
+typedef struct {
+    int id;                             // NORAD编号（OEM 的 OBJECT_ID 非纯数字时为0）
+    char name[CATALOG_NAME_LEN];
+    double epoch_jd;                    // 共同历元
+    OrbitalElements elements;
+    StateVector state;
+} CatalogEntry;
+
+/* 导入统计 */
+typedef struct {
+    int parsed;                 // 格式合法的记录数（含被筛掉的）
+    int filtered;               // 被半长轴筛掉的记录数
+    int rejected;               // 格式、校验和或参考系不合法而跳过的记录数（带外记录不做校验）
+    int chunks;                 // 切块数
+} CatalogStats;
+
+/* GEO 保护带筛选的默认参数 */
+void catalog_default_options(CatalogOptions *options);
+
+/**
+ * 读取编目文件
+ * @param options 导入参数（NULL 同 catalog_default_options）
+ * @param entries_out 输出条目数组（调用方 free），无符合条件的目标时为NULL
+ * @param stats 可选统计输出
+ * @return 条目数，文件无法读取返回-1
+ */
+int catalog_load(const char *path, const CatalogOptions *options,
+                 CatalogEntry **entries_out, CatalogStats *stats);
+
+/**
+ * 把编目条目作为卫星加入引擎（卫星建在引擎slab上）
+ * @param team 阵营 (0红 1蓝)
+ * @param function_type 功能 (0攻击 1侦察 2防御)
+ * @param history_capacity 同 config_load_engine
+ * @return 加入的卫星数；ID为0或与已有卫星重复的条目按当前最大ID依次续编
+ */
+int catalog_add_to_engine(KinematicsEngine *engine, const CatalogEntry *entries, int count,
+                          uint8_t team, uint8_t function_type, int history_capacity);
+
+#endif /* CATALOG_H */
@@ -2,6 +2,7 @@
 #define CONFIG_H
 
 #include "types.h"
+#include "kinematics.h"
 
 /* ==================== 配置文件路径 ==================== */
 
@@ -10,24 +11,140 @@
 #define OUTPUT_MANEUVER_FILE  "output/maneuver.json"
 #define OUTPUT_HISTORY_FILE   "output/trajectory.json"
 
-/* ==================== 配置读取 ==================== */
-
-/* 从JSON文件读取仿真配置 */
+/* ==================== 配置读取 ====================
+ *
+ * 场景文件按只读 mmap 映射后单遍原位解析（不复制、不建DOM），支持两种结构：
+ *   config1.json：simulation / satellites / strategy_thresholds / formation_parameters / attitude_parameters
+ *   config.json ：red / blue 各功能卫星数 + strategy + simulation
+ * 卫星半长轴和编队距离文件中为km，读入后换算为m（策略阈值保持原值）；卫星 type 为阵营 (0红 1蓝)，
+ * function_type 为 SatelliteFunctionType (1攻击 2侦察 3防御)。未识别的键跳过。
+ * 以下各函数同样接受 config_compile_scenario 生成的二进制场景（按文件头识别）。
+ */
+
+/* 从JSON文件读取仿真配置（只覆盖文件中出现的项），返回0成功 */
 int config_load_simulation(const char *config_file, SimulationConfig *config);
 
-/* 从JSON文件读取卫星配置 */
+/**
+ * 从JSON文件读取卫星配置（卫星在系统堆上创建）
+ * @param satellites_out 输出卫星指针数组（调用方逐颗 satellite_destroy 后 free）
+ * @return 0 成功，-1 失败
+ */
 int config_load_satellites(
     const char *config_file,
     Satellite ***satellites_out,
     int *num_satellites_out
 );
 
-/* 从JSON文件读取策略阈值 */
+/* 从JSON文件读取策略阈值，返回0成功 */
 int config_load_strategy_thresholds(
     const char *config_file,
     StrategyThresholds *thresholds
 );
 
+/* 从JSON文件读取按功能计数的场景（config.json 结构），返回0成功 */
+int config_load_scenario(const char *config_file, Config *scenario);
+
+/**
+ * 读取场景文件并创建引擎：仿真参数和策略阈值在 defaults 上覆盖，
+ * 有 satellites 数组时卫星按六根数直接在引擎slab上创建，否则按 red/blue 计数创建
+ * @param history_capacity 同 simulation_create_engine
+ * @return 引擎，文件、格式或卫星参数错误返回NULL
+ */
+KinematicsEngine* config_load_engine(const char *config_file, const SimulationConfig *defaults,
+                                     uint64_t seed, int history_capacity);
+
+/* ==================== 运行时参数重载 ==================== */
+
+/**
+ * 从场景文件重新读取策略阈值、编队参数和 simulation.slew_cost_weight 并提交给引擎，
+ * 下一个决策周期开始时生效；文件中未出现的项保持当前值，其余内容忽略。可在任意线程调用。
+ * 编队参数（lambert_* / ellipse_*）随参数块保存，但目前没有模块在运行中读取
+ * @return 0 成功；文件、格式错误或参数无效返回-1，引擎参数不变
+ */
+int config_reload_params(KinematicsEngine *engine, const char *config_file);
+
+/* ==================== 二进制场景 ====================
+ *
+ * JSON场景一次性编译为定长二进制：文件头（版本、仿真参数、策略）后按列存放卫星数组，
+ * 各列64字节对齐，初始位置速度已由根数换算好。加载时 mmap 后按列直接拷入卫星，
+ * 不做解析也不做根数换算，启动耗时只剩缺页。
+ * 仿真参数在编译时以 simulation_default_config 为底合并，逐项写入文件头（不依赖
+ * SimulationConfig 的内存布局），加载时整体采用（kernel_isa 除外，仍取调用方的）。
+ */
+
+#define SCENARIO_MAGIC      "SATSCN"    // 8字节（含结尾0）
+#define SCENARIO_VERSION    2
+#define SCENARIO_ALIGN      64          // 各列起始偏移对齐字节数
+
+/* 卫星数组的列，下标即 ScenarioHeader.columns 的下标 */
+typedef enum {
+    SCENARIO_COL_ID = 0,        // int32_t
+    SCENARIO_COL_TEAM,          // uint8_t 阵营 (0红 1蓝)
+    SCENARIO_COL_FUNCTION,      // uint8_t 功能 (0攻击 1侦察 2防御)
+    SCENARIO_COL_FUEL,          // double 初始燃料 (kg)
+    SCENARIO_COL_A,             // double 六根数，单位同 OrbitalElements (m, 度)
+    SCENARIO_COL_E,
+    SCENARIO_COL_I,
+    SCENARIO_COL_RAAN,
+    SCENARIO_COL_ARGP,
+    SCENARIO_COL_M0,
+    SCENARIO_COL_POS_X,         // double 初始位置 (m)
+    SCENARIO_COL_POS_Y,
+    SCENARIO_COL_POS_Z,
+    SCENARIO_COL_VEL_X,         // double 初始速度 (m/s)
+    SCENARIO_COL_VEL_Y,
+    SCENARIO_COL_VEL_Z,
+    SCENARIO_COL_COUNT
+} ScenarioColumn;
+
+/* 仿真参数，下标即 ScenarioHeader.params 的下标；整数项也存为 double（可精确表示）。
+   SimulationConfig 增删参数时在此同步增删并提升 SCENARIO_VERSION */
+typedef enum {
+    SCENARIO_PARAM_TIME_STEP = 0,
+    SCENARIO_PARAM_MAX_STEPS,
+    SCENARIO_PARAM_SAVE_INTERVAL,
+    SCENARIO_PARAM_ATTITUDE_TIME_STEP,
+    SCENARIO_PARAM_CONTROL_INTERVAL,
+    SCENARIO_PARAM_DECISION_INTERVAL,
+    SCENARIO_PARAM_HOHMANN_PRECISION,
+    SCENARIO_PARAM_LAMBERT_MAX_ITERATIONS,
+    SCENARIO_PARAM_LAMBERT_CONVERGENCE,
+    SCENARIO_PARAM_LAMBERT_TARGET_DISTANCE,
+    SCENARIO_PARAM_LAMBERT_MAX_DELTA_V,
+    SCENARIO_PARAM_ELLIPSE_MIN_DISTANCE,
+    SCENARIO_PARAM_ELLIPSE_MAX_DISTANCE,
+    SCENARIO_PARAM_ATTACK_DISTANCE,
+    SCENARIO_PARAM_INSPECT_DISTANCE,
+    SCENARIO_PARAM_DEFENSE_DISTANCE,
+    SCENARIO_PARAM_CRITICAL_DISTANCE,
+    SCENARIO_PARAM_WARNING_DISTANCE,
+    SCENARIO_PARAM_SLEW_COST_WEIGHT,
+    SCENARIO_PARAM_PERTURBATION_FLAGS,
+    SCENARIO_PARAM_EPOCH_JD,
+    SCENARIO_PARAM_COUNT
+} ScenarioParam;
+
+/* 文件头（位于偏移0，各字段自然对齐、无填充）；header_size 用于检测结构布局变化 */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t file_size;
+    int32_t satellite_count;
+    int32_t reserved;
+    uint64_t columns[SCENARIO_COL_COUNT];   // 各列的文件偏移
+    double params[SCENARIO_PARAM_COUNT];    // 仿真参数（含策略阈值），见 ScenarioParam
+    char strategy[32];
+    double max_rate;                        // 姿态约束（0 表示沿用卫星默认值）
+    double max_accel;
+} ScenarioHeader;
+
+/**
+ * 把带 satellites 数组的JSON场景编译为二进制场景（先写临时文件再改名）
+ * @return 0 成功；JSON错误、只有阵营计数或写入失败返回-1
+ */
+int config_compile_scenario(const char *json_file, const char *binary_file);
+
 /* ==================== 配置保存 ==================== */
 
 /* 将仿真配置保存到JSON文件 */
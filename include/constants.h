@@ -8,6 +8,17 @@
 #define GEO_ALTITUDE        35786.0         // 地球同步轨道高度 (km)
 #define GEO_SEMIMAJOR       42164.0         // 地球同步轨道半长轴 (km)
 
+/* ===================== 国际单位制物理常数（状态向量使用 m、m/s） ===================== */
+#define MU_SI               3.986004418e14  // 地心引力常数 (m³/s²)
+#define EARTH_EQ_RADIUS_SI  6378137.0       // 地球赤道半径 (m)
+#define EARTH_J2            1.08262668e-3   // 地球J2带谐项系数
+#define MU_SUN_SI           1.32712440018e20 // 太阳引力常数 (m³/s²)
+#define MU_MOON_SI          4.9028e12       // 月球引力常数 (m³/s²)
+#define AU_SI               1.495978707e11  // 天文单位 (m)
+#define SOLAR_PRESSURE_SI   4.56e-6         // 1AU处太阳光压 (N/m²)
+#define JD_J2000            2451545.0       // J2000.0 儒略日
+#define SECONDS_PER_DAY     86400.0         // 每日秒数
+
 /* ===================== 仿真参数 ===================== */
 #define MAX_SATELLITES      100             // 最大卫星数
 #define MAX_HISTORY_PER_SAT 10000          // 每颗卫星最大历史长度
@@ -2,6 +2,7 @@
 #define DECISION_TREE_H
 
 #include "types.h"
+#include "arena.h"
 
 /* ==================== 决策树分组结果 ==================== */
 
@@ -28,6 +29,17 @@ GroupResult* decision_tree_group_satellites(
     int target_num_groups
 );
 
+/**
+ * 同 decision_tree_group_satellites，结果从 scratch 切分（随arena重置回收，不要调用free_result）
+ * @param scratch 决策周期临时arena，NULL 时等同于 decision_tree_group_satellites
+ */
+GroupResult* decision_tree_group_satellites_in(
+    Arena *scratch,
+    Satellite **satellites,
+    int num_satellites,
+    int target_num_groups
+);
+
 /**
  * 根据分组和卫星功能类型选择合适的编队
  * @param satellites 卫星数组
@@ -2,6 +2,7 @@
 #define DIFFERENTIAL_GAME_H
 
 #include "types.h"
+#include "arena.h"
 
 /* ==================== 博弈结果结构 ==================== */
 
@@ -32,6 +33,22 @@ GameResult* differential_game_assign_strategies(
     const char *strategy_type
 );
 
+/**
+ * 同 differential_game_assign_strategies，结果和收益矩阵从 scratch 切分
+ * （随arena重置回收，不要调用free_result）
+ * @param scratch 决策周期临时arena，NULL 时等同于 differential_game_assign_strategies
+ * @param slew_weight 收益扣减：红星机体轴转向蓝星每秒机动时间扣 slew_weight（0 不计入）
+ */
+GameResult* differential_game_assign_strategies_in(
+    Arena *scratch,
+    Satellite **red_satellites,
+    int num_red,
+    Satellite **blue_satellites,
+    int num_blue,
+    const char *strategy_type,
+    double slew_weight
+);
+
 /**
  * 计算两颗卫星之间的威胁等级（基于距离、速度、燃料）
  * @param red_sat 红方卫星
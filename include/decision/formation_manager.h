@@ -5,6 +5,8 @@
 #include <types.h>
 #include <satellite.h>
 
+#define FORMATION_MANAGER_INITIAL_CAPACITY  100   // 初始卫星容量（注册时按需加倍）
+
 typedef struct {
     uint8_t from_formation;
     uint8_t to_formation;
@@ -14,6 +16,7 @@ typedef struct {
 
 typedef struct {
     int num_satellites;
+    int capacity;
     Satellite **satellites;
     FormationTrigger *triggers;
     FormationTransitionRule *transition_rules;
@@ -0,0 +1,216 @@
+/* 轨道事件检测：事件函数符号变化检测 + Illinois求根精化事件时刻 */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include "types.h"
+#include "vector3.h"
+#include "perturbation.h"
+
+#define EVENT_TIME_TOLERANCE    1e-3    // 事件时刻收敛容差 (秒)
+#define EVENT_MAX_ITERATIONS    60      // 求根最大迭代次数
+
+/* ==================== 数据结构 ==================== */
+
+/* 触发方向：g 由负变正为上升沿，由正变负为下降沿 */
+typedef enum {
+    EVENT_DIR_FALLING = -1,
+    EVENT_DIR_ANY     = 0,
+    EVENT_DIR_RISING  = 1
+} EventDirection;
+
+struct OrbitEvent;
+
+/**
+ * 事件函数：事件发生在 g 过零处
+ * @param primary 主卫星状态
+ * @param secondary 副卫星状态（单星事件为NULL）
+ * @param user_data 用户数据
+ */
+typedef double (*event_func)(
+    const StateVector *primary,
+    const StateVector *secondary,
+    void *user_data
+);
+
+/* 事件回调：t 为精化后的事件时刻，状态为该时刻插值结果 */
+typedef void (*event_handler)(
+    const struct OrbitEvent *event,
+    double t,
+    const StateVector *primary,
+    const StateVector *secondary,
+    void *user_data
+);
+
+/* 轨道事件 */
+typedef struct OrbitEvent {
+    int id;                         // 事件ID（注册时分配）
+    const char *name;               // 事件名称
+    int primary_id;                 // 主卫星ID
+    int secondary_id;               // 副卫星ID（-1表示单星事件）
+
+    event_func g;                   // 事件函数
+    event_handler handler;          // 事件回调（可为NULL）
+    void *user_data;
+
+    EventDirection direction;       // 触发方向
+    int terminal;                   // 触发后停止外推（仅 event_propagate 使用）
+    int one_shot;                   // 触发一次后自动停用
+    int active;                     // 是否启用
+
+    // ===== 运行时状态 =====
+    int primed;                     // 是否已记录上一步
+    double t_prev;                  // 上一步时刻
+    double g_prev;                  // 上一步事件函数值
+    StateVector primary_prev;
+    StateVector secondary_prev;
+
+    uint32_t fire_count;            // 累计触发次数
+    double last_fire_time;          // 最近一次触发时刻
+} OrbitEvent;
+
+/* 事件触发记录 */
+typedef struct {
+    int event_id;
+    double time;
+    StateVector primary;
+    StateVector secondary;
+} EventHit;
+
+/* 事件表 */
+typedef struct {
+    OrbitEvent *events;
+    int num_events;
+    int capacity;
+    int next_id;
+
+    EventHit *pending;              // 单步触发缓冲（按时间排序后回调）
+    int pending_capacity;
+} EventList;
+
+/* 按卫星ID取当前状态（找不到返回NULL） */
+typedef const StateVector* (*event_state_lookup)(int sat_id, void *context);
+
+/* ==================== 内置事件函数 ==================== */
+
+/* 距离阈值参数 */
+typedef struct {
+    double threshold;               // 距离阈值 (m)
+} EventDistanceParams;
+
+/* 相位角参数（主星LVLH系内副星方位角） */
+typedef struct {
+    double target_angle;            // 目标方位角 (rad)
+} EventPhaseParams;
+
+/**
+ * 两星距离减阈值：下降沿=进入阈值内，上升沿=离开
+ * user_data 为 EventDistanceParams*
+ */
+double event_distance_func(const StateVector *primary, const StateVector *secondary, void *user_data);
+
+/* 径向速度 r·v：下降沿=远地点，上升沿=近地点 */
+double event_apsis_func(const StateVector *primary, const StateVector *secondary, void *user_data);
+
+/**
+ * sin(θ - θ*)，θ为副星在主星LVLH径向-沿迹平面内的方位角
+ * θ递增时上升沿对应经过目标方位角（用于绕飞圈数统计）
+ * user_data 为 EventPhaseParams*
+ */
+double event_phase_angle_func(const StateVector *primary, const StateVector *secondary, void *user_data);
+
+/* ==================== 求根和插值 ==================== */
+
+/**
+ * Illinois（改进试位法）求根，要求 g0 与 g1 异号
+ * @param f 标量函数
+ * @param context 传给 f 的上下文
+ * @param t0 区间左端
+ * @param g0 f(t0)
+ * @param t1 区间右端
+ * @param g1 f(t1)
+ * @param tolerance 时间容差
+ * @param root_out 输出根
+ * @return 成功返回0，区间无效返回-1
+ */
+int event_find_root(
+    double (*f)(double t, void *context),
+    void *context,
+    double t0, double g0,
+    double t1, double g1,
+    double tolerance,
+    double *root_out
+);
+
+/* 三次Hermite插值（位置/速度端点），t ∈ [s0->time, s1->time] */
+void event_hermite_interpolate(
+    const StateVector *s0,
+    const StateVector *s1,
+    double t,
+    StateVector *out
+);
+
+/* ==================== 事件表 ==================== */
+
+void event_list_init(EventList *list);
+void event_list_free(EventList *list);
+
+/**
+ * 注册事件（拷贝模板，运行时字段清零）
+ * @return 事件ID，失败返回-1
+ */
+int event_list_add(EventList *list, const OrbitEvent *event);
+
+int event_list_remove(EventList *list, int event_id);
+
+OrbitEvent* event_list_get(EventList *list, int event_id);
+
+/* 使事件在下一次检测时重新记录初值（卫星状态被外部改写后调用） */
+void event_list_reset(EventList *list);
+
+/**
+ * 步末检测：与上一步比较符号变化，用Hermite插值+Illinois精化事件时刻，
+ * 按时间先后调用回调
+ * @param list 事件表
+ * @param t 当前时刻
+ * @param lookup 卫星状态查询
+ * @param context 传给 lookup 的上下文
+ * @param hits_out 输出触发记录（可为NULL）
+ * @param max_hits hits_out 容量
+ * @return 本步触发的事件数
+ */
+int event_list_check(
+    EventList *list,
+    double t,
+    event_state_lookup lookup,
+    void *context,
+    EventHit *hits_out,
+    int max_hits
+);
+
+/* ==================== 带事件的外推 ==================== */
+
+/**
+ * 单星大步长外推，步间检测单星事件，遇终止事件时停在事件时刻
+ * 每步先对全部事件求根，非终止事件按时刻先后触发，晚于本步最早终止事件的留待下次外推
+ * 事件时刻状态由步起点重新积分得到（与积分器同精度）
+ * @param state 卫星状态（原地更新）
+ * @param duration 外推时长 (秒)
+ * @param max_step 最大步长 (秒)
+ * @param model 摄动模型（可为NULL）
+ * @param events 事件数组（secondary_id 应为 -1）
+ * @param num_events 事件数
+ * @param hit_out 终止事件记录（可为NULL）
+ * @return 遇终止事件返回1，到达终点返回0，失败返回-1
+ */
+int event_propagate(
+    StateVector *state,
+    double duration,
+    double max_step,
+    const PerturbationModel *model,
+    OrbitEvent *events,
+    int num_events,
+    EventHit *hit_out
+);
+
+#endif /* EVENT_H */
@@ -0,0 +1,115 @@
+/* 轨迹历史：分层环形缓冲（近期全速率，远期逐级抽稀），冷层可选预测+XOR压缩 */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "types.h"
+#include "arena.h"
+
+#define HISTORY_MAX_TIERS          4
+#define HISTORY_DEFAULT_CAPACITY   1024    // 每层样本数
+#define HISTORY_DEFAULT_DECIMATION 10      // 相邻层抽稀倍数
+#define HISTORY_BLOCK_SAMPLES      64      // 冷层压缩块样本数
+
+/* ==================== 数据结构 ==================== */
+
+/* 单个历史样本 */
+typedef struct {
+    double time;
+    Vector3 position;
+    Vector3 velocity;
+    int32_t formation;
+} HistorySample;
+
+/* 分层配置：第k层每 decimation[k] 个追加样本记录一个（第0层应为1） */
+typedef struct {
+    int num_tiers;
+    uint32_t capacity[HISTORY_MAX_TIERS];
+    uint32_t decimation[HISTORY_MAX_TIERS];
+    int compress_cold;             // 最后一层按块压缩存储
+    uint32_t block_samples;        // 压缩块大小
+} HistoryConfig;
+
+/* 未压缩层：定长环形缓冲，满后覆盖最旧样本 */
+typedef struct {
+    HistorySample *samples;
+    uint32_t capacity;
+    uint32_t head;                 // 下一个写入位置
+    uint32_t count;
+    uint32_t decimation;
+} HistoryRing;
+
+/* 压缩块 */
+typedef struct {
+    uint8_t *data;
+    uint32_t size;                 // 字节数
+    uint32_t count;                // 样本数
+} HistoryBlock;
+
+/* 压缩冷层：样本先进暂存区，满一块后压缩进块环形缓冲 */
+typedef struct {
+    HistoryBlock *blocks;
+    uint32_t max_blocks;
+    uint32_t head;
+    uint32_t count;
+    HistorySample *staging;
+    uint32_t staging_count;
+    uint32_t block_samples;
+    uint32_t decimation;
+    uint8_t *scratch;              // 编码暂存（按一块最坏情况分配，各次压缩复用）
+    size_t compressed_bytes;       // 当前所有块的字节总数
+} HistoryColdTier;
+
+typedef struct TrajectoryHistory {
+    HistoryConfig config;
+    int num_rings;                 // 未压缩层数
+    HistoryRing rings[HISTORY_MAX_TIERS];
+    HistoryColdTier cold;          // compress_cold 时有效
+    uint64_t total_appended;
+    SlabAllocator *allocator;      // 所属分配器，NULL 为系统堆
+} TrajectoryHistory;
+
+/* ==================== 创建和销毁 ==================== */
+
+/* 默认三层：近期全速率，其后逐级抽稀 HISTORY_DEFAULT_DECIMATION 倍，最远层压缩 */
+void history_config_default(HistoryConfig *config, uint32_t recent_capacity);
+
+/* allocator 非NULL时定长缓冲从该slab分配；冷层压缩块长度不定，按实际字节数从系统堆分配 */
+TrajectoryHistory* history_create(const HistoryConfig *config, SlabAllocator *allocator);
+void history_destroy(TrajectoryHistory *history);
+void history_clear(TrajectoryHistory *history);
+
+/* ==================== 记录和读取 ==================== */
+
+/* 追加样本（O(1)，冷层每满一块压缩一次） */
+int history_append(TrajectoryHistory *history, const HistorySample *sample);
+
+/**
+ * 读取最近的全速率样本
+ * @param back 0 为最新样本，1 为上一个……
+ * @return 成功返回0，超出第0层窗口返回-1
+ */
+int history_latest(const TrajectoryHistory *history, uint32_t back, HistorySample *out);
+
+/**
+ * 按时间顺序导出多分辨率历史：远期取粗层，近期取细层，不重复
+ * @param out 输出数组（NULL 时只返回样本数）
+ * @param max_samples 输出容量
+ * @return 写出的样本数
+ */
+int history_collect(const TrajectoryHistory *history, HistorySample *out, int max_samples);
+
+/* 当前占用内存（字节，含压缩块） */
+size_t history_memory_bytes(const TrajectoryHistory *history);
+
+/* ==================== 序列化（检查点用） ==================== */
+
+/* 序列化到 out（NULL 时只返回所需字节数） */
+size_t history_serialize(const TrajectoryHistory *history, uint8_t *out);
+
+/* 从字节流恢复，失败返回NULL */
+TrajectoryHistory* history_deserialize(const uint8_t *data, size_t size, SlabAllocator *allocator);
+
+#endif /* HISTORY_H */
@@ -5,6 +5,10 @@
 #include <satellite.h>
 #include <orbit.h>
 #include <attitude.h>
+#include <perturbation.h>
+#include <relative_motion.h>
+#include <event.h>
+#include <proximity.h>
 #include <decision/formation_manager.h>
 
 /* ==================== 编队控制器结构 ==================== */
@@ -15,11 +19,40 @@ typedef struct {
     void *retreat_state;             // RetreatFormationState*
 } FormationControllers;
 
+/* ==================== 相对运动链接 ==================== */
+/* 近距离从星不再独立积分，而是相对主星按闭式STM外推 */
+typedef struct {
+    Satellite *chief;
+    Satellite *deputy;
+    RelativePropagator prop;
+} RelativeMotionLink;
+
+/* ==================== 多速率时钟 ==================== */
+/* 每次 kinematics_engine_step 推进一个动力学步，其余子系统按各自周期触发 */
+typedef enum {
+    SIM_CLOCK_DYNAMICS = 0,        // 轨道动力学（基本步长）
+    SIM_CLOCK_ATTITUDE,            // 姿态（子步长，仅机动中的卫星）
+    SIM_CLOCK_CONTROL,             // 编队控制
+    SIM_CLOCK_DECISION,            // 决策层（分组 + 博弈分配）
+    SIM_CLOCK_COUNT
+} SimClockId;
+
+typedef struct {
+    double period;                 // 周期 (秒)
+    double next_time;              // 下次触发时刻 (秒)
+    uint32_t tick_count;           // 累计触发次数
+    uint32_t enabled;              // 0 为停用：到期判断恒为否（动力学时钟不可停用）
+} SimClock;
+
+#define DECISION_DEFAULT_STEPS  100    // 未配置决策周期时的默认步数
+
 /* ==================== 运动学引擎结构 ==================== */
 typedef struct KinematicsEngine {
     Satellite **satellites;
     int satellite_count;
     int satellite_capacity;
+    Satellite **id_index;            // 卫星ID开放寻址哈希（线性探测，容量为2的幂）
+    int id_index_capacity;
     int formation_count;
     
     double current_time;
@@ -32,11 +65,48 @@ typedef struct KinematicsEngine {
     Formation **formations;
     int num_formations;
     
-    StrategyThresholds strategy_thresholds;
+    // ===== 运行时参数（不可变块，读写均经 __atomic，读方不加锁） =====
+    const RuntimeParams *params;     // 当前生效的参数块
+    RuntimeParams *pending_params;   // 已提交、下一决策周期开始时换入
+    RuntimeParams *retired_params;   // 换下的旧块，决策开始时若无外部读方即释放
+    uint32_t params_readers;         // 引擎线程之外正在读参数块的读方数
     
     // ===== 新增：编队控制器 =====
     FormationControllers formation_controllers;
     
+    // ===== 摄动力模型 =====
+    PerturbationModel perturbations;
+    
+    // ===== 相对运动链接 =====
+    RelativeMotionLink *relative_links;
+    int num_relative_links;
+    int relative_links_capacity;
+    
+    // ===== 轨道事件（步末检测，精确时刻回调） =====
+    EventList events;
+    
+    // ===== 近距告警（未启用时为NULL） =====
+    ProximityMonitor *proximity;
+    
+    // ===== 多速率时钟 =====
+    SimClock clocks[SIM_CLOCK_COUNT];
+    char strategy[32];               // 博弈策略类型 (GJ/ZC/FY)
+    uint32_t attitude_substeps;      // 累计姿态子步数（仅机动卫星）
+    AttitudeFleet attitude_fleet;    // 姿态批量步进工作区（SoA，容量跨步复用）
+    Vector3SoA orbit_position;       // 轨道批量外推工作区（SoA，容量跨步复用）
+    Vector3SoA orbit_velocity;
+    Satellite **orbit_batch_sats;    // 工作区各列对应的卫星
+    Vector3SoAIsa kernel_isa;        // 创建时选定的批量内核指令集
+    
+    // ===== 引擎独立随机数（可重入，批量运行互不干扰） =====
+    uint64_t seed;                   // 主种子（按卫星寻址的Philox流密钥）
+    Rng rng;                         // 引擎级顺序流
+    
+    // ===== 引擎内存（卫星和历史按创建顺序切分，销毁时整体释放） =====
+    SlabAllocator slab;
+    int external_satellites;         // 外部分配（不属于slab）的卫星数
+    Arena scratch;                   // 决策周期临时内存，每次决策前重置
+    
     FILE *state_file;
     FILE *maneuver_file;
     FILE *history_file;
@@ -50,6 +120,10 @@ KinematicsEngine* kinematics_engine_create(SimulationConfig config);
 void kinematics_engine_destroy(KinematicsEngine *engine);
 
 int kinematics_engine_add_satellite(KinematicsEngine *engine, Satellite *sat);
+
+/* 从引擎slab创建卫星（初始扰动由引擎种子决定）并加入引擎，失败返回NULL */
+Satellite* kinematics_engine_create_satellite(KinematicsEngine *engine, int id, uint8_t team,
+                                              uint8_t type, uint8_t function_type);
 Satellite* kinematics_engine_get_satellite(KinematicsEngine *engine, int sat_id);
 Satellite** kinematics_engine_get_all_satellites(KinematicsEngine *engine, int *count);
 int kinematics_engine_remove_satellite(KinematicsEngine *engine, int sat_id);
@@ -57,6 +131,72 @@ int kinematics_engine_remove_satellite(KinematicsEngine *engine, int sat_id);
 int kinematics_engine_step(KinematicsEngine *engine);
 int kinematics_engine_run(KinematicsEngine *engine, uint32_t num_steps);
 
+int kinematics_engine_set_perturbations(KinematicsEngine *engine, uint32_t flags, int enabled);
+
+int kinematics_engine_link_relative(KinematicsEngine *engine, int chief_id, int deputy_id);
+int kinematics_engine_unlink_relative(KinematicsEngine *engine, int deputy_id);
+
+int kinematics_engine_seed(KinematicsEngine *engine, uint64_t seed);
+int kinematics_engine_set_strategy(KinematicsEngine *engine, const char *strategy);
+int kinematics_engine_set_clock_period(KinematicsEngine *engine, SimClockId clock, double period);
+
+/**
+ * 启用或停用多速率时钟（动力学时钟即基本步进，不可停用）
+ * 重新启用时从当前时刻起按周期触发
+ * @return 成功返回0，参数无效返回-1
+ */
+int kinematics_engine_enable_clock(KinematicsEngine *engine, SimClockId clock, int enabled);
+int kinematics_engine_decide(KinematicsEngine *engine);
+
+/* ==================== 运行时参数 ====================
+ * 参数块发布后不再修改：读方取一次指针即得到一致的一组参数，无需加锁；
+ * 新块可在任意线程提交，由下一次 kinematics_engine_decide 在决策开始前换入，
+ * 同一决策周期内参数不变。换下的旧块在之后的决策开始时回收：此时若没有
+ * 外部读方（acquire 未 release），回收链整体释放，否则留到下一周期再试。
+ */
+
+/* 由仿真配置生成参数块（generation 为0），失败返回NULL */
+RuntimeParams* runtime_params_create(const SimulationConfig *config);
+
+/* 把参数块写回仿真配置的对应字段 */
+void runtime_params_apply(const RuntimeParams *params, SimulationConfig *config);
+
+/* 当前生效的参数块（引擎线程使用，下一次 kinematics_engine_decide 之前有效） */
+const RuntimeParams* kinematics_engine_params(const KinematicsEngine *engine);
+
+/**
+ * 其他线程读参数块：acquire 返回当前块，release 之前该块不会被回收
+ * （acquire / release 须成对调用，期间不宜长时间持有）
+ */
+const RuntimeParams* kinematics_engine_params_acquire(KinematicsEngine *engine);
+void kinematics_engine_params_release(KinematicsEngine *engine);
+
+/* 提交新参数块（引擎接管所有权；尚未换入的前一次提交被丢弃），返回0成功 */
+int kinematics_engine_submit_params(KinematicsEngine *engine, RuntimeParams *params);
+
+int kinematics_engine_control(KinematicsEngine *engine);
+
+int kinematics_engine_add_event(KinematicsEngine *engine, const OrbitEvent *event);
+int kinematics_engine_remove_event(KinematicsEngine *engine, int event_id);
+
+/* 近距告警：每步末按当前参数块的策略阈值更新红蓝卫星对的距离带，跨带事件写入环形缓冲 */
+/* 告警状态不进入检查点，恢复后重新启用即按当时位置重建 */
+int kinematics_engine_enable_proximity(KinematicsEngine *engine, int event_capacity);
+
+/* 取出告警事件（可在步进线程之外的一个线程调用），未启用返回0 */
+int kinematics_engine_poll_proximity(KinematicsEngine *engine, ProximityEvent *out, int max_events);
+
+/* 当前在阈值圈内的卫星对数（步进线程或步进结束后调用），未启用返回-1 */
+int kinematics_engine_proximity_pairs(const KinematicsEngine *engine);
+
+/* 事件缓冲满而丢弃的告警事件数（任意线程），未启用返回0 */
+uint64_t kinematics_engine_proximity_dropped(const KinematicsEngine *engine);
+
+/* 检查点：卫星/历史/编队控制器/编队管理器/相对链接/时间和时钟
+   （事件表和自定义摄动项含函数指针，恢复后需重新注册） */
+int kinematics_engine_save_checkpoint(KinematicsEngine *engine, const char *filename);
+KinematicsEngine* kinematics_engine_load_checkpoint(const char *filename);
+
 int kinematics_engine_init_satellites(KinematicsEngine *engine);
 int kinematics_engine_init_formations(KinematicsEngine *engine);
 int kinematics_engine_init_transition_rules(KinematicsEngine *engine);
@@ -0,0 +1,18 @@
+/* 仿真日志：库内部的进度/诊断输出统一经 SIM_LOG，可按线程静默 */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdio.h>
+
+/* 当前线程是否静默（线程局部，批量运行的工作线程各自关闭） */
+extern _Thread_local int sim_log_quiet;
+
+/* 设置当前线程静默，返回原值 */
+int sim_log_set_quiet(int quiet);
+
+/* 与 printf 用法相同；错误信息仍直接写 stderr，不受静默影响 */
+#define SIM_LOG(...) \
+    do { if (!sim_log_quiet) printf(__VA_ARGS__); } while (0)
+
+#endif /* LOG_H */
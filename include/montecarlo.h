@@ -0,0 +1,66 @@
+/* 蒙特卡洛批量仿真：多线程运行M个独立引擎，在线累计统计量（不保存单次轨迹） */
+
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <stdint.h>
+#include "kinematics.h"
+
+/* ==================== 在线统计（Welford） ==================== */
+
+typedef struct {
+    uint64_t count;
+    double mean;
+    double m2;                     // 与均值之差的平方和
+    double min;
+    double max;
+} RunningStats;
+
+void running_stats_init(RunningStats *stats);
+void running_stats_push(RunningStats *stats, double x);
+
+/* 合并两组统计量（Chan并行公式），用于汇总各工作线程的局部结果 */
+void running_stats_merge(RunningStats *dst, const RunningStats *src);
+
+/* 样本方差 (n-1) */
+double running_stats_variance(const RunningStats *stats);
+double running_stats_stddev(const RunningStats *stats);
+
+/* ==================== 批量运行 ==================== */
+
+/**
+ * 场景构建回调：按给定种子创建一个已装载卫星的引擎
+ * 在工作线程中调用，必须可重入（随机性只能来自 engine->rng）
+ */
+typedef KinematicsEngine* (*MonteCarloBuildFunc)(uint64_t seed, void *user_data);
+
+typedef struct {
+    int num_runs;                  // 运行次数 M
+    int num_threads;               // 工作线程数（<=0 表示CPU核数）
+    uint32_t num_steps;            // 每次运行步数
+    uint64_t base_seed;            // 主种子，第k次运行的种子由其确定性派生
+    MonteCarloBuildFunc build;
+    void *user_data;
+} MonteCarloOptions;
+
+typedef struct {
+    int runs_completed;
+    int runs_failed;
+    int num_threads;
+    double elapsed_seconds;        // 墙钟耗时 (秒)
+
+    // 只统计随场景变化的量：编队控制器尚不施加速度增量（燃料、机动次数恒为0），编队质量也未实现
+    RunningStats target_distance;  // 红星到目标平均距离 (km)
+} MonteCarloResult;
+
+/**
+ * 运行蒙特卡洛批量仿真
+ * 工作线程日志静默；每个线程维护局部统计量，结束时合并一次
+ * @return 成功完成的运行数，参数错误返回-1
+ */
+int monte_carlo_run(const MonteCarloOptions *options, MonteCarloResult *result);
+
+/* 打印统计结果 */
+void monte_carlo_print_result(const MonteCarloResult *result);
+
+#endif /* MONTECARLO_H */
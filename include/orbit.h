@@ -4,10 +4,12 @@
 #include "types.h"
 #include "vector3.h"
 #include "constants.h"
+#include "perturbation.h"
+#include "vector3_soa.h"
 
 /* ==================== 轨道六根数转换 ==================== */
 
-/* 轨道六根数转换为位置和速度（PQW坐标系 -> ECI坐标系） */
+/* 轨道六根数转换为位置和速度（PQW坐标系 -> ECI坐标系；a与状态同为m，角度为度） */
 int orbit_elements_to_state(
     OrbitalElements *elements,
     StateVector *state
@@ -21,7 +23,9 @@ int orbit_state_to_elements(
 
 /* ==================== Kepler方程求解 ==================== */
 
-/* 求解Kepler方程: E - e*sin(E) = M */
+#define ORBIT_KEPLER_MAX_ITERATIONS  50     // Newton迭代次数上限
+
+/* 求解Kepler方程: E - e*sin(E) = M（Newton迭代，至多 ORBIT_KEPLER_MAX_ITERATIONS 次） */
 double orbit_solve_kepler_equation(double M, double e, double tolerance);
 
 /* 从偏近地点角E计算真近地点角nu */
@@ -109,6 +113,13 @@ int orbit_rk4_step(
     Vector3 *acceleration  // 可选的非万有引力加速度
 );
 
+/* RK4积分一步（二体引力 + 摄动模型中所有启用项），model可为NULL */
+int orbit_rk4_step_perturbed(
+    StateVector *state,
+    double dt,
+    const PerturbationModel *model
+);
+
 /* 从当前状态外推到未来时刻 */
 int orbit_propagate(
     StateVector *initial_state,
@@ -117,6 +128,27 @@ int orbit_propagate(
     double time_step
 );
 
+/* ==================== 批量内核（SoA，随 vector3_soa 当前指令集分派） ==================== */
+
+/* 批量内核是否覆盖 model 的全部启用项（二体 + J2；model 可为NULL） */
+int orbit_batch_supports(const PerturbationModel *model);
+
+/**
+ * 批量RK4积分一步，每颗卫星与 orbit_rk4_step_perturbed 结果逐位一致
+ * @param position 位置（原地更新）
+ * @param velocity 速度（原地更新，count 须与 position 相同）
+ * @return 0 成功；参数错误或 model 含不支持的摄动项返回-1
+ */
+int orbit_batch_rk4_step(
+    Vector3SoA *position,
+    Vector3SoA *velocity,
+    double dt,
+    const PerturbationModel *model
+);
+
+/* 批量求解Kepler方程：逐元素调用 orbit_solve_kepler_equation（标量实现，不随指令集切换） */
+void orbit_batch_solve_kepler(const double *M, const double *e, double *E, int count, double tolerance);
+
 /* ==================== 轨道操纵参数计算 ==================== */
 
 /* 计算速度增量大小 */
@@ -182,12 +214,12 @@ static inline double orbit_semimajor_axis_from_altitude(double altitude) {
     return altitude + EARTH_RADIUS;
 }
 
-/* 计算圆轨道速度 */
+/* 计算圆轨道速度（a 为 km，返回 km/s） */
 static inline double orbit_circular_velocity(double a) {
     return sqrt(MU / a);
 }
 
-/* 计算逃逸速度 */
+/* 计算逃逸速度（a 为 km，返回 km/s） */
 static inline double orbit_escape_velocity(double a) {
     return sqrt(2.0 * MU / a);
 }
@@ -0,0 +1,161 @@
+/* 摄动力模型：J2、日月三体引力、太阳光压 */
+
+#ifndef PERTURBATION_H
+#define PERTURBATION_H
+
+#include "types.h"
+#include "vector3.h"
+
+/* ==================== 摄动项开关 ==================== */
+
+/* 内置摄动项（可按位组合，逐项开关以权衡计算量和精度） */
+typedef enum {
+    PERTURB_NONE   = 0,
+    PERTURB_J2     = 1u << 0,     // 地球J2带谐项
+    PERTURB_SUN    = 1u << 1,     // 太阳三体引力
+    PERTURB_MOON   = 1u << 2,     // 月球三体引力
+    PERTURB_SRP    = 1u << 3,     // 太阳光压（含柱形地影）
+    PERTURB_CUSTOM = 1u << 8,     // 自定义摄动项起始位
+    PERTURB_ALL_BUILTIN = PERTURB_J2 | PERTURB_SUN | PERTURB_MOON | PERTURB_SRP
+} PerturbationFlags;
+
+#define PERTURBATION_MAX_TERMS      8       // 摄动项表容量
+#define EPHEMERIS_CHEB_ORDER        12      // 切比雪夫系数个数
+#define EPHEMERIS_SEGMENT_SECONDS   86400.0 // 默认星历分段长度 (秒)
+
+/* ==================== 切比雪夫星历表 ==================== */
+
+/* 单个星历段：每个坐标分量一组切比雪夫系数 */
+typedef struct {
+    double t_start;                             // 段起始时间 (仿真秒)
+    double t_end;                               // 段结束时间 (仿真秒)
+    double coeffs[3][EPHEMERIS_CHEB_ORDER];     // x/y/z 系数
+} ChebyshevSegment;
+
+/* 预计算星历表（仿真开始时按场景时长生成） */
+typedef struct {
+    ChebyshevSegment *segments;
+    int num_segments;
+    double t_start;            // 覆盖起始时间 (仿真秒)
+    double t_end;              // 覆盖结束时间 (仿真秒)
+    double segment_span;       // 每段长度 (秒)
+} ChebyshevEphemeris;
+
+/* 解析星历函数：输入儒略日，输出ECI位置 (m) */
+typedef Vector3 (*ephemeris_position_func)(double jd);
+
+/* ==================== 摄动模型 ==================== */
+
+struct PerturbationModel;
+
+/* 摄动加速度函数：输入当前状态（state->time 为仿真秒），返回加速度 (m/s²) */
+typedef Vector3 (*perturbation_accel_func)(
+    const struct PerturbationModel *model,
+    const StateVector *state,
+    void *user_data
+);
+
+/* 摄动项表条目 */
+typedef struct {
+    const char *name;
+    uint32_t flag;
+    perturbation_accel_func accel;
+    void *user_data;
+} PerturbationTerm;
+
+/* 可插拔摄动模型 */
+typedef struct PerturbationModel {
+    uint32_t enabled_flags;                         // 当前启用的摄动项
+    PerturbationTerm terms[PERTURBATION_MAX_TERMS];
+    int num_terms;
+
+    double epoch_jd;                                // 仿真零时刻对应儒略日
+    double srp_cr;                                  // 光压反射系数
+    double srp_area_to_mass;                        // 面质比 (m²/kg)
+
+    ChebyshevEphemeris sun;                         // 太阳星历
+    ChebyshevEphemeris moon;                        // 月球星历
+} PerturbationModel;
+
+/* ==================== 模型创建和配置 ==================== */
+
+/**
+ * 初始化摄动模型，并为[0, span_seconds]生成日月切比雪夫星历
+ * @param model 待初始化的模型
+ * @param flags 启用的摄动项 (PerturbationFlags组合)
+ * @param epoch_jd 仿真零时刻儒略日（<=0 表示使用J2000）
+ * @param span_seconds 场景时长 (秒)
+ * @return 成功返回0，失败返回-1
+ */
+int perturbation_model_init(
+    PerturbationModel *model,
+    uint32_t flags,
+    double epoch_jd,
+    double span_seconds
+);
+
+/* 释放摄动模型持有的星历表 */
+void perturbation_model_free(PerturbationModel *model);
+
+/* 开关单个或多个摄动项 */
+void perturbation_model_enable(PerturbationModel *model, uint32_t flags, int enabled);
+
+/* 判断摄动项是否启用 */
+int perturbation_model_is_enabled(const PerturbationModel *model, uint32_t flag);
+
+/**
+ * 注册自定义摄动项
+ * @return 分配到的开关位，失败返回0
+ */
+uint32_t perturbation_model_add_term(
+    PerturbationModel *model,
+    const char *name,
+    perturbation_accel_func accel,
+    void *user_data
+);
+
+/* 设置太阳光压参数 */
+void perturbation_model_set_srp(PerturbationModel *model, double cr, double area_to_mass);
+
+/* ==================== 加速度计算 ==================== */
+
+/* 所有启用摄动项的合加速度 (m/s²) */
+Vector3 perturbation_total_acceleration(const PerturbationModel *model, const StateVector *state);
+
+/* J2加速度 */
+Vector3 perturbation_j2_acceleration(Vector3 r);
+
+/* 三体引力加速度（r_body为第三体地心位置） */
+Vector3 perturbation_third_body_acceleration(Vector3 r, Vector3 r_body, double mu_body);
+
+/* 太阳光压加速度（柱形地影模型） */
+Vector3 perturbation_srp_acceleration(Vector3 r, Vector3 r_sun, double cr, double area_to_mass);
+
+/* 从预计算星历表获取日/月位置 */
+Vector3 perturbation_sun_position(const PerturbationModel *model, double t);
+Vector3 perturbation_moon_position(const PerturbationModel *model, double t);
+
+/* ==================== 星历表 ==================== */
+
+/* 低精度解析太阳位置（ECI，m） */
+Vector3 ephemeris_sun_position_analytic(double jd);
+
+/* 低精度解析月球位置（ECI，m） */
+Vector3 ephemeris_moon_position_analytic(double jd);
+
+/* 按分段切比雪夫拟合生成星历表 */
+int ephemeris_build(
+    ChebyshevEphemeris *eph,
+    ephemeris_position_func position_func,
+    double epoch_jd,
+    double span_seconds,
+    double segment_span
+);
+
+/* 释放星历表 */
+void ephemeris_free(ChebyshevEphemeris *eph);
+
+/* 星历表求值（Clenshaw递推），t超出覆盖范围时按端点段外推 */
+Vector3 ephemeris_evaluate(const ChebyshevEphemeris *eph, double t);
+
+#endif /* PERTURBATION_H */
@@ -0,0 +1,92 @@
+/* 阶段计时插桩：CLOCK_MONOTONIC 区间计时 + 对数直方图（按线程统计，无锁，汇总时合并全部线程）
+   未定义 SIM_PROFILE 时 PROF_* 宏展开为空，热路径无任何开销 */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define PROF_SUB_BITS     3                              // 每个2倍区间细分 8 档（相对误差 ≤12.5%）
+#define PROF_NUM_BUCKETS  (64 << PROF_SUB_BITS)
+
+/* ==================== 阶段 ==================== */
+
+typedef enum {
+    PROF_STEP = 0,               // 单步合计
+    PROF_PROPAGATION,            // 轨道外推（RK4 + 相对运动）
+    PROF_DECISION,               // 决策合计
+    PROF_PARTITION,              // 红蓝分队
+    PROF_KMEANS,                 // K-means 分组
+    PROF_PAYOFF,                 // 收益矩阵
+    PROF_ASSIGNMENT,             // 目标分配
+    PROF_FORMATION,              // 编队控制
+    PROF_ATTITUDE,               // 姿态子步进
+    PROF_HISTORY,                // 轨迹历史记录
+    PROF_OUTPUT,                 // 结果输出
+    PROF_RUN,                    // 批量运行中的单次运行（创建+步进+销毁）
+    PROF_PHASE_COUNT
+} ProfPhase;
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint32_t buckets[PROF_NUM_BUCKETS];
+} ProfHistogram;
+
+typedef struct Profiler {
+    ProfHistogram phases[PROF_PHASE_COUNT];
+    uint64_t tick_ns[PROF_PHASE_COUNT];    // 当前tick内各阶段累计（逐tick跟踪用）
+    FILE *trace;                           // 逐tick跟踪输出（NULL 为关闭）
+    struct Profiler *next;                 // 全局登记链表（线程退出后保留，汇总时仍计入）
+} Profiler;
+
+/* ==================== 接口 ==================== */
+
+/* 单调时钟 (纳秒) */
+uint64_t profiler_now_ns(void);
+
+/* 当前线程的统计（首次使用时分配并登记，工作线程之间互不干扰；分配失败返回NULL） */
+Profiler* profiler_current(void);
+
+/* 清空当前线程的统计 */
+void profiler_reset(void);
+
+/* 记录一次区间 [start_ns, end_ns) */
+void profiler_record(ProfPhase phase, uint64_t start_ns, uint64_t end_ns);
+
+/* 阶段名（跟踪文件列名） */
+const char* profiler_phase_name(ProfPhase phase);
+
+/**
+ * 直方图分位数
+ * @param q 分位 (0-1)
+ * @return 所在档的中值（纳秒，不超过观测最大值）
+ */
+uint64_t profiler_percentile(const ProfHistogram *hist, double q);
+
+/* 打开逐tick跟踪（CSV：每步一行，各阶段微秒），file 为NULL时关闭 */
+void profiler_set_trace(FILE *file);
+
+/* 结束一个tick：写出跟踪行并清零tick累计 */
+void profiler_end_tick(uint32_t step);
+
+/* 合并所有登记线程（含已退出的）后打印汇总表，调用时其他线程应已停止记录（无样本时不输出） */
+void profiler_print_summary(void);
+
+/* ==================== 插桩宏 ==================== */
+
+#ifdef SIM_PROFILE
+#define PROF_BEGIN(var)          uint64_t var = profiler_now_ns()
+#define PROF_END(phase, var)     profiler_record((phase), (var), profiler_now_ns())
+#define PROF_TICK_END(step)      profiler_end_tick(step)
+#else
+#define PROF_BEGIN(var)          ((void)0)
+#define PROF_END(phase, var)     ((void)0)
+#define PROF_TICK_END(step)      ((void)0)
+#endif
+
+#endif /* PROFILER_H */
@@ -0,0 +1,113 @@
+/* 近距告警：按策略阈值给每对红蓝卫星划分距离带，只在跨带时产生进入/退出事件 */
+
+#ifndef PROXIMITY_H
+#define PROXIMITY_H
+
+#include <stdint.h>
+#include "types.h"
+#include "satellite.h"
+
+#define PROXIMITY_HYSTERESIS       0.02    // 退出某带须超过阈值的比例（进入按阈值本身）
+#define PROXIMITY_DEFAULT_EVENTS   4096    // 默认事件缓冲容量
+
+/* 距离带：卫星对所在的最内层阈值圈，各圈大小以当前参数块为准（不要求按枚举顺序） */
+typedef enum {
+    PROXIMITY_ZONE_CRITICAL = 0,   // critical_distance 内
+    PROXIMITY_ZONE_INSPECT,        // inspect_distance 内
+    PROXIMITY_ZONE_ATTACK,         // attack_distance 内
+    PROXIMITY_ZONE_DEFENSE,        // defense_distance 内
+    PROXIMITY_ZONE_WARNING,        // warning_distance 内
+    PROXIMITY_ZONE_NONE,           // 所有阈值之外
+    PROXIMITY_ZONE_COUNT
+} ProximityZone;
+
+/* 告警事件：to 比 from 更靠内为进入，否则为退出；一次更新跨多带只产生一条 */
+typedef struct {
+    double time;                   // 仿真时刻 (秒)
+    int red_id;
+    int blue_id;
+    uint8_t from;                  // ProximityZone
+    uint8_t to;                    // ProximityZone
+    uint8_t entering;              // 1 进入 0 退出
+    double distance;               // 该时刻距离 (km)，任一卫星已移除时为 -1
+} ProximityEvent;
+
+/* 处于某带内的卫星对（带外的不保存） */
+typedef struct {
+    int red_id;
+    int blue_id;
+    uint8_t zone;
+    uint32_t stamp;                // 最近一次作为候选被检查的更新序号
+} ProximityPair;
+
+/* 蓝星均匀网格：格边长不小于最外圈退出距离，任一红星只需查相邻 27 格 */
+typedef struct {
+    double cell;                   // 格边长 (m)
+    int count;                     // 蓝星数
+    int capacity;
+    int num_buckets;               // 散列桶数（2的幂）
+    int *bucket_start;             // 桶 b 的蓝星在 order 中占 [start[b], start[b+1])
+    int *order;                    // 按桶排序后的蓝星下标
+    int32_t (*coord)[3];           // 各蓝星所在格
+    Vector3 *position;             // 各蓝星位置 (m)
+    int *id;
+} ProximityGrid;
+
+typedef struct {
+    // ===== 卫星对状态（稠密数组 + 开放寻址索引，每次更新后压缩并重建索引） =====
+    ProximityPair *pairs;
+    int num_pairs;
+    int pairs_capacity;
+    int32_t *pair_index;           // 槽位存 pairs 下标+1，0 为空
+    int pair_index_capacity;
+    uint32_t stamp;
+
+    ProximityGrid grid;
+
+    // ===== 本次更新的红星位置（退出候选范围的卫星对按ID查位置） =====
+    Vector3 *red_position;
+    int *red_id;
+    int num_red;
+    int red_capacity;
+    int32_t *sat_index;            // 本次更新所有卫星 ID -> 下标+1（蓝星取负）
+    int sat_index_capacity;
+
+    // ===== 事件环形缓冲（单生产者单消费者，读写位置经 __atomic） =====
+    ProximityEvent *events;
+    uint32_t event_capacity;       // 2的幂
+    uint32_t event_head;           // 下一个写入序号（生产者）
+    uint32_t event_tail;           // 下一个读取序号（消费者）
+    uint64_t dropped;              // 缓冲满丢弃的事件数
+    uint64_t total_events;
+} ProximityMonitor;
+
+/**
+ * 创建近距告警器
+ * @param event_capacity 事件缓冲容量（向上取2的幂，<=0 取 PROXIMITY_DEFAULT_EVENTS）
+ */
+ProximityMonitor* proximity_monitor_create(int event_capacity);
+void proximity_monitor_destroy(ProximityMonitor *monitor);
+
+/**
+ * 按当前位置更新各卫星对所在的带，跨带的写入事件缓冲
+ * 候选对由蓝星网格给出，开销为 O(卫星数 + 候选对数 + 带内对数)，与红蓝组合总数无关
+ * @param sats 卫星数组（可含NULL），team 0 为红 1 为蓝
+ * @param thresholds 策略阈值 (km)，<=0 的阈值不参与
+ * @param time 事件时刻 (秒)
+ * @return 本次产生的事件数，失败返回-1
+ */
+int proximity_monitor_update(ProximityMonitor *monitor, Satellite *const *sats, int count,
+                             const StrategyThresholds *thresholds, double time);
+
+/**
+ * 取出缓冲中的事件（与 update 可在不同线程，各限一个线程）
+ * @return 取出的事件数
+ */
+int proximity_monitor_poll(ProximityMonitor *monitor, ProximityEvent *out, int max_events);
+
+/* 当前处于某带内的卫星对所在的带，不在任何带内返回 PROXIMITY_ZONE_NONE */
+ProximityZone proximity_monitor_zone(const ProximityMonitor *monitor, int red_id, int blue_id);
+
+const char* proximity_zone_name(ProximityZone zone);
+
+#endif /* PROXIMITY_H */
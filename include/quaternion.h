@@ -61,9 +61,12 @@ Quaternion quat_multiply_vector(Quaternion q, Vector3 v);
 
 /* ==================== 四元数与向量的关系 ==================== */
 
-/* 向量旋转: v' = q * [v, 0] * q* */
+/* 向量旋转: v' = q * [v, 0] * q*（q 须为单位四元数，按 t = 2q×v, v' = v + w·t + q×t 展开计算） */
 Vector3 quat_rotate_vector(Quaternion q, Vector3 v);
 
+/* 批量向量旋转：同一姿态旋转 count 个向量（out 可与 in 相同） */
+void quat_rotate_vectors(Quaternion q, const Vector3 *in, Vector3 *out, int count);
+
 /* 从两个向量构造四元数: 旋转使a转向b */
 Quaternion quat_from_two_vectors(Vector3 a, Vector3 b);
 
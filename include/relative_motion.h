@@ -0,0 +1,104 @@
+/* LVLH相对运动外推：Clohessy–Wiltshire / Yamanaka–Ankersen 状态转移矩阵 */
+
+#ifndef RELATIVE_MOTION_H
+#define RELATIVE_MOTION_H
+
+#include "types.h"
+#include "vector3.h"
+
+/* 主星偏心率低于该阈值时使用CW（圆轨道）解，否则使用YA解 */
+#define RELMOTION_CW_ECC_THRESHOLD  1e-4
+
+/* ==================== 数据结构 ==================== */
+
+/* 相对运动模型 */
+typedef enum {
+    RELMOTION_CW = 0,          // Clohessy–Wiltshire（圆参考轨道）
+    RELMOTION_YA = 1           // Yamanaka–Ankersen（椭圆参考轨道）
+} RelativeMotionModel;
+
+/* LVLH系相对状态：x径向、y沿迹、z轨道面法向 (m, m/s，旋转系导数) */
+typedef struct {
+    Vector3 position;
+    Vector3 velocity;
+} RelativeState;
+
+/* 相对运动外推器：记录历元时刻的主星根数和从星相对状态 */
+typedef struct {
+    RelativeMotionModel model;
+    double epoch;              // 历元 (仿真秒)
+    double a;                  // 主星半长轴 (m)
+    double e;                  // 主星偏心率
+    double n;                  // 主星平均角速度 (rad/s)
+    double M0;                 // 历元时主星平近点角 (rad)
+    double nu0;                // 历元时主星真近点角 (rad)
+    RelativeState rel0;        // 历元时从星相对状态
+} RelativePropagator;
+
+/* ==================== 坐标转换 ==================== */
+
+/* 由主星/从星惯性状态计算LVLH相对状态 */
+int relative_state_from_inertial(
+    const StateVector *chief,
+    const StateVector *deputy,
+    RelativeState *rel_out
+);
+
+/* 由主星惯性状态和LVLH相对状态恢复从星惯性状态 */
+int relative_state_to_inertial(
+    const StateVector *chief,
+    const RelativeState *rel,
+    StateVector *deputy_out
+);
+
+/* ==================== 状态转移矩阵 ==================== */
+
+/* CW状态转移矩阵 Φ(dt)，状态顺序 [x y z vx vy vz] */
+void relative_cw_stm(double n, double dt, double phi[6][6]);
+
+/* CW闭式外推 */
+RelativeState relative_cw_propagate(const RelativeState *rel0, double n, double dt);
+
+/**
+ * YA闭式外推（椭圆参考轨道）
+ * @param rel0 初始相对状态
+ * @param e 主星偏心率
+ * @param n 主星平均角速度 (rad/s)
+ * @param nu0 初始真近点角 (rad)
+ * @param nu 目标时刻真近点角 (rad)
+ * @param dt 时间间隔 (秒)
+ * @return 目标时刻相对状态
+ */
+RelativeState relative_ya_propagate(
+    const RelativeState *rel0,
+    double e,
+    double n,
+    double nu0,
+    double nu,
+    double dt
+);
+
+/* ==================== 相对运动外推器 ==================== */
+
+/* 以当前主星/从星状态为历元初始化外推器，自动选择CW或YA */
+int relative_propagator_init(
+    RelativePropagator *prop,
+    const StateVector *chief,
+    const StateVector *deputy
+);
+
+/* 计算 t 时刻的相对状态（闭式，无累积误差） */
+int relative_propagator_state_at(
+    const RelativePropagator *prop,
+    double t,
+    RelativeState *rel_out
+);
+
+/* 结合 t 时刻主星惯性状态，得到从星惯性状态 */
+int relative_propagator_deputy_state(
+    const RelativePropagator *prop,
+    const StateVector *chief_now,
+    StateVector *deputy_out
+);
+
+#endif /* RELATIVE_MOTION_H */
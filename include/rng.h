@@ -0,0 +1,96 @@
+/* 可重入随机数：xoshiro256**（引擎顺序流）与 Philox4x32-10（按卫星/用途寻址的计数器流） */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RNG_DEFAULT_SEED  1ULL
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+/* ==================== 初始化 ==================== */
+
+/* 用splitmix64将64位种子扩展为256位状态（任何种子都不会得到全零状态） */
+void rng_seed(Rng *rng, uint64_t seed);
+
+/* 跳过2^128个输出，用于从同一种子派生互不重叠的子序列 */
+void rng_jump(Rng *rng);
+
+/* ==================== 生成 ==================== */
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* 下一个64位输出 */
+static inline uint64_t rng_next_u64(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+
+    return result;
+}
+
+/* [0, 1) 均匀分布（取高53位） */
+static inline double rng_uniform(Rng *rng) {
+    return (double)(rng_next_u64(rng) >> 11) * 0x1.0p-53;
+}
+
+/* [lo, hi) 均匀分布 */
+static inline double rng_uniform_range(Rng *rng, double lo, double hi) {
+    return lo + (hi - lo) * rng_uniform(rng);
+}
+
+/* 标准正态分布（Box-Muller） */
+double rng_normal(Rng *rng);
+
+/* ==================== 计数器型随机数 (Philox4x32-10) ==================== */
+/* 无状态：输出只由 (种子, 卫星ID, 流, 序号) 决定，与创建顺序和线程数无关
+   计数器 = {序号低32位, 序号高32位, 卫星ID, 流}，密钥 = 种子 */
+
+#define RNG_PHILOX_LANES  8        // 批量生成时每块并行的计数器数
+
+/* 随机流：同一卫星不同用途的随机数互不相关 */
+typedef enum {
+    RNG_STREAM_INIT_POSITION = 0,  // 初始位置扰动
+    RNG_STREAM_INIT_VELOCITY,      // 初始速度扰动
+    RNG_STREAM_SENSOR,             // 测量噪声
+    RNG_STREAM_MANEUVER,           // 机动执行误差
+    RNG_STREAM_COUNT
+} RngStream;
+
+/* 单块Philox4x32-10：128位计数器 + 64位密钥 -> 128位输出 */
+void rng_philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]);
+
+/* 第 index 块的两个 [0,1) 均匀数 */
+void rng_philox_uniform2(uint64_t seed, uint32_t sat_id, uint32_t stream,
+                         uint64_t index, double out[2]);
+
+/**
+ * 批量生成同一 (种子, 卫星, 流) 上从 first_index 起的 n 个均匀数
+ * 与逐块调用 rng_philox_uniform2 结果逐位一致
+ */
+void rng_philox_fill_uniform(uint64_t seed, uint32_t sat_id, uint32_t stream,
+                             uint64_t first_index, double *out, size_t n);
+
+/**
+ * 批量为多颗卫星各生成同一序号块的两个均匀数（舰队初始化）
+ * out[2*k], out[2*k+1] 对应 sat_ids[k]
+ */
+void rng_philox_fill_fleet(uint64_t seed, const uint32_t *sat_ids, size_t n,
+                           uint32_t stream, uint64_t index, double *out);
+
+#endif /* RNG_H */
@@ -6,12 +6,42 @@
 #include "types.h"
 #include "vector3.h"
 #include "quaternion.h"
+#include "rng.h"
+#include "history.h"
+#include "arena.h"
 
 /* ==================== 卫星创建和销毁 ==================== */
 
 /* 创建卫星 */
 Satellite* satellite_create(int id, uint8_t team, uint8_t type, uint8_t function_type);
 
+/* 创建卫星，初始位置扰动由 (种子, 卫星ID) 的Philox流决定，与创建顺序无关 */
+Satellite* satellite_create_seeded(int id, uint8_t team, uint8_t type, uint8_t function_type, uint64_t seed);
+
+/* 同 satellite_create_seeded，卫星及其历史缓冲从 allocator 切分（NULL 为系统堆） */
+Satellite* satellite_create_in(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                               uint8_t function_type, uint64_t seed);
+
+/**
+ * 批量创建ID连续的卫星（初始扰动批量生成，与逐颗 satellite_create_seeded 一致）
+ * @param out 输出数组（长度 count）
+ * @return 创建数量，失败返回-1（已创建的会被释放）
+ */
+int satellite_create_fleet(SlabAllocator *allocator, int first_id, int count, uint8_t team, uint8_t type,
+                           uint8_t function_type, uint64_t seed, Satellite **out);
+
+/**
+ * 按六根数创建卫星，状态向量由根数换算（a 为m，角度为度，与 orbit_elements_to_state 相同）
+ * @return 卫星，根数无效或分配失败返回NULL
+ */
+Satellite* satellite_create_from_elements(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                          uint8_t function_type, const OrbitalElements *elements);
+
+/* 同 satellite_create_from_elements，状态向量已由调用方算好（根数仅记录，不再换算） */
+Satellite* satellite_create_from_state(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                       uint8_t function_type, const OrbitalElements *elements,
+                                       const StateVector *state);
+
 /* 创建卫星（完整参数） */
 Satellite* satellite_create_full(
     int id, uint8_t type, uint8_t function_type,
@@ -20,7 +50,7 @@ Satellite* satellite_create_full(
     double fuel
 );
 
-/* 销毁卫星 */
+/* 销毁卫星（slab分配的归还给所属分配器） */
 void satellite_destroy(Satellite *sat);
 
 /* ==================== 轨道计算 ==================== */
@@ -93,13 +123,13 @@ int satellite_check_illumination(Satellite *observer, Satellite *target);
 // /* 初始化历史缓冲 */
 // int satellite_history_init(Satellite *sat, int capacity);
 
-/* 初始化历史（兼容函数） */
+/* 初始化分层历史，capacity 为每层样本数（近期层全速率） */
 void satellite_init_history(Satellite *sat, int capacity);
 
-/* 记录当前位置到历史 */
+/* 记录当前状态到历史（环形覆盖，近期样本不会丢失） */
 int satellite_history_append(Satellite *sat);
 
-/* 获取历史数据 */
+/* 获取近期位置，index 0 为最新样本（超出近期窗口返回零向量） */
 Vector3 satellite_history_get_position(Satellite *sat, int index);
 
 /* 清空历史 */
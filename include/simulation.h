@@ -0,0 +1,76 @@
+/* 仿真驱动：场景装载 + 步进循环 + 结果输出
+   不含任何界面输出（横幅/进度条/逐星打印），主程序和 satellite_bench 共用 */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdint.h>
+#include "kinematics.h"
+#include "montecarlo.h"
+
+/* ==================== 输出 ==================== */
+
+typedef enum {
+    SIM_OUTPUT_NONE = 0,           // 不输出
+    SIM_OUTPUT_CSV,                // 红星逐步CSV（与 red_satellites_trajectory.csv 同格式）
+    SIM_OUTPUT_BINARY              // 红星逐步定长记录 SimOutputRecord
+} SimOutputMode;
+
+/* 二进制输出记录（80字节，无填充，主机字节序） */
+typedef struct {
+    uint32_t step;
+    int32_t sat_id;
+    double time;                   // 仿真时间 (秒)
+    double position[3];            // 位置 (m)
+    double velocity[3];            // 速度 (m/s)
+    double fuel;                   // 剩余燃料 (kg)
+    int32_t formation;
+    int32_t strategy;
+} SimOutputRecord;
+
+/* ==================== 运行参数和统计 ==================== */
+
+/* 进度回调：每 progress_interval 步调用一次 */
+typedef void (*SimProgressFunc)(uint32_t step, uint32_t max_steps, double simulation_time, void *user_data);
+
+typedef struct {
+    SimOutputMode output;
+    const char *output_file;       // SIM_OUTPUT_NONE 时忽略
+    SimProgressFunc progress;      // 可为NULL
+    uint32_t progress_interval;    // 0 表示不回调
+    void *user_data;
+} SimRunOptions;
+
+typedef struct {
+    uint32_t steps;                // 实际完成步数
+    double elapsed_seconds;        // 墙钟耗时 (秒)
+    uint64_t bytes_written;        // 输出字节数
+    uint32_t decision_ticks;       // 本次运行中的决策触发次数
+    RunningStats decision_latency_us;  // 决策步耗时（含该步外推、控制和输出）
+    double decision_p50_us;
+    double decision_p99_us;
+} SimRunStats;
+
+/* ==================== 接口 ==================== */
+
+/* 默认仿真配置（主程序所用参数） */
+void simulation_default_config(SimulationConfig *config);
+
+/**
+ * 按场景配置创建引擎并装载红蓝卫星（ID从1000起：红星攻击/侦察/防御，再蓝星）
+ * @param scenario 各类卫星数量和博弈策略
+ * @param history_capacity 每颗卫星每层历史样本数（<=0 取默认值）
+ * @return 引擎，失败返回NULL
+ */
+KinematicsEngine* simulation_create_engine(const Config *scenario, const SimulationConfig *config,
+                                           uint64_t seed, int history_capacity);
+
+/**
+ * 运行至 max_steps 或引擎配置的步数上限
+ * @param stats 可为NULL
+ * @return 0 成功，输出文件无法打开返回-1
+ */
+int simulation_run(KinematicsEngine *engine, uint32_t max_steps,
+                   const SimRunOptions *options, SimRunStats *stats);
+
+#endif /* SIMULATION_H */
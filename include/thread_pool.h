@@ -0,0 +1,56 @@
+/* 固定大小工作线程池：任务队列 + 条件变量，用于批量独立仿真等粗粒度并行 */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+
+#define THREAD_POOL_MAX_THREADS  256
+
+/* 任务函数 */
+typedef void (*thread_pool_task)(void *arg);
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct ThreadPoolJob {
+    thread_pool_task fn;
+    void *arg;
+    struct ThreadPoolJob *next;
+} ThreadPoolJob;
+
+typedef struct {
+    pthread_t *threads;
+    int num_threads;
+
+    ThreadPoolJob *head;           // 待执行任务队列 (FIFO)
+    ThreadPoolJob *tail;
+    int pending;                   // 队列中 + 执行中的任务数
+
+    pthread_mutex_t lock;
+    pthread_cond_t job_ready;      // 有新任务或正在关闭
+    pthread_cond_t all_done;       // pending 归零
+    int shutdown;
+} ThreadPool;
+
+/* ==================== 线程池接口 ==================== */
+
+/**
+ * 创建线程池
+ * @param num_threads 工作线程数（<=0 表示CPU核数）
+ * @return 线程池，失败返回NULL
+ */
+ThreadPool* thread_pool_create(int num_threads);
+
+/* 提交任务，成功返回0 */
+int thread_pool_submit(ThreadPool *pool, thread_pool_task fn, void *arg);
+
+/* 阻塞直到所有已提交任务执行完毕 */
+void thread_pool_wait(ThreadPool *pool);
+
+/* 等待剩余任务完成后回收线程并释放 */
+void thread_pool_destroy(ThreadPool *pool);
+
+/* 在线CPU核数 */
+int thread_pool_cpu_count(void);
+
+#endif /* THREAD_POOL_H */
@@ -0,0 +1,75 @@
+/* 时间线跟踪：各阶段区间写入线程局部缓冲（无锁），结束后导出 Chrome trace-event JSON
+   （chrome://tracing 或 Perfetto 直接打开）。区间来自 profiler 插桩，需 SIM_PROFILE 编译 */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "profiler.h"
+
+#define TRACE_CHUNK_EVENTS  4096       // 每个缓冲块事件数
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct {
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint32_t step;                     // 所在仿真步
+    int32_t satellites;                // 当时卫星数
+    int32_t phase;                     // ProfPhase
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk *next;
+    uint32_t count;
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+/* 每线程一个，只由所属线程写入；创建时无锁挂入全局链表 */
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;
+    TraceChunk *head;                  // 最早的块
+    TraceChunk *tail;                  // 当前写入块
+    int tid;
+    char name[32];
+    uint32_t step;                     // 当前上下文
+    int32_t satellites;
+} TraceBuffer;
+
+/* ==================== 接口 ==================== */
+
+/* 开始记录（清空此前的事件）；调用时不应有其他线程正在记录 */
+void trace_start(void);
+
+/* 停止记录 */
+void trace_stop(void);
+
+int trace_is_active(void);
+
+/* 记录一个区间（未开始记录时立即返回） */
+void trace_record(ProfPhase phase, uint64_t start_ns, uint64_t end_ns);
+
+/* 设置当前线程后续事件的标签 */
+void trace_set_context(uint32_t step, int satellites);
+
+/* 当前线程在时间线中的名称 */
+void trace_set_thread_name(const char *name);
+
+/**
+ * 导出 Chrome trace-event JSON（应在所有记录线程结束后调用）
+ * @return 写出的事件数，失败返回-1
+ */
+int trace_write_chrome(const char *filename);
+
+/* 释放所有缓冲（各线程下次记录时重建）；调用时不应有其他线程正在记录 */
+void trace_shutdown(void);
+
+/* ==================== 插桩宏 ==================== */
+
+#ifdef SIM_PROFILE
+#define TRACE_CONTEXT(step, satellites)  trace_set_context((step), (satellites))
+#else
+#define TRACE_CONTEXT(step, satellites)  ((void)0)
+#endif
+
+#endif /* TRACE_H */
@@ -87,6 +87,8 @@ typedef struct {
     Vector3 body_axis;         // 机体前向轴 (体坐标系)
     int target_id;             // 指向目标ID (-1表示无目标)
     uint32_t step_count;       // 更新步数
+    Matrix3x3 rotation;        // 旋转矩阵缓存（体→世界）
+    Quaternion rotation_q;     // 缓存所对应的四元数，与 q 不同即失效
 } AttitudeTracker;
 
 /* ===================== 卫星数据结构 ===================== */
@@ -113,6 +115,7 @@ typedef struct Satellite {
     /* 编队信息 */
     uint8_t current_formation; // 当前编队类型
     int target_id;             // 目标卫星ID (-1表示无目标)
+    int current_strategy;      // 当前博弈策略
     double distance_to_target; // 到目标距离 (km)
     double min_distance_reached; // 到达过的最小距离 (km)
     
@@ -121,12 +124,12 @@ typedef struct Satellite {
     double circle_progress;    // 当前圈进度 (0-1)
     int inspection_started;    // 是否开始侦查 (0/1)
     
+    /* 相对运动 */
+    int relative_link;         // 作为从星时为引擎 relative_links 下标+1，0 表示独立外推
+    
     /* 历史数据 */
-    Vector3 *position_history; // 位置历史
-    Vector3 *velocity_history; // 速度历史
-    int *formation_history;    // 编队类型历史
-    int history_count;         // 当前历史点数
-    int history_capacity;      // 历史缓冲容量
+    struct TrajectoryHistory *history; // 分层轨迹历史 (NULL表示不记录)
+    struct SlabAllocator *allocator;   // 所属引擎分配器 (NULL表示系统堆)
     
     /* 时间信息 */
     double creation_time;      // 创建时间 (秒)
@@ -201,6 +204,11 @@ typedef struct {
     uint32_t max_steps;        // 最大步数
     uint32_t save_interval;    // 保存间隔
     
+    /* 多速率时钟 (秒，0表示使用默认值) */
+    double attitude_time_step; // 姿态子步长（仅机动中的卫星子步进）
+    double control_interval;   // 编队控制周期（默认每步）
+    double decision_interval;  // 决策周期（默认100步）
+    
     /* 轨道参数 */
     double hohmann_precision;
     uint32_t lambert_max_iterations;
@@ -214,8 +222,29 @@ typedef struct {
     
     /* 策略参数 */
     StrategyThresholds strategy;
+    double slew_cost_weight;   // 收益矩阵中每秒姿态机动时间的扣分（0 不计入）
+    
+    /* 摄动参数 */
+    uint32_t perturbation_flags; // 启用的摄动项 (PerturbationFlags)
+    double epoch_jd;           // 仿真零时刻儒略日 (0=J2000)
+    
+    /* 计算内核 */
+    char kernel_isa[16];       // 批量内核指令集 (scalar/sse2/avx2/avx512，空串按CPUID选最宽)
 } SimulationConfig;
 
+/* 运行时参数块：策略阈值和编队参数（单位同 SimulationConfig），
+   由引擎以原子指针发布，发布后只读，决策周期之间整体替换 */
+typedef struct RuntimeParams {
+    uint32_t generation;            // 换入序号（引擎创建时为0）
+    StrategyThresholds strategy;
+    double lambert_target_distance;
+    double lambert_max_delta_v;
+    double ellipse_min_distance;
+    double ellipse_max_distance;
+    double slew_cost_weight;
+    struct RuntimeParams *retired_next;  // 引擎内部回收链（换下后才写入）
+} RuntimeParams;
+
 
 /* ===================== 仿真引擎 ===================== */
 /* KinematicsEngine定义在kinematics.h中 */
@@ -0,0 +1,101 @@
+/* SoA 向量数组运算：x/y/z 分列存放，距离/范数/点积/叉积/规范化/矩阵乘按数组批量计算
+   内核有 SSE2/AVX2/AVX-512 和标量四套，首次调用时按 CPUID 选用最宽的一套；
+   各套逐元素运算次序相同且不使用 FMA，结果与 vector3.h 的单向量版本逐位一致 */
+
+#ifndef VECTOR3_SOA_H
+#define VECTOR3_SOA_H
+
+#include "types.h"
+
+/* ==================== 数据结构 ==================== */
+
+typedef struct {
+    double *x, *y, *z;
+    int count;
+    int capacity;
+    int owned;                     // 是否由 vector3_soa_init 分配（视图为0）
+} Vector3SoA;
+
+typedef enum {
+    VECTOR3_SOA_ISA_SCALAR = 0,
+    VECTOR3_SOA_ISA_SSE2,
+    VECTOR3_SOA_ISA_AVX2,
+    VECTOR3_SOA_ISA_AVX512,
+    VECTOR3_SOA_ISA_COUNT
+} Vector3SoAIsa;
+
+/* ==================== 容器 ==================== */
+
+/* 分配容量为 capacity 的数组（64字节对齐），返回0成功 */
+int vector3_soa_init(Vector3SoA *a, int capacity);
+
+/* 包装外部内存（如arena切出的分列），不负责释放 */
+Vector3SoA vector3_soa_view(double *x, double *y, double *z, int count);
+
+void vector3_soa_free(Vector3SoA *a);
+
+/* 扩容到至少 capacity（保留已有数据），返回0成功；视图不可扩容 */
+int vector3_soa_reserve(Vector3SoA *a, int capacity);
+
+/* 追加一个向量，返回下标，失败返回-1 */
+int vector3_soa_push(Vector3SoA *a, Vector3 v);
+
+static inline Vector3 vector3_soa_get(const Vector3SoA *a, int i) {
+    return (Vector3){a->x[i], a->y[i], a->z[i]};
+}
+
+static inline void vector3_soa_set(Vector3SoA *a, int i, Vector3 v) {
+    a->x[i] = v.x;
+    a->y[i] = v.y;
+    a->z[i] = v.z;
+}
+
+/* ==================== 批量运算（out 长度为 a->count） ==================== */
+
+/* out[i] = ||a[i]|| */
+void vector3_soa_norm(const Vector3SoA *a, double *out);
+
+/* out[i] = ||a[i] - p||（一对多距离，如一颗卫星到全队） */
+void vector3_soa_distance_to(const Vector3SoA *a, Vector3 p, double *out);
+
+/* out[i] = ||a[i] - b[i]||（逐对距离，b->count 不得小于 a->count） */
+void vector3_soa_distance(const Vector3SoA *a, const Vector3SoA *b, double *out);
+
+/* out[i] = a[i] · b[i] */
+void vector3_soa_dot(const Vector3SoA *a, const Vector3SoA *b, double *out);
+
+/* out[i] = a[i] × b[i]（out 可与 a 或 b 相同，容量须足够） */
+void vector3_soa_cross(const Vector3SoA *a, const Vector3SoA *b, Vector3SoA *out);
+
+/* out[i] = a[i] / ||a[i]||，零向量得零向量（同 vector3_normalize；out 可与 a 相同） */
+void vector3_soa_normalize(const Vector3SoA *a, Vector3SoA *out);
+
+/* out[i] = m · a[i]（out 可与 a 相同） */
+void vector3_soa_matrix_multiply(Matrix3x3 m, const Vector3SoA *a, Vector3SoA *out);
+
+/**
+ * 最近中心：assignments[i] 为距 a[i] 最近的中心下标（距离相同时取下标小者）
+ * @param distances 可为NULL，输出到最近中心的距离
+ */
+void vector3_soa_nearest(const Vector3SoA *a, const Vector3SoA *centers, int *assignments, double *distances);
+
+/* ==================== 指令集选择 ==================== */
+
+/* 本机支持的最宽指令集（CPUID） */
+Vector3SoAIsa vector3_soa_detect_isa(void);
+
+/* 当前使用的指令集 */
+Vector3SoAIsa vector3_soa_get_isa(void);
+
+/**
+ * 指定指令集（进程内全局生效，也决定 orbit.h 批量内核的版本；可与计算并发调用）
+ * @return 0 成功，本机不支持返回-1
+ */
+int vector3_soa_set_isa(Vector3SoAIsa isa);
+
+const char* vector3_soa_isa_name(Vector3SoAIsa isa);
+
+/* 按名称 (scalar/sse2/avx2/avx512) 查指令集，未知名称返回-1 */
+int vector3_soa_isa_from_name(const char *name);
+
+#endif /* VECTOR3_SOA_H */
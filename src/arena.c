@@ -0,0 +1,204 @@
+#include <arena.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 块头之后的数据区起始地址 */
+#define ARENA_CHUNK_DATA(chunk)  ((uint8_t*)(chunk) + sizeof(ArenaChunk))
+
+/* ==================== 内部函数 ==================== */
+
+static ArenaChunk* arena_new_chunk(Arena *arena, size_t min_size) {
+    size_t size = (min_size > arena->chunk_size) ? min_size : arena->chunk_size;
+    ArenaChunk *chunk = (ArenaChunk*)malloc(sizeof(ArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = arena->head;
+    chunk->size = size;
+    chunk->used = 0;
+    arena->head = chunk;
+    arena->bytes_reserved += size;
+    arena->num_chunks++;
+    return chunk;
+}
+
+static void arena_free_chunks(ArenaChunk *chunk) {
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+/* 尺寸级：64 << k 能容纳 size 的最小 k，超出返回-1 */
+static int slab_class(size_t size) {
+    size_t class_size = (size_t)1 << SLAB_MIN_SHIFT;
+    for (int k = 0; k < SLAB_NUM_CLASSES; k++) {
+        if (size <= class_size) return k;
+        class_size <<= 1;
+    }
+    return -1;
+}
+
+/* ==================== Arena ==================== */
+
+void arena_init(Arena *arena, size_t chunk_size) {
+    if (!arena) return;
+    memset(arena, 0, sizeof(Arena));
+    arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+}
+
+void* arena_alloc(Arena *arena, size_t size, size_t align) {
+    if (!arena || size == 0) return NULL;
+    if (align == 0) align = ARENA_DEFAULT_ALIGN;
+
+    ArenaChunk *chunk = arena->head;
+    if (chunk) {
+        uintptr_t base = (uintptr_t)ARENA_CHUNK_DATA(chunk);
+        uintptr_t p = (base + chunk->used + (align - 1)) & ~(uintptr_t)(align - 1);
+        size_t end = (size_t)(p - base) + size;
+        if (end <= chunk->size) {
+            arena->bytes_used += end - chunk->used;
+            chunk->used = end;
+            return (void*)p;
+        }
+    }
+
+    // 当前块不足：新块至少容纳本次分配和对齐填充
+    chunk = arena_new_chunk(arena, size + align);
+    if (!chunk) return NULL;
+    uintptr_t base = (uintptr_t)ARENA_CHUNK_DATA(chunk);
+    uintptr_t p = (base + (align - 1)) & ~(uintptr_t)(align - 1);
+    chunk->used = (size_t)(p - base) + size;
+    arena->bytes_used += chunk->used;
+    return (void*)p;
+}
+
+void* arena_calloc(Arena *arena, size_t count, size_t size) {
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+    void *p = arena_alloc(arena, count * size, ARENA_DEFAULT_ALIGN);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+ArenaMark arena_mark(const Arena *arena) {
+    ArenaMark mark = {NULL, 0, 0};
+    if (!arena) return mark;
+    mark.chunk = arena->head;
+    mark.used = arena->head ? arena->head->used : 0;
+    mark.bytes_used = arena->bytes_used;
+    return mark;
+}
+
+void arena_rewind(Arena *arena, ArenaMark mark) {
+    if (!arena) return;
+
+    // 释放回退点之后申请的块
+    while (arena->head && arena->head != mark.chunk) {
+        ArenaChunk *chunk = arena->head;
+        arena->head = chunk->next;
+        arena->bytes_reserved -= chunk->size;
+        arena->num_chunks--;
+        free(chunk);
+    }
+    if (arena->head) arena->head->used = mark.used;
+    arena->bytes_used = mark.bytes_used;
+}
+
+void arena_reset(Arena *arena) {
+    if (!arena) return;
+
+    if (arena->num_chunks > 1) {
+        size_t total = arena->bytes_reserved;
+        arena_free_chunks(arena->head);
+        arena->head = NULL;
+        arena->bytes_reserved = 0;
+        arena->num_chunks = 0;
+        arena_new_chunk(arena, total);
+    } else if (arena->head) {
+        arena->head->used = 0;
+    }
+    arena->bytes_used = 0;
+}
+
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+    arena_free_chunks(arena->head);
+    arena->head = NULL;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+    arena->num_chunks = 0;
+}
+
+/* ==================== Slab ==================== */
+
+void slab_init(SlabAllocator *slab, size_t chunk_size) {
+    if (!slab) return;
+    memset(slab, 0, sizeof(SlabAllocator));
+    arena_init(&slab->arena, chunk_size);
+}
+
+void* slab_alloc(SlabAllocator *slab, size_t size) {
+    if (!slab || size == 0) return NULL;
+
+    int k = slab_class(size);
+    if (k >= 0) {
+        size_t class_size = (size_t)1 << (SLAB_MIN_SHIFT + k);
+        void *p = slab->free_lists[k];
+        if (p) {
+            memcpy(&slab->free_lists[k], p, sizeof(void*));
+        } else {
+            p = arena_alloc(&slab->arena, class_size, ARENA_DEFAULT_ALIGN);
+            if (!p) return NULL;
+        }
+        slab->live_bytes += class_size;
+        return p;
+    }
+
+    // 大对象：按精确尺寸复用（同配置的历史缓冲尺寸相同）
+    size = (size + ARENA_DEFAULT_ALIGN - 1) & ~(size_t)(ARENA_DEFAULT_ALIGN - 1);
+    SlabLargeBlock **link = &slab->large_free;
+    while (*link) {
+        if ((*link)->size == size) {
+            SlabLargeBlock *block = *link;
+            *link = block->next;
+            slab->live_bytes += size;
+            return block;
+        }
+        link = &(*link)->next;
+    }
+    void *p = arena_alloc(&slab->arena, size, ARENA_DEFAULT_ALIGN);
+    if (p) slab->live_bytes += size;
+    return p;
+}
+
+void* slab_calloc(SlabAllocator *slab, size_t size) {
+    void *p = slab_alloc(slab, size);
+    if (p) memset(p, 0, size);
+    return p;
+}
+
+void slab_free(SlabAllocator *slab, void *ptr, size_t size) {
+    if (!slab || !ptr || size == 0) return;
+
+    int k = slab_class(size);
+    if (k >= 0) {
+        memcpy(ptr, &slab->free_lists[k], sizeof(void*));
+        slab->free_lists[k] = ptr;
+        slab->live_bytes -= (size_t)1 << (SLAB_MIN_SHIFT + k);
+        return;
+    }
+
+    size = (size + ARENA_DEFAULT_ALIGN - 1) & ~(size_t)(ARENA_DEFAULT_ALIGN - 1);
+    SlabLargeBlock *block = (SlabLargeBlock*)ptr;
+    block->size = size;
+    block->next = slab->large_free;
+    slab->large_free = block;
+    slab->live_bytes -= size;
+}
+
+void slab_destroy(SlabAllocator *slab) {
+    if (!slab) return;
+    arena_destroy(&slab->arena);
+    memset(slab->free_lists, 0, sizeof(slab->free_lists));
+    slab->large_free = NULL;
+    slab->live_bytes = 0;
+}
@@ -1,5 +1,7 @@
 #include <attitude.h>
+#include <constants.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 AttitudeTracker* attitude_tracker_create(double max_rate, double max_accel, Vector3 body_axis) {
@@ -14,6 +16,7 @@ AttitudeTracker* attitude_tracker_create(double max_rate, double max_accel, Vect
     tracker->body_axis = vector3_normalize_safe(body_axis);
     tracker->target_id = -1;
     tracker->step_count = 0;
+    attitude_tracker_invalidate_rotation(tracker);
     
     return tracker;
 }
@@ -31,6 +34,7 @@ int attitude_tracker_init(AttitudeTracker *tracker, double max_rate, double max_
     tracker->max_accel = max_accel;
     tracker->body_axis = vector3_normalize_safe(body_axis);
     tracker->step_count = 0;
+    attitude_tracker_invalidate_rotation(tracker);
     return 0;
 }
 
@@ -42,28 +46,9 @@ void attitude_tracker_reset(AttitudeTracker *tracker) {
     tracker->step_count = 0;
 }
 
-int attitude_tracker_step_towards(AttitudeTracker *tracker, Vector3 target_direction, Vector3 omega_desired, double dt) {
-    if (!tracker || dt <= 0) return -1;
-    
-    target_direction = vector3_normalize_safe(target_direction);
-    
-    Vector3 omega_error = vector3_sub(omega_desired, tracker->omega);
-    Vector3 alpha_cmd = vector3_scale(omega_error, 0.1);
-    
-    if (vector3_magnitude(alpha_cmd) > tracker->max_accel) {
-        alpha_cmd = vector3_scale(vector3_normalize_safe(alpha_cmd), tracker->max_accel);
-    }
-    
-    tracker->alpha = alpha_cmd;
-    
-    Vector3 omega_new = vector3_add(tracker->omega, vector3_scale(tracker->alpha, dt));
-    if (vector3_magnitude(omega_new) > tracker->max_rate) {
-        omega_new = vector3_scale(vector3_normalize_safe(omega_new), tracker->max_rate);
-    }
-    tracker->omega = omega_new;
-    
-    tracker->step_count++;
-    return 0;
+int attitude_tracker_step_towards(AttitudeTracker *tracker, Vector3 current_pos, Vector3 target_pos, double dt_sec) {
+    if (!tracker || dt_sec <= 0) return -1;
+    return attitude_tracker_slew_step(tracker, vector3_sub(target_pos, current_pos), dt_sec);
 }
 
 int attitude_euler_to_quaternion(double roll, double pitch, double yaw, Quaternion *q) {
@@ -141,11 +126,34 @@ void attitude_tracker_get_euler_angles_xyz(AttitudeTracker *tracker, double *rol
 
 Matrix3x3 attitude_tracker_get_rotation_matrix(AttitudeTracker *tracker) {
     if (!tracker) return matrix3x3_identity();
-    return matrix3x3_identity();
+    // q 可能被直接改写（批量步进写回、检查点恢复），按四元数比对判断缓存是否有效
+    Quaternion q = tracker->q;
+    Quaternion c = tracker->rotation_q;
+    if (q.x != c.x || q.y != c.y || q.z != c.z || q.w != c.w) {
+        tracker->rotation = quat_to_matrix(q);
+        tracker->rotation_q = q;
+    }
+    return tracker->rotation;
+}
+
+int attitude_tracker_set_rotation_matrix(AttitudeTracker *tracker, Matrix3x3 m) {
+    if (!tracker) return -1;
+    attitude_tracker_set_quaternion(tracker, quat_from_matrix(m));
+    return 0;
 }
 
-double attitude_time_to_reach(Quaternion current, Quaternion target, double max_rate) {
-    return 1.0;
+int attitude_tracker_rotate_vectors(AttitudeTracker *tracker, const Vector3 *in, Vector3 *out, int count) {
+    if (!tracker || !in || !out || count < 0) return -1;
+    Matrix3x3 r = attitude_tracker_get_rotation_matrix(tracker);
+    for (int i = 0; i < count; i++) {
+        Vector3 v = in[i];
+        out[i] = (Vector3){
+            r.m[0][0] * v.x + r.m[0][1] * v.y + r.m[0][2] * v.z,
+            r.m[1][0] * v.x + r.m[1][1] * v.y + r.m[1][2] * v.z,
+            r.m[2][0] * v.x + r.m[2][1] * v.y + r.m[2][2] * v.z
+        };
+    }
+    return 0;
 }
 
 Quaternion attitude_quat_from_axis_angle(Vector3 axis, double angle) {
@@ -163,6 +171,374 @@ int attitude_tracker_set_pointing_direction(AttitudeTracker *tracker, Vector3 di
     return 0;
 }
 
-Vector3 attitude_pd_control(Vector3 error_axis, double error_angle, double kp, double kd) {
-    return vector3_scale(error_axis, kp * error_angle);
-}
\ No newline at end of file
+Vector3 attitude_pd_control(Vector3 error_axis, double error_angle, Vector3 omega, double kp, double kd) {
+    return vector3_sub(vector3_scale(error_axis, kp * error_angle), vector3_scale(omega, kd));
+}
+
+/* 饱和PD子步：指令角加速度限幅 → 角速度积分并限幅 → 四元数积分
+   PD按子步末状态隐式求解（kp=2、kd=1 在 1s 子步下显式积分临界振荡）：
+   α = (kp·θ·axis - (kd + kp·dt)·ω) / (1 + kd·dt + kp·dt²)，dt→0 时即为 attitude_pd_control */
+static inline void attitude_slew_kernel(Quaternion *q, Vector3 *omega, Vector3 *alpha,
+                                        Vector3 axis, double angle,
+                                        double max_rate, double max_accel, double dt) {
+    const double kp = ATT_CONTROL_KP, kd = ATT_CONTROL_KD;
+    Vector3 alpha_cmd = vector3_scale(attitude_pd_control(axis, angle, *omega, kp, kd + kp * dt),
+                                      1.0 / (1.0 + kd * dt + kp * dt * dt));
+    *alpha = attitude_saturate_alpha(alpha_cmd, max_accel);
+    *omega = attitude_saturate_omega(vector3_add(*omega, vector3_scale(*alpha, dt)), max_rate);
+    *q = quat_integrate(*q, *omega, dt);
+}
+
+/**
+ * 机体轴当前指向（世界系）与目标方向的夹角和转轴
+ * @param cos_out 可为NULL，输出夹角余弦（死区判断与全队批量步进同一判据）
+ */
+static double attitude_pointing_error(const AttitudeTracker *tracker, Vector3 target_direction,
+                                      Vector3 *axis_out, double *cos_out) {
+    Vector3 boresight = quat_rotate_vector(tracker->q, tracker->body_axis);
+    Vector3 target = vector3_normalize_safe(target_direction);
+    Vector3 axis = vector3_cross(boresight, target);
+    double s = vector3_magnitude(axis);
+    double c = vector3_dot(boresight, target);
+
+    if (axis_out) *axis_out = (s > 1e-12) ? vector3_scale(axis, 1.0 / s) : vector3_zero();
+    if (cos_out) *cos_out = c;
+    return atan2(s, c);
+}
+
+int attitude_tracker_is_slewing(const AttitudeTracker *tracker, Vector3 target_direction) {
+    if (!tracker) return 0;
+    double c;
+    attitude_pointing_error(tracker, target_direction, NULL, &c);
+    return c < cos(ATTITUDE_POINTING_TOLERANCE);
+}
+
+int attitude_tracker_slew_step(AttitudeTracker *tracker, Vector3 target_direction, double dt) {
+    if (!tracker || dt <= 0) return -1;
+
+    Vector3 axis;
+    double angle = attitude_pointing_error(tracker, target_direction, &axis, NULL);
+
+    // 角速度为世界系，quat_integrate 左乘
+    attitude_slew_kernel(&tracker->q, &tracker->omega, &tracker->alpha, axis, angle,
+                         tracker->max_rate, tracker->max_accel, dt);
+    tracker->step_count++;
+
+    if (attitude_tracker_is_slewing(tracker, target_direction)) return 1;
+
+    // 已稳定：清零残余角速度，直到误差再次超出容差
+    tracker->omega = vector3_zero();
+    tracker->alpha = vector3_zero();
+    return 0;
+}
+
+/* ==================== 机动规划（特征轴 bang-coast-bang） ==================== */
+
+double attitude_slew_time(double angle, double max_rate, double max_accel) {
+    if (angle <= 0) return 0.0;
+    if (max_rate <= 0 || max_accel <= 0) return HUGE_VAL;
+    // 加速到 max_rate 需转过 ω²/(2α)，加减速合计 ω²/α
+    if (angle <= max_rate * max_rate / max_accel) return 2.0 * sqrt(angle / max_accel);
+    return angle / max_rate + max_rate / max_accel;
+}
+
+/* 由机动轴和机动角填充剖面 */
+static void attitude_fill_profile(AttitudeSlewProfile *profile, Vector3 axis, double angle,
+                                  double max_rate, double max_accel) {
+    profile->axis = axis;
+    profile->angle = angle;
+    profile->max_accel = max_accel;
+    if (angle <= max_rate * max_rate / max_accel) {
+        profile->accel_time = sqrt(angle / max_accel);
+        profile->coast_time = 0.0;
+    } else {
+        profile->accel_time = max_rate / max_accel;
+        profile->coast_time = angle / max_rate - max_rate / max_accel;
+    }
+    profile->peak_rate = max_accel * profile->accel_time;
+    profile->total_time = 2.0 * profile->accel_time + profile->coast_time;
+}
+
+/* current 到 target 的最短转角 (rad)，axis 非空时写入世界系机动轴 */
+static double attitude_short_arc(Quaternion current, Quaternion target, Vector3 *axis) {
+    // 世界系误差四元数 dq = target * current⁻¹，w<0 时取反走短弧
+    Quaternion dq = quat_multiply(quat_normalize(target), quat_conjugate(quat_normalize(current)));
+    if (dq.w < 0) dq = (Quaternion){ -dq.x, -dq.y, -dq.z, -dq.w };
+    Vector3 v = { dq.x, dq.y, dq.z };
+    double s = vector3_magnitude(v);
+    if (axis) *axis = (s > 1e-12) ? vector3_scale(v, 1.0 / s) : vector3_zero();
+    return 2.0 * atan2(s, dq.w);
+}
+
+double attitude_time_to_reach(Quaternion current, Quaternion target, double max_rate, double max_accel) {
+    return attitude_slew_time(attitude_short_arc(current, target, NULL), max_rate, max_accel);
+}
+
+int attitude_plan_slew(Quaternion current, Quaternion target, double max_rate, double max_accel,
+                       AttitudeSlewProfile *profile) {
+    if (!profile || max_rate <= 0 || max_accel <= 0) return -1;
+
+    Vector3 axis;
+    double angle = attitude_short_arc(current, target, &axis);
+    attitude_fill_profile(profile, axis, angle, max_rate, max_accel);
+    return 0;
+}
+
+int attitude_plan_pointing(AttitudeTracker *tracker, Vector3 target_direction, AttitudeSlewProfile *profile) {
+    if (!tracker || !profile || tracker->max_rate <= 0 || tracker->max_accel <= 0) return -1;
+
+    Vector3 axis;
+    double angle = attitude_pointing_error(tracker, target_direction, &axis, NULL);
+    attitude_fill_profile(profile, axis, angle, tracker->max_rate, tracker->max_accel);
+    return 0;
+}
+
+double attitude_slew_profile_angle(const AttitudeSlewProfile *profile, double t, double *rate) {
+    if (!profile) return 0.0;
+    double a = profile->max_accel;
+    double t1 = profile->accel_time;
+    double t2 = t1 + profile->coast_time;
+    double angle, w;
+
+    if (t <= 0) {
+        angle = 0.0;
+        w = 0.0;
+    } else if (t < t1) {
+        angle = 0.5 * a * t * t;
+        w = a * t;
+    } else if (t < t2) {
+        angle = 0.5 * a * t1 * t1 + profile->peak_rate * (t - t1);
+        w = profile->peak_rate;
+    } else if (t < profile->total_time) {
+        double remaining = profile->total_time - t;
+        angle = profile->angle - 0.5 * a * remaining * remaining;
+        w = a * remaining;
+    } else {
+        angle = profile->angle;
+        w = 0.0;
+    }
+
+    if (rate) *rate = w;
+    return angle;
+}
+
+Quaternion attitude_slew_profile_attitude(const AttitudeSlewProfile *profile, Quaternion start, double t) {
+    if (!profile) return start;
+    double angle = attitude_slew_profile_angle(profile, t, NULL);
+    return quat_normalize(quat_multiply(quat_from_axis_angle(profile->axis, angle), start));
+}
+
+int attitude_slew_time_matrix(Satellite **red_satellites, int num_red,
+                              Satellite **blue_satellites, int num_blue, double *times) {
+    if (!red_satellites || !blue_satellites || !times || num_red < 0 || num_blue < 0) return -1;
+
+    for (int r = 0; r < num_red; r++) {
+        Satellite *red = red_satellites[r];
+        AttitudeTracker *tracker = &red->attitude;
+        double *row = times + (size_t)r * num_blue;
+
+        // 每颗红星的当前指向只算一次（旋转矩阵缓存）
+        Matrix3x3 m = attitude_tracker_get_rotation_matrix(tracker);
+        Vector3 boresight = matrix3x3_multiply_vector(m, tracker->body_axis);
+        Vector3 origin = red->state.position;
+        double max_rate = tracker->max_rate;
+        double max_accel = tracker->max_accel;
+
+        for (int b = 0; b < num_blue; b++) {
+            // 夹角 atan2(|b×d|, b·d) 与 d 的长度无关，无需单位化
+            Vector3 d = vector3_sub(blue_satellites[b]->state.position, origin);
+            double angle = atan2(vector3_magnitude(vector3_cross(boresight, d)), vector3_dot(boresight, d));
+            row[b] = attitude_slew_time(angle, max_rate, max_accel);
+        }
+    }
+    return 0;
+}
+
+/* ==================== 全队批量步进（SoA） ==================== */
+
+#define ATTITUDE_FLEET_DOUBLES  22      // 每颗卫星的 double 分列数
+
+void attitude_fleet_init(AttitudeFleet *fleet) {
+    if (!fleet) return;
+    memset(fleet, 0, sizeof(AttitudeFleet));
+}
+
+void attitude_fleet_free(AttitudeFleet *fleet) {
+    if (!fleet) return;
+    free(fleet->block);
+    memset(fleet, 0, sizeof(AttitudeFleet));
+}
+
+void attitude_fleet_clear(AttitudeFleet *fleet) {
+    if (!fleet) return;
+    fleet->count = 0;
+    fleet->num_active = 0;
+}
+
+/* 按新容量重新切分分列并搬移已有数据 */
+static int attitude_fleet_grow(AttitudeFleet *fleet, int capacity) {
+    size_t n = (size_t)capacity;
+    size_t bytes = n * (ATTITUDE_FLEET_DOUBLES * sizeof(double) + sizeof(uint32_t) + sizeof(int) + sizeof(AttitudeTracker*));
+    char *block = (char*)malloc(bytes);
+    if (!block) return -1;
+
+    AttitudeFleet grown = *fleet;
+    double **columns[ATTITUDE_FLEET_DOUBLES] = {
+        &grown.qx, &grown.qy, &grown.qz, &grown.qw,
+        &grown.wx, &grown.wy, &grown.wz,
+        &grown.ax, &grown.ay, &grown.az,
+        &grown.bx, &grown.by, &grown.bz,
+        &grown.dx, &grown.dy, &grown.dz,
+        &grown.max_rate, &grown.max_accel,
+        &grown.err_cos, &grown.ex, &grown.ey, &grown.ez
+    };
+    double **old_columns[ATTITUDE_FLEET_DOUBLES] = {
+        &fleet->qx, &fleet->qy, &fleet->qz, &fleet->qw,
+        &fleet->wx, &fleet->wy, &fleet->wz,
+        &fleet->ax, &fleet->ay, &fleet->az,
+        &fleet->bx, &fleet->by, &fleet->bz,
+        &fleet->dx, &fleet->dy, &fleet->dz,
+        &fleet->max_rate, &fleet->max_accel,
+        &fleet->err_cos, &fleet->ex, &fleet->ey, &fleet->ez
+    };
+
+    // double 分列在前（8字节对齐），其后为步数、下标和指针
+    char *cursor = block;
+    for (int c = 0; c < ATTITUDE_FLEET_DOUBLES; c++) {
+        *columns[c] = (double*)cursor;
+        if (fleet->count > 0) memcpy(cursor, *old_columns[c], sizeof(double) * fleet->count);
+        cursor += n * sizeof(double);
+    }
+    grown.trackers = (AttitudeTracker**)cursor;
+    cursor += n * sizeof(AttitudeTracker*);
+    grown.steps = (uint32_t*)cursor;
+    cursor += n * sizeof(uint32_t);
+    grown.active = (int*)cursor;
+    if (fleet->count > 0) {
+        memcpy(grown.trackers, fleet->trackers, sizeof(AttitudeTracker*) * fleet->count);
+        memcpy(grown.steps, fleet->steps, sizeof(uint32_t) * fleet->count);
+    }
+
+    free(fleet->block);
+    grown.block = block;
+    grown.capacity = capacity;
+    *fleet = grown;
+    return 0;
+}
+
+int attitude_fleet_add(AttitudeFleet *fleet, AttitudeTracker *tracker, Vector3 target_direction) {
+    if (!fleet || !tracker) return -1;
+    if (fleet->count >= fleet->capacity &&
+        attitude_fleet_grow(fleet, fleet->capacity ? fleet->capacity * 2 : 64) != 0) {
+        return -1;
+    }
+
+    int i = fleet->count++;
+    Vector3 d = vector3_normalize_safe(target_direction);
+    fleet->qx[i] = tracker->q.x;
+    fleet->qy[i] = tracker->q.y;
+    fleet->qz[i] = tracker->q.z;
+    fleet->qw[i] = tracker->q.w;
+    fleet->wx[i] = tracker->omega.x;
+    fleet->wy[i] = tracker->omega.y;
+    fleet->wz[i] = tracker->omega.z;
+    fleet->ax[i] = tracker->alpha.x;
+    fleet->ay[i] = tracker->alpha.y;
+    fleet->az[i] = tracker->alpha.z;
+    fleet->bx[i] = tracker->body_axis.x;
+    fleet->by[i] = tracker->body_axis.y;
+    fleet->bz[i] = tracker->body_axis.z;
+    fleet->dx[i] = d.x;
+    fleet->dy[i] = d.y;
+    fleet->dz[i] = d.z;
+    fleet->max_rate[i] = tracker->max_rate;
+    fleet->max_accel[i] = tracker->max_accel;
+    fleet->steps[i] = 0;
+    fleet->trackers[i] = tracker;
+    return i;
+}
+
+int attitude_fleet_scan(AttitudeFleet *fleet, double tolerance) {
+    if (!fleet) return 0;
+    const int n = fleet->count;
+    const double *restrict qx = fleet->qx, *restrict qy = fleet->qy, *restrict qz = fleet->qz, *restrict qw = fleet->qw;
+    const double *restrict bx = fleet->bx, *restrict by = fleet->by, *restrict bz = fleet->bz;
+    const double *restrict dx = fleet->dx, *restrict dy = fleet->dy, *restrict dz = fleet->dz;
+    double *restrict err_cos = fleet->err_cos;
+    double *restrict ex = fleet->ex, *restrict ey = fleet->ey, *restrict ez = fleet->ez;
+
+    // 机体轴转到世界系（t = 2q×b, b' = b + w·t + q×t），与目标方向求余弦和叉积；无分支
+    for (int i = 0; i < n; i++) {
+        double tx = 2.0 * (qy[i] * bz[i] - qz[i] * by[i]);
+        double ty = 2.0 * (qz[i] * bx[i] - qx[i] * bz[i]);
+        double tz = 2.0 * (qx[i] * by[i] - qy[i] * bx[i]);
+        double rx = bx[i] + qw[i] * tx + (qy[i] * tz - qz[i] * ty);
+        double ry = by[i] + qw[i] * ty + (qz[i] * tx - qx[i] * tz);
+        double rz = bz[i] + qw[i] * tz + (qx[i] * ty - qy[i] * tx);
+        err_cos[i] = rx * dx[i] + ry * dy[i] + rz * dz[i];
+        ex[i] = ry * dz[i] - rz * dy[i];
+        ey[i] = rz * dx[i] - rx * dz[i];
+        ez[i] = rx * dy[i] - ry * dx[i];
+    }
+
+    // 死区外的下标压缩到 active；上一子步积分后进入死区的清零残余角速度（直到误差再次超出容差）
+    const double cos_tolerance = cos(tolerance);
+    int num_active = 0;
+    for (int i = 0; i < n; i++) {
+        int outside = (err_cos[i] < cos_tolerance);
+        fleet->active[num_active] = i;
+        num_active += outside;
+        if (!outside && fleet->steps[i] > 0) {
+            fleet->wx[i] = fleet->wy[i] = fleet->wz[i] = 0.0;
+            fleet->ax[i] = fleet->ay[i] = fleet->az[i] = 0.0;
+        }
+    }
+    fleet->num_active = num_active;
+    return num_active;
+}
+
+int attitude_fleet_step(AttitudeFleet *fleet, double dt) {
+    if (!fleet || dt <= 0) return 0;
+    int num_active = attitude_fleet_scan(fleet, ATTITUDE_POINTING_TOLERANCE);
+
+    for (int k = 0; k < num_active; k++) {
+        int i = fleet->active[k];
+        Vector3 cross = { fleet->ex[i], fleet->ey[i], fleet->ez[i] };
+        double s = vector3_magnitude(cross);
+        double angle = atan2(s, fleet->err_cos[i]);
+        Vector3 axis = (s > 1e-12) ? vector3_scale(cross, 1.0 / s) : vector3_zero();
+
+        Quaternion q = { fleet->qx[i], fleet->qy[i], fleet->qz[i], fleet->qw[i] };
+        Vector3 omega = { fleet->wx[i], fleet->wy[i], fleet->wz[i] };
+        Vector3 alpha;
+        attitude_slew_kernel(&q, &omega, &alpha, axis, angle, fleet->max_rate[i], fleet->max_accel[i], dt);
+        fleet->steps[i]++;
+
+        // 是否进入死区留给下一次扫描判断（扫描本就要转全部机体轴），此处不再单独旋转
+        fleet->qx[i] = q.x;
+        fleet->qy[i] = q.y;
+        fleet->qz[i] = q.z;
+        fleet->qw[i] = q.w;
+        fleet->wx[i] = omega.x;
+        fleet->wy[i] = omega.y;
+        fleet->wz[i] = omega.z;
+        fleet->ax[i] = alpha.x;
+        fleet->ay[i] = alpha.y;
+        fleet->az[i] = alpha.z;
+    }
+    return num_active;
+}
+
+void attitude_fleet_store(AttitudeFleet *fleet) {
+    if (!fleet) return;
+    // 最后一个子步后补一次扫描，清零已进入死区的残余角速度
+    attitude_fleet_scan(fleet, ATTITUDE_POINTING_TOLERANCE);
+    for (int i = 0; i < fleet->count; i++) {
+        if (fleet->steps[i] == 0) continue;
+        AttitudeTracker *tracker = fleet->trackers[i];
+        tracker->q = (Quaternion){ fleet->qx[i], fleet->qy[i], fleet->qz[i], fleet->qw[i] };
+        tracker->omega = (Vector3){ fleet->wx[i], fleet->wy[i], fleet->wz[i] };
+        tracker->alpha = (Vector3){ fleet->ax[i], fleet->ay[i], fleet->az[i] };
+        tracker->step_count += fleet->steps[i];
+    }
+}
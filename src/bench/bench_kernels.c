@@ -0,0 +1,476 @@
+/* 数学原语和轨道内核微基准：预热 + 自动标定迭代次数 + 多次重复，输出 JSON
+ *
+ * 用法: bench_kernels [--json FILE] [--reps N] [--min-time MS] [--warmup MS]
+ *                     [--filter SUBSTR] [--stable] [--isa scalar|sse2|avx2|avx512]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sched.h>
+
+#include <constants.h>
+#include <vector3.h>
+#include <quaternion.h>
+#include <attitude.h>
+#include <vector3_soa.h>
+#include <orbit.h>
+
+#define BENCH_INPUTS        1024          // 输入表长度（2的幂，循环取用防止常量折叠）
+#define BENCH_MAX_REPS      100
+#define BENCH_GEO_RADIUS    42164000.0
+
+typedef void (*BenchFunc)(uint64_t iterations);
+
+typedef struct {
+    const char *name;
+    const char *group;
+    BenchFunc func;
+} BenchCase;
+
+typedef struct {
+    int repetitions;
+    double min_time_ms;           // 每次重复的最短耗时
+    double warmup_ms;
+    int stable;                   // 绑定CPU，重复次数×3、预热时长×4
+    int cpu;                      // 绑定的CPU（-1 为未绑定）
+    const char *filter;
+    const char *json_path;
+    Vector3SoAIsa isa;            // SoA内核指令集
+} BenchConfig;
+
+typedef struct {
+    const char *name;
+    const char *group;
+    uint64_t iterations;          // 每次重复的迭代次数
+    int repetitions;
+    double ns_min, ns_median, ns_mean, ns_stddev;
+} BenchResult;
+
+/* ==================== 输入数据 ==================== */
+
+static Vector3 bench_vectors[BENCH_INPUTS];
+static Quaternion bench_quats[BENCH_INPUTS];
+static Matrix3x3 bench_matrices[BENCH_INPUTS];
+static OrbitalElements bench_elements[BENCH_INPUTS];
+static StateVector bench_states[BENCH_INPUTS];
+static double bench_scalars[BENCH_INPUTS];
+static double bench_soa_x[BENCH_INPUTS], bench_soa_y[BENCH_INPUTS], bench_soa_z[BENCH_INPUTS];
+static double bench_soa_out[BENCH_INPUTS];
+static double bench_orbit_cols[6][BENCH_INPUTS];     // 批量RK4的位置/速度分列
+static double bench_mean_anomaly[BENCH_INPUTS], bench_ecc[BENCH_INPUTS];
+
+/* 结果写入 volatile，防止被优化掉 */
+static volatile double bench_sink;
+
+static double bench_uniform(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double)(*state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void bench_init_inputs(void) {
+    uint64_t seed = 12345;
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        Vector3 v = { bench_uniform(&seed) - 0.5, bench_uniform(&seed) - 0.5, bench_uniform(&seed) - 0.5 };
+        bench_vectors[i] = vector3_scale(v, 1000.0);
+        bench_quats[i] = quat_from_axis_angle(vector3_normalize(v), bench_uniform(&seed) * 2 * PI);
+        bench_matrices[i] = quat_to_matrix(bench_quats[i]);
+        bench_scalars[i] = bench_uniform(&seed);
+        bench_soa_x[i] = bench_vectors[i].x;
+        bench_soa_y[i] = bench_vectors[i].y;
+        bench_soa_z[i] = bench_vectors[i].z;
+
+        OrbitalElements *el = &bench_elements[i];
+        el->a = BENCH_GEO_RADIUS * (0.98 + 0.04 * bench_uniform(&seed));
+        el->e = 0.2 * bench_uniform(&seed);
+        el->i = 10.0 * bench_uniform(&seed);
+        el->omega_big = 360.0 * bench_uniform(&seed);
+        el->omega_small = 360.0 * bench_uniform(&seed);
+        el->m0 = 360.0 * bench_uniform(&seed);
+        orbit_elements_to_state(el, &bench_states[i]);
+        bench_orbit_cols[0][i] = bench_states[i].position.x;
+        bench_orbit_cols[1][i] = bench_states[i].position.y;
+        bench_orbit_cols[2][i] = bench_states[i].position.z;
+        bench_orbit_cols[3][i] = bench_states[i].velocity.x;
+        bench_orbit_cols[4][i] = bench_states[i].velocity.y;
+        bench_orbit_cols[5][i] = bench_states[i].velocity.z;
+        bench_mean_anomaly[i] = el->m0 * PI / 180.0;
+        bench_ecc[i] = el->e;
+    }
+}
+
+#define BENCH_IDX(i)  ((i) & (BENCH_INPUTS - 1))
+
+/* ==================== 数学原语 ==================== */
+
+static void bench_vector3_add(uint64_t n) {
+    Vector3 acc = vector3_zero();
+    for (uint64_t i = 0; i < n; i++) acc = vector3_add(acc, bench_vectors[BENCH_IDX(i)]);
+    bench_sink = acc.x + acc.y + acc.z;
+}
+
+static void bench_vector3_cross(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        Vector3 c = vector3_cross(bench_vectors[BENCH_IDX(i)], bench_vectors[BENCH_IDX(i + 1)]);
+        acc += c.x;
+    }
+    bench_sink = acc;
+}
+
+static void bench_vector3_normalize(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) acc += vector3_normalize(bench_vectors[BENCH_IDX(i)]).y;
+    bench_sink = acc;
+}
+
+static void bench_vector3_distance(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) acc += vector3_distance(bench_vectors[BENCH_IDX(i)], bench_vectors[BENCH_IDX(i + 7)]);
+    bench_sink = acc;
+}
+
+/* SoA一对多距离（当前指令集），按向量计次 */
+static void bench_soa_distance_to(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i += BENCH_INPUTS) {
+        int count = (n - i < BENCH_INPUTS) ? (int)(n - i) : BENCH_INPUTS;
+        Vector3SoA a = vector3_soa_view(bench_soa_x, bench_soa_y, bench_soa_z, count);
+        vector3_soa_distance_to(&a, bench_vectors[BENCH_IDX(i / BENCH_INPUTS)], bench_soa_out);
+        acc += bench_soa_out[count - 1];
+    }
+    bench_sink = acc;
+}
+
+static void bench_quat_rotate_vector(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) acc += quat_rotate_vector(bench_quats[BENCH_IDX(i)], bench_vectors[BENCH_IDX(i + 3)]).z;
+    bench_sink = acc;
+}
+
+/* 同一姿态旋转一组向量（每 BENCH_ROTATE_BATCH 个换一次姿态），按向量计次 */
+#define BENCH_ROTATE_BATCH  16
+
+static void bench_quat_rotate_vectors(uint64_t n) {
+    Vector3 out[BENCH_ROTATE_BATCH];
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i += BENCH_ROTATE_BATCH) {
+        int count = (n - i < BENCH_ROTATE_BATCH) ? (int)(n - i) : BENCH_ROTATE_BATCH;
+        quat_rotate_vectors(bench_quats[BENCH_IDX(i)], &bench_vectors[BENCH_IDX(i) & ~(uint64_t)(BENCH_ROTATE_BATCH - 1)], out, count);
+        acc += out[0].z;
+    }
+    bench_sink = acc;
+}
+
+static void bench_attitude_rotate_cached(uint64_t n) {
+    AttitudeTracker tracker;
+    attitude_tracker_init(&tracker, 0.1, 0.01, (Vector3){0, 0, 1});
+    Vector3 out[BENCH_ROTATE_BATCH];
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i += BENCH_ROTATE_BATCH) {
+        int count = (n - i < BENCH_ROTATE_BATCH) ? (int)(n - i) : BENCH_ROTATE_BATCH;
+        tracker.q = bench_quats[BENCH_IDX(i)];
+        attitude_tracker_rotate_vectors(&tracker, &bench_vectors[BENCH_IDX(i) & ~(uint64_t)(BENCH_ROTATE_BATCH - 1)], out, count);
+        acc += out[0].z;
+    }
+    bench_sink = acc;
+}
+
+static void bench_attitude_slew_time(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) acc += attitude_slew_time(bench_scalars[BENCH_IDX(i)] * PI, ATT_DEFAULT_MAX_RATE, ATT_DEFAULT_MAX_ACCEL);
+    bench_sink = acc;
+}
+
+static void bench_quat_slerp(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        Quaternion q = quat_slerp(bench_quats[BENCH_IDX(i)], bench_quats[BENCH_IDX(i + 1)], bench_scalars[BENCH_IDX(i)]);
+        acc += q.w;
+    }
+    bench_sink = acc;
+}
+
+static void bench_matrix3x3_multiply(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        Matrix3x3 m = matrix3x3_multiply(bench_matrices[BENCH_IDX(i)], bench_matrices[BENCH_IDX(i + 1)]);
+        acc += m.m[1][2];
+    }
+    bench_sink = acc;
+}
+
+/* ==================== 轨道内核 ==================== */
+
+static void bench_kepler_solve(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        const OrbitalElements *el = &bench_elements[BENCH_IDX(i)];
+        acc += orbit_solve_kepler_equation(el->m0 * PI / 180.0, el->e, 1e-12);
+    }
+    bench_sink = acc;
+}
+
+/* 批量求解（按元素计次） */
+static void bench_kepler_batch(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i += BENCH_INPUTS) {
+        int count = (n - i < BENCH_INPUTS) ? (int)(n - i) : BENCH_INPUTS;
+        orbit_batch_solve_kepler(bench_mean_anomaly, bench_ecc, bench_soa_out, count, 1e-12);
+        acc += bench_soa_out[count - 1];
+    }
+    bench_sink = acc;
+}
+
+static void bench_hohmann(uint64_t n) {
+    double acc = 0;
+    HohmannTransfer transfer;
+    for (uint64_t i = 0; i < n; i++) {
+        orbit_hohmann_transfer(bench_elements[BENCH_IDX(i)].a, bench_elements[BENCH_IDX(i + 1)].a, &transfer);
+        acc += transfer.total_delta_v;
+    }
+    bench_sink = acc;
+}
+
+static void bench_elements_to_state(uint64_t n) {
+    double acc = 0;
+    StateVector state;
+    for (uint64_t i = 0; i < n; i++) {
+        orbit_elements_to_state(&bench_elements[BENCH_IDX(i)], &state);
+        acc += state.position.x;
+    }
+    bench_sink = acc;
+}
+
+static void bench_state_to_elements(uint64_t n) {
+    double acc = 0;
+    OrbitalElements el;
+    for (uint64_t i = 0; i < n; i++) {
+        StateVector state = bench_states[BENCH_IDX(i)];
+        orbit_state_to_elements(&state, &el);
+        acc += el.a;
+    }
+    bench_sink = acc;
+}
+
+static void bench_rk4_step(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        StateVector state = bench_states[BENCH_IDX(i)];
+        orbit_rk4_step_perturbed(&state, 60.0, NULL);
+        acc += state.position.x;
+    }
+    bench_sink = acc;
+}
+
+/* 批量RK4（二体，原地连续积分，按卫星计次） */
+static void bench_rk4_batch(uint64_t n) {
+    double acc = 0;
+    for (uint64_t i = 0; i < n; i += BENCH_INPUTS) {
+        int count = (n - i < BENCH_INPUTS) ? (int)(n - i) : BENCH_INPUTS;
+        Vector3SoA pos = vector3_soa_view(bench_orbit_cols[0], bench_orbit_cols[1], bench_orbit_cols[2], count);
+        Vector3SoA vel = vector3_soa_view(bench_orbit_cols[3], bench_orbit_cols[4], bench_orbit_cols[5], count);
+        orbit_batch_rk4_step(&pos, &vel, 60.0, NULL);
+        acc += pos.x[count - 1];
+    }
+    bench_sink = acc;
+}
+
+/* orbit_lambert_solve 仍是只写零向量的占位实现，不在此计时 */
+static const BenchCase BENCH_CASES[] = {
+    { "vector3_add",         "math",  bench_vector3_add },
+    { "vector3_cross",       "math",  bench_vector3_cross },
+    { "vector3_normalize",   "math",  bench_vector3_normalize },
+    { "vector3_distance",    "math",  bench_vector3_distance },
+    { "soa_distance_to",     "math",  bench_soa_distance_to },
+    { "quat_rotate_vector",  "math",  bench_quat_rotate_vector },
+    { "quat_rotate_vectors", "math",  bench_quat_rotate_vectors },
+    { "attitude_rotate_cached", "math", bench_attitude_rotate_cached },
+    { "attitude_slew_time",  "math",  bench_attitude_slew_time },
+    { "quat_slerp",          "math",  bench_quat_slerp },
+    { "matrix3x3_multiply",  "math",  bench_matrix3x3_multiply },
+    { "kepler_solve",        "orbit", bench_kepler_solve },
+    { "kepler_batch",        "orbit", bench_kepler_batch },
+    { "hohmann_transfer",    "orbit", bench_hohmann },
+    { "elements_to_state",   "orbit", bench_elements_to_state },
+    { "state_to_elements",   "orbit", bench_state_to_elements },
+    { "rk4_step",            "orbit", bench_rk4_step },
+    { "rk4_batch",           "orbit", bench_rk4_batch },
+};
+
+#define BENCH_NUM_CASES  ((int)(sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0])))
+
+/* ==================== 计时和统计 ==================== */
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_time_ns(BenchFunc func, uint64_t iterations) {
+    double t0 = bench_now_ns();
+    func(iterations);
+    return bench_now_ns() - t0;
+}
+
+static int bench_compare_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_run_case(const BenchCase *bc, const BenchConfig *config, BenchResult *result) {
+    // 预热
+    double warmup_end = bench_now_ns() + config->warmup_ms * 1e6;
+    while (bench_now_ns() < warmup_end) bc->func(1024);
+
+    // 标定：迭代次数翻倍直到单次重复不短于 min_time
+    uint64_t iterations = 1024;
+    double target_ns = config->min_time_ms * 1e6;
+    for (;;) {
+        double elapsed = bench_time_ns(bc->func, iterations);
+        if (elapsed >= target_ns || iterations >= (1ULL << 40)) break;
+        iterations = (elapsed > target_ns / 16) ? (uint64_t)(iterations * target_ns / elapsed * 1.1) + 1
+                                                : iterations * 16;
+    }
+
+    double samples[BENCH_MAX_REPS];
+    int reps = config->repetitions;
+    double sum = 0;
+    for (int r = 0; r < reps; r++) {
+        samples[r] = bench_time_ns(bc->func, iterations) / (double)iterations;
+        sum += samples[r];
+    }
+    qsort(samples, reps, sizeof(double), bench_compare_double);
+
+    double mean = sum / reps, var = 0;
+    for (int r = 0; r < reps; r++) var += (samples[r] - mean) * (samples[r] - mean);
+
+    result->name = bc->name;
+    result->group = bc->group;
+    result->iterations = iterations;
+    result->repetitions = reps;
+    result->ns_min = samples[0];
+    result->ns_median = (reps % 2) ? samples[reps / 2] : 0.5 * (samples[reps / 2 - 1] + samples[reps / 2]);
+    result->ns_mean = mean;
+    result->ns_stddev = (reps > 1) ? sqrt(var / (reps - 1)) : 0.0;
+}
+
+/* 稳定模式：绑定到当前CPU，避免迁移带来的抖动 */
+static int bench_pin_cpu(void) {
+    int cpu = sched_getcpu();
+    if (cpu < 0) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return (sched_setaffinity(0, sizeof(set), &set) == 0) ? cpu : -1;
+}
+
+/* ==================== 输出 ==================== */
+
+static void bench_write_json(FILE *file, const BenchConfig *config, const BenchResult *results, int count) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"suite\": \"kernels\",\n");
+    fprintf(file, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(file, "  \"config\": {\"repetitions\": %d, \"min_time_ms\": %.1f, \"warmup_ms\": %.1f, "
+                  "\"stable\": %s, \"cpu\": %d, \"isa\": \"%s\"},\n",
+            config->repetitions, config->min_time_ms, config->warmup_ms,
+            config->stable ? "true" : "false", config->cpu, vector3_soa_isa_name(config->isa));
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"group\": \"%s\", \"iterations\": %llu, \"repetitions\": %d, "
+                      "\"ns_per_op\": %.4f, \"ns_per_op_min\": %.4f, \"ns_per_op_mean\": %.4f, "
+                      "\"ns_per_op_stddev\": %.4f, \"ops_per_sec\": %.1f}%s\n",
+                r->name, r->group, (unsigned long long)r->iterations, r->repetitions,
+                r->ns_median, r->ns_min, r->ns_mean, r->ns_stddev,
+                r->ns_median > 0 ? 1e9 / r->ns_median : 0.0,
+                (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+static void bench_usage(const char *program) {
+    fprintf(stderr, "用法: %s [--json FILE] [--reps N] [--min-time MS] [--warmup MS] "
+                    "[--filter SUBSTR] [--stable] [--isa scalar|sse2|avx2|avx512]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    BenchConfig config = {
+        .repetitions = 10,
+        .min_time_ms = 20.0,
+        .warmup_ms = 50.0,
+        .stable = 0,
+        .cpu = -1,
+        .filter = NULL,
+        .json_path = NULL,
+        .isa = vector3_soa_get_isa()
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            config.json_path = argv[++i];
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            config.repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            config.min_time_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.warmup_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (strcmp(argv[i], "--stable") == 0) {
+            config.stable = 1;
+        } else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            int isa = vector3_soa_isa_from_name(name);
+            if (isa < 0 || vector3_soa_set_isa((Vector3SoAIsa)isa) != 0) {
+                fprintf(stderr, "错误：本机不支持指令集 %s\n", name);
+                return 1;
+            }
+            config.isa = (Vector3SoAIsa)isa;
+        } else {
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.stable) {
+        config.cpu = bench_pin_cpu();
+        if (config.cpu < 0) fprintf(stderr, "警告：无法绑定CPU，继续以非绑定方式运行\n");
+        config.repetitions *= 3;
+        config.warmup_ms *= 4;
+    }
+    if (config.repetitions < 1) config.repetitions = 1;
+    if (config.repetitions > BENCH_MAX_REPS) config.repetitions = BENCH_MAX_REPS;
+    if (config.min_time_ms <= 0) config.min_time_ms = 1.0;
+
+    bench_init_inputs();
+
+    BenchResult results[BENCH_NUM_CASES];
+    int count = 0;
+    fprintf(stderr, "%-22s %12s %12s %10s %16s\n", "benchmark", "ns/op", "min", "stddev", "ops/sec");
+    for (int c = 0; c < BENCH_NUM_CASES; c++) {
+        if (config.filter && !strstr(BENCH_CASES[c].name, config.filter)) continue;
+        BenchResult *r = &results[count++];
+        bench_run_case(&BENCH_CASES[c], &config, r);
+        fprintf(stderr, "%-22s %12.3f %12.3f %10.3f %16.0f\n",
+                r->name, r->ns_median, r->ns_min, r->ns_stddev, 1e9 / r->ns_median);
+    }
+
+    // 人可读表格写 stderr，JSON 写文件或 stdout
+    FILE *out = stdout;
+    if (config.json_path) {
+        out = fopen(config.json_path, "w");
+        if (!out) {
+            fprintf(stderr, "错误：无法创建 %s\n", config.json_path);
+            return 1;
+        }
+    }
+    bench_write_json(out, &config, results, count);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,395 @@
+/* 整机规模扫描：合成 N 颗红蓝卫星场景，按 N × 线程数 × 输出模式逐项运行，输出 JSON
+ *
+ * 用法: satellite_bench [--sizes LIST] [--threads LIST] [--outputs LIST] [--steps N]
+ *                       [--decision-every STEPS] [--decision-max N] [--history N]
+ *                       [--output-dir DIR] [--seed N] [--json FILE]
+ *
+ * 每个线程运行一份独立引擎（种子不同），吞吐按并发总步数/最慢线程耗时汇总；
+ * 峰值RSS每项开始前经 /proc/self/clear_refs 复位，读取 VmHWM
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <kinematics.h>
+#include <simulation.h>
+#include <thread_pool.h>
+#include <profiler.h>
+#include <log.h>
+#include <rng.h>
+
+#define BENCH_MAX_SIZES          16
+#define BENCH_MAX_THREADS        16
+#define BENCH_STEP_BUDGET        2000000     // 自动步数：每项约 N×steps 卫星步
+#define BENCH_MIN_STEPS          20
+#define BENCH_MAX_STEPS          2000
+#define BENCH_HISTORY_CAPACITY   32          // 每层历史样本数（默认1024时10万星需数十GB）
+
+typedef struct {
+    int sizes[BENCH_MAX_SIZES];
+    int num_sizes;
+    int threads[BENCH_MAX_THREADS];
+    int num_threads;
+    SimOutputMode outputs[3];
+    int num_outputs;
+    uint32_t steps;                // 0 为按规模自动
+    uint32_t decision_every;       // 决策周期 (步)
+    int decision_max;              // 超过此卫星数时不触发决策（收益矩阵和分配为 O(R×B)）
+    int history;
+    uint64_t seed;
+    const char *output_dir;
+    const char *json_path;
+} BenchConfig;
+
+/* 单个线程的一次运行 */
+typedef struct {
+    const BenchConfig *config;
+    int size;
+    uint32_t steps;
+    SimOutputMode output;
+    uint64_t seed;
+    char path[512];
+    int status;
+    double setup_seconds;
+    SimRunStats stats;
+} BenchJob;
+
+typedef struct {
+    int size;
+    int threads;
+    SimOutputMode output;
+    uint32_t steps;
+    int decision;                  // 是否触发决策
+    int failed;
+    double setup_seconds;          // 场景构建（最慢线程）
+    double elapsed_seconds;        // 步进（最慢线程）
+    double steps_per_sec;          // 全部线程合计
+    double sat_steps_per_sec;
+    uint32_t decision_ticks;
+    double decision_mean_us, decision_p50_us, decision_p99_us, decision_max_us;
+    long peak_rss_kb;
+    uint64_t bytes_written;
+} BenchResult;
+
+static const char *const BENCH_OUTPUT_NAMES[] = { "none", "csv", "binary" };
+
+/* ==================== 内存 ==================== */
+
+/* 复位峰值RSS（内核 ≥4.0 支持写入5），失败返回-1 */
+static int bench_reset_peak_rss(void) {
+    FILE *file = fopen("/proc/self/clear_refs", "w");
+    if (!file) return -1;
+    int ok = fputs("5", file) >= 0;
+    return (fclose(file) == 0 && ok) ? 0 : -1;
+}
+
+/* 进程峰值RSS (KB)，读取失败返回-1 */
+static long bench_peak_rss_kb(void) {
+    FILE *file = fopen("/proc/self/status", "r");
+    if (!file) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "VmHWM:", 6) == 0) {
+            kb = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return kb;
+}
+
+/* ==================== 运行 ==================== */
+
+/* 合成场景：红蓝各半，每队攻击/侦察/防御三等分 */
+static void bench_scenario(int size, Config *scenario) {
+    memset(scenario, 0, sizeof(Config));
+    int red = size / 2, blue = size - red;
+    scenario->red_attack = red / 3;
+    scenario->red_recon = red / 3;
+    scenario->red_defense = red - 2 * (red / 3);
+    scenario->blue_attack = blue / 3;
+    scenario->blue_recon = blue / 3;
+    scenario->blue_defense = blue - 2 * (blue / 3);
+    strncpy(scenario->strategy, "GJ", sizeof(scenario->strategy));
+}
+
+static void bench_job_run(void *arg) {
+    BenchJob *job = (BenchJob*)arg;
+    const BenchConfig *config = job->config;
+    sim_log_set_quiet(1);
+
+    Config scenario;
+    bench_scenario(job->size, &scenario);
+    SimulationConfig sim_config;
+    simulation_default_config(&sim_config);
+    sim_config.max_steps = job->steps;
+
+    uint64_t setup_start = profiler_now_ns();
+    KinematicsEngine *engine = simulation_create_engine(&scenario, &sim_config, job->seed, config->history);
+    if (!engine) {
+        job->status = -1;
+        return;
+    }
+    kinematics_engine_set_clock_period(engine, SIM_CLOCK_DECISION, config->decision_every * sim_config.time_step);
+    if (job->size > config->decision_max) {
+        // 超出规模上限：停用决策时钟，步进中不再触发
+        kinematics_engine_enable_clock(engine, SIM_CLOCK_DECISION, 0);
+    }
+    job->setup_seconds = (profiler_now_ns() - setup_start) * 1e-9;
+
+    SimRunOptions options = {
+        .output = job->output,
+        .output_file = job->path
+    };
+    job->status = simulation_run(engine, job->steps, &options, &job->stats);
+    if (job->status == 0 && job->stats.steps < job->steps) job->status = -1;
+
+    kinematics_engine_destroy(engine);
+    if (job->output != SIM_OUTPUT_NONE) remove(job->path);
+}
+
+static uint32_t bench_steps_for(const BenchConfig *config, int size) {
+    if (config->steps > 0) return config->steps;
+    uint32_t steps = (uint32_t)(BENCH_STEP_BUDGET / (size > 0 ? size : 1));
+    if (steps < BENCH_MIN_STEPS) steps = BENCH_MIN_STEPS;
+    if (steps > BENCH_MAX_STEPS) steps = BENCH_MAX_STEPS;
+    return steps;
+}
+
+static int bench_run_point(const BenchConfig *config, int size, int threads, SimOutputMode output,
+                           BenchResult *result) {
+    memset(result, 0, sizeof(BenchResult));
+    result->size = size;
+    result->threads = threads;
+    result->output = output;
+    result->steps = bench_steps_for(config, size);
+    result->decision = size <= config->decision_max;
+
+    BenchJob *jobs = (BenchJob*)calloc((size_t)threads, sizeof(BenchJob));
+    if (!jobs) return -1;
+    Rng seeder;
+    rng_seed(&seeder, config->seed);
+    for (int t = 0; t < threads; t++) {
+        BenchJob *job = &jobs[t];
+        job->config = config;
+        job->size = size;
+        job->steps = result->steps;
+        job->output = output;
+        job->seed = rng_next_u64(&seeder);
+        snprintf(job->path, sizeof(job->path), "%s/satellite_bench_%d_%d_%d.%s", config->output_dir,
+                 (int)getpid(), size, t, output == SIM_OUTPUT_CSV ? "csv" : "bin");
+    }
+
+    bench_reset_peak_rss();
+    ThreadPool *pool = thread_pool_create(threads);
+    if (!pool) {
+        free(jobs);
+        return -1;
+    }
+    for (int t = 0; t < threads; t++) thread_pool_submit(pool, bench_job_run, &jobs[t]);
+    thread_pool_wait(pool);
+    thread_pool_destroy(pool);
+    result->peak_rss_kb = bench_peak_rss_kb();
+
+    // 汇总：并发吞吐按最慢线程耗时计，决策延迟取合并均值和各线程分位数最大值
+    RunningStats latency;
+    running_stats_init(&latency);
+    uint64_t total_steps = 0;
+    for (int t = 0; t < threads; t++) {
+        const BenchJob *job = &jobs[t];
+        if (job->status != 0) result->failed++;
+        if (job->setup_seconds > result->setup_seconds) result->setup_seconds = job->setup_seconds;
+        if (job->stats.elapsed_seconds > result->elapsed_seconds) result->elapsed_seconds = job->stats.elapsed_seconds;
+        if (job->stats.decision_p50_us > result->decision_p50_us) result->decision_p50_us = job->stats.decision_p50_us;
+        if (job->stats.decision_p99_us > result->decision_p99_us) result->decision_p99_us = job->stats.decision_p99_us;
+        running_stats_merge(&latency, &job->stats.decision_latency_us);
+        total_steps += job->stats.steps;
+        result->bytes_written += job->stats.bytes_written;
+    }
+    result->decision_ticks = (uint32_t)latency.count;
+    result->decision_mean_us = latency.count ? latency.mean : 0.0;
+    result->decision_max_us = latency.count ? latency.max : 0.0;
+    if (result->elapsed_seconds > 0) {
+        result->steps_per_sec = total_steps / result->elapsed_seconds;
+        result->sat_steps_per_sec = result->steps_per_sec * size;
+    }
+
+    free(jobs);
+    return result->failed ? -1 : 0;
+}
+
+/* ==================== 输出 ==================== */
+
+static void bench_write_json(FILE *file, const BenchConfig *config, const BenchResult *results, int count) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"suite\": \"scaling\",\n");
+    fprintf(file, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(file, "  \"config\": {\"decision_every\": %u, \"decision_max\": %d, \"history\": %d, "
+                  "\"seed\": %llu, \"cpus\": %d},\n",
+            config->decision_every, config->decision_max, config->history,
+            (unsigned long long)config->seed, thread_pool_cpu_count());
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(file, "    {\"satellites\": %d, \"threads\": %d, \"output\": \"%s\", \"steps\": %u, "
+                      "\"decision\": %s, \"failed\": %d, \"setup_s\": %.4f, \"elapsed_s\": %.4f, "
+                      "\"steps_per_sec\": %.2f, \"satellite_steps_per_sec\": %.1f, "
+                      "\"decision_ticks\": %u, \"decision_mean_us\": %.2f, \"decision_p50_us\": %.2f, "
+                      "\"decision_p99_us\": %.2f, \"decision_max_us\": %.2f, "
+                      "\"peak_rss_kb\": %ld, \"bytes_written\": %llu}%s\n",
+                r->size, r->threads, BENCH_OUTPUT_NAMES[r->output], r->steps,
+                r->decision ? "true" : "false", r->failed, r->setup_seconds, r->elapsed_seconds,
+                r->steps_per_sec, r->sat_steps_per_sec,
+                r->decision_ticks, r->decision_mean_us, r->decision_p50_us,
+                r->decision_p99_us, r->decision_max_us,
+                r->peak_rss_kb, (unsigned long long)r->bytes_written,
+                (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+/* ==================== 参数 ==================== */
+
+/* 逗号分隔的正整数列表，返回个数，格式错误返回-1 */
+static int bench_parse_list(const char *text, int *values, int max_values) {
+    int count = 0;
+    const char *p = text;
+    while (*p) {
+        char *end = NULL;
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0 || count >= max_values) return -1;
+        values[count++] = (int)v;
+        p = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return count;
+}
+
+static int bench_parse_outputs(const char *text, BenchConfig *config) {
+    config->num_outputs = 0;
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *tok = strtok(buffer, ","); tok; tok = strtok(NULL, ",")) {
+        int mode = -1;
+        for (int m = 0; m < 3; m++) {
+            if (strcmp(tok, BENCH_OUTPUT_NAMES[m]) == 0) mode = m;
+        }
+        if (mode < 0 || config->num_outputs >= 3) return -1;
+        config->outputs[config->num_outputs++] = (SimOutputMode)mode;
+    }
+    return config->num_outputs;
+}
+
+static void bench_usage(const char *program) {
+    fprintf(stderr, "用法: %s [--sizes LIST] [--threads LIST] [--outputs none,csv,binary] [--steps N]\n"
+                    "          [--decision-every STEPS] [--decision-max N] [--history N]\n"
+                    "          [--output-dir DIR] [--seed N] [--json FILE]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    BenchConfig config = {
+        .sizes = { 10, 100, 1000, 10000, 100000 },
+        .num_sizes = 5,
+        .num_threads = 0,
+        .outputs = { SIM_OUTPUT_NONE, SIM_OUTPUT_CSV, SIM_OUTPUT_BINARY },
+        .num_outputs = 3,
+        .steps = 0,
+        .decision_every = 20,
+        .decision_max = 1000,
+        .history = BENCH_HISTORY_CAPACITY,
+        .seed = RNG_DEFAULT_SEED,
+        .output_dir = "/tmp",
+        .json_path = NULL
+    };
+
+    for (int i = 1; i < argc; i++) {
+        int ok = 1;
+        if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            ok = (config.num_sizes = bench_parse_list(argv[++i], config.sizes, BENCH_MAX_SIZES)) > 0;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            ok = (config.num_threads = bench_parse_list(argv[++i], config.threads, BENCH_MAX_THREADS)) > 0;
+        } else if (strcmp(argv[i], "--outputs") == 0 && i + 1 < argc) {
+            ok = bench_parse_outputs(argv[++i], &config) > 0;
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            config.steps = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--decision-every") == 0 && i + 1 < argc) {
+            config.decision_every = (uint32_t)strtoul(argv[++i], NULL, 10);
+            ok = config.decision_every > 0;
+        } else if (strcmp(argv[i], "--decision-max") == 0 && i + 1 < argc) {
+            config.decision_max = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc) {
+            config.history = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output-dir") == 0 && i + 1 < argc) {
+            config.output_dir = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            config.json_path = argv[++i];
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // 默认线程数：1 和 CPU核数（最多8）
+    if (config.num_threads == 0) {
+        int cpus = thread_pool_cpu_count();
+        if (cpus > 8) cpus = 8;
+        config.threads[config.num_threads++] = 1;
+        if (cpus > 1) config.threads[config.num_threads++] = cpus;
+    }
+
+    sim_log_set_quiet(1);
+    if (bench_reset_peak_rss() != 0) {
+        fprintf(stderr, "警告：无法复位峰值RSS，各项 peak_rss_kb 为进程累计峰值\n");
+    }
+
+    int capacity = config.num_sizes * config.num_threads * config.num_outputs;
+    BenchResult *results = (BenchResult*)calloc((size_t)capacity, sizeof(BenchResult));
+    if (!results) return 1;
+
+    int count = 0, failures = 0;
+    fprintf(stderr, "%8s %3s %-6s %6s %10s %14s %12s %12s %10s %10s\n", "sats", "thr", "output", "steps",
+            "steps/s", "sat-steps/s", "dec_p50_us", "dec_p99_us", "rss_MB", "written_MB");
+    for (int s = 0; s < config.num_sizes; s++) {
+        for (int t = 0; t < config.num_threads; t++) {
+            for (int o = 0; o < config.num_outputs; o++) {
+                BenchResult *r = &results[count++];
+                if (bench_run_point(&config, config.sizes[s], config.threads[t], config.outputs[o], r) != 0) {
+                    fprintf(stderr, "错误：%d 颗卫星 × %d 线程 (%s) 运行失败\n",
+                            r->size, r->threads, BENCH_OUTPUT_NAMES[r->output]);
+                    failures++;
+                }
+                fprintf(stderr, "%8d %3d %-6s %6u %10.1f %14.0f %12.1f %12.1f %10.1f %10.1f\n",
+                        r->size, r->threads, BENCH_OUTPUT_NAMES[r->output], r->steps,
+                        r->steps_per_sec, r->sat_steps_per_sec,
+                        r->decision_p50_us, r->decision_p99_us,
+                        r->peak_rss_kb / 1024.0, r->bytes_written / (1024.0 * 1024.0));
+            }
+        }
+    }
+
+    // 人可读表格写 stderr，JSON 写文件或 stdout
+    FILE *out = stdout;
+    if (config.json_path) {
+        out = fopen(config.json_path, "w");
+        if (!out) {
+            fprintf(stderr, "错误：无法创建 %s\n", config.json_path);
+            free(results);
+            return 1;
+        }
+    }
+    bench_write_json(out, &config, results, count);
+    if (out != stdout) fclose(out);
+    free(results);
+    return failures ? 1 : 0;
+}
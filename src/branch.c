@@ -0,0 +1,231 @@
+#define _DEFAULT_SOURCE
+
+#include <branch.h>
+#include <satellite.h>
+#include <log.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+/* ==================== 内部函数 ==================== */
+
+static double branch_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double branch_red_fuel(KinematicsEngine *engine) {
+    double total = 0.0;
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (sat && sat->team == 0) total += sat->total_fuel_used;
+    }
+    return total;
+}
+
+/**
+ * 子进程：切换策略并立即重新决策，运行指定步数后写回共享结果
+ */
+static void branch_child_run(KinematicsEngine *engine, const char *strategy,
+                             const BranchOptions *options, BranchOutcome *outcome) {
+    if (options->quiet && !freopen("/dev/null", "w", stdout)) {
+        outcome->status = -1;
+        return;
+    }
+
+    double start = branch_wall_time();
+    double fuel_before = branch_red_fuel(engine);
+
+    kinematics_engine_set_strategy(engine, strategy);
+    engine->clocks[SIM_CLOCK_DECISION].next_time = engine->current_time;
+
+    uint32_t steps = 0;
+    while (steps < options->num_steps) {
+        if (kinematics_engine_step(engine) != 0) break;
+        steps++;
+    }
+
+    branch_collect_outcome(engine, outcome);
+    strncpy(outcome->strategy, strategy, sizeof(outcome->strategy) - 1);
+    outcome->steps_run = steps;
+    outcome->red_fuel_used = branch_red_fuel(engine) - fuel_before;
+    outcome->elapsed_seconds = branch_wall_time() - start;
+    outcome->status = (steps == options->num_steps) ? 0 : -1;
+}
+
+/* waitpid 状态转为退出码：正常退出为退出码，被信号终止为 128+信号号 */
+static int branch_exit_code(int wstatus) {
+    if (WIFEXITED(wstatus)) return WEXITSTATUS(wstatus);
+    if (WIFSIGNALED(wstatus)) return 128 + WTERMSIG(wstatus);
+    return -1;
+}
+
+/**
+ * 回收一个本次创建的子进程，只等待 pids 中的进程（调用方的其他子进程不受影响）：
+ * 先非阻塞轮询，全部未结束时阻塞等待最早启动的一个
+ * @return 回收的分支下标，没有待回收的子进程返回-1
+ */
+static int branch_reap_one(pid_t *pids, int num_branches, BranchOutcome *shared) {
+    int oldest = -1;
+    int wstatus;
+    for (int b = 0; b < num_branches; b++) {
+        if (pids[b] <= 0) continue;
+        if (oldest < 0) oldest = b;
+        if (waitpid(pids[b], &wstatus, WNOHANG) == pids[b]) {
+            shared[b].exit_status = branch_exit_code(wstatus);
+            pids[b] = 0;
+            return b;
+        }
+    }
+    if (oldest < 0) return -1;
+
+    pid_t r;
+    do {
+        r = waitpid(pids[oldest], &wstatus, 0);
+    } while (r < 0 && errno == EINTR);
+    shared[oldest].exit_status = (r == pids[oldest]) ? branch_exit_code(wstatus) : -1;
+    pids[oldest] = 0;
+    return oldest;
+}
+
+/* ==================== 公开接口实现 ==================== */
+
+void branch_collect_outcome(KinematicsEngine *engine, BranchOutcome *outcome) {
+    if (!engine || !outcome) return;
+
+    double sum = 0.0, min_dist = 1e10;
+    double warning_km = kinematics_engine_params(engine)->strategy.warning_distance;
+    int num_targeted = 0, within = 0;
+    memset(outcome->formation_counts, 0, sizeof(outcome->formation_counts));
+
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat || sat->team != 0) continue;
+
+        if (sat->current_formation < 5) outcome->formation_counts[sat->current_formation]++;
+
+        Satellite *target = (sat->target_id >= 0) ? kinematics_engine_get_satellite(engine, sat->target_id) : NULL;
+        if (!target) continue;
+
+        double d = vector3_distance(sat->state.position, target->state.position) / 1000.0;
+        sum += d;
+        num_targeted++;
+        if (d < min_dist) min_dist = d;
+        if (d < warning_km) within++;
+    }
+
+    outcome->final_time = engine->current_time;
+    outcome->mean_target_distance = num_targeted ? sum / num_targeted : 0.0;
+    outcome->min_target_distance = num_targeted ? min_dist : 0.0;
+    outcome->red_within_warning = within;
+}
+
+int kinematics_engine_branch(
+    KinematicsEngine *engine,
+    const char **strategies,
+    int num_branches,
+    const BranchOptions *options,
+    BranchOutcome *outcomes_out) {
+
+    if (!engine || !strategies || !options || !outcomes_out) return -1;
+    if (num_branches <= 0 || num_branches > BRANCH_MAX_BRANCHES) return -1;
+
+    // 结果放在共享匿名映射中，子进程直接写入
+    size_t shared_size = sizeof(BranchOutcome) * num_branches;
+    BranchOutcome *shared = (BranchOutcome*)mmap(NULL, shared_size, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        fprintf(stderr, "错误：无法分配分支共享内存\n");
+        return -1;
+    }
+    memset(shared, 0, shared_size);
+    for (int b = 0; b < num_branches; b++) {
+        strncpy(shared[b].strategy, strategies[b] ? strategies[b] : "", sizeof(shared[b].strategy) - 1);
+        shared[b].status = -1;
+        shared[b].exit_status = -1;
+    }
+
+    int max_concurrent = options->max_concurrent;
+    if (max_concurrent <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        max_concurrent = (ncpu > 0) ? (int)ncpu : 1;
+    }
+
+    pid_t *pids = (pid_t*)calloc(num_branches, sizeof(pid_t));
+    if (!pids) {
+        munmap(shared, shared_size);
+        return -1;
+    }
+
+    SIM_LOG("[Branch] 从 t=%.1f s 分出 %d 个分支（并发 %d），每支 %u 步\n",
+           engine->current_time, num_branches, max_concurrent, options->num_steps);
+
+    // 避免缓冲区内容在子进程中重复输出
+    fflush(stdout);
+    fflush(stderr);
+
+    int running = 0;
+    for (int b = 0; b < num_branches; b++) {
+        // 并发数已满时等待任一分支子进程结束
+        while (running >= max_concurrent && branch_reap_one(pids, num_branches, shared) >= 0) {
+            running--;
+        }
+
+        if (!strategies[b]) continue;
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "错误：分支 %d fork失败\n", b);
+            continue;
+        }
+        if (pid == 0) {
+            branch_child_run(engine, strategies[b], options, &shared[b]);
+            fflush(stdout);
+            _exit(shared[b].status == 0 ? 0 : 1);
+        }
+        pids[b] = pid;
+        running++;
+    }
+
+    while (running > 0 && branch_reap_one(pids, num_branches, shared) >= 0) {
+        running--;
+    }
+
+    // 子进程正常退出且自报成功才算完成
+    int completed = 0;
+    for (int b = 0; b < num_branches; b++) {
+        outcomes_out[b] = shared[b];
+        if (shared[b].exit_status == 0 && shared[b].status == 0) completed++;
+        else outcomes_out[b].status = -1;
+    }
+
+    free(pids);
+    munmap(shared, shared_size);
+    return completed;
+}
+
+void branch_print_outcomes(const BranchOutcome *outcomes, int num_branches) {
+    if (!outcomes) return;
+
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║                    分支策略对比                            ║\n");
+    printf("╠════════════════════════════════════════════════════════════╣\n");
+    printf("│ 策略  状态  步数    燃料(kg)  平均距离(km)  最小距离(km)  监视内  耗时(s)\n");
+
+    for (int b = 0; b < num_branches; b++) {
+        const BranchOutcome *o = &outcomes[b];
+        printf("│ %-4s  %-4s  %-6u  %8.2f  %12.1f  %12.1f  %6d  %7.2f\n",
+               o->strategy, o->status == 0 ? "完成" : "失败", o->steps_run,
+               o->red_fuel_used, o->mean_target_distance, o->min_target_distance,
+               o->red_within_warning, o->elapsed_seconds);
+    }
+
+    printf("╚════════════════════════════════════════════════════════════╝\n");
+    printf("\n");
+}
@@ -0,0 +1,466 @@
+#define _DEFAULT_SOURCE
+
+#include <checkpoint.h>
+#include <kinematics.h>
+#include <satellite.h>
+#include <log.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "formation/formation_around.h"
+#include "formation/formation_inspect.h"
+#include "formation/formation_circumnavigate.h"
+#include "formation/formation_retreat.h"
+
+#define CHECKPOINT_MAX_SECTIONS 16
+
+/* ==================== 写入 ==================== */
+
+typedef struct {
+    FILE *fp;
+    CheckpointSection sections[CHECKPOINT_MAX_SECTIONS];
+    int num_sections;
+    uint64_t offset;
+    int failed;
+} CheckpointWriter;
+
+static void checkpoint_write_bytes(CheckpointWriter *w, const void *data, size_t size) {
+    if (w->failed || size == 0) return;
+    if (fwrite(data, 1, size, w->fp) != size) {
+        w->failed = 1;
+        return;
+    }
+    w->offset += size;
+}
+
+/* 开始新节：补齐到对齐边界并记录偏移 */
+static CheckpointSection* checkpoint_begin_section(CheckpointWriter *w, uint32_t tag, uint32_t record_size) {
+    static const uint8_t zeros[CHECKPOINT_ALIGN] = {0};
+    if (w->num_sections >= CHECKPOINT_MAX_SECTIONS) {
+        w->failed = 1;
+        return NULL;
+    }
+
+    uint64_t pad = (CHECKPOINT_ALIGN - (w->offset % CHECKPOINT_ALIGN)) % CHECKPOINT_ALIGN;
+    checkpoint_write_bytes(w, zeros, (size_t)pad);
+
+    CheckpointSection *sec = &w->sections[w->num_sections++];
+    sec->tag = tag;
+    sec->record_size = record_size;
+    sec->offset = w->offset;
+    sec->size = 0;
+    return sec;
+}
+
+static void checkpoint_end_section(CheckpointWriter *w, CheckpointSection *sec) {
+    if (sec) sec->size = w->offset - sec->offset;
+}
+
+static void checkpoint_write_section(CheckpointWriter *w, uint32_t tag, uint32_t record_size,
+                                     const void *data, size_t size) {
+    CheckpointSection *sec = checkpoint_begin_section(w, tag, record_size);
+    checkpoint_write_bytes(w, data, size);
+    checkpoint_end_section(w, sec);
+}
+
+int kinematics_engine_save_checkpoint(KinematicsEngine *engine, const char *filename) {
+    if (!engine || !filename) return -1;
+
+    // 先写临时文件再改名，崩溃时不会留下半个检查点
+    char tmp_name[1024];
+    if (snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", filename) >= (int)sizeof(tmp_name)) return -1;
+
+    CheckpointWriter w;
+    memset(&w, 0, sizeof(w));
+    w.fp = fopen(tmp_name, "wb");
+    if (!w.fp) {
+        fprintf(stderr, "错误：无法创建检查点文件 %s\n", tmp_name);
+        return -1;
+    }
+
+    // 预留文件头和节表，最后回填
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    uint8_t reserved[sizeof(CheckpointHeader) + sizeof(CheckpointSection) * CHECKPOINT_MAX_SECTIONS];
+    memset(reserved, 0, sizeof(reserved));
+    checkpoint_write_bytes(&w, reserved, sizeof(reserved));
+
+    // ===== ENGINE =====
+    CheckpointEngineRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.config = engine->config;
+    runtime_params_apply(kinematics_engine_params(engine), &rec.config);  // 保存当前生效的参数
+    rec.strategy_thresholds = rec.config.strategy;
+    rec.current_time = engine->current_time;
+    rec.dt_seconds = engine->dt_seconds;
+    rec.step_count = engine->step_count;
+    rec.total_maneuvers = engine->total_maneuvers;
+    rec.total_fuel_consumed = engine->total_fuel_consumed;
+    rec.satellite_count = engine->satellite_count;
+    rec.formation_count = engine->formation_count;
+    rec.perturbation_flags = engine->perturbations.enabled_flags & PERTURB_ALL_BUILTIN;
+    rec.srp_cr = engine->perturbations.srp_cr;
+    rec.srp_area_to_mass = engine->perturbations.srp_area_to_mass;
+    memcpy(rec.clocks, engine->clocks, sizeof(rec.clocks));
+    memcpy(rec.strategy, engine->strategy, sizeof(rec.strategy));
+    rec.attitude_substeps = engine->attitude_substeps;
+    checkpoint_write_section(&w, CKPT_TAG_ENGINE, sizeof(rec), &rec, sizeof(rec));
+
+    // ===== SATELLITES（历史缓冲指针和链接下标清零，链接按 RELLINKS 重建） =====
+    CheckpointSection *sec = checkpoint_begin_section(&w, CKPT_TAG_SATELLITES, sizeof(Satellite));
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite copy = *engine->satellites[i];
+        copy.history = NULL;
+        copy.relative_link = 0;
+        checkpoint_write_bytes(&w, &copy, sizeof(copy));
+    }
+    checkpoint_end_section(&w, sec);
+
+    // ===== HISTORY：有历史的卫星依次写 {卫星ID, 字节数, 序列化历史} =====
+    sec = checkpoint_begin_section(&w, CKPT_TAG_HISTORY, 1);
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat->history) continue;
+        size_t size = history_serialize(sat->history, NULL);
+        uint8_t *blob = (uint8_t*)malloc(size);
+        if (!blob) {
+            w.failed = 1;
+            break;
+        }
+        history_serialize(sat->history, blob);
+        CheckpointHistoryHeader hh = {sat->id, (uint32_t)size};
+        checkpoint_write_bytes(&w, &hh, sizeof(hh));
+        checkpoint_write_bytes(&w, blob, size);
+        free(blob);
+    }
+    checkpoint_end_section(&w, sec);
+
+    // ===== 编队控制器 =====
+    FormationControllers *fc = &engine->formation_controllers;
+    if (fc->around_state) {
+        checkpoint_write_section(&w, CKPT_TAG_AROUND, sizeof(AroundFormationState),
+                                 fc->around_state, sizeof(AroundFormationState));
+    }
+    if (fc->inspect_state) {
+        InspectFormationState *s = (InspectFormationState*)fc->inspect_state;
+        checkpoint_write_section(&w, CKPT_TAG_INSPECT, sizeof(InspectionState),
+                                 s->states, sizeof(InspectionState) * s->num_states);
+    }
+    if (fc->circumnavigate_state) {
+        CircumnavigateFormationState *s = (CircumnavigateFormationState*)fc->circumnavigate_state;
+        checkpoint_write_section(&w, CKPT_TAG_CIRCUM, sizeof(CircumnavigateState),
+                                 s->states, sizeof(CircumnavigateState) * s->num_states);
+    }
+    if (fc->retreat_state) {
+        RetreatFormationState *s = (RetreatFormationState*)fc->retreat_state;
+        checkpoint_write_section(&w, CKPT_TAG_RETREAT, sizeof(RetreatState),
+                                 s->states, sizeof(RetreatState) * s->num_states);
+    }
+
+    // ===== 编队管理器 =====
+    FormationManager *fm = engine->formation_manager;
+    if (fm) {
+        checkpoint_write_section(&w, CKPT_TAG_TRIGGERS, sizeof(FormationTrigger),
+                                 fm->triggers, sizeof(FormationTrigger) * fm->num_satellites);
+        checkpoint_write_section(&w, CKPT_TAG_RULES, sizeof(FormationTransitionRule),
+                                 fm->transition_rules, sizeof(FormationTransitionRule) * fm->num_rules);
+    }
+
+    // ===== 相对运动链接 =====
+    sec = checkpoint_begin_section(&w, CKPT_TAG_RELLINKS, sizeof(CheckpointRelativeLinkRecord));
+    for (int i = 0; i < engine->num_relative_links; i++) {
+        CheckpointRelativeLinkRecord link;
+        memset(&link, 0, sizeof(link));
+        link.chief_id = engine->relative_links[i].chief->id;
+        link.deputy_id = engine->relative_links[i].deputy->id;
+        link.prop = engine->relative_links[i].prop;
+        checkpoint_write_bytes(&w, &link, sizeof(link));
+    }
+    checkpoint_end_section(&w, sec);
+
+    // ===== 引擎随机数状态 =====
+    CheckpointRngRecord rng_rec = {engine->seed, engine->rng};
+    checkpoint_write_section(&w, CKPT_TAG_RNG, sizeof(rng_rec), &rng_rec, sizeof(rng_rec));
+
+    // 回填文件头和节表
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.num_sections = (uint32_t)w.num_sections;
+    header.file_size = w.offset;
+
+    if (!w.failed && fseek(w.fp, 0, SEEK_SET) == 0) {
+        if (fwrite(&header, sizeof(header), 1, w.fp) != 1 ||
+            fwrite(w.sections, sizeof(CheckpointSection), CHECKPOINT_MAX_SECTIONS, w.fp) != CHECKPOINT_MAX_SECTIONS) {
+            w.failed = 1;
+        }
+    } else {
+        w.failed = 1;
+    }
+
+    if (fclose(w.fp) != 0) w.failed = 1;
+    if (w.failed || rename(tmp_name, filename) != 0) {
+        fprintf(stderr, "错误：写入检查点失败 %s\n", filename);
+        remove(tmp_name);
+        return -1;
+    }
+
+    SIM_LOG("[Checkpoint] ✓ 已保存 %s (t=%.1f s, 步数=%u, %d颗卫星, %.1f KB)\n",
+           filename, engine->current_time, engine->step_count,
+           engine->satellite_count, header.file_size / 1024.0);
+    return 0;
+}
+
+/* ==================== 读取 ==================== */
+
+typedef struct {
+    const uint8_t *base;
+    const CheckpointSection *sections;
+    uint32_t num_sections;
+} CheckpointView;
+
+/* 查找数据节并检查元素大小；未找到返回NULL，*count 为元素个数 */
+static const void* checkpoint_find(const CheckpointView *view, uint32_t tag, uint32_t record_size, size_t *count) {
+    for (uint32_t i = 0; i < view->num_sections; i++) {
+        const CheckpointSection *sec = &view->sections[i];
+        if (sec->tag != tag) continue;
+        if (sec->record_size != record_size || sec->size % record_size != 0) {
+            fprintf(stderr, "错误：检查点数据节 0x%08x 布局不匹配\n", tag);
+            return NULL;
+        }
+        if (count) *count = (size_t)(sec->size / record_size);
+        return view->base + sec->offset;
+    }
+    if (count) *count = 0;
+    return NULL;
+}
+
+/* 把数组节恢复到编队状态（容量不足时扩容） */
+static int checkpoint_restore_states(void **states, int *num_states, int *capacity,
+                                     const void *data, size_t count, size_t record_size) {
+    if ((int)count > *capacity) {
+        void *grown = realloc(*states, record_size * count);
+        if (!grown) return -1;
+        *states = grown;
+        *capacity = (int)count;
+    }
+    if (count > 0) memcpy(*states, data, record_size * count);
+    *num_states = (int)count;
+    return 0;
+}
+
+static int checkpoint_restore_engine(KinematicsEngine *engine, const CheckpointView *view) {
+    size_t n_sats = 0;
+    const Satellite *sats = (const Satellite*)checkpoint_find(view, CKPT_TAG_SATELLITES, sizeof(Satellite), &n_sats);
+    size_t hist_size = 0;
+    const uint8_t *hist = (const uint8_t*)checkpoint_find(view, CKPT_TAG_HISTORY, 1, &hist_size);
+
+    // ===== 卫星和历史 =====
+    for (size_t i = 0; i < n_sats; i++) {
+        Satellite *sat = (Satellite*)slab_alloc(&engine->slab, sizeof(Satellite));
+        if (!sat) return -1;
+        *sat = sats[i];
+
+        sat->history = NULL;
+        sat->relative_link = 0;
+        sat->allocator = &engine->slab;
+        if (kinematics_engine_add_satellite(engine, sat) < 0) {
+            satellite_destroy(sat);
+            return -1;
+        }
+    }
+
+    // ===== 历史按卫星ID挂回 =====
+    size_t hist_offset = 0;
+    while (hist && hist_offset + sizeof(CheckpointHistoryHeader) <= hist_size) {
+        CheckpointHistoryHeader hh;
+        memcpy(&hh, hist + hist_offset, sizeof(hh));
+        hist_offset += sizeof(hh);
+        if (hh.size > hist_size - hist_offset) {
+            fprintf(stderr, "错误：检查点历史数据不完整\n");
+            return -1;
+        }
+        Satellite *sat = kinematics_engine_get_satellite(engine, hh.sat_id);
+        if (sat) {
+            sat->history = history_deserialize(hist + hist_offset, hh.size, sat->allocator);
+            if (!sat->history) {
+                fprintf(stderr, "错误：卫星 %d 历史数据损坏\n", hh.sat_id);
+                return -1;
+            }
+        }
+        hist_offset += hh.size;
+    }
+
+    // ===== 编队控制器 =====
+    FormationControllers *fc = &engine->formation_controllers;
+    size_t count = 0;
+    const void *data = checkpoint_find(view, CKPT_TAG_AROUND, sizeof(AroundFormationState), &count);
+    if (data && count == 1 && fc->around_state) {
+        memcpy(fc->around_state, data, sizeof(AroundFormationState));
+    }
+
+    data = checkpoint_find(view, CKPT_TAG_INSPECT, sizeof(InspectionState), &count);
+    if (data && fc->inspect_state) {
+        InspectFormationState *s = (InspectFormationState*)fc->inspect_state;
+        if (checkpoint_restore_states((void**)&s->states, &s->num_states, &s->capacity,
+                                      data, count, sizeof(InspectionState)) != 0) return -1;
+    }
+
+    data = checkpoint_find(view, CKPT_TAG_CIRCUM, sizeof(CircumnavigateState), &count);
+    if (data && fc->circumnavigate_state) {
+        CircumnavigateFormationState *s = (CircumnavigateFormationState*)fc->circumnavigate_state;
+        if (checkpoint_restore_states((void**)&s->states, &s->num_states, &s->capacity,
+                                      data, count, sizeof(CircumnavigateState)) != 0) return -1;
+    }
+
+    data = checkpoint_find(view, CKPT_TAG_RETREAT, sizeof(RetreatState), &count);
+    if (data && fc->retreat_state) {
+        RetreatFormationState *s = (RetreatFormationState*)fc->retreat_state;
+        if (checkpoint_restore_states((void**)&s->states, &s->num_states, &s->capacity,
+                                      data, count, sizeof(RetreatState)) != 0) return -1;
+    }
+
+    // ===== 编队管理器：触发器按卫星ID对应，规则整体覆盖 =====
+    FormationManager *fm = engine->formation_manager;
+    const FormationTrigger *triggers = (const FormationTrigger*)checkpoint_find(
+        view, CKPT_TAG_TRIGGERS, sizeof(FormationTrigger), &count);
+    if (fm && triggers) {
+        for (size_t i = 0; i < count; i++) {
+            for (int k = 0; k < fm->num_satellites; k++) {
+                if (fm->triggers[k].sat_id == triggers[i].sat_id) {
+                    fm->triggers[k] = triggers[i];
+                    break;
+                }
+            }
+        }
+    }
+    const FormationTransitionRule *rules = (const FormationTransitionRule*)checkpoint_find(
+        view, CKPT_TAG_RULES, sizeof(FormationTransitionRule), &count);
+    if (fm && rules) {
+        int n_rules = (count > 50) ? 50 : (int)count;
+        memcpy(fm->transition_rules, rules, sizeof(FormationTransitionRule) * n_rules);
+        fm->num_rules = n_rules;
+    }
+
+    // ===== 相对运动链接：按ID重新绑定，外推器参数原样恢复 =====
+    const CheckpointRelativeLinkRecord *links = (const CheckpointRelativeLinkRecord*)checkpoint_find(
+        view, CKPT_TAG_RELLINKS, sizeof(CheckpointRelativeLinkRecord), &count);
+    for (size_t i = 0; links && i < count; i++) {
+        if (kinematics_engine_link_relative(engine, links[i].chief_id, links[i].deputy_id) != 0) continue;
+        Satellite *deputy = kinematics_engine_get_satellite(engine, links[i].deputy_id);
+        engine->relative_links[deputy->relative_link - 1].prop = links[i].prop;
+    }
+
+    return 0;
+}
+
+KinematicsEngine* kinematics_engine_load_checkpoint(const char *filename) {
+    if (!filename) return NULL;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "错误：无法打开检查点文件 %s\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CheckpointHeader)) {
+        fprintf(stderr, "错误：检查点文件无效 %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    void *map = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "错误：无法映射检查点文件 %s\n", filename);
+        return NULL;
+    }
+    // 建议值不能按位或，分两次提交；失败只影响预读，不影响恢复
+    if (madvise(map, file_size, MADV_SEQUENTIAL) != 0 ||
+        madvise(map, file_size, MADV_WILLNEED) != 0) {
+        fprintf(stderr, "警告：检查点文件预读建议失败 %s\n", filename);
+    }
+
+    // ===== 校验文件头和节表 =====
+    const CheckpointHeader *header = (const CheckpointHeader*)map;
+    CheckpointView view = {(const uint8_t*)map, NULL, 0};
+    KinematicsEngine *engine = NULL;
+
+    if (memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != CHECKPOINT_VERSION ||
+        header->file_size != file_size ||
+        header->num_sections > CHECKPOINT_MAX_SECTIONS ||
+        sizeof(CheckpointHeader) + sizeof(CheckpointSection) * CHECKPOINT_MAX_SECTIONS > file_size) {
+        fprintf(stderr, "错误：检查点格式或版本不匹配 %s\n", filename);
+        goto done;
+    }
+
+    view.sections = (const CheckpointSection*)(view.base + sizeof(CheckpointHeader));
+    view.num_sections = header->num_sections;
+    for (uint32_t i = 0; i < view.num_sections; i++) {
+        const CheckpointSection *sec = &view.sections[i];
+        if (sec->offset > file_size || sec->size > file_size - sec->offset) {
+            fprintf(stderr, "错误：检查点数据节越界 %s\n", filename);
+            goto done;
+        }
+    }
+
+    size_t count = 0;
+    const CheckpointEngineRecord *rec = (const CheckpointEngineRecord*)checkpoint_find(
+        &view, CKPT_TAG_ENGINE, sizeof(CheckpointEngineRecord), &count);
+    if (!rec || count != 1) {
+        fprintf(stderr, "错误：检查点缺少引擎数据 %s\n", filename);
+        goto done;
+    }
+
+    // ===== 按保存时的配置重建引擎，再覆盖运行时状态 =====
+    // 各节直接在映射上读取，只把记录拷入引擎自有的对象；返回前解除映射
+    SimulationConfig config = rec->config;
+    config.strategy = rec->strategy_thresholds;
+    engine = kinematics_engine_create(config);
+    if (!engine) goto done;
+
+    engine->dt_seconds = rec->dt_seconds;
+    engine->total_maneuvers = rec->total_maneuvers;
+    engine->total_fuel_consumed = rec->total_fuel_consumed;
+    engine->formation_count = rec->formation_count;
+    perturbation_model_enable(&engine->perturbations, PERTURB_ALL_BUILTIN, 0);
+    perturbation_model_enable(&engine->perturbations, rec->perturbation_flags, 1);
+    perturbation_model_set_srp(&engine->perturbations, rec->srp_cr, rec->srp_area_to_mass);
+    memcpy(engine->strategy, rec->strategy, sizeof(engine->strategy));
+    engine->strategy[sizeof(engine->strategy) - 1] = '\0';
+
+    engine->current_time = rec->current_time;
+    engine->step_count = rec->step_count;
+
+    if (checkpoint_restore_engine(engine, &view) != 0) {
+        fprintf(stderr, "错误：检查点恢复失败 %s\n", filename);
+        kinematics_engine_destroy(engine);
+        engine = NULL;
+        goto done;
+    }
+
+    memcpy(engine->clocks, rec->clocks, sizeof(engine->clocks));
+    engine->attitude_substeps = rec->attitude_substeps;
+
+    // 旧检查点没有RNG节，保留默认种子
+    const CheckpointRngRecord *rng_rec = (const CheckpointRngRecord*)checkpoint_find(
+        &view, CKPT_TAG_RNG, sizeof(CheckpointRngRecord), &count);
+    if (rng_rec && count == 1) {
+        engine->seed = rng_rec->seed;
+        engine->rng = rng_rec->rng;
+    }
+
+    SIM_LOG("[Checkpoint] ✓ 已恢复 %s (t=%.1f s, 步数=%u, %d颗卫星)\n",
+           filename, engine->current_time, engine->step_count, engine->satellite_count);
+
+done:
+    munmap(map, file_size);
+    return engine;
+}
@@ -0,0 +1,684 @@
+#define _DEFAULT_SOURCE
+
+#include <config/catalog.h>
+#include <satellite.h>
+#include <orbit.h>
+#include <history.h>
+#include <log.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CATALOG_KM          1000.0      // OEM 中的 km、km/s 换算为 m、m/s
+#define CATALOG_TLE_LEN     69          // TLE 行长（第69列为校验位）
+#define CATALOG_LINE_MAX    256         // OEM 星历行最大字符数
+#define CATALOG_R2D         (180.0 / PI)
+
+/* ==================== 文件映射 ==================== */
+
+typedef struct {
+    const char *data;
+    size_t size;
+} CatalogMapping;
+
+static int catalog_map(const char *path, CatalogMapping *map) {
+    memset(map, 0, sizeof(CatalogMapping));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "错误：无法打开编目文件 %s\n", path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        fprintf(stderr, "错误：编目文件 %s 为空或无法读取\n", path);
+        return -1;
+    }
+    // 各块由不同线程同时读，预先建立页表，避免工作线程在缺页上排队
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        fprintf(stderr, "错误：无法映射编目文件 %s\n", path);
+        return -1;
+    }
+    map->data = (const char*)p;
+    map->size = (size_t)st.st_size;
+    return 0;
+}
+
+static void catalog_unmap(CatalogMapping *map) {
+    if (map->data) munmap((void*)map->data, map->size);
+    memset(map, 0, sizeof(CatalogMapping));
+}
+
+/* ==================== 行与字段 ==================== */
+
+/* 映射内存中的一行（不含换行符） */
+typedef struct {
+    const char *p;
+    int len;
+} CatalogLine;
+
+/* 取出 p 起的一行，返回下一行起点 */
+static const char* catalog_line(const char *p, const char *end, CatalogLine *line) {
+    const char *nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+    const char *stop = nl ? nl : end;
+    line->p = p;
+    line->len = (int)(stop - p);
+    if (line->len > 0 && p[line->len - 1] == '\r') line->len--;
+    return nl ? nl + 1 : end;
+}
+
+static CatalogLine catalog_trim(CatalogLine line) {
+    while (line.len > 0 && (line.p[0] == ' ' || line.p[0] == '\t')) {
+        line.p++;
+        line.len--;
+    }
+    while (line.len > 0 && (line.p[line.len - 1] == ' ' || line.p[line.len - 1] == '\t')) line.len--;
+    return line;
+}
+
+static int catalog_starts_with(CatalogLine line, const char *word) {
+    size_t n = strlen(word);
+    return (size_t)line.len >= n && memcmp(line.p, word, n) == 0;
+}
+
+static int catalog_line_is(CatalogLine line, const char *word) {
+    line = catalog_trim(line);
+    return (size_t)line.len == strlen(word) && catalog_starts_with(line, word);
+}
+
+/* 把行内文本拷成以0结尾的字符串（超长截断） */
+static void catalog_copy(CatalogLine text, char *out, size_t size) {
+    size_t n = (size_t)text.len < size - 1 ? (size_t)text.len : size - 1;
+    memcpy(out, text.p, n);
+    out[n] = '\0';
+}
+
+/* 块起点对齐到行首：不在行首时前进到下一行 */
+static size_t catalog_align_line(const char *data, size_t size, size_t offset) {
+    if (offset == 0 || offset >= size || data[offset - 1] == '\n') return offset;
+    const char *nl = (const char*)memchr(data + offset, '\n', size - offset);
+    return nl ? (size_t)(nl - data) + 1 : size;
+}
+
+static const double CATALOG_POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+/**
+ * 定宽定点字段转数字（列号从1起，同TLE规范）：可带前后空格和符号，有效数字至多15位，
+ * 整数尾数除以10的幂只舍入一次，结果与 strtod 相同
+ * @param implied_point 字段前隐含小数点（TLE偏心率）
+ * @return 0 成功，字段越界、为空或含其他字符返回-1
+ */
+static int catalog_field(const CatalogLine *line, int col, int width, int implied_point, double *out) {
+    if (col - 1 + width > line->len) return -1;
+    const char *p = line->p + col - 1, *end = p + width;
+    while (p < end && *p == ' ') p++;
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0, scale = 0, point = implied_point;
+    for (; p < end && *p != ' '; p++) {
+        if (*p == '.' && !point) {
+            point = 1;
+            continue;
+        }
+        if (*p < '0' || *p > '9' || ++digits > 15) return -1;
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        scale += point;
+    }
+    while (p < end && *p == ' ') p++;
+    if (p != end || digits == 0) return -1;
+    double v = (double)mantissa / CATALOG_POW10[scale];
+    *out = negative ? -v : v;
+    return 0;
+}
+
+/* 儒略日：day 为年积日（1.0 = 1月1日0时），格里历 */
+static double catalog_julian_date(int year, double day) {
+    int y = year - 1;
+    return 1721424.5 + 365.0 * y + y / 4 - y / 100 + y / 400 + day;
+}
+
+static double catalog_wrap_degrees(double deg) {
+    deg = fmod(deg, 360.0);
+    return deg < 0 ? deg + 360.0 : deg;
+}
+
+/* ==================== 并行任务 ==================== */
+
+typedef enum {
+    CATALOG_PHASE_PARSE = 0,    // 解析并筛选
+    CATALOG_PHASE_ALIGN         // 推到共同历元并换算状态
+} CatalogPhase;
+
+struct CatalogJob;
+
+/* 一个切块：[begin, end) 为行首对齐后的字节范围，条目按文件顺序追加 */
+typedef struct {
+    const struct CatalogJob *job;
+    size_t begin, end;
+    CatalogEntry *entries;
+    int count, capacity;
+    int parsed, filtered, rejected;
+    int failed;                 // 内存不足
+} CatalogChunk;
+
+typedef struct CatalogJob {
+    const char *data;
+    size_t size;
+    CatalogFormat format;
+    const CatalogOptions *options;
+    CatalogPhase phase;
+    double epoch_jd;            // 对齐阶段的共同历元
+
+    CatalogChunk *chunks;
+    int num_chunks;
+    atomic_int next_chunk;      // 下一个待领取的块
+} CatalogJob;
+
+static CatalogEntry* catalog_chunk_push(CatalogChunk *chunk) {
+    if (chunk->count >= chunk->capacity) {
+        int grown = chunk->capacity ? chunk->capacity * 2 : 64;
+        CatalogEntry *entries = (CatalogEntry*)realloc(chunk->entries, sizeof(CatalogEntry) * grown);
+        if (!entries) {
+            chunk->failed = 1;
+            return NULL;
+        }
+        chunk->entries = entries;
+        chunk->capacity = grown;
+    }
+    CatalogEntry *entry = &chunk->entries[chunk->count++];
+    memset(entry, 0, sizeof(CatalogEntry));
+    return entry;
+}
+
+static int catalog_in_band(const CatalogOptions *options, double a) {
+    return options->a_max <= 0 || (a >= options->a_min && a <= options->a_max);
+}
+
+/* ==================== TLE ==================== */
+
+/* 模10校验：数字按值、'-' 记1，其余字符记0 */
+static int catalog_tle_checksum(const CatalogLine *line) {
+    int sum = 0;
+    for (int k = 0; k < CATALOG_TLE_LEN - 1; k++) {
+        unsigned d = (unsigned)(unsigned char)line->p[k] - '0';
+        sum += (d <= 9) ? (int)d : (line->p[k] == '-');
+    }
+    char check = line->p[CATALOG_TLE_LEN - 1];
+    return check >= '0' && check <= '9' && sum % 10 == check - '0';
+}
+
+/* 第3-7列卫星编号，首位可为 Alpha-5 字母（A=10 … Z=33，跳过 I、O），不合法返回-1 */
+static int catalog_tle_number(const CatalogLine *line) {
+    const char *s = line->p + 2;
+    int number;
+    if (s[0] >= '0' && s[0] <= '9') number = s[0] - '0';
+    else if (s[0] == ' ') number = 0;
+    else if (s[0] >= 'A' && s[0] <= 'Z' && s[0] != 'I' && s[0] != 'O') {
+        number = 10 + (s[0] - 'A') - (s[0] > 'I') - (s[0] > 'O');
+    } else return -1;
+    for (int k = 1; k < 5; k++) {
+        if (s[k] >= '0' && s[k] <= '9') number = number * 10 + (s[k] - '0');
+        else if (s[k] == ' ') number *= 10;
+        else return -1;
+    }
+    return number;
+}
+
+/* 第1行之前的名称行（3LE 的 "0 " 前缀去掉）；上一行是另一条TLE或不存在时为空 */
+static void catalog_tle_name(const char *data, const char *line1, char *name) {
+    name[0] = '\0';
+    if (line1 == data) return;
+    const char *end = line1 - 1;
+    if (end > data && end[-1] == '\r') end--;
+    const char *start = end;
+    while (start > data && start[-1] != '\n') start--;
+
+    CatalogLine line = { start, (int)(end - start) };
+    if (line.len >= 2 && (line.p[0] == '1' || line.p[0] == '2') && line.p[1] == ' ') return;
+    if (line.len >= 2 && line.p[0] == '0' && line.p[1] == ' ') {
+        line.p += 2;
+        line.len -= 2;
+    }
+    catalog_copy(catalog_trim(line), name, CATALOG_NAME_LEN);
+}
+
+static void catalog_tle_record(CatalogChunk *chunk, const CatalogLine *l1, const CatalogLine *l2) {
+    const CatalogOptions *options = chunk->job->options;
+    double mean_motion;
+    int id = (l1->len >= CATALOG_TLE_LEN && l2->len >= CATALOG_TLE_LEN) ? catalog_tle_number(l1) : -1;
+    if (id < 0 || id != catalog_tle_number(l2) ||
+        catalog_field(l2, 53, 11, 0, &mean_motion) != 0 || mean_motion <= 0) {
+        chunk->rejected++;
+        return;
+    }
+
+    // 先由平运动 (圈/天) 算半长轴做筛选，带外目标不再校验也不解析其余字段
+    double n = mean_motion * 2.0 * PI / SECONDS_PER_DAY;
+    double a = cbrt(MU_SI / (n * n));
+    if (!catalog_in_band(options, a)) {
+        chunk->parsed++;
+        chunk->filtered++;
+        return;
+    }
+
+    double year, day, inc, raan, ecc, argp, m;
+    if (!catalog_tle_checksum(l1) || !catalog_tle_checksum(l2) ||
+        catalog_field(l1, 19, 2, 0, &year) != 0 || catalog_field(l1, 21, 12, 0, &day) != 0 ||
+        catalog_field(l2, 9, 8, 0, &inc) != 0 || catalog_field(l2, 18, 8, 0, &raan) != 0 ||
+        catalog_field(l2, 27, 7, 1, &ecc) != 0 || catalog_field(l2, 35, 8, 0, &argp) != 0 ||
+        catalog_field(l2, 44, 8, 0, &m) != 0 || ecc >= 1.0) {
+        chunk->rejected++;
+        return;
+    }
+
+    CatalogEntry *entry = catalog_chunk_push(chunk);
+    if (!entry) return;
+    entry->id = id;
+    catalog_tle_name(chunk->job->data, l1->p, entry->name);
+    int y = (int)year;
+    entry->epoch_jd = catalog_julian_date(y < 57 ? 2000 + y : 1900 + y, day);
+    entry->elements = (OrbitalElements){ a, ecc, inc, raan, argp, m };
+    chunk->parsed++;
+}
+
+/* 处理第1行起点落在块内的记录，第2行可越过块尾 */
+static void catalog_parse_tle(CatalogChunk *chunk) {
+    const char *data = chunk->job->data;
+    const char *end = data + chunk->job->size;
+    const char *p = data + chunk->begin;
+    const char *stop = data + chunk->end;
+
+    while (p < stop) {
+        CatalogLine l1, l2;
+        const char *next = catalog_line(p, end, &l1);
+        if (l1.len < 2 || l1.p[0] != '1' || l1.p[1] != ' ') {
+            p = next;
+            continue;
+        }
+        const char *after = catalog_line(next, end, &l2);
+        if (l2.len < 2 || l2.p[0] != '2' || l2.p[1] != ' ') {
+            chunk->rejected++;
+            p = next;
+            continue;
+        }
+        catalog_tle_record(chunk, &l1, &l2);
+        p = after;
+    }
+}
+
+/* ==================== CCSDS OEM ==================== */
+
+/* "KEY = VALUE" 行：键匹配时取出去掉空白的值 */
+static int catalog_kvn(CatalogLine line, const char *key, CatalogLine *value) {
+    line = catalog_trim(line);
+    if (!catalog_starts_with(line, key)) return 0;
+    CatalogLine rest = { line.p + strlen(key), line.len - (int)strlen(key) };
+    rest = catalog_trim(rest);
+    if (rest.len == 0 || rest.p[0] != '=') return 0;
+    rest.p++;
+    rest.len--;
+    *value = catalog_trim(rest);
+    return 1;
+}
+
+/* 惯性参考系（地固系等旋转系不能直接当作二体初值） */
+static int catalog_inertial_frame(const char *frame) {
+    static const char *FRAMES[] = { "EME2000", "GCRF", "ICRF", "TEME", "TOD", "MOD" };
+    for (size_t k = 0; k < sizeof(FRAMES) / sizeof(FRAMES[0]); k++) {
+        if (strcmp(frame, FRAMES[k]) == 0) return 1;
+    }
+    return 0;
+}
+
+/* 历元 YYYY-MM-DDThh:mm:ss[.f] 或 YYYY-DDDThh:mm:ss[.f]，返回0成功 */
+static int catalog_oem_epoch(const char *text, double *jd) {
+    static const int DAYS_BEFORE[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+    int year, month, mday, doy, hour, minute;
+    double second;
+    if (sscanf(text, "%4d-%2d-%2dT%2d:%2d:%lf", &year, &month, &mday, &hour, &minute, &second) == 6) {
+        if (month < 1 || month > 12 || mday < 1 || mday > 31) return -1;
+        int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        doy = DAYS_BEFORE[month - 1] + mday + (month > 2 ? leap : 0);
+    } else if (sscanf(text, "%4d-%3dT%2d:%2d:%lf", &year, &doy, &hour, &minute, &second) != 5) {
+        return -1;
+    }
+    if (doy < 1 || doy > 366) return -1;
+    *jd = catalog_julian_date(year, doy + (hour * 3600.0 + minute * 60.0 + second) / SECONDS_PER_DAY);
+    return 0;
+}
+
+typedef struct {
+    char name[CATALOG_NAME_LEN];
+    char center[16];
+    char frame[16];
+    int id;
+} CatalogOemMeta;
+
+/* 星历行：历元 + x y z vx vy vz（其后的加速度列忽略） */
+static void catalog_oem_state(CatalogChunk *chunk, CatalogLine line, const CatalogOemMeta *meta) {
+    char buf[CATALOG_LINE_MAX];
+    double jd, v[6];
+    if (strcmp(meta->center, "EARTH") != 0 || !catalog_inertial_frame(meta->frame) ||
+        line.len >= CATALOG_LINE_MAX) {
+        chunk->rejected++;
+        return;
+    }
+    catalog_copy(line, buf, sizeof(buf));
+    char *s = buf;
+    while (*s && *s != ' ' && *s != '\t') s++;
+    if (*s) *s++ = '\0';
+    if (catalog_oem_epoch(buf, &jd) != 0) {
+        chunk->rejected++;
+        return;
+    }
+    for (int k = 0; k < 6; k++) {
+        char *endp;
+        v[k] = strtod(s, &endp);
+        if (endp == s || !isfinite(v[k])) {
+            chunk->rejected++;
+            return;
+        }
+        s = endp;
+    }
+
+    StateVector state = {
+        { v[0] * CATALOG_KM, v[1] * CATALOG_KM, v[2] * CATALOG_KM },
+        { v[3] * CATALOG_KM, v[4] * CATALOG_KM, v[5] * CATALOG_KM },
+        0.0
+    };
+    // 由能量直接得半长轴做筛选，带外与逃逸轨道不换算根数
+    double r = vector3_magnitude(state.position);
+    double energy = 0.5 * vector3_magnitude_squared(state.velocity) - MU_SI / r;
+    chunk->parsed++;
+    if (!(energy < 0) || !catalog_in_band(chunk->job->options, -MU_SI / (2.0 * energy))) {
+        chunk->filtered++;
+        return;
+    }
+
+    CatalogEntry *entry = catalog_chunk_push(chunk);
+    if (!entry) return;
+    if (orbit_state_to_elements(&state, &entry->elements) != 0) {
+        chunk->count--;
+        chunk->parsed--;
+        chunk->rejected++;
+        return;
+    }
+    entry->id = meta->id;
+    memcpy(entry->name, meta->name, sizeof(entry->name));
+    entry->epoch_jd = jd;
+    entry->state = state;
+}
+
+/* META 段：读元数据，取 META_STOP 之后的第一条星历；返回继续扫描的位置 */
+static const char* catalog_oem_segment(CatalogChunk *chunk, const char *p, const char *end) {
+    CatalogOemMeta meta;
+    CatalogLine line, value;
+    int closed = 0;
+    memset(&meta, 0, sizeof(meta));
+
+    while (p < end && !closed) {
+        p = catalog_line(p, end, &line);
+        if (catalog_line_is(line, "META_STOP")) {
+            closed = 1;
+        } else if (catalog_kvn(line, "OBJECT_NAME", &value)) {
+            catalog_copy(value, meta.name, sizeof(meta.name));
+        } else if (catalog_kvn(line, "OBJECT_ID", &value)) {
+            // NORAD编号为纯数字；国际编号 (1999-012A) 等留0，加入引擎时续编
+            int digits = value.len > 0 && value.len < 10;
+            for (int k = 0; k < value.len && digits; k++) digits = value.p[k] >= '0' && value.p[k] <= '9';
+            meta.id = digits ? (int)strtol(value.p, NULL, 10) : 0;
+        } else if (catalog_kvn(line, "CENTER_NAME", &value)) {
+            catalog_copy(value, meta.center, sizeof(meta.center));
+        } else if (catalog_kvn(line, "REF_FRAME", &value)) {
+            catalog_copy(value, meta.frame, sizeof(meta.frame));
+        }
+    }
+    if (!closed) {
+        chunk->rejected++;
+        return p;
+    }
+
+    while (p < end) {
+        const char *line_start = p;
+        p = catalog_line(p, end, &line);
+        CatalogLine text = catalog_trim(line);
+        if (text.len == 0 || catalog_starts_with(text, "COMMENT")) continue;
+        if (text.p[0] < '0' || text.p[0] > '9') {
+            // 段内没有星历（下一个 META_START 或协方差块），从该行继续扫描
+            chunk->rejected++;
+            return line_start;
+        }
+        catalog_oem_state(chunk, text, &meta);
+        return p;
+    }
+    chunk->rejected++;
+    return p;
+}
+
+/* 处理 META_START 起点落在块内的段，段内数据可越过块尾 */
+static void catalog_parse_oem(CatalogChunk *chunk) {
+    const char *data = chunk->job->data;
+    const char *end = data + chunk->job->size;
+    const char *p = data + chunk->begin;
+    const char *stop = data + chunk->end;
+
+    while (p < stop) {
+        CatalogLine line;
+        p = catalog_line(p, end, &line);
+        if (catalog_line_is(line, "META_START")) p = catalog_oem_segment(chunk, p, end);
+    }
+}
+
+/* ==================== 历元对齐 ==================== */
+
+/* 二体平运动推进平近点角；TLE 条目及推进过的条目由根数重算状态 */
+static void catalog_align_chunk(CatalogChunk *chunk) {
+    const CatalogJob *job = chunk->job;
+    for (int k = 0; k < chunk->count; k++) {
+        CatalogEntry *entry = &chunk->entries[k];
+        double dt = (job->epoch_jd - entry->epoch_jd) * SECONDS_PER_DAY;
+        if (dt != 0.0) {
+            double a = entry->elements.a;
+            double n = sqrt(MU_SI / (a * a * a));
+            entry->elements.m0 = catalog_wrap_degrees(entry->elements.m0 + n * dt * CATALOG_R2D);
+        }
+        if (dt != 0.0 || job->format == CATALOG_FORMAT_TLE) {
+            orbit_elements_to_state(&entry->elements, &entry->state);
+        }
+        entry->state.time = 0.0;
+        entry->epoch_jd = job->epoch_jd;
+    }
+}
+
+/* 工作线程：从原子计数器领取块，直到领完 */
+static void catalog_task(void *arg) {
+    CatalogJob *job = (CatalogJob*)arg;
+    for (;;) {
+        int k = atomic_fetch_add(&job->next_chunk, 1);
+        if (k >= job->num_chunks) break;
+        CatalogChunk *chunk = &job->chunks[k];
+        if (job->phase == CATALOG_PHASE_ALIGN) catalog_align_chunk(chunk);
+        else if (job->format == CATALOG_FORMAT_OEM) catalog_parse_oem(chunk);
+        else catalog_parse_tle(chunk);
+    }
+}
+
+static void catalog_run(CatalogJob *job, ThreadPool *pool, int workers) {
+    atomic_store(&job->next_chunk, 0);
+    if (pool) {
+        for (int t = 0; t < workers; t++) {
+            if (thread_pool_submit(pool, catalog_task, job) != 0) break;
+        }
+    }
+    // 调用线程也参与领取（无线程池或提交失败时由它处理全部块）
+    catalog_task(job);
+    if (pool) thread_pool_wait(pool);
+}
+
+/* ==================== 导入接口 ==================== */
+
+void catalog_default_options(CatalogOptions *options) {
+    if (!options) return;
+    memset(options, 0, sizeof(CatalogOptions));
+    options->a_min = CATALOG_GEO_A_MIN;
+    options->a_max = CATALOG_GEO_A_MAX;
+}
+
+static CatalogFormat catalog_detect_format(const CatalogMapping *map) {
+    const char *p = map->data, *end = map->data + map->size;
+    if (end - p >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    CatalogLine head = { p, (int)((end - p) < 64 ? (end - p) : 64) };
+    return catalog_starts_with(head, "CCSDS_OEM_VERS") ? CATALOG_FORMAT_OEM : CATALOG_FORMAT_TLE;
+}
+
+int catalog_load(const char *path, const CatalogOptions *options,
+                 CatalogEntry **entries_out, CatalogStats *stats) {
+    if (!path || !entries_out) return -1;
+    *entries_out = NULL;
+    if (stats) memset(stats, 0, sizeof(CatalogStats));
+
+    CatalogOptions opt;
+    if (options) opt = *options;
+    else catalog_default_options(&opt);
+
+    CatalogMapping map;
+    if (catalog_map(path, &map) != 0) return -1;
+
+    // ===== 切块：边界对齐到行首，相邻块首尾相接 =====
+    size_t chunk_size = opt.chunk_size > 0 ? opt.chunk_size : CATALOG_DEFAULT_CHUNK;
+    int num_chunks = (int)((map.size + chunk_size - 1) / chunk_size);
+    CatalogJob job;
+    memset(&job, 0, sizeof(job));
+    job.data = map.data;
+    job.size = map.size;
+    job.format = opt.format != CATALOG_FORMAT_AUTO ? opt.format : catalog_detect_format(&map);
+    job.options = &opt;
+    job.num_chunks = num_chunks;
+    job.chunks = (CatalogChunk*)calloc((size_t)num_chunks, sizeof(CatalogChunk));
+    if (!job.chunks) {
+        catalog_unmap(&map);
+        return -1;
+    }
+    for (int k = 0; k < num_chunks; k++) {
+        size_t begin = (size_t)k * chunk_size;
+        size_t end = (k + 1 < num_chunks) ? begin + chunk_size : map.size;
+        job.chunks[k].job = &job;
+        job.chunks[k].begin = catalog_align_line(map.data, map.size, begin);
+        job.chunks[k].end = catalog_align_line(map.data, map.size, end);
+    }
+
+    // 只有一块时不起线程
+    ThreadPool *pool = opt.pool;
+    int owned = 0;
+    if (!pool && num_chunks > 1) {
+        int threads = opt.num_threads > 0 ? opt.num_threads : thread_pool_cpu_count();
+        pool = thread_pool_create(threads < num_chunks ? threads : num_chunks);
+        owned = (pool != NULL);
+    }
+    int workers = pool ? (pool->num_threads < num_chunks ? pool->num_threads : num_chunks) : 0;
+
+    job.phase = CATALOG_PHASE_PARSE;
+    catalog_run(&job, pool, workers);
+
+    // ===== 共同历元：未指定时取最晚的记录历元，推进量最小 =====
+    job.epoch_jd = opt.epoch_jd;
+    if (job.epoch_jd <= 0) {
+        for (int k = 0; k < num_chunks; k++) {
+            for (int j = 0; j < job.chunks[k].count; j++) {
+                if (job.chunks[k].entries[j].epoch_jd > job.epoch_jd) job.epoch_jd = job.chunks[k].entries[j].epoch_jd;
+            }
+        }
+    }
+    job.phase = CATALOG_PHASE_ALIGN;
+    catalog_run(&job, pool, workers);
+    if (owned) thread_pool_destroy(pool);
+    catalog_unmap(&map);
+
+    // ===== 按块顺序合并，结果与线程数无关 =====
+    int total = 0, failed = 0;
+    CatalogStats sum = { 0, 0, 0, num_chunks };
+    for (int k = 0; k < num_chunks; k++) {
+        total += job.chunks[k].count;
+        failed |= job.chunks[k].failed;
+        sum.parsed += job.chunks[k].parsed;
+        sum.filtered += job.chunks[k].filtered;
+        sum.rejected += job.chunks[k].rejected;
+    }
+    CatalogEntry *entries = NULL;
+    if (!failed && total > 0) {
+        entries = (CatalogEntry*)malloc(sizeof(CatalogEntry) * total);
+        failed = (entries == NULL);
+    }
+    if (entries) {
+        CatalogEntry *out = entries;
+        for (int k = 0; k < num_chunks; k++) {
+            if (job.chunks[k].count == 0) continue;
+            memcpy(out, job.chunks[k].entries, sizeof(CatalogEntry) * job.chunks[k].count);
+            out += job.chunks[k].count;
+        }
+    }
+    for (int k = 0; k < num_chunks; k++) free(job.chunks[k].entries);
+    free(job.chunks);
+    if (failed) {
+        fprintf(stderr, "错误：读取编目文件 %s 时内存不足\n", path);
+        return -1;
+    }
+
+    if (stats) *stats = sum;
+    *entries_out = entries;
+    SIM_LOG("[Catalog] ✓ %s (%s)：%d 条记录，%d 条入选，筛除 %d 条，跳过 %d 条，%d 块 × %d 线程\n",
+            path, job.format == CATALOG_FORMAT_OEM ? "OEM" : "TLE", sum.parsed, total,
+            sum.filtered, sum.rejected, num_chunks, workers > 0 ? workers : 1);
+    return total;
+}
+
+int catalog_add_to_engine(KinematicsEngine *engine, const CatalogEntry *entries, int count,
+                          uint8_t team, uint8_t function_type, int history_capacity) {
+    if (!engine || (count > 0 && !entries) || team > 1 || function_type > FUNCTION_DEFENSE - FUNCTION_ATTACK) {
+        return -1;
+    }
+
+    // 续编号从现有卫星和编目中的最大ID之后开始，不会与后面的编目ID冲突
+    int next_id = 1;
+    for (int i = 0; i < engine->satellite_count; i++) {
+        if (engine->satellites[i]->id >= next_id) next_id = engine->satellites[i]->id + 1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (entries[i].id >= next_id) next_id = entries[i].id + 1;
+    }
+
+    int added = 0;
+    for (int i = 0; i < count; i++) {
+        const CatalogEntry *entry = &entries[i];
+        int id = entry->id;
+        if (id <= 0 || kinematics_engine_get_satellite(engine, id)) id = next_id++;
+        Satellite *sat = satellite_create_from_state(&engine->slab, id, team, 0, function_type,
+                                                     &entry->elements, &entry->state);
+        if (!sat) break;
+        if (kinematics_engine_add_satellite(engine, sat) < 0) {
+            satellite_destroy(sat);
+            break;
+        }
+        satellite_init_history(sat, history_capacity > 0 ? history_capacity : HISTORY_DEFAULT_CAPACITY);
+        added++;
+    }
+    SIM_LOG("[Catalog] ✓ %d 颗编目目标加入引擎（阵营 %d，功能 %d）\n", added, team, function_type);
+    return added;
+}
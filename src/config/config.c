@@ -1,41 +1,1065 @@
-#ifndef CONFIG_H
-#define CONFIG_H
+#define _DEFAULT_SOURCE
 
-#include <stdbool.h>
+#include <config/config.h>
+#include <simulation.h>
+#include <satellite.h>
+#include <orbit.h>
+#include <log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-// 团队属性结构体
+#define CONFIG_KM           1000.0      // 文件中的 km 换算为 m
+#define CONFIG_NUMBER_MAX   64          // 慢路径数字的最大字符数
+#define CONFIG_FUEL_DEFAULT 1000.0      // 未给出 fuel 时的初始燃料 (kg)，同 satellite_create
+
+/* ==================== 文件映射 ==================== */
+
+typedef struct {
+    const char *data;
+    size_t size;
+} ConfigMapping;
+
+static int config_map(const char *path, ConfigMapping *map) {
+    memset(map, 0, sizeof(ConfigMapping));
+    if (!path) return -1;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "错误：无法打开配置文件 %s\n", path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        fprintf(stderr, "错误：配置文件 %s 为空或无法读取\n", path);
+        return -1;
+    }
+    // 整个文件都要顺序读一遍，预先建立页表，省去逐页缺页中断
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        fprintf(stderr, "错误：无法映射配置文件 %s\n", path);
+        return -1;
+    }
+    posix_madvise(p, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    map->data = (const char*)p;
+    map->size = (size_t)st.st_size;
+    return 0;
+}
+
+static void config_unmap(ConfigMapping *map) {
+    if (map->data) munmap((void*)map->data, map->size);
+    memset(map, 0, sizeof(ConfigMapping));
+}
+
+/* ==================== JSON 单遍解析 ==================== */
+
+/* 游标直接走映射内存；字符串以 (指针,长度) 返回，不拷贝也不解码转义 */
+typedef struct {
+    const char *p;
+    const char *end;
+    const char *begin;
+    const char *error;      // 首个语法错误，NULL 表示无错
+} JsonCursor;
+
+#define JSON_KEY(key, len, lit)  ((len) == sizeof(lit) - 1 && memcmp((key), (lit), sizeof(lit) - 1) == 0)
+#define JSON_IS_DIGIT(ch)        ((unsigned)((ch) - '0') <= 9u)
+
+/* 10^0..10^22 均可精确表示为 double */
+static const double JSON_POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static int json_fail(JsonCursor *c, const char *what) {
+    if (!c->error) c->error = what;
+    return -1;
+}
+
+static inline int json_peek(JsonCursor *c) {
+    const char *p = c->p;
+    while (p < c->end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    c->p = p;
+    return p < c->end ? (unsigned char)*p : -1;
+}
+
+static int json_string(JsonCursor *c, const char **s, size_t *len) {
+    if (json_peek(c) != '"') return json_fail(c, "应为字符串");
+    const char *start = ++c->p;
+    const char *p = start;
+    // memchr 找引号，再数前面连续的反斜杠：偶数个才是字符串结尾
+    while (p < c->end && (p = (const char*)memchr(p, '"', (size_t)(c->end - p))) != NULL) {
+        const char *q = p;
+        while (q > start && q[-1] == '\\') q--;
+        if (((p - q) & 1) == 0) {
+            *s = start;
+            *len = (size_t)(p - start);
+            c->p = p + 1;
+            return 0;
+        }
+        p++;
+    }
+    c->p = c->end;
+    return json_fail(c, "字符串未结束");
+}
+
+/* 快速路径：有效数字不超过 2^53 且十进制指数在 ±22 内时，一次乘除即正确舍入；
+   其余交给 strtod */
+static int json_number(JsonCursor *c, double *out) {
+    json_peek(c);
+    const char *start = c->p, *p = start, *end = c->end;
+    int negative = 0;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    if (p >= end || !JSON_IS_DIGIT(*p)) return json_fail(c, "应为数字");
+
+    uint64_t mantissa = 0;
+    int digits = 0, exp10 = 0, exact = 1;
+    for (; p < end && JSON_IS_DIGIT(*p); p++) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digits += (mantissa != 0);
+        } else {
+            exp10++;
+            exact &= (*p == '0');
+        }
+    }
+    if (p < end && *p == '.') {
+        p++;
+        if (p >= end || !JSON_IS_DIGIT(*p)) {
+            c->p = p;
+            return json_fail(c, "小数点后应为数字");
+        }
+        for (; p < end && JSON_IS_DIGIT(*p); p++) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                digits += (mantissa != 0);
+                exp10--;
+            } else {
+                exact &= (*p == '0');
+            }
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exp_negative = 0;
+        if (p < end && (*p == '+' || *p == '-')) exp_negative = (*p++ == '-');
+        if (p >= end || !JSON_IS_DIGIT(*p)) {
+            c->p = p;
+            return json_fail(c, "指数应为数字");
+        }
+        int e = 0;
+        for (; p < end && JSON_IS_DIGIT(*p); p++) {
+            if (e < 100000) e = e * 10 + (*p - '0');
+        }
+        exp10 += exp_negative ? -e : e;
+    }
+    c->p = p;
+
+    if (exact && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+        double v = (double)mantissa;
+        v = (exp10 < 0) ? v / JSON_POW10[-exp10] : v * JSON_POW10[exp10];
+        *out = negative ? -v : v;
+        return 0;
+    }
+
+    char buffer[CONFIG_NUMBER_MAX];
+    size_t len = (size_t)(p - start);
+    if (len >= sizeof(buffer)) return json_fail(c, "数字过长");
+    memcpy(buffer, start, len);
+    buffer[len] = '\0';
+    *out = strtod(buffer, NULL);
+    return 0;
+}
+
+static int json_literal(JsonCursor *c, const char *word, size_t len) {
+    if ((size_t)(c->end - c->p) < len || memcmp(c->p, word, len) != 0) return json_fail(c, "无法识别的值");
+    c->p += len;
+    return 0;
+}
+
+/* 跳过任意值；对象和数组只按括号深度扫描，不逐项解析 */
+static int json_skip_value(JsonCursor *c) {
+    const char *s;
+    size_t len;
+    int ch = json_peek(c);
+    switch (ch) {
+    case '"':
+        return json_string(c, &s, &len);
+    case 't':
+        return json_literal(c, "true", 4);
+    case 'f':
+        return json_literal(c, "false", 5);
+    case 'n':
+        return json_literal(c, "null", 4);
+    case '{':
+    case '[': {
+        int depth = 0;
+        const char *p = c->p;
+        while (p < c->end) {
+            char x = *p;
+            if (x == '"') {
+                c->p = p;
+                if (json_string(c, &s, &len) != 0) return -1;
+                p = c->p;
+                continue;
+            }
+            if (x == '{' || x == '[') {
+                depth++;
+            } else if ((x == '}' || x == ']') && --depth == 0) {
+                c->p = p + 1;
+                return 0;
+            }
+            p++;
+        }
+        c->p = p;
+        return json_fail(c, "括号不匹配");
+    }
+    default: {
+        double v;
+        return json_number(c, &v);
+    }
+    }
+}
+
+static int json_object_begin(JsonCursor *c) {
+    if (json_peek(c) != '{') return json_fail(c, "应为对象");
+    c->p++;
+    return 0;
+}
+
+/**
+ * 取对象的下一个成员，返回时游标位于值之前
+ * @param index 已读成员数（首次传0）
+ * @return 1 有成员，0 对象结束，-1 语法错误
+ */
+static int json_object_next(JsonCursor *c, int *index, const char **key, size_t *len) {
+    int ch = json_peek(c);
+    if (ch == '}') {
+        c->p++;
+        return 0;
+    }
+    if ((*index)++ > 0) {
+        if (ch != ',') return json_fail(c, "成员之间应为逗号");
+        c->p++;
+    }
+    if (json_string(c, key, len) != 0) return -1;
+    if (json_peek(c) != ':') return json_fail(c, "键后应为冒号");
+    c->p++;
+    return 1;
+}
+
+static int json_array_begin(JsonCursor *c) {
+    if (json_peek(c) != '[') return json_fail(c, "应为数组");
+    c->p++;
+    return 0;
+}
+
+/* 同 json_object_next：1 有元素，0 数组结束，-1 语法错误 */
+static int json_array_next(JsonCursor *c, int *index) {
+    int ch = json_peek(c);
+    if (ch == ']') {
+        c->p++;
+        return 0;
+    }
+    if ((*index)++ > 0) {
+        if (ch != ',') return json_fail(c, "元素之间应为逗号");
+        c->p++;
+    }
+    return 1;
+}
+
+static void json_report(const JsonCursor *c, const char *path) {
+    int line = 1;
+    for (const char *p = c->begin; p < c->p; p++) line += (*p == '\n');
+    fprintf(stderr, "错误：配置文件 %s 第 %d 行：%s\n", path, line, c->error ? c->error : "格式错误");
+}
+
+/* ==================== 场景文档 ==================== */
+
+/* 一颗卫星的解析结果（a 已换算为m，function_type 已换为内部编号 0..2） */
 typedef struct {
-    int attack;
-    int recon;
-    int defense;
-} TeamConfig;
+    OrbitalElements elements;
+    double fuel;
+    int id;
+    uint8_t team;
+    uint8_t function_type;
+} ConfigSatelliteRecord;
 
-// 模拟配置结构体
+/* 单遍遍历的结果：各段可能以任意次序出现，satellites 数组先解析为紧凑记录，
+   全文读完、仿真参数确定后再据此建卫星；二进制场景则保持映射，卫星直接取自各列 */
 typedef struct {
-    int max_time;
-    int time_step;
-} SimulationConfig;
+    const char *path;
+    ConfigMapping map;
+    const ScenarioHeader *binary;       // 非NULL 表示二进制场景
+    SimulationConfig config;
+    Config scenario;
+    int has_counts;                     // 出现 red/blue
+    int want_satellites;                // 0 时 satellites 数组整体跳过
+    int has_satellites;
+    ConfigSatelliteRecord *satellites;
+    int satellite_count;
+    int satellite_capacity;
+    double max_rate;                    // attitude_parameters，0 表示未给出
+    double max_accel;
+} ConfigDocument;
+
+static int config_parse_simulation(JsonCursor *c, ConfigDocument *doc) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    double v;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        if (JSON_KEY(key, len, "time_step")) {
+            if (json_number(c, &v) != 0) return -1;
+            doc->config.time_step = v;
+            doc->scenario.time_step = v;
+        } else if (JSON_KEY(key, len, "max_steps")) {
+            if (json_number(c, &v) != 0) return -1;
+            doc->config.max_steps = (uint32_t)v;
+        } else if (JSON_KEY(key, len, "save_interval")) {
+            if (json_number(c, &v) != 0) return -1;
+            doc->config.save_interval = (uint32_t)v;
+        } else if (JSON_KEY(key, len, "attitude_time_step")) {
+            if (json_number(c, &doc->config.attitude_time_step) != 0) return -1;
+        } else if (JSON_KEY(key, len, "control_interval")) {
+            if (json_number(c, &doc->config.control_interval) != 0) return -1;
+        } else if (JSON_KEY(key, len, "decision_interval")) {
+            if (json_number(c, &doc->config.decision_interval) != 0) return -1;
+        } else if (JSON_KEY(key, len, "epoch_jd")) {
+            if (json_number(c, &doc->config.epoch_jd) != 0) return -1;
+        } else if (JSON_KEY(key, len, "slew_cost_weight")) {
+            if (json_number(c, &doc->config.slew_cost_weight) != 0) return -1;
+        } else if (JSON_KEY(key, len, "max_time")) {
+            if (json_number(c, &doc->scenario.max_time) != 0) return -1;
+        } else if (json_skip_value(c) != 0) {
+            return -1;
+        }
+    }
+    return r;
+}
+
+static int config_parse_thresholds(JsonCursor *c, StrategyThresholds *t) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    double v;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        int *field = JSON_KEY(key, len, "attack_distance")   ? &t->attack_distance
+                   : JSON_KEY(key, len, "inspect_distance")  ? &t->inspect_distance
+                   : JSON_KEY(key, len, "defense_distance")  ? &t->defense_distance
+                   : JSON_KEY(key, len, "critical_distance") ? &t->critical_distance
+                   : JSON_KEY(key, len, "warning_distance")  ? &t->warning_distance : NULL;
+        if (!field) {
+            if (json_skip_value(c) != 0) return -1;
+            continue;
+        }
+        if (json_number(c, &v) != 0) return -1;
+        *field = (int)lround(v);
+    }
+    return r;
+}
+
+static int config_parse_formation(JsonCursor *c, SimulationConfig *config) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    double v;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        double *field = JSON_KEY(key, len, "lambert_target_distance") ? &config->lambert_target_distance
+                      : JSON_KEY(key, len, "lambert_max_delta_v")     ? &config->lambert_max_delta_v
+                      : JSON_KEY(key, len, "ellipse_min_distance")    ? &config->ellipse_min_distance
+                      : JSON_KEY(key, len, "ellipse_max_distance")    ? &config->ellipse_max_distance : NULL;
+        if (!field) {
+            if (json_skip_value(c) != 0) return -1;
+            continue;
+        }
+        if (json_number(c, &v) != 0) return -1;
+        *field = v * CONFIG_KM;
+    }
+    return r;
+}
+
+/* control_kp / control_kd 为姿态控制器的编译期常数，此处不读 */
+static int config_parse_attitude(JsonCursor *c, ConfigDocument *doc) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        if (JSON_KEY(key, len, "max_angular_rate")) {
+            if (json_number(c, &doc->max_rate) != 0) return -1;
+        } else if (JSON_KEY(key, len, "max_angular_accel")) {
+            if (json_number(c, &doc->max_accel) != 0) return -1;
+        } else if (json_skip_value(c) != 0) {
+            return -1;
+        }
+    }
+    return r;
+}
+
+static int config_parse_team(JsonCursor *c, int *attack, int *recon, int *defense) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    double v;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        int *field = JSON_KEY(key, len, "attack")  ? attack
+                   : JSON_KEY(key, len, "recon")   ? recon
+                   : JSON_KEY(key, len, "defense") ? defense : NULL;
+        if (!field) {
+            if (json_skip_value(c) != 0) return -1;
+            continue;
+        }
+        if (json_number(c, &v) != 0) return -1;
+        if (v < 0) return json_fail(c, "卫星数量不能为负");
+        *field = (int)v;
+    }
+    return r;
+}
+
+/* 键按长度和首字母分派，省去逐个 memcmp */
+static int config_parse_satellite(JsonCursor *c, ConfigSatelliteRecord *rec, int *team, int *function_type) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    double v;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        double *field = NULL;
+        int *integer = NULL;
+        switch (len) {
+        case 1:
+            field = key[0] == 'a' ? &rec->elements.a
+                  : key[0] == 'e' ? &rec->elements.e
+                  : key[0] == 'i' ? &rec->elements.i : NULL;
+            break;
+        case 2:
+            if (key[0] == 'i' && key[1] == 'd') integer = &rec->id;
+            else if (key[0] == 'm' && key[1] == '0') field = &rec->elements.m0;
+            break;
+        case 4:
+            if (JSON_KEY(key, len, "type")) integer = team;
+            else if (JSON_KEY(key, len, "fuel")) field = &rec->fuel;
+            break;
+        case 9:
+            if (JSON_KEY(key, len, "omega_big")) field = &rec->elements.omega_big;
+            break;
+        case 11:
+            if (JSON_KEY(key, len, "omega_small")) field = &rec->elements.omega_small;
+            break;
+        case 13:
+            if (JSON_KEY(key, len, "function_type")) integer = function_type;
+            break;
+        default:
+            break;
+        }
+        if (field) {
+            if (json_number(c, field) != 0) return -1;
+        } else if (integer) {
+            if (json_number(c, &v) != 0) return -1;
+            *integer = (int)v;
+        } else if (json_skip_value(c) != 0) {
+            return -1;
+        }
+    }
+    return r;
+}
+
+static int config_parse_satellites(JsonCursor *c, ConfigDocument *doc) {
+    int index = 0, r;
+    doc->satellite_count = 0;
+    if (json_array_begin(c) != 0) return -1;
+    while ((r = json_array_next(c, &index)) > 0) {
+        if (doc->satellite_count >= doc->satellite_capacity) {
+            int capacity = doc->satellite_capacity ? doc->satellite_capacity * 2 : 256;
+            ConfigSatelliteRecord *grown = (ConfigSatelliteRecord*)realloc(
+                doc->satellites, sizeof(ConfigSatelliteRecord) * capacity);
+            if (!grown) {
+                fprintf(stderr, "错误：卫星记录内存分配失败\n");
+                return -1;
+            }
+            doc->satellites = grown;
+            doc->satellite_capacity = capacity;
+        }
+        ConfigSatelliteRecord *rec = &doc->satellites[doc->satellite_count];
+        int team = 0, function_type = FUNCTION_ATTACK;
+        memset(rec, 0, sizeof(ConfigSatelliteRecord));
+        rec->id = -1;
+        rec->fuel = CONFIG_FUEL_DEFAULT;
+        if (config_parse_satellite(c, rec, &team, &function_type) != 0) return -1;
+
+        const OrbitalElements *el = &rec->elements;
+        if (rec->id < 0 || (team != 0 && team != 1) ||
+            function_type < FUNCTION_ATTACK || function_type > FUNCTION_DEFENSE ||
+            !(el->a > 0) || !(el->e >= 0 && el->e < 1) || !(rec->fuel >= 0)) {
+            fprintf(stderr, "错误：配置文件 %s 第 %d 颗卫星 (id=%d) 参数无效\n", doc->path, index, rec->id);
+            return -1;
+        }
+        rec->elements.a *= CONFIG_KM;
+        rec->team = (uint8_t)team;
+        rec->function_type = (uint8_t)(function_type - FUNCTION_ATTACK);
+        doc->satellite_count++;
+    }
+    return r;
+}
+
+static int config_parse_document(JsonCursor *c, ConfigDocument *doc) {
+    const char *key;
+    size_t len;
+    int index = 0, r;
+    if (json_object_begin(c) != 0) return -1;
+    while ((r = json_object_next(c, &index, &key, &len)) > 0) {
+        int status;
+        if (JSON_KEY(key, len, "simulation")) {
+            status = config_parse_simulation(c, doc);
+        } else if (JSON_KEY(key, len, "satellites")) {
+            doc->has_satellites = 1;
+            status = doc->want_satellites ? config_parse_satellites(c, doc) : json_skip_value(c);
+        } else if (JSON_KEY(key, len, "strategy_thresholds")) {
+            status = config_parse_thresholds(c, &doc->config.strategy);
+        } else if (JSON_KEY(key, len, "formation_parameters")) {
+            status = config_parse_formation(c, &doc->config);
+        } else if (JSON_KEY(key, len, "attitude_parameters")) {
+            status = config_parse_attitude(c, doc);
+        } else if (JSON_KEY(key, len, "red")) {
+            doc->has_counts = 1;
+            status = config_parse_team(c, &doc->scenario.red_attack, &doc->scenario.red_recon,
+                                       &doc->scenario.red_defense);
+        } else if (JSON_KEY(key, len, "blue")) {
+            doc->has_counts = 1;
+            status = config_parse_team(c, &doc->scenario.blue_attack, &doc->scenario.blue_recon,
+                                       &doc->scenario.blue_defense);
+        } else if (JSON_KEY(key, len, "strategy")) {
+            const char *s;
+            size_t n;
+            status = json_string(c, &s, &n);
+            if (status == 0) {
+                if (n >= sizeof(doc->scenario.strategy)) n = sizeof(doc->scenario.strategy) - 1;
+                memcpy(doc->scenario.strategy, s, n);
+                doc->scenario.strategy[n] = '\0';
+            }
+        } else {
+            status = json_skip_value(c);
+        }
+        if (status != 0) return -1;
+    }
+    if (r == 0 && json_peek(c) != -1) return json_fail(c, "顶层对象之后有多余内容");
+    return r;
+}
+
+/* ==================== 二进制场景 ==================== */
+
+/* 各列元素大小，下标为 ScenarioColumn */
+static const uint32_t SCENARIO_COLUMN_SIZE[SCENARIO_COL_COUNT] = {
+    sizeof(int32_t), sizeof(uint8_t), sizeof(uint8_t),
+    sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(double),
+    sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(double),
+    sizeof(double)
+};
+
+#define SCENARIO_COLUMN(header, col, type) \
+    ((const type*)((const char*)(header) + (header)->columns[col]))
+
+static uint64_t scenario_align(uint64_t offset) {
+    return (offset + SCENARIO_ALIGN - 1) & ~(uint64_t)(SCENARIO_ALIGN - 1);
+}
+
+/* 仿真参数在 SimulationConfig 中的位置和类型，下标为 ScenarioParam */
+enum { SCENARIO_FIELD_DOUBLE, SCENARIO_FIELD_U32, SCENARIO_FIELD_INT };
 
-// 主配置结构体
 typedef struct {
-    TeamConfig red;
-    TeamConfig blue;
-    char strategy[50];
-    SimulationConfig simulation;
-} GameConfig;
-
-// 函数声明
-bool config_init(const char* config_path);
-void config_cleanup(void);
-const GameConfig* config_get(void);
-
-// 便捷访问函数
-const TeamConfig* config_get_red(void);
-const TeamConfig* config_get_blue(void);
-const char* config_get_strategy(void);
-const SimulationConfig* config_get_simulation(void);
-
-// 调试函数
-void config_print(void);
-
-#endif // CONFIG_H
\ No newline at end of file
+    size_t offset;
+    int kind;
+} ScenarioParamField;
+
+#define SCENARIO_FIELD(member, kind) { offsetof(SimulationConfig, member), SCENARIO_FIELD_##kind }
+
+static const ScenarioParamField SCENARIO_PARAM_FIELDS[SCENARIO_PARAM_COUNT] = {
+    [SCENARIO_PARAM_TIME_STEP]               = SCENARIO_FIELD(time_step, DOUBLE),
+    [SCENARIO_PARAM_MAX_STEPS]               = SCENARIO_FIELD(max_steps, U32),
+    [SCENARIO_PARAM_SAVE_INTERVAL]           = SCENARIO_FIELD(save_interval, U32),
+    [SCENARIO_PARAM_ATTITUDE_TIME_STEP]      = SCENARIO_FIELD(attitude_time_step, DOUBLE),
+    [SCENARIO_PARAM_CONTROL_INTERVAL]        = SCENARIO_FIELD(control_interval, DOUBLE),
+    [SCENARIO_PARAM_DECISION_INTERVAL]       = SCENARIO_FIELD(decision_interval, DOUBLE),
+    [SCENARIO_PARAM_HOHMANN_PRECISION]       = SCENARIO_FIELD(hohmann_precision, DOUBLE),
+    [SCENARIO_PARAM_LAMBERT_MAX_ITERATIONS]  = SCENARIO_FIELD(lambert_max_iterations, U32),
+    [SCENARIO_PARAM_LAMBERT_CONVERGENCE]     = SCENARIO_FIELD(lambert_convergence, DOUBLE),
+    [SCENARIO_PARAM_LAMBERT_TARGET_DISTANCE] = SCENARIO_FIELD(lambert_target_distance, DOUBLE),
+    [SCENARIO_PARAM_LAMBERT_MAX_DELTA_V]     = SCENARIO_FIELD(lambert_max_delta_v, DOUBLE),
+    [SCENARIO_PARAM_ELLIPSE_MIN_DISTANCE]    = SCENARIO_FIELD(ellipse_min_distance, DOUBLE),
+    [SCENARIO_PARAM_ELLIPSE_MAX_DISTANCE]    = SCENARIO_FIELD(ellipse_max_distance, DOUBLE),
+    [SCENARIO_PARAM_ATTACK_DISTANCE]         = SCENARIO_FIELD(strategy.attack_distance, INT),
+    [SCENARIO_PARAM_INSPECT_DISTANCE]        = SCENARIO_FIELD(strategy.inspect_distance, INT),
+    [SCENARIO_PARAM_DEFENSE_DISTANCE]        = SCENARIO_FIELD(strategy.defense_distance, INT),
+    [SCENARIO_PARAM_CRITICAL_DISTANCE]       = SCENARIO_FIELD(strategy.critical_distance, INT),
+    [SCENARIO_PARAM_WARNING_DISTANCE]        = SCENARIO_FIELD(strategy.warning_distance, INT),
+    [SCENARIO_PARAM_SLEW_COST_WEIGHT]        = SCENARIO_FIELD(slew_cost_weight, DOUBLE),
+    [SCENARIO_PARAM_PERTURBATION_FLAGS]      = SCENARIO_FIELD(perturbation_flags, U32),
+    [SCENARIO_PARAM_EPOCH_JD]                = SCENARIO_FIELD(epoch_jd, DOUBLE),
+};
+
+static void scenario_store_params(const SimulationConfig *config, double *params) {
+    for (int k = 0; k < SCENARIO_PARAM_COUNT; k++) {
+        const char *field = (const char*)config + SCENARIO_PARAM_FIELDS[k].offset;
+        switch (SCENARIO_PARAM_FIELDS[k].kind) {
+            case SCENARIO_FIELD_U32: params[k] = *(const uint32_t*)field; break;
+            case SCENARIO_FIELD_INT: params[k] = *(const int*)field; break;
+            default:                 params[k] = *(const double*)field; break;
+        }
+    }
+}
+
+/* 整数项须为范围内的整数，否则文件已损坏；失败时 config 不变 */
+static int scenario_load_params(const double *params, SimulationConfig *config) {
+    for (int k = 0; k < SCENARIO_PARAM_COUNT; k++) {
+        double v = params[k];
+        int kind = SCENARIO_PARAM_FIELDS[k].kind;
+        if ((kind == SCENARIO_FIELD_U32 && !(v >= 0 && v <= UINT32_MAX && v == floor(v))) ||
+            (kind == SCENARIO_FIELD_INT && !(v >= INT32_MIN && v <= INT32_MAX && v == floor(v)))) {
+            return -1;
+        }
+    }
+    for (int k = 0; k < SCENARIO_PARAM_COUNT; k++) {
+        char *field = (char*)config + SCENARIO_PARAM_FIELDS[k].offset;
+        switch (SCENARIO_PARAM_FIELDS[k].kind) {
+            case SCENARIO_FIELD_U32: *(uint32_t*)field = (uint32_t)params[k]; break;
+            case SCENARIO_FIELD_INT: *(int*)field = (int)params[k]; break;
+            default:                 *(double*)field = params[k]; break;
+        }
+    }
+    return 0;
+}
+
+/* 校验文件头和各列范围，通过后参数写入 doc，映射交给 doc 持有 */
+static int config_read_binary(ConfigDocument *doc, ConfigMapping *map) {
+    const ScenarioHeader *header = (const ScenarioHeader*)map->data;
+    if (map->size < sizeof(ScenarioHeader) ||
+        header->version != SCENARIO_VERSION ||
+        header->header_size != sizeof(ScenarioHeader) ||
+        header->file_size != map->size ||
+        header->satellite_count < 0) {
+        fprintf(stderr, "错误：二进制场景格式或版本不匹配 %s\n", doc->path);
+        return -1;
+    }
+    for (int col = 0; col < SCENARIO_COL_COUNT; col++) {
+        uint64_t offset = header->columns[col];
+        uint64_t bytes = (uint64_t)header->satellite_count * SCENARIO_COLUMN_SIZE[col];
+        if (offset < sizeof(ScenarioHeader) || offset % SCENARIO_ALIGN != 0 ||
+            offset > map->size || bytes > map->size - offset) {
+            fprintf(stderr, "错误：二进制场景数据列越界 %s\n", doc->path);
+            return -1;
+        }
+    }
+
+    // 逐项覆盖，kernel_isa 仍取调用方的
+    if (scenario_load_params(header->params, &doc->config) != 0) {
+        fprintf(stderr, "错误：二进制场景仿真参数无效 %s\n", doc->path);
+        return -1;
+    }
+    memcpy(doc->scenario.strategy, header->strategy, sizeof(doc->scenario.strategy));
+    doc->scenario.strategy[sizeof(doc->scenario.strategy) - 1] = '\0';
+    doc->scenario.time_step = doc->config.time_step;
+    doc->max_rate = header->max_rate;
+    doc->max_accel = header->max_accel;
+    doc->has_satellites = 1;
+    doc->satellite_count = header->satellite_count;
+    doc->binary = header;
+    doc->map = *map;
+    return 0;
+}
+
+static int config_satellite_id(const ConfigDocument *doc, int i) {
+    return doc->binary ? SCENARIO_COLUMN(doc->binary, SCENARIO_COL_ID, int32_t)[i] : doc->satellites[i].id;
+}
+
+static int config_compare_ids(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/* 卫星ID须唯一：排序后比较相邻项（JSON 和二进制场景同一检查，建星前只做一次） */
+static int config_check_unique_ids(const ConfigDocument *doc) {
+    const int n = doc->satellite_count;
+    if (n < 2) return 0;
+    int *ids = (int*)malloc(sizeof(int) * n);
+    if (!ids) return -1;
+    for (int i = 0; i < n; i++) ids[i] = config_satellite_id(doc, i);
+    qsort(ids, n, sizeof(int), config_compare_ids);
+    int status = 0;
+    for (int i = 1; i < n; i++) {
+        if (ids[i] == ids[i - 1]) {
+            fprintf(stderr, "错误：配置文件 %s 中卫星ID %d 重复\n", doc->path, ids[i]);
+            status = -1;
+            break;
+        }
+    }
+    free(ids);
+    return status;
+}
+
+static void config_document_free(ConfigDocument *doc);
+
+/* 映射并读取：JSON 单遍解析后解除映射，二进制场景保持映射；要建星时检查ID唯一。失败时已报错、已释放 */
+static int config_read_document(const char *path, ConfigDocument *doc) {
+    ConfigMapping map;
+    if (config_map(path, &map) != 0) return -1;
+    int status;
+    if (map.size >= sizeof(SCENARIO_MAGIC) && memcmp(map.data, SCENARIO_MAGIC, sizeof(SCENARIO_MAGIC)) == 0) {
+        status = config_read_binary(doc, &map);
+        if (status != 0) config_unmap(&map);
+    } else {
+        JsonCursor c = { map.data, map.data + map.size, map.data, NULL };
+        status = config_parse_document(&c, doc);
+        if (status != 0 && c.error) json_report(&c, path);
+        config_unmap(&map);
+    }
+    if (status == 0 && doc->want_satellites) status = config_check_unique_ids(doc);
+    if (status != 0) config_document_free(doc);
+    return status;
+}
+
+static void config_document_free(ConfigDocument *doc) {
+    free(doc->satellites);
+    doc->satellites = NULL;
+    config_unmap(&doc->map);
+    doc->binary = NULL;
+}
+
+/* ==================== 建卫星 ==================== */
+
+/* 第 i 颗卫星：JSON 记录按根数换算，二进制场景直接取已换算的状态 */
+static Satellite* config_build_satellite(SlabAllocator *allocator, const ConfigDocument *doc, int i) {
+    Satellite *sat;
+    double fuel;
+    if (doc->binary) {
+        const ScenarioHeader *h = doc->binary;
+        uint8_t team = SCENARIO_COLUMN(h, SCENARIO_COL_TEAM, uint8_t)[i];
+        uint8_t function_type = SCENARIO_COLUMN(h, SCENARIO_COL_FUNCTION, uint8_t)[i];
+        if (team > 1 || function_type > FUNCTION_DEFENSE - FUNCTION_ATTACK) {
+            fprintf(stderr, "错误：二进制场景第 %d 颗卫星阵营或功能无效\n", i + 1);
+            return NULL;
+        }
+        OrbitalElements el = {
+            SCENARIO_COLUMN(h, SCENARIO_COL_A, double)[i],    SCENARIO_COLUMN(h, SCENARIO_COL_E, double)[i],
+            SCENARIO_COLUMN(h, SCENARIO_COL_I, double)[i],    SCENARIO_COLUMN(h, SCENARIO_COL_RAAN, double)[i],
+            SCENARIO_COLUMN(h, SCENARIO_COL_ARGP, double)[i], SCENARIO_COLUMN(h, SCENARIO_COL_M0, double)[i]
+        };
+        StateVector state = {
+            { SCENARIO_COLUMN(h, SCENARIO_COL_POS_X, double)[i], SCENARIO_COLUMN(h, SCENARIO_COL_POS_Y, double)[i],
+              SCENARIO_COLUMN(h, SCENARIO_COL_POS_Z, double)[i] },
+            { SCENARIO_COLUMN(h, SCENARIO_COL_VEL_X, double)[i], SCENARIO_COLUMN(h, SCENARIO_COL_VEL_Y, double)[i],
+              SCENARIO_COLUMN(h, SCENARIO_COL_VEL_Z, double)[i] },
+            0.0
+        };
+        sat = satellite_create_from_state(allocator, SCENARIO_COLUMN(h, SCENARIO_COL_ID, int32_t)[i],
+                                          team, 0, function_type, &el, &state);
+        fuel = SCENARIO_COLUMN(h, SCENARIO_COL_FUEL, double)[i];
+    } else {
+        const ConfigSatelliteRecord *rec = &doc->satellites[i];
+        sat = satellite_create_from_elements(allocator, rec->id, rec->team, 0, rec->function_type, &rec->elements);
+        fuel = rec->fuel;
+    }
+    if (!sat) {
+        fprintf(stderr, "错误：无法创建卫星 %d\n", config_satellite_id(doc, i));
+        return NULL;
+    }
+    sat->fuel = fuel;
+    if (doc->max_rate > 0) sat->attitude.max_rate = doc->max_rate;
+    if (doc->max_accel > 0) sat->attitude.max_accel = doc->max_accel;
+    return sat;
+}
+
+/* ==================== 接口 ==================== */
+
+static void config_document_init(ConfigDocument *doc, const char *path, const SimulationConfig *config) {
+    memset(doc, 0, sizeof(ConfigDocument));
+    doc->path = path;
+    if (config) {
+        doc->config = *config;
+    } else {
+        simulation_default_config(&doc->config);
+    }
+    strcpy(doc->scenario.strategy, "GJ");
+}
+
+int config_load_simulation(const char *config_file, SimulationConfig *config) {
+    if (!config) return -1;
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, config);
+    if (config_read_document(config_file, &doc) != 0) return -1;
+    *config = doc.config;
+    config_document_free(&doc);
+    return 0;
+}
+
+int config_load_strategy_thresholds(const char *config_file, StrategyThresholds *thresholds) {
+    if (!thresholds) return -1;
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, NULL);
+    doc.config.strategy = *thresholds;
+    if (config_read_document(config_file, &doc) != 0) return -1;
+    *thresholds = doc.config.strategy;
+    config_document_free(&doc);
+    return 0;
+}
+
+int config_load_scenario(const char *config_file, Config *scenario) {
+    if (!scenario) return -1;
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, NULL);
+    doc.scenario = *scenario;
+    if (config_read_document(config_file, &doc) != 0) return -1;
+    *scenario = doc.scenario;
+    config_document_free(&doc);
+    return 0;
+}
+
+int config_load_satellites(const char *config_file, Satellite ***satellites_out, int *num_satellites_out) {
+    if (!satellites_out || !num_satellites_out) return -1;
+    *satellites_out = NULL;
+    *num_satellites_out = 0;
+
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, NULL);
+    doc.want_satellites = 1;
+    if (config_read_document(config_file, &doc) != 0) {
+        config_document_free(&doc);
+        return -1;
+    }
+
+    Satellite **satellites = NULL;
+    if (doc.satellite_count > 0) {
+        satellites = (Satellite**)malloc(sizeof(Satellite*) * doc.satellite_count);
+        if (!satellites) {
+            config_document_free(&doc);
+            return -1;
+        }
+    }
+    for (int i = 0; i < doc.satellite_count; i++) {
+        satellites[i] = config_build_satellite(NULL, &doc, i);
+        if (!satellites[i]) {
+            while (i-- > 0) satellite_destroy(satellites[i]);
+            free(satellites);
+            config_document_free(&doc);
+            return -1;
+        }
+    }
+    *satellites_out = satellites;
+    *num_satellites_out = doc.satellite_count;
+    config_document_free(&doc);
+    return 0;
+}
+
+KinematicsEngine* config_load_engine(const char *config_file, const SimulationConfig *defaults,
+                                     uint64_t seed, int history_capacity) {
+    if (!config_file || !defaults) return NULL;
+
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, defaults);
+    doc.want_satellites = 1;
+    if (config_read_document(config_file, &doc) != 0) {
+        config_document_free(&doc);
+        return NULL;
+    }
+
+    // 只有阵营计数（config.json）：按计数生成
+    if (!doc.has_satellites) {
+        config_document_free(&doc);
+        if (!doc.has_counts) {
+            fprintf(stderr, "错误：配置文件 %s 中没有 satellites 或 red/blue\n", config_file);
+            return NULL;
+        }
+        return simulation_create_engine(&doc.scenario, &doc.config, seed, history_capacity);
+    }
+
+    KinematicsEngine *engine = kinematics_engine_create(doc.config);
+    if (!engine) {
+        config_document_free(&doc);
+        fprintf(stderr, "错误：无法创建运动学引擎\n");
+        return NULL;
+    }
+    kinematics_engine_seed(engine, seed);
+    kinematics_engine_set_strategy(engine, doc.scenario.strategy);
+
+    // 卫星直接建在引擎的slab上（ID唯一性已在读取时检查）
+    for (int i = 0; i < doc.satellite_count; i++) {
+        Satellite *sat = config_build_satellite(&engine->slab, &doc, i);
+        if (!sat) break;
+        if (kinematics_engine_add_satellite(engine, sat) < 0) {
+            satellite_destroy(sat);
+            break;
+        }
+    }
+    int complete = (engine->satellite_count == doc.satellite_count);
+    config_document_free(&doc);
+    if (!complete) {
+        kinematics_engine_destroy(engine);
+        return NULL;
+    }
+
+    if (history_capacity > 0) {
+        for (int i = 0; i < engine->satellite_count; i++) {
+            satellite_init_history(engine->satellites[i], history_capacity);
+        }
+    } else {
+        kinematics_engine_init_satellites(engine);
+    }
+    SIM_LOG("[Config] ✓ 已从 %s 加载 %d 颗卫星\n", config_file, engine->satellite_count);
+    return engine;
+}
+
+/* ==================== 运行时参数重载 ==================== */
+
+/* 距离和权重非负，绕飞距离上下限有序 */
+static int config_validate_params(const SimulationConfig *config, const char *path) {
+    const StrategyThresholds *t = &config->strategy;
+    if (t->attack_distance < 0 || t->inspect_distance < 0 || t->defense_distance < 0 ||
+        t->critical_distance < 0 || t->warning_distance < 0 ||
+        config->lambert_target_distance < 0 || config->lambert_max_delta_v < 0 ||
+        config->ellipse_min_distance < 0 || config->ellipse_min_distance > config->ellipse_max_distance ||
+        config->slew_cost_weight < 0) {
+        fprintf(stderr, "错误：配置文件 %s 中的策略阈值或编队参数无效\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int config_reload_params(KinematicsEngine *engine, const char *config_file) {
+    if (!engine || !config_file) return -1;
+
+    // 以当前生效的参数为底，只覆盖文件中出现的项（可能不在引擎线程，须登记为读方）
+    ConfigDocument doc;
+    config_document_init(&doc, config_file, NULL);
+    runtime_params_apply(kinematics_engine_params_acquire(engine), &doc.config);
+    kinematics_engine_params_release(engine);
+    if (config_read_document(config_file, &doc) != 0) {
+        config_document_free(&doc);
+        return -1;
+    }
+    RuntimeParams *params = NULL;
+    if (config_validate_params(&doc.config, config_file) == 0) params = runtime_params_create(&doc.config);
+    config_document_free(&doc);
+    if (!params || kinematics_engine_submit_params(engine, params) != 0) {
+        free(params);
+        return -1;
+    }
+    SIM_LOG("[Config] ✓ 已从 %s 读取运行时参数，下一决策周期生效\n", config_file);
+    return 0;
+}
+
+int config_compile_scenario(const char *json_file, const char *binary_file) {
+    if (!json_file || !binary_file) return -1;
+
+    ConfigDocument doc;
+    config_document_init(&doc, json_file, NULL);
+    doc.want_satellites = 1;
+    if (config_read_document(json_file, &doc) != 0) {
+        config_document_free(&doc);
+        return -1;
+    }
+    if (doc.binary || !doc.has_satellites) {
+        fprintf(stderr, "错误：%s 不是带 satellites 数组的JSON场景\n", json_file);
+        config_document_free(&doc);
+        return -1;
+    }
+
+    // ===== 布局：文件头之后各列依次排列，起点按 SCENARIO_ALIGN 对齐 =====
+    const int n = doc.satellite_count;
+    ScenarioHeader header;
+    memset(&header, 0, sizeof(header));
+    uint64_t offset = scenario_align(sizeof(ScenarioHeader));
+    for (int col = 0; col < SCENARIO_COL_COUNT; col++) {
+        header.columns[col] = offset;
+        offset = scenario_align(offset + (uint64_t)n * SCENARIO_COLUMN_SIZE[col]);
+    }
+    memcpy(header.magic, SCENARIO_MAGIC, sizeof(SCENARIO_MAGIC));
+    header.version = SCENARIO_VERSION;
+    header.header_size = sizeof(ScenarioHeader);
+    header.file_size = offset;
+    header.satellite_count = n;
+    scenario_store_params(&doc.config, header.params);
+    memcpy(header.strategy, doc.scenario.strategy, sizeof(header.strategy));
+    header.max_rate = doc.max_rate;
+    header.max_accel = doc.max_accel;
+
+    char *image = (char*)calloc(1, (size_t)offset);
+    if (!image) {
+        config_document_free(&doc);
+        return -1;
+    }
+    memcpy(image, &header, sizeof(header));
+
+    // ===== 各列：根数在这里一次换算成初始状态 =====
+    int32_t *ids = (int32_t*)(image + header.columns[SCENARIO_COL_ID]);
+    uint8_t *teams = (uint8_t*)(image + header.columns[SCENARIO_COL_TEAM]);
+    uint8_t *functions = (uint8_t*)(image + header.columns[SCENARIO_COL_FUNCTION]);
+    double *col[SCENARIO_COL_COUNT];
+    for (int c = SCENARIO_COL_FUEL; c < SCENARIO_COL_COUNT; c++) col[c] = (double*)(image + header.columns[c]);
+
+    int status = 0;
+    for (int i = 0; i < n; i++) {
+        const ConfigSatelliteRecord *rec = &doc.satellites[i];
+        OrbitalElements el = rec->elements;
+        StateVector state;
+        if (orbit_elements_to_state(&el, &state) != 0) {
+            fprintf(stderr, "错误：卫星 %d 的根数无法换算为状态\n", rec->id);
+            status = -1;
+            break;
+        }
+        ids[i] = rec->id;
+        teams[i] = rec->team;
+        functions[i] = rec->function_type;
+        col[SCENARIO_COL_FUEL][i] = rec->fuel;
+        col[SCENARIO_COL_A][i] = el.a;
+        col[SCENARIO_COL_E][i] = el.e;
+        col[SCENARIO_COL_I][i] = el.i;
+        col[SCENARIO_COL_RAAN][i] = el.omega_big;
+        col[SCENARIO_COL_ARGP][i] = el.omega_small;
+        col[SCENARIO_COL_M0][i] = el.m0;
+        col[SCENARIO_COL_POS_X][i] = state.position.x;
+        col[SCENARIO_COL_POS_Y][i] = state.position.y;
+        col[SCENARIO_COL_POS_Z][i] = state.position.z;
+        col[SCENARIO_COL_VEL_X][i] = state.velocity.x;
+        col[SCENARIO_COL_VEL_Y][i] = state.velocity.y;
+        col[SCENARIO_COL_VEL_Z][i] = state.velocity.z;
+    }
+    config_document_free(&doc);
+
+    // ===== 先写临时文件再改名，中途失败不留下半个文件 =====
+    char tmp_name[1024];
+    if (snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", binary_file) >= (int)sizeof(tmp_name)) status = -1;
+    if (status == 0) {
+        FILE *fp = fopen(tmp_name, "wb");
+        if (!fp || fwrite(image, 1, (size_t)offset, fp) != (size_t)offset) status = -1;
+        if (fp && fclose(fp) != 0) status = -1;
+        if (status == 0 && rename(tmp_name, binary_file) != 0) status = -1;
+        if (status != 0) {
+            fprintf(stderr, "错误：写入二进制场景失败 %s\n", binary_file);
+            remove(tmp_name);
+        }
+    }
+    free(image);
+    if (status == 0) {
+        SIM_LOG("[Config] ✓ 已编译 %s → %s (%d 颗卫星, %.1f KB)\n",
+                json_file, binary_file, n, offset / 1024.0);
+    }
+    return status;
+}
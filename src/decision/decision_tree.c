@@ -3,95 +3,86 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <profiler.h>
+#include <vector3.h>
+#include <vector3_soa.h>
 
 #define MAX_ITERATIONS 100
 #define CONVERGENCE_THRESHOLD 1e-4
 
-/**
- * 计算两个卫星之间的欧氏距离
- */
-static double calculate_distance(Vector3 pos1, Vector3 pos2) {
-    double dx = pos1.x - pos2.x;
-    double dy = pos1. y - pos2.y;
-    double dz = pos1.z - pos2.z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
+/* scratch 为NULL时走系统堆 */
+static void* decision_tree_alloc(Arena *scratch, size_t size) {
+    return scratch ? arena_alloc(scratch, size, ARENA_DEFAULT_ALIGN) : malloc(size);
 }
 
 /**
- * 向量相加
+ * 卫星位置按 x/y/z 分列收集（一块内存，scratch 为NULL时由调用者 free(points->x)）
  */
-static Vector3 vector_add(Vector3 a, Vector3 b) {
-    return (Vector3){a.x + b.x, a.y + b.y, a.z + b.z};
-}
-
-/**
- * 向量数乘
- */
-static Vector3 vector_scale(Vector3 v, double scale) {
-    return (Vector3){v.x * scale, v.y * scale, v.z * scale};
+static int decision_tree_gather_positions(Arena *scratch, Satellite **satellites, int num_satellites,
+                                          Vector3SoA *points) {
+    double *block = (double*)decision_tree_alloc(scratch, sizeof(double) * 3 * num_satellites);
+    if (!block) return -1;
+    
+    *points = vector3_soa_view(block, block + num_satellites, block + 2 * num_satellites, num_satellites);
+    for (int i = 0; i < num_satellites; i++) {
+        vector3_soa_set(points, i, satellites[i]->state.position);
+    }
+    return 0;
 }
 
 /**
  * K-means聚类的核心算法
  */
 static void kmeans_clustering(
-    Satellite **satellites,
-    int num_satellites,
+    const Vector3SoA *points,
     int num_groups,
     int *assignments,
     Vector3 *centers) {
     
+    int num_satellites = points->count;
+    
     // 初始化聚类中心（选择前num_groups个卫星作为初始中心）
     for (int i = 0; i < num_groups; i++) {
-        centers[i] = satellites[i % num_satellites]->state.position;
+        centers[i] = vector3_soa_get(points, i % num_satellites);
     }
     
+    double center_x[num_groups], center_y[num_groups], center_z[num_groups];
+    Vector3SoA center_soa = vector3_soa_view(center_x, center_y, center_z, num_groups);
+    Vector3 sums[num_groups];
+    int counts[num_groups];
+    
     // 迭代聚类
     for (int iter = 0; iter < MAX_ITERATIONS; iter++) {
         // ===== Step 1: 分配卫星到最近的聚类中心 =====
-        for (int i = 0; i < num_satellites; i++) {
-            double min_distance = 1e100;
-            int closest_center = 0;
-            
-            for (int k = 0; k < num_groups; k++) {
-                double dist = calculate_distance(
-                    satellites[i]->state.position,
-                    centers[k]
-                );
-                
-                if (dist < min_distance) {
-                    min_distance = dist;
-                    closest_center = k;
-                }
-            }
-            
-            assignments[i] = closest_center;
+        for (int k = 0; k < num_groups; k++) {
+            vector3_soa_set(&center_soa, k, centers[k]);
         }
+        vector3_soa_nearest(points, &center_soa, assignments, NULL);
         
         // ===== Step 2: 更新聚类中心 =====
         Vector3 old_centers[num_groups];
         memcpy(old_centers, centers, sizeof(Vector3) * num_groups);
         
+        // 单遍累加，各组仍按卫星下标顺序求和
+        memset(sums, 0, sizeof(Vector3) * num_groups);
+        memset(counts, 0, sizeof(int) * num_groups);
+        for (int i = 0; i < num_satellites; i++) {
+            int k = assignments[i];
+            sums[k] = vector3_add(sums[k], vector3_soa_get(points, i));
+            counts[k]++;
+        }
+        
         for (int k = 0; k < num_groups; k++) {
-            Vector3 sum = {0, 0, 0};
-            int count = 0;
-            
-            for (int i = 0; i < num_satellites; i++) {
-                if (assignments[i] == k) {
-                    sum = vector_add(sum, satellites[i]->state. position);
-                    count++;
-                }
-            }
-            
-            if (count > 0) {
-                centers[k] = vector_scale(sum, 1.0 / count);
+            if (counts[k] > 0) {
+                centers[k] = vector3_scale(sums[k], 1.0 / counts[k]);
             }
         }
         
         // ===== Step 3: 检查收敛 =====
         int converged = 1;
         for (int k = 0; k < num_groups; k++) {
-            double center_shift = calculate_distance(centers[k], old_centers[k]);
+            double center_shift = vector3_distance(centers[k], old_centers[k]);
             if (center_shift > CONVERGENCE_THRESHOLD) {
                 converged = 0;
                 break;
@@ -99,7 +90,7 @@ static void kmeans_clustering(
         }
         
         if (converged) {
-            printf("[决策树] K-means在第%d次迭代时收敛\n", iter);
+            SIM_LOG("[决策树] K-means在第%d次迭代时收敛\n", iter);
             break;
         }
     }
@@ -112,6 +103,15 @@ GroupResult* decision_tree_group_satellites(
     int num_satellites,
     int target_num_groups) {
     
+    return decision_tree_group_satellites_in(NULL, satellites, num_satellites, target_num_groups);
+}
+
+GroupResult* decision_tree_group_satellites_in(
+    Arena *scratch,
+    Satellite **satellites,
+    int num_satellites,
+    int target_num_groups) {
+    
     if (! satellites || num_satellites <= 0 || target_num_groups <= 0) {
         fprintf(stderr, "[错误] 决策树: 输入参数无效\n");
         return NULL;
@@ -122,10 +122,10 @@ GroupResult* decision_tree_group_satellites(
         target_num_groups = num_satellites;
     }
     
-    printf("[决策树] 开始分组: %d颗卫星分%d组\n", num_satellites, target_num_groups);
+    SIM_LOG("[决策树] 开始分组: %d颗卫星分%d组\n", num_satellites, target_num_groups);
     
     // 分配结果结构
-    GroupResult *result = (GroupResult*)malloc(sizeof(GroupResult));
+    GroupResult *result = (GroupResult*)decision_tree_alloc(scratch, sizeof(GroupResult));
     if (!result) {
         fprintf(stderr, "[错误] 内存分配失败\n");
         return NULL;
@@ -133,12 +133,13 @@ GroupResult* decision_tree_group_satellites(
     
     result->num_satellites = num_satellites;
     result->num_groups = target_num_groups;
-    result->group_ids = (int*)malloc(sizeof(int) * num_satellites);
-    result->group_centers = (Vector3*)malloc(sizeof(Vector3) * target_num_groups);
-    result->group_sizes = (int*)malloc(sizeof(int) * target_num_groups);
+    result->group_ids = (int*)decision_tree_alloc(scratch, sizeof(int) * num_satellites);
+    result->group_centers = (Vector3*)decision_tree_alloc(scratch, sizeof(Vector3) * target_num_groups);
+    result->group_sizes = (int*)decision_tree_alloc(scratch, sizeof(int) * target_num_groups);
     
     if (!result->group_ids || !result->group_centers || !result->group_sizes) {
         fprintf(stderr, "[错误] 内存分配失败\n");
+        if (scratch) return NULL;   // arena内存随重置回收
         free(result->group_ids);
         free(result->group_centers);
         free(result->group_sizes);
@@ -147,13 +148,22 @@ GroupResult* decision_tree_group_satellites(
     }
     
     // 执行K-means聚类
+    PROF_BEGIN(prof_kmeans);
+    Vector3SoA points;
+    if (decision_tree_gather_positions(scratch, satellites, num_satellites, &points) != 0) {
+        fprintf(stderr, "[错误] 内存分配失败\n");
+        if (scratch) return NULL;
+        decision_tree_free_result(result);
+        return NULL;
+    }
     kmeans_clustering(
-        satellites,
-        num_satellites,
+        &points,
         target_num_groups,
         result->group_ids,
         result->group_centers
     );
+    if (!scratch) free(points.x);
+    PROF_END(PROF_KMEANS, prof_kmeans);
     
     // 计算每组的卫星数量
     memset(result->group_sizes, 0, sizeof(int) * target_num_groups);
@@ -162,9 +172,9 @@ GroupResult* decision_tree_group_satellites(
     }
     
     // 打印分组统计
-    printf("[决策树] 分组完成:\n");
+    SIM_LOG("[决策树] 分组完成:\n");
     for (int k = 0; k < target_num_groups; k++) {
-        printf("  第%d组: %d颗卫星, 中心=(%.1f, %.1f, %.1f)km\n",
+        SIM_LOG("  第%d组: %d颗卫星, 中心=(%.1f, %.1f, %.1f)km\n",
                k, result->group_sizes[k],
                result->group_centers[k].x / 1000.0,
                result->group_centers[k]. y / 1000.0,
@@ -210,24 +220,24 @@ uint8_t decision_tree_select_formation(
         }
     }
     
-    printf("[决策树] 第%d组编队选择: 攻击%d 侦察%d 防御%d\n",
+    SIM_LOG("[决策树] 第%d组编队选择: 攻击%d 侦察%d 防御%d\n",
            group_id, attack_count, recon_count, defense_count);
     
     // 编队选择规则
     if (attack_count >= 2) {
-        printf("  → 选择: 球形围观(AROUND)\n");
+        SIM_LOG("  → 选择: 球形围观(AROUND)\n");
         return 0;  // AROUND
     } else if (recon_count >= 1) {
-        printf("  → 选择: 巡视编队(INSPECT)\n");
+        SIM_LOG("  → 选择: 巡视编队(INSPECT)\n");
         return 1;  // INSPECT
     } else if (defense_count >= 1 && attack_count >= 1) {
-        printf("  → 选择: 环视编队(CIRCUMNAVIGATE)\n");
+        SIM_LOG("  → 选择: 环视编队(CIRCUMNAVIGATE)\n");
         return 2;  // CIRCUMNAVIGATE
     } else if (total_fuel < 50000) {
-        printf("  → 选择: 撤退编队(RETREAT) - 燃料不足\n");
+        SIM_LOG("  → 选择: 撤退编队(RETREAT) - 燃料不足\n");
         return 3;  // RETREAT
     } else {
-        printf("  → 选择: 球形围观(AROUND) - 默认\n");
+        SIM_LOG("  → 选择: 球形围观(AROUND) - 默认\n");
         return 0;  // AROUND (默认)
     }
 }
@@ -245,12 +255,18 @@ int decision_tree_auto_determine_groups(
         return num_satellites;
     }
     
-    printf("[决策树] 使用肘部法则自动确定分组数.. .\n");
+    SIM_LOG("[决策树] 使用肘部法则自动确定分组数.. .\n");
     
     // 简化的肘部法则
     double *wcss_values = (double*)malloc(sizeof(double) * max_groups);
     if (!wcss_values) return 1;
     
+    Vector3SoA points;
+    if (decision_tree_gather_positions(NULL, satellites, num_satellites, &points) != 0) {
+        free(wcss_values);
+        return 1;
+    }
+    
     for (int k = 1; k <= max_groups; k++) {
         int *assignments = (int*)malloc(sizeof(int) * num_satellites);
         Vector3 *centers = (Vector3*)malloc(sizeof(Vector3) * k);
@@ -259,25 +275,23 @@ int decision_tree_auto_determine_groups(
             free(assignments);
             free(centers);
             free(wcss_values);
+            free(points.x);
             return 1;
         }
         
         // 执行K-means
-        kmeans_clustering(satellites, num_satellites, k, assignments, centers);
+        kmeans_clustering(&points, k, assignments, centers);
         
         // 计算WCSS (Within-Cluster Sum of Squares)
         double wcss = 0;
         for (int i = 0; i < num_satellites; i++) {
             int cluster = assignments[i];
-            double dist = calculate_distance(
-                satellites[i]->state.position,
-                centers[cluster]
-            );
+            double dist = vector3_distance(vector3_soa_get(&points, i), centers[cluster]);
             wcss += dist * dist;
         }
         wcss_values[k-1] = wcss;
         
-        printf("  K=%d: WCSS=%. 2f\n", k, wcss);
+        SIM_LOG("  K=%d: WCSS=%. 2f\n", k, wcss);
         
         free(assignments);
         free(centers);
@@ -297,8 +311,9 @@ int decision_tree_auto_determine_groups(
     }
     
     free(wcss_values);
+    free(points.x);
     
-    printf("[决策树] 自动分组数: %d\n", optimal_k);
+    SIM_LOG("[决策树] 自动分组数: %d\n", optimal_k);
     return optimal_k;
 }
 
@@ -3,30 +3,23 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <profiler.h>
+#include <attitude.h>
+#include <vector3.h>
+#include <vector3_soa.h>
+#include <constants.h>
 
-#define MU 3.986004418e5  // 地球重力参数 km³/s²
-
-/**
- * 计算两个卫星之间的距离
- */
-static double calculate_distance(Vector3 pos1, Vector3 pos2) {
-    double dx = pos1.x - pos2.x;
-    double dy = pos1. y - pos2.y;
-    double dz = pos1. z - pos2.z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
-}
-
-/**
- * 计算向量的模长
- */
-static double vector_magnitude(Vector3 v) {
-    return sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
+/* scratch 为NULL时走系统堆 */
+static void* differential_game_alloc(Arena *scratch, size_t size) {
+    return scratch ? arena_alloc(scratch, size, ARENA_DEFAULT_ALIGN) : malloc(size);
 }
 
 /**
  * - 贪心最大权匹配
  */
 static void hungarian_assignment_greedy(
+    Arena *scratch,
     const double *payoff_matrix,
     int num_red,
     int num_blue,
@@ -35,7 +28,9 @@ static void hungarian_assignment_greedy(
     // 初始化：所有红星无分配（-1）
     memset(assignments, -1, sizeof(int) * num_red);
     
-    int *used_blue = (int*)calloc(num_blue, sizeof(int));
+    ArenaMark mark = arena_mark(scratch);
+    int *used_blue = scratch ? (int*)arena_calloc(scratch, num_blue, sizeof(int))
+                             : (int*)calloc(num_blue, sizeof(int));
     if (!used_blue) return;
     
     // 按收益从高到低贪心分配
@@ -72,32 +67,21 @@ static void hungarian_assignment_greedy(
         }
     }
     
-    free(used_blue);
+    if (scratch) {
+        arena_rewind(scratch, mark);
+    } else {
+        free(used_blue);
+    }
 }
 
-/* ==================== 公开接口实现 ==================== */
-
-double differential_game_calculate_threat(
-    Satellite *red_sat,
-    Satellite *blue_sat) {
-    
-    if (!red_sat || !blue_sat) return 0;
-    
-    // 距离因素 (km)
-    double distance = calculate_distance(
-        red_sat->state.position,
-        blue_sat->state.position
-    );
+/* 威胁等级：距离和相对速度由调用者给出（单对计算或整行批量计算） */
+static double differential_game_threat_from(const Satellite *red_sat, double distance, double rel_vel) {
     double distance_factor = 100.0 / (1.0 + distance / 10000.0);  // 距离越近，威胁越大
     
     // 燃料因素
     double fuel_factor = (red_sat->fuel / 1000.0) * 20.0;  // 燃料越多，威胁越大
     
     // 相对速度因素
-    double vel_x = red_sat->state.velocity. x - blue_sat->state.velocity. x;
-    double vel_y = red_sat->state.velocity.y - blue_sat->state.velocity.y;
-    double vel_z = red_sat->state.velocity.z - blue_sat->state.velocity.z;
-    double rel_vel = sqrt(vel_x*vel_x + vel_y*vel_y + vel_z*vel_z);
     double velocity_factor = rel_vel * 5.0;  // 相对速度越大，威胁越大
     
     // 功能因素
@@ -110,21 +94,8 @@ double differential_game_calculate_threat(
     return (threat_level < 100.0) ? threat_level : 100.0;  // 限制在0-100
 }
 
-double differential_game_calculate_payoff(
-    Satellite *red_sat,
-    Satellite *blue_sat,
-    int strategy) {
-    
-    if (!red_sat || !blue_sat) return 0;
-    
-    double distance = calculate_distance(
-        red_sat->state.position,
-        blue_sat->state.position
-    );
-    
-    double threat = differential_game_calculate_threat(red_sat, blue_sat);
-    
-    // 收益计算 (基于策略和距离)
+/* 收益：距离和威胁由调用者给出 */
+static double differential_game_payoff_from(const Satellite *red_sat, int strategy, double distance, double threat) {
     double payoff = 0;
     
     switch (strategy) {
@@ -154,6 +125,72 @@ double differential_game_calculate_payoff(
     return payoff;
 }
 
+/**
+ * 收益矩阵：蓝星位置/速度分列存放，每颗红星一次批量算出到全部蓝星的距离和相对速度
+ * @return 0 成功，内存不足返回-1
+ */
+static int differential_game_fill_payoff(Arena *scratch, Satellite **red_satellites, int num_red,
+                                         Satellite **blue_satellites, int num_blue,
+                                         const int *strategies, double *payoff_matrix) {
+    double *block = (double*)differential_game_alloc(scratch, sizeof(double) * 7 * num_blue);
+    if (!block) return -1;
+    
+    Vector3SoA blue_pos = vector3_soa_view(block, block + num_blue, block + 2 * num_blue, num_blue);
+    Vector3SoA blue_vel = vector3_soa_view(block + 3 * num_blue, block + 4 * num_blue, block + 5 * num_blue, num_blue);
+    double *rel_vel = block + 6 * num_blue;
+    for (int b = 0; b < num_blue; b++) {
+        vector3_soa_set(&blue_pos, b, blue_satellites[b]->state.position);
+        vector3_soa_set(&blue_vel, b, blue_satellites[b]->state.velocity);
+    }
+    
+    for (int r = 0; r < num_red; r++) {
+        Satellite *red = red_satellites[r];
+        double *row = payoff_matrix + (size_t)r * num_blue;
+        
+        // 先把距离写入本行，再原地换算为收益
+        vector3_soa_distance_to(&blue_pos, red->state.position, row);
+        vector3_soa_distance_to(&blue_vel, red->state.velocity, rel_vel);
+        for (int b = 0; b < num_blue; b++) {
+            double threat = differential_game_threat_from(red, row[b], rel_vel[b]);
+            row[b] = differential_game_payoff_from(red, strategies[r], row[b], threat);
+        }
+    }
+    
+    if (!scratch) free(block);
+    return 0;
+}
+
+/* ==================== 公开接口实现 ==================== */
+
+double differential_game_calculate_threat(
+    Satellite *red_sat,
+    Satellite *blue_sat) {
+    
+    if (!red_sat || !blue_sat) return 0;
+    
+    // 距离因素 (km)
+    double distance = vector3_distance(red_sat->state.position, blue_sat->state.position);
+    
+    // 相对速度因素
+    double rel_vel = vector3_distance(red_sat->state.velocity, blue_sat->state.velocity);
+    
+    return differential_game_threat_from(red_sat, distance, rel_vel);
+}
+
+double differential_game_calculate_payoff(
+    Satellite *red_sat,
+    Satellite *blue_sat,
+    int strategy) {
+    
+    if (!red_sat || !blue_sat) return 0;
+    
+    double distance = vector3_distance(red_sat->state.position, blue_sat->state.position);
+    double threat = differential_game_calculate_threat(red_sat, blue_sat);
+    
+    // 收益计算 (基于策略和距离)
+    return differential_game_payoff_from(red_sat, strategy, distance, threat);
+}
+
 GameResult* differential_game_assign_strategies(
     Satellite **red_satellites,
     int num_red,
@@ -161,16 +198,29 @@ GameResult* differential_game_assign_strategies(
     int num_blue,
     const char *strategy_type) {
     
+    return differential_game_assign_strategies_in(NULL, red_satellites, num_red,
+                                                  blue_satellites, num_blue, strategy_type, 0.0);
+}
+
+GameResult* differential_game_assign_strategies_in(
+    Arena *scratch,
+    Satellite **red_satellites,
+    int num_red,
+    Satellite **blue_satellites,
+    int num_blue,
+    const char *strategy_type,
+    double slew_weight) {
+    
     if (!red_satellites || ! blue_satellites || num_red <= 0 || num_blue <= 0) {
         fprintf(stderr, "[错误] 微分博弈: 输入参数无效\n");
         return NULL;
     }
     
-    printf("[微分博弈] 开始策略分配: %d红vs%d蓝, 策略=%s\n",
+    SIM_LOG("[微分博弈] 开始策略分配: %d红vs%d蓝, 策略=%s\n",
            num_red, num_blue, strategy_type ?  strategy_type : "未指定");
     
     // 分配结果结构
-    GameResult *result = (GameResult*)malloc(sizeof(GameResult));
+    GameResult *result = (GameResult*)differential_game_alloc(scratch, sizeof(GameResult));
     if (!result) {
         fprintf(stderr, "[错误] 内存分配失败\n");
         return NULL;
@@ -178,12 +228,13 @@ GameResult* differential_game_assign_strategies(
     
     result->num_red_satellites = num_red;
     result->num_blue_satellites = num_blue;
-    result->strategy_assignments = (int*)malloc(sizeof(int) * num_red);
-    result->target_assignments = (int*)malloc(sizeof(int) * num_red);
-    result->payoff_matrix = (double*)malloc(sizeof(double) * num_red * num_blue);
+    result->strategy_assignments = (int*)differential_game_alloc(scratch, sizeof(int) * num_red);
+    result->target_assignments = (int*)differential_game_alloc(scratch, sizeof(int) * num_red);
+    result->payoff_matrix = (double*)differential_game_alloc(scratch, sizeof(double) * num_red * num_blue);
     
     if (!result->strategy_assignments || !result->target_assignments || !result->payoff_matrix) {
         fprintf(stderr, "[错误] 内存分配失败\n");
+        if (scratch) return NULL;   // arena内存随重置回收
         free(result->strategy_assignments);
         free(result->target_assignments);
         free(result->payoff_matrix);
@@ -216,30 +267,43 @@ GameResult* differential_game_assign_strategies(
     }
     
     // ===== Step 2: 计算收益矩阵 =====
-    printf("[微分博弈] 计算收益矩阵...\n");
+    SIM_LOG("[微分博弈] 计算收益矩阵...\n");
+    PROF_BEGIN(prof_payoff);
     
-    for (int r = 0; r < num_red; r++) {
-        for (int b = 0; b < num_blue; b++) {
-            double payoff = differential_game_calculate_payoff(
-                red_satellites[r],
-                blue_satellites[b],
-                result->strategy_assignments[r]
-            );
-            result->payoff_matrix[r * num_blue + b] = payoff;
+    if (differential_game_fill_payoff(scratch, red_satellites, num_red, blue_satellites, num_blue,
+                                      result->strategy_assignments, result->payoff_matrix) != 0) {
+        fprintf(stderr, "[错误] 内存分配失败\n");
+        PROF_END(PROF_PAYOFF, prof_payoff);
+        if (!scratch) differential_game_free_result(result);
+        return NULL;
+    }
+    
+    // 姿态机动代价：闭式机动时间，不做姿态仿真
+    if (slew_weight > 0) {
+        double *slew_times = (double*)differential_game_alloc(scratch, sizeof(double) * num_red * num_blue);
+        if (slew_times && attitude_slew_time_matrix(red_satellites, num_red, blue_satellites, num_blue, slew_times) == 0) {
+            for (int i = 0; i < num_red * num_blue; i++) {
+                result->payoff_matrix[i] -= slew_weight * slew_times[i];
+            }
         }
+        if (!scratch) free(slew_times);
     }
+    PROF_END(PROF_PAYOFF, prof_payoff);
     
     // ===== Step 3: 最优分配 =====
-    printf("[微分博弈] 执行最优分配...\n");
+    SIM_LOG("[微分博弈] 执行最优分配...\n");
+    PROF_BEGIN(prof_assignment);
     hungarian_assignment_greedy(
+        scratch,
         result->payoff_matrix,
         num_red,
         num_blue,
         result->target_assignments
     );
+    PROF_END(PROF_ASSIGNMENT, prof_assignment);
     
     // ===== 打印分配结果 =====
-    printf("[微分博弈] 分配完成:\n");
+    SIM_LOG("[微分博弈] 分配完成:\n");
     for (int r = 0; r < num_red; r++) {
         int target_id = result->target_assignments[r];
         if (target_id >= 0 && target_id < num_blue) {
@@ -248,13 +312,13 @@ GameResult* differential_game_assign_strategies(
                 result->strategy_assignments[r] == 0 ? "攻击" :
                 result->strategy_assignments[r] == 1 ? "侦察" : "防御";
             
-            printf("  红星%d -> 蓝星%d [%s] 收益=%.2f\n",
+            SIM_LOG("  红星%d -> 蓝星%d [%s] 收益=%.2f\n",
                    red_satellites[r]->id,
                    blue_satellites[target_id]->id,
                    strat_name,
                    payoff);
         } else {
-            printf("  红星%d -> 无目标\n", red_satellites[r]->id);
+            SIM_LOG("  红星%d -> 无目标\n", red_satellites[r]->id);
         }
     }
     
@@ -267,7 +331,7 @@ void differential_game_hungarian_assignment(
     int num_blue,
     int *assignments) {
     
-    hungarian_assignment_greedy(payoff_matrix, num_red, num_blue, assignments);
+    hungarian_assignment_greedy(NULL, payoff_matrix, num_red, num_blue, assignments);
 }
 
 void differential_game_free_result(GameResult *result) {
@@ -9,8 +9,9 @@ FormationManager* formation_manager_create(void) {
     
     memset(fm, 0, sizeof(FormationManager));
     
-    fm->satellites = (Satellite**)calloc(100, sizeof(Satellite*));
-    fm->triggers = (FormationTrigger*)calloc(100, sizeof(FormationTrigger));
+    fm->capacity = FORMATION_MANAGER_INITIAL_CAPACITY;
+    fm->satellites = (Satellite**)calloc(fm->capacity, sizeof(Satellite*));
+    fm->triggers = (FormationTrigger*)calloc(fm->capacity, sizeof(FormationTrigger));
     fm->transition_rules = (FormationTransitionRule*)calloc(50, sizeof(FormationTransitionRule));
     
     if (!fm->satellites || !fm->triggers || !fm->transition_rules) {
@@ -34,7 +35,18 @@ void formation_manager_destroy(FormationManager *fm) {
 
 int formation_manager_register_satellite(FormationManager *fm, Satellite *sat) {
     if (!fm || !sat) return -1;
-    if (fm->num_satellites >= 100) return -1;
+    
+    // 容量不足时加倍（卫星和触发器数组同步增长）
+    if (fm->num_satellites >= fm->capacity) {
+        int grown = fm->capacity * 2;
+        Satellite **sats = (Satellite**)realloc(fm->satellites, sizeof(Satellite*) * grown);
+        if (!sats) return -1;
+        fm->satellites = sats;
+        FormationTrigger *triggers = (FormationTrigger*)realloc(fm->triggers, sizeof(FormationTrigger) * grown);
+        if (!triggers) return -1;
+        fm->triggers = triggers;
+        fm->capacity = grown;
+    }
     
     fm->satellites[fm->num_satellites] = sat;
     memset(&fm->triggers[fm->num_satellites], 0, sizeof(FormationTrigger));
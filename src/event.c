@@ -0,0 +1,436 @@
+#include <event.h>
+#include <orbit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* ==================== 内置事件函数 ==================== */
+
+double event_distance_func(const StateVector *primary, const StateVector *secondary, void *user_data) {
+    const EventDistanceParams *params = (const EventDistanceParams*)user_data;
+    if (!secondary || !params) return 0.0;
+    return vector3_distance(primary->position, secondary->position) - params->threshold;
+}
+
+double event_apsis_func(const StateVector *primary, const StateVector *secondary, void *user_data) {
+    (void)secondary;
+    (void)user_data;
+    return vector3_dot(primary->position, primary->velocity);
+}
+
+double event_phase_angle_func(const StateVector *primary, const StateVector *secondary, void *user_data) {
+    const EventPhaseParams *params = (const EventPhaseParams*)user_data;
+    if (!secondary || !params) return 0.0;
+
+    // 主星LVLH：x径向，y沿迹
+    Vector3 x_hat = vector3_normalize(primary->position);
+    Vector3 z_hat = vector3_normalize(vector3_cross(primary->position, primary->velocity));
+    Vector3 y_hat = vector3_cross(z_hat, x_hat);
+    Vector3 dr = vector3_sub(secondary->position, primary->position);
+
+    double theta = atan2(vector3_dot(dr, y_hat), vector3_dot(dr, x_hat));
+    return sin(theta - params->target_angle);
+}
+
+/* ==================== 求根和插值 ==================== */
+
+int event_find_root(double (*f)(double t, void *context), void *context,
+                    double t0, double g0, double t1, double g1,
+                    double tolerance, double *root_out) {
+    if (!f || !root_out) return -1;
+    if (g0 == 0.0) { *root_out = t0; return 0; }
+    if (g1 == 0.0) { *root_out = t1; return 0; }
+    if ((g0 > 0) == (g1 > 0)) return -1;
+
+    double a = t0, fa = g0, b = t1, fb = g1;
+    double c = b, c_prev = a;
+    int side = 0;
+
+    for (int iter = 0; iter < EVENT_MAX_ITERATIONS; iter++) {
+        c = (a * fb - b * fa) / (fb - fa);
+        double fc = f(c, context);
+
+        if (fc == 0.0 || fabs(b - a) < tolerance || fabs(c - c_prev) < 0.5 * tolerance) break;
+        c_prev = c;
+
+        if ((fc > 0) == (fb > 0)) {
+            b = c; fb = fc;
+            if (side == -1) fa *= 0.5;   // 同侧连续更新时把对侧函数值减半
+            side = -1;
+        } else {
+            a = c; fa = fc;
+            if (side == 1) fb *= 0.5;
+            side = 1;
+        }
+    }
+
+    *root_out = c;
+    return 0;
+}
+
+void event_hermite_interpolate(const StateVector *s0, const StateVector *s1, double t, StateVector *out) {
+    double h = s1->time - s0->time;
+    if (fabs(h) < 1e-12) {
+        *out = *s1;
+        return;
+    }
+
+    double s = (t - s0->time) / h;
+    double s2 = s * s, s3 = s2 * s;
+
+    double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    double h10 = s3 - 2.0 * s2 + s;
+    double h01 = -2.0 * s3 + 3.0 * s2;
+    double h11 = s3 - s2;
+
+    double d00 = (6.0 * s2 - 6.0 * s) / h;
+    double d10 = 3.0 * s2 - 4.0 * s + 1.0;
+    double d01 = (-6.0 * s2 + 6.0 * s) / h;
+    double d11 = 3.0 * s2 - 2.0 * s;
+
+    out->position = vector3_add(
+        vector3_add(vector3_scale(s0->position, h00), vector3_scale(s0->velocity, h10 * h)),
+        vector3_add(vector3_scale(s1->position, h01), vector3_scale(s1->velocity, h11 * h)));
+    out->velocity = vector3_add(
+        vector3_add(vector3_scale(s0->position, d00), vector3_scale(s0->velocity, d10)),
+        vector3_add(vector3_scale(s1->position, d01), vector3_scale(s1->velocity, d11)));
+    out->time = t;
+}
+
+/* 符号变化 + 方向过滤 */
+static int event_crossed(const OrbitEvent *event, double g0, double g1) {
+    int rising = (g0 < 0.0 && g1 >= 0.0);
+    int falling = (g0 > 0.0 && g1 <= 0.0);
+
+    switch (event->direction) {
+        case EVENT_DIR_RISING:  return rising;
+        case EVENT_DIR_FALLING: return falling;
+        default:                return rising || falling;
+    }
+}
+
+/* ==================== 事件表 ==================== */
+
+void event_list_init(EventList *list) {
+    if (!list) return;
+    memset(list, 0, sizeof(EventList));
+    list->next_id = 1;
+}
+
+void event_list_free(EventList *list) {
+    if (!list) return;
+    free(list->events);
+    free(list->pending);
+    memset(list, 0, sizeof(EventList));
+}
+
+int event_list_add(EventList *list, const OrbitEvent *event) {
+    if (!list || !event || !event->g) return -1;
+
+    if (list->num_events >= list->capacity) {
+        int new_capacity = list->capacity ? list->capacity * 2 : 8;
+        OrbitEvent *events = (OrbitEvent*)realloc(list->events, sizeof(OrbitEvent) * new_capacity);
+        if (!events) return -1;
+        list->events = events;
+        list->capacity = new_capacity;
+    }
+
+    OrbitEvent *e = &list->events[list->num_events++];
+    *e = *event;
+    e->id = list->next_id++;
+    e->active = 1;
+    e->primed = 0;
+    e->fire_count = 0;
+    e->last_fire_time = 0.0;
+    return e->id;
+}
+
+int event_list_remove(EventList *list, int event_id) {
+    if (!list) return -1;
+    for (int i = 0; i < list->num_events; i++) {
+        if (list->events[i].id == event_id) {
+            memmove(&list->events[i], &list->events[i + 1],
+                    sizeof(OrbitEvent) * (list->num_events - i - 1));
+            list->num_events--;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+OrbitEvent* event_list_get(EventList *list, int event_id) {
+    if (!list) return NULL;
+    for (int i = 0; i < list->num_events; i++) {
+        if (list->events[i].id == event_id) return &list->events[i];
+    }
+    return NULL;
+}
+
+void event_list_reset(EventList *list) {
+    if (!list) return;
+    for (int i = 0; i < list->num_events; i++) {
+        list->events[i].primed = 0;
+    }
+}
+
+/* 步内插值求根上下文 */
+typedef struct {
+    const OrbitEvent *event;
+    StateVector p0, p1, s0, s1;
+    int has_secondary;
+} EventBracket;
+
+static double event_bracket_eval(double t, void *context) {
+    EventBracket *br = (EventBracket*)context;
+    StateVector p, s;
+    event_hermite_interpolate(&br->p0, &br->p1, t, &p);
+    if (br->has_secondary) {
+        event_hermite_interpolate(&br->s0, &br->s1, t, &s);
+        return br->event->g(&p, &s, br->event->user_data);
+    }
+    return br->event->g(&p, NULL, br->event->user_data);
+}
+
+/* 每个事件单步最多触发一次，缓冲按事件数预留 */
+static int event_list_reserve_pending(EventList *list) {
+    if (list->num_events > list->pending_capacity) {
+        EventHit *pending = (EventHit*)realloc(list->pending, sizeof(EventHit) * list->num_events);
+        if (!pending) return -1;
+        list->pending = pending;
+        list->pending_capacity = list->num_events;
+    }
+    return 0;
+}
+
+int event_list_check(EventList *list, double t, event_state_lookup lookup, void *context,
+                     EventHit *hits_out, int max_hits) {
+    if (!list || !lookup) return 0;
+    if (list->num_events == 0) return 0;
+    if (event_list_reserve_pending(list) != 0) return 0;
+
+    int num_hits = 0;
+
+    for (int i = 0; i < list->num_events; i++) {
+        OrbitEvent *e = &list->events[i];
+        if (!e->active) continue;
+
+        const StateVector *primary = lookup(e->primary_id, context);
+        const StateVector *secondary = (e->secondary_id >= 0) ? lookup(e->secondary_id, context) : NULL;
+        if (!primary || (e->secondary_id >= 0 && !secondary)) {
+            e->primed = 0;
+            continue;
+        }
+
+        StateVector p1 = *primary, s1 = secondary ? *secondary : p1;
+        p1.time = t;
+        s1.time = t;
+        double g1 = e->g(&p1, secondary ? &s1 : NULL, e->user_data);
+
+        if (e->primed && t > e->t_prev && event_crossed(e, e->g_prev, g1)) {
+            EventBracket br;
+            br.event = e;
+            br.p0 = e->primary_prev;
+            br.p1 = p1;
+            br.s0 = e->secondary_prev;
+            br.s1 = s1;
+            br.has_secondary = (secondary != NULL);
+
+            double t_event;
+            if (event_find_root(event_bracket_eval, &br, e->t_prev, e->g_prev, t, g1,
+                                EVENT_TIME_TOLERANCE, &t_event) == 0) {
+                EventHit *hit = &list->pending[num_hits++];
+                hit->event_id = e->id;
+                hit->time = t_event;
+                event_hermite_interpolate(&br.p0, &br.p1, t_event, &hit->primary);
+                if (br.has_secondary) {
+                    event_hermite_interpolate(&br.s0, &br.s1, t_event, &hit->secondary);
+                } else {
+                    memset(&hit->secondary, 0, sizeof(StateVector));
+                }
+            }
+        }
+
+        e->primed = 1;
+        e->t_prev = t;
+        e->g_prev = g1;
+        e->primary_prev = p1;
+        e->secondary_prev = s1;
+    }
+
+    // 按事件时刻排序（插入排序，单步触发数通常很少）
+    for (int i = 1; i < num_hits; i++) {
+        EventHit key = list->pending[i];
+        int j = i - 1;
+        while (j >= 0 && list->pending[j].time > key.time) {
+            list->pending[j + 1] = list->pending[j];
+            j--;
+        }
+        list->pending[j + 1] = key;
+    }
+
+    // 回调中可能增删事件，按ID重新查找
+    int num_fired = 0;
+    for (int i = 0; i < num_hits; i++) {
+        EventHit hit = list->pending[i];
+        OrbitEvent *e = event_list_get(list, hit.event_id);
+        if (!e || !e->active) continue;
+
+        e->fire_count++;
+        e->last_fire_time = hit.time;
+        if (e->one_shot) e->active = 0;
+
+        if (hits_out && num_fired < max_hits) hits_out[num_fired] = hit;
+        num_fired++;
+        if (e->handler) {
+            OrbitEvent snapshot = *e;
+            snapshot.handler(&snapshot, hit.time, &hit.primary,
+                             snapshot.secondary_id >= 0 ? &hit.secondary : NULL, snapshot.user_data);
+        }
+    }
+
+    return num_fired;
+}
+
+/* ==================== 带事件的外推 ==================== */
+
+/* 单星外推求根上下文：由步起点重新积分 */
+typedef struct {
+    const OrbitEvent *event;
+    StateVector s0;
+    const PerturbationModel *model;
+} EventPropagateBracket;
+
+static void event_integrate_to(const StateVector *s0, double t, const PerturbationModel *model, StateVector *out) {
+    *out = *s0;
+    if (t != s0->time) orbit_rk4_step_perturbed(out, t - s0->time, model);
+}
+
+static double event_propagate_eval(double t, void *context) {
+    EventPropagateBracket *br = (EventPropagateBracket*)context;
+    StateVector s;
+    event_integrate_to(&br->s0, t, br->model, &s);
+    return br->event->g(&s, NULL, br->event->user_data);
+}
+
+/* 单步内的过零点：先对全部事件求根，再按时间顺序处理 */
+typedef struct {
+    int index;                      // events 下标
+    double time;                    // 精化后的事件时刻
+} EventCrossing;
+
+int event_propagate(StateVector *state, double duration, double max_step, const PerturbationModel *model,
+                    OrbitEvent *events, int num_events, EventHit *hit_out) {
+    if (!state || max_step <= 0 || duration < 0) return -1;
+    if (num_events > 0 && !events) return -1;
+
+    // 每个事件单步最多一个过零点，缓冲按事件数一次分配
+    EventCrossing *crossings = NULL;
+    if (num_events > 0) {
+        crossings = (EventCrossing*)malloc(sizeof(EventCrossing) * num_events);
+        if (!crossings) return -1;
+    }
+
+    // 未记录初值或状态已被外部改写的事件重新记录
+    for (int k = 0; k < num_events; k++) {
+        OrbitEvent *e = &events[k];
+        if (!e->active || !e->g) continue;
+        if (!e->primed || e->t_prev != state->time) {
+            e->g_prev = e->g(state, NULL, e->user_data);
+            e->t_prev = state->time;
+            e->primed = 1;
+        }
+    }
+
+    double t_end = state->time + duration;
+    int result = 0;
+
+    while (state->time < t_end) {
+        StateVector s0 = *state;
+        double h = fmin(max_step, t_end - s0.time);
+        orbit_rk4_step_perturbed(state, h, model);
+
+        // 1. 本步全部过零点求根，记下最早的终止事件（同一时刻取下标小者）
+        int num_crossings = 0;
+        int terminal_index = -1;
+        double terminal_time = state->time;
+
+        for (int k = 0; k < num_events; k++) {
+            OrbitEvent *e = &events[k];
+            if (!e->active || !e->g) continue;
+
+            double g1 = e->g(state, NULL, e->user_data);
+            if (event_crossed(e, e->g_prev, g1)) {
+                EventPropagateBracket br = {e, s0, model};
+                double t_event;
+                if (event_find_root(event_propagate_eval, &br, s0.time, e->g_prev, state->time, g1,
+                                    EVENT_TIME_TOLERANCE, &t_event) == 0) {
+                    if (!e->terminal) {
+                        crossings[num_crossings].index = k;
+                        crossings[num_crossings].time = t_event;
+                        num_crossings++;
+                    } else if (terminal_index < 0 || t_event < terminal_time) {
+                        terminal_time = t_event;
+                        terminal_index = k;
+                    }
+                }
+            }
+            e->g_prev = g1;
+            e->t_prev = state->time;
+        }
+
+        // 2. 非终止事件按时间排序（插入排序，稳定：同一时刻按下标），不晚于终止时刻的依次触发
+        for (int i = 1; i < num_crossings; i++) {
+            EventCrossing key = crossings[i];
+            int j = i - 1;
+            while (j >= 0 && crossings[j].time > key.time) {
+                crossings[j + 1] = crossings[j];
+                j--;
+            }
+            crossings[j + 1] = key;
+        }
+
+        for (int i = 0; i < num_crossings; i++) {
+            if (terminal_index >= 0 && crossings[i].time > terminal_time) break;
+            OrbitEvent *e = &events[crossings[i].index];
+            if (!e->active) continue;   // 同一步内先触发的回调可能停用后面的事件
+
+            StateVector s_event;
+            event_integrate_to(&s0, crossings[i].time, model, &s_event);
+            e->fire_count++;
+            e->last_fire_time = crossings[i].time;
+            if (e->one_shot) e->active = 0;
+            if (e->handler) e->handler(e, crossings[i].time, &s_event, NULL, e->user_data);
+        }
+
+        // 3. 终止事件：停在事件时刻，终止时刻之后的过零点留待下次外推
+        if (terminal_index >= 0) {
+            OrbitEvent *e = &events[terminal_index];
+            event_integrate_to(&s0, terminal_time, model, state);
+
+            for (int k = 0; k < num_events; k++) {
+                if (!events[k].active || !events[k].g) continue;
+                events[k].g_prev = events[k].g(state, NULL, events[k].user_data);
+                events[k].t_prev = state->time;
+            }
+            // 停在根上，避免下次调用时同一过零点重复触发
+            e->g_prev = 0.0;
+
+            e->fire_count++;
+            e->last_fire_time = terminal_time;
+            if (e->one_shot) e->active = 0;
+            if (e->handler) e->handler(e, terminal_time, state, NULL, e->user_data);
+
+            if (hit_out) {
+                hit_out->event_id = e->id;
+                hit_out->time = terminal_time;
+                hit_out->primary = *state;
+                memset(&hit_out->secondary, 0, sizeof(StateVector));
+            }
+            result = 1;
+            break;
+        }
+    }
+
+    free(crossings);
+    return result;
+}
@@ -3,36 +3,12 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <vector3.h>
 
 #define MU 3.986004418e5  // 地球重力参数
 #define EARTH_RADIUS 6371000. 0
 
-/**
- * 计算两个向量之间的欧氏距离
- */
-static double vector_distance(Vector3 v1, Vector3 v2) {
-    double dx = v1.x - v2.x;
-    double dy = v1.y - v2. y;
-    double dz = v1.z - v2. z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
-}
-
-/**
- * 向量规范化
- */
-static Vector3 vector_normalize(Vector3 v) {
-    double mag = sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
-    if (mag < 1e-10) return v;
-    return (Vector3){v.x/mag, v. y/mag, v.z/mag};
-}
-
-/**
- * 向量点积
- */
-static double vector_dot(Vector3 a, Vector3 b) {
-    return a.x*b. x + a.y*b. y + a.z*b. z;
-}
-
 /**
  * 计算Hohmann转移的速度增量
  */
@@ -76,7 +52,7 @@ AroundFormationState* around_formation_create(void) {
     if (!state) return NULL;
     
     memset(state, 0, sizeof(AroundFormationState));
-    printf("[AROUND] 球形围观编队已创建\n");
+    SIM_LOG("[AROUND] 球形围观编队已创建\n");
     
     return state;
 }
@@ -92,16 +68,16 @@ double around_formation_single_vs_single(
     
     if (!chaser || !target || !orbital_elements_out) return 0;
     
-    printf("[AROUND] 单对一编队: 红星%d → 蓝星%d\n", chaser->id, target->id);
+    SIM_LOG("[AROUND] 单对一编队: 红星%d → 蓝星%d\n", chaser->id, target->id);
     
     // 获取当前位置
     if (!chaser->state. position. x) {
-        printf("  警告: 卫星位置未初始化\n");
+        SIM_LOG("  警告: 卫星位置未初始化\n");
     }
     
     // 计算距离
-    double distance = vector_distance(chaser->state.position, target->state.position);
-    printf("  当前距离: %.1f km\n", distance / 1000.0);
+    double distance = vector3_distance(chaser->state.position, target->state.position);
+    SIM_LOG("  当前距离: %.1f km\n", distance / 1000.0);
     
     // 计算Hohmann转移参数
     double target_a = target->orbital_elements.a;
@@ -112,7 +88,7 @@ double around_formation_single_vs_single(
     memcpy(orbital_elements_out, &target->orbital_elements, sizeof(OrbitalElements));
     orbital_elements_out->e = 0.001;  // 圆轨道
     
-    printf("  目标轨道: a=%.1f km, 速度增量=%.4f km/s\n", target_a, delta_v);
+    SIM_LOG("  目标轨道: a=%.1f km, 速度增量=%.4f km/s\n", target_a, delta_v);
     
     return delta_v;
 }
@@ -126,7 +102,7 @@ int around_formation_multi_vs_single_sphere(
     
     if (!chasers || num_chasers <= 0 || !target) return -1;
     
-    printf("[AROUND] 多对一球形编队: %d个红星 → 蓝星%d\n", num_chasers, target->id);
+    SIM_LOG("[AROUND] 多对一球形编队: %d个红星 → 蓝星%d\n", num_chasers, target->id);
     
     // 计算球形位置
     Vector3 sphere_positions[100];
@@ -151,11 +127,11 @@ int around_formation_multi_vs_single_sphere(
         // 计算速度增量
         delta_v_out[i] = calculate_hohmann_delta_v(chaser->orbital_elements.a, orbit_a);
         
-        printf("  WX%d: a=%.1f km → %.1f km, ΔV=%.4f km/s\n",
+        SIM_LOG("  WX%d: a=%.1f km → %.1f km, ΔV=%.4f km/s\n",
                chaser->id, chaser->orbital_elements.a, orbit_a, delta_v_out[i]);
     }
     
-    printf("[AROUND] 球形编队配置完成\n");
+    SIM_LOG("[AROUND] 球形编队配置完成\n");
     return 0;
 }
 
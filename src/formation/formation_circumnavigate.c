@@ -3,16 +3,11 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <vector3.h>
 
 #define MU 3.986004418e5
 
-static double point_distance(Vector3 p1, Vector3 p2) {
-    double dx = p1.x - p2.x;
-    double dy = p1. y - p2.y;
-    double dz = p1. z - p2.z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
-}
-
 static double hohmann_delta_v(double a1, double a2) {
     if (fabs(a1 - a2) < 1.0) return 0.001;
     
@@ -42,7 +37,7 @@ CircumnavigateFormationState* circumnavigate_formation_create(void) {
         return NULL;
     }
     
-    printf("[CIRCUMNAVIGATE] 环视编队已创建\n");
+    SIM_LOG("[CIRCUMNAVIGATE] 环视编队已创建\n");
     return state;
 }
 
@@ -60,14 +55,14 @@ int circumnavigate_formation_single(
     
     if (!chaser || !target) return -1;
     
-    printf("[CIRCUMNAVIGATE] 单对一环视: 红星%d → 蓝星%d\n", chaser->id, target->id);
+    SIM_LOG("[CIRCUMNAVIGATE] 单对一环视: 红星%d → 蓝星%d\n", chaser->id, target->id);
     
     // Lambert接近：瞄准距离目标100km的位置
-    double distance = point_distance(chaser->state.position, target->state.position);
+    double distance = vector3_distance(chaser->state.position, target->state.position);
     double target_distance = 100000.0;  // 100km
     
-    printf("  当前距离: %.1f km\n", distance / 1000.0);
-    printf("  目标距离: %.1f km\n", target_distance / 1000.0);
+    SIM_LOG("  当前距离: %.1f km\n", distance / 1000.0);
+    SIM_LOG("  目标距离: %.1f km\n", target_distance / 1000.0);
     
     // 简化：使用霍曼转移到目标轨道高度
     double target_a = target->orbital_elements.a;
@@ -77,7 +72,7 @@ int circumnavigate_formation_single(
     memcpy(orbital_elements_out, &target->orbital_elements, sizeof(OrbitalElements));
     orbital_elements_out->e = 0.001;  // 圆轨道维持
     
-    printf("  轨道转移: a=%.1f→%.1f km, ΔV=%.4f km/s\n", 
+    SIM_LOG("  轨道转移: a=%.1f→%.1f km, ΔV=%.4f km/s\n", 
            chaser_a, target_a, *delta_v_out);
     
     return 0;
@@ -92,7 +87,7 @@ int circumnavigate_formation_multi(
     
     if (!chasers || num_chasers <= 0 || !target) return -1;
     
-    printf("[CIRCUMNAVIGATE] 多对一环视: %d个红星 → 蓝星%d\n", num_chasers, target->id);
+    SIM_LOG("[CIRCUMNAVIGATE] 多对一环视: %d个红星 → 蓝星%d\n", num_chasers, target->id);
     
     double target_a = target->orbital_elements.a;
     
@@ -101,7 +96,7 @@ int circumnavigate_formation_multi(
                                        &orbital_elements_out[i], &delta_v_out[i]);
     }
     
-    printf("[CIRCUMNAVIGATE] 环视编队配置完成\n");
+    SIM_LOG("[CIRCUMNAVIGATE] 环视编队配置完成\n");
     return 0;
 }
 
@@ -3,21 +3,13 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <vector3.h>
 
 #define MU 3.986004418e5
 #define EARTH_RADIUS 6371000.0
 #define PI 3.14159265359
 
-/**
- * 计算两点间距离
- */
-static double point_distance(Vector3 p1, Vector3 p2) {
-    double dx = p1.x - p2. x;
-    double dy = p1.y - p2.y;
-    double dz = p1.z - p2.z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
-}
-
 /**
  * 计算Hohmann转移速度增量
  */
@@ -51,7 +43,7 @@ InspectFormationState* inspect_formation_create(void) {
         return NULL;
     }
     
-    printf("[INSPECT] 巡视编队已创建\n");
+    SIM_LOG("[INSPECT] 巡视编队已创建\n");
     return state;
 }
 
@@ -70,14 +62,14 @@ int inspect_formation_multi_inspect_single(
     
     if (!inspectors || num_inspectors <= 0 || !target) return -1;
     
-    printf("[INSPECT] 多对一巡视: %d个红星 → 蓝星%d\n", num_inspectors, target->id);
+    SIM_LOG("[INSPECT] 多对一巡视: %d个红星 → 蓝星%d\n", num_inspectors, target->id);
     
     double target_a = target->orbital_elements.a;
     double ellipse_altitude = 30000.0;  // ±30km
     double ellipse_e = ellipse_altitude / target_a;  // 偏心率
     double ellipse_a = target_a;  // 半长轴相同
     
-    printf("  统一椭圆轨道: a=%.1f km, e=%.6f\n", ellipse_a, ellipse_e);
+    SIM_LOG("  统一椭圆轨道: a=%.1f km, e=%.6f\n", ellipse_a, ellipse_e);
     
     // 为每个巡视卫星分配轨道参数
     for (int i = 0; i < num_inspectors; i++) {
@@ -92,14 +84,14 @@ int inspect_formation_multi_inspect_single(
         // 计算速度增量
         delta_v_out[i] = hohmann_delta_v(inspector->orbital_elements.a, ellipse_a);
         
-        printf("  WX%d: 轨道变更 a=%.1f→%.1f km, e=%.1f→%.6f, ΔV=%.4f km/s\n",
+        SIM_LOG("  WX%d: 轨道变更 a=%.1f→%.1f km, e=%.1f→%.6f, ΔV=%.4f km/s\n",
                inspector->id,
                inspector->orbital_elements. a, ellipse_a,
                inspector->orbital_elements.e, ellipse_e,
                delta_v_out[i]);
     }
     
-    printf("[INSPECT] 巡视编队配置完成\n");
+    SIM_LOG("[INSPECT] 巡视编队配置完成\n");
     return 0;
 }
 
@@ -136,13 +128,14 @@ void inspect_formation_update_circle_count(
         insp_state->circle_count = 0;
         insp_state->circle_progress = 0.0;
         insp_state->inspection_started = 0;
+        insp_state->min_distance_reached = 1e10;
         state->num_states++;
     }
     
     if (! insp_state) return;
     
     // 计算距离
-    double distance = point_distance(inspector_sat->state.position, target_sat->state.position);
+    double distance = vector3_distance(inspector_sat->state.position, target_sat->state.position);
     
     // 更新最小距离
     if (distance < insp_state->min_distance_reached) {
@@ -152,7 +145,7 @@ void inspect_formation_update_circle_count(
     // 检查是否开始巡视
     if (! insp_state->inspection_started && distance < 2000000.0) {
         insp_state->inspection_started = 1;
-        printf("[INSPECT] WX%d 开始圈数统计, 距离=%.1f km\n", 
+        SIM_LOG("[INSPECT] WX%d 开始圈数统计, 距离=%.1f km\n", 
                inspector_id, distance / 1000.0);
     }
 }
@@ -3,20 +3,11 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <log.h>
+#include <vector3.h>
 
 #define MU 3.986004418e5
 
-static double point_distance(Vector3 p1, Vector3 p2) {
-    double dx = p1.x - p2.x;
-    double dy = p1. y - p2.y;
-    double dz = p1. z - p2.z;
-    return sqrt(dx*dx + dy*dy + dz*dz);
-}
-
-static double vector_magnitude(Vector3 v) {
-    return sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
-}
-
 RetreatFormationState* retreat_formation_create(void) {
     RetreatFormationState *state = (RetreatFormationState*)malloc(sizeof(RetreatFormationState));
     if (!state) return NULL;
@@ -30,7 +21,7 @@ RetreatFormationState* retreat_formation_create(void) {
         return NULL;
     }
     
-    printf("[RETREAT] 撤退编队已创建\n");
+    SIM_LOG("[RETREAT] 撤退编队已创建\n");
     return state;
 }
 
@@ -48,10 +39,10 @@ int retreat_formation_initiate_rapid(
     
     if (!red_sat || !blue_sat) return -1;
     
-    printf("[RETREAT] 快速撤退: 红星%d 远离 蓝星%d\n", red_sat->id, blue_sat->id);
+    SIM_LOG("[RETREAT] 快速撤退: 红星%d 远离 蓝星%d\n", red_sat->id, blue_sat->id);
     
     // Hohmann转移参数
-    double r_magnitude = vector_magnitude(red_sat->state.position);
+    double r_magnitude = vector3_magnitude(red_sat->state.position);
     double retreat_altitude_gain = 1500000.0;  // 1500km
     
     double r_periapsis = r_magnitude;
@@ -72,13 +63,13 @@ int retreat_formation_initiate_rapid(
     
     double total_delta_v = fabs(delta_v1) + fabs(delta_v2);
     
-    printf("  Hohmann转移参数:\n");
-    printf("    近地点: %. 1f km\n", r_periapsis / 1000.0);
-    printf("    远地点: %.1f km (增益+%. 1f km)\n", 
+    SIM_LOG("  Hohmann转移参数:\n");
+    SIM_LOG("    近地点: %. 1f km\n", r_periapsis / 1000.0);
+    SIM_LOG("    远地点: %.1f km (增益+%. 1f km)\n", 
            r_apoapsis / 1000.0, retreat_altitude_gain / 1000.0);
-    printf("    ΔV1: %.4f km/s (切向加速)\n", delta_v1);
-    printf("    ΔV2: %.4f km/s (远地点圆化)\n", delta_v2);
-    printf("    总ΔV: %.4f km/s\n", total_delta_v);
+    SIM_LOG("    ΔV1: %.4f km/s (切向加速)\n", delta_v1);
+    SIM_LOG("    ΔV2: %.4f km/s (远地点圆化)\n", delta_v2);
+    SIM_LOG("    总ΔV: %.4f km/s\n", total_delta_v);
     
     // 输出新轨道（基于当前位置但速度改变）
     memcpy(orbital_elements_out, &red_sat->orbital_elements, sizeof(OrbitalElements));
@@ -90,7 +81,7 @@ int retreat_formation_initiate_rapid(
     // 记录撤退状态
     // （在实际应用中应将状态添加到 RetreatFormationState）
     
-    printf("[RETREAT] 快速撤退配置完成\n");
+    SIM_LOG("[RETREAT] 快速撤退配置完成\n");
     return 0;
 }
 
@@ -102,10 +93,10 @@ int retreat_formation_initiate_gradual(
     
     if (! red_sat || !blue_sat) return -1;
     
-    printf("[RETREAT] 渐进撤退: 红星%d 缓慢远离 蓝星%d\n", red_sat->id, blue_sat->id);
+    SIM_LOG("[RETREAT] 渐进撤退: 红星%d 缓慢远离 蓝星%d\n", red_sat->id, blue_sat->id);
     
     // 小幅度提升
-    double r_magnitude = vector_magnitude(red_sat->state.position);
+    double r_magnitude = vector3_magnitude(red_sat->state.position);
     double altitude_gain = 1200000.0;  // 1200km
     
     double r_periapsis = r_magnitude;
@@ -118,9 +109,9 @@ int retreat_formation_initiate_gradual(
     double v_transfer = sqrt(MU * (2.0 / r_magnitude - 1.0 / a_transfer));
     double delta_v = v_transfer - v_circular;
     
-    printf("  渐进撤退参数:\n");
-    printf("    高度提升: +%.1f km\n", altitude_gain / 1000.0);
-    printf("    ΔV: %.4f km/s\n", delta_v);
+    SIM_LOG("  渐进撤退参数:\n");
+    SIM_LOG("    高度提升: +%.1f km\n", altitude_gain / 1000.0);
+    SIM_LOG("    ΔV: %.4f km/s\n", delta_v);
     
     memcpy(orbital_elements_out, &red_sat->orbital_elements, sizeof(OrbitalElements));
     orbital_elements_out->a = a_transfer;
@@ -128,7 +119,7 @@ int retreat_formation_initiate_gradual(
     
     *delta_v_out = fabs(delta_v) * 2.0;  // 估算总ΔV
     
-    printf("[RETREAT] 渐进撤退配置完成\n");
+    SIM_LOG("[RETREAT] 渐进撤退配置完成\n");
     return 0;
 }
 
@@ -153,16 +144,16 @@ int retreat_formation_update_phase(
     if (retreat_state->phase == 1) {
         // Phase 1: 脉冲1完成，进入滑行
         retreat_state->phase = 2;
-        printf("[RETREAT] WX%d: 第一次脉冲完成，进入滑行\n", sat_id);
+        SIM_LOG("[RETREAT] WX%d: 第一次脉冲完成，进入滑行\n", sat_id);
     } else if (retreat_state->phase == 2) {
         // Phase 2: 滑行到远地点
         // 简化：10步后进入Phase 3
         retreat_state->phase = 3;
-        printf("[RETREAT] WX%d: 到达远地点，准备第二次脉冲\n", sat_id);
+        SIM_LOG("[RETREAT] WX%d: 到达远地点，准备第二次脉冲\n", sat_id);
     } else if (retreat_state->phase == 3) {
         // Phase 3: 施加第二次脉冲
         retreat_state->phase = 4;
-        printf("[RETREAT] WX%d: 施加第二次脉冲，进入高轨维持\n", sat_id);
+        SIM_LOG("[RETREAT] WX%d: 施加第二次脉冲，进入高轨维持\n", sat_id);
     }
     
     return 0;
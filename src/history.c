@@ -0,0 +1,520 @@
+#include <history.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HISTORY_MAGIC         0x54534948U   // "HIST"
+#define HISTORY_FIELDS        7             // time + 位置3 + 速度3
+#define HISTORY_ZERO_XOR      0xFF          // 预测完全命中，无负载字节
+
+/* ==================== 内部函数：压缩编解码 ==================== */
+
+static inline uint64_t history_bits(double x) {
+    uint64_t u;
+    memcpy(&u, &x, sizeof(u));
+    return u;
+}
+
+static inline double history_double(uint64_t u) {
+    double x;
+    memcpy(&x, &u, sizeof(x));
+    return x;
+}
+
+static inline void history_fields(const HistorySample *s, double f[HISTORY_FIELDS]) {
+    f[0] = s->time;
+    f[1] = s->position.x; f[2] = s->position.y; f[3] = s->position.z;
+    f[4] = s->velocity.x; f[5] = s->velocity.y; f[6] = s->velocity.z;
+}
+
+/**
+ * 线性外推预测（差分的差分为0），块内前两个样本分别预测为0和上一值
+ * 乘2是精确运算，编码端和解码端得到逐位相同的预测
+ */
+static inline double history_predict(uint32_t i, double p1, double p2) {
+    if (i == 0) return 0.0;
+    if (i == 1) return p1;
+    return 2.0 * p1 - p2;
+}
+
+/* 单个字段：头字节 = (前导零字节数<<4)|末尾零字节数，随后是中间的有效字节 */
+static uint8_t* history_put_xor(uint8_t *p, uint64_t x) {
+    if (x == 0) {
+        *p++ = HISTORY_ZERO_XOR;
+        return p;
+    }
+    int lz = 0, tz = 0;
+    while (lz < 8 && ((x >> (8 * (7 - lz))) & 0xFF) == 0) lz++;
+    while (tz < 8 && ((x >> (8 * tz)) & 0xFF) == 0) tz++;
+    *p++ = (uint8_t)((lz << 4) | tz);
+    for (int b = tz; b < 8 - lz; b++) {
+        *p++ = (uint8_t)(x >> (8 * b));
+    }
+    return p;
+}
+
+static const uint8_t* history_get_xor(const uint8_t *p, const uint8_t *end, uint64_t *x) {
+    if (p >= end) return NULL;
+    uint8_t header = *p++;
+    *x = 0;
+    if (header == HISTORY_ZERO_XOR) return p;
+    int lz = header >> 4, tz = header & 0x0F;
+    if (lz + tz >= 8 || p + (8 - lz - tz) > end) return NULL;
+    for (int b = tz; b < 8 - lz; b++) {
+        *x |= (uint64_t)(*p++) << (8 * b);
+    }
+    return p;
+}
+
+/* 最坏情况每样本字节数：7个字段各 1+8 字节，编队 1+4 字节 */
+#define HISTORY_MAX_ENCODED_SAMPLE  (HISTORY_FIELDS * 9 + 5)
+
+static size_t history_encode_block(const HistorySample *samples, uint32_t n, uint8_t *out) {
+    double p1[HISTORY_FIELDS] = {0}, p2[HISTORY_FIELDS] = {0};
+    int32_t formation = 0;
+    uint8_t *p = out;
+
+    for (uint32_t i = 0; i < n; i++) {
+        double f[HISTORY_FIELDS];
+        history_fields(&samples[i], f);
+        for (int k = 0; k < HISTORY_FIELDS; k++) {
+            double pred = history_predict(i, p1[k], p2[k]);
+            p = history_put_xor(p, history_bits(f[k]) ^ history_bits(pred));
+            p2[k] = p1[k];
+            p1[k] = f[k];
+        }
+
+        // 编队类型很少变化：0=不变，1=随后4字节新值
+        if (i == 0 || samples[i].formation != formation) {
+            formation = samples[i].formation;
+            *p++ = 1;
+            memcpy(p, &formation, sizeof(formation));
+            p += sizeof(formation);
+        } else {
+            *p++ = 0;
+        }
+    }
+    return (size_t)(p - out);
+}
+
+static int history_decode_block(const HistoryBlock *block, HistorySample *out) {
+    double p1[HISTORY_FIELDS] = {0}, p2[HISTORY_FIELDS] = {0};
+    int32_t formation = 0;
+    const uint8_t *p = block->data;
+    const uint8_t *end = block->data + block->size;
+
+    for (uint32_t i = 0; i < block->count; i++) {
+        double f[HISTORY_FIELDS];
+        for (int k = 0; k < HISTORY_FIELDS; k++) {
+            uint64_t x;
+            p = history_get_xor(p, end, &x);
+            if (!p) return -1;
+            double pred = history_predict(i, p1[k], p2[k]);
+            f[k] = history_double(x ^ history_bits(pred));
+            p2[k] = p1[k];
+            p1[k] = f[k];
+        }
+
+        if (p >= end) return -1;
+        if (*p++ == 1) {
+            if (p + sizeof(formation) > end) return -1;
+            memcpy(&formation, p, sizeof(formation));
+            p += sizeof(formation);
+        }
+
+        out[i].time = f[0];
+        out[i].position = (Vector3){f[1], f[2], f[3]};
+        out[i].velocity = (Vector3){f[4], f[5], f[6]};
+        out[i].formation = formation;
+    }
+    return 0;
+}
+
+/* ==================== 内部函数：内存 ==================== */
+
+/* allocator 为NULL时走系统堆 */
+static void* history_mem_alloc(SlabAllocator *allocator, size_t size) {
+    return allocator ? slab_alloc(allocator, size) : malloc(size);
+}
+
+static void* history_mem_calloc(SlabAllocator *allocator, size_t size) {
+    return allocator ? slab_calloc(allocator, size) : calloc(1, size);
+}
+
+static void history_mem_free(SlabAllocator *allocator, void *ptr, size_t size) {
+    if (allocator) {
+        slab_free(allocator, ptr, size);
+    } else {
+        free(ptr);
+    }
+}
+
+/* 压缩块按实际字节数从系统堆分配（slab 尺寸级向上取2的幂，最多浪费近一半），空块占1字节 */
+static inline uint8_t* history_block_alloc(uint32_t size) {
+    return (uint8_t*)malloc(size ? size : 1);
+}
+
+/* ==================== 内部函数：分层缓冲 ==================== */
+
+static void history_ring_push(HistoryRing *ring, const HistorySample *sample) {
+    ring->samples[ring->head] = *sample;
+    ring->head = (ring->head + 1) % ring->capacity;
+    if (ring->count < ring->capacity) ring->count++;
+}
+
+/* 第 i 个（0 为最旧）样本 */
+static const HistorySample* history_ring_at(const HistoryRing *ring, uint32_t i) {
+    uint32_t oldest = (ring->head + ring->capacity - ring->count) % ring->capacity;
+    return &ring->samples[(oldest + i) % ring->capacity];
+}
+
+static int history_cold_flush(HistoryColdTier *cold) {
+    if (cold->staging_count == 0) return 0;
+
+    size_t size = history_encode_block(cold->staging, cold->staging_count, cold->scratch);
+    uint8_t *data = history_block_alloc((uint32_t)size);
+    if (!data) return -1;
+    memcpy(data, cold->scratch, size);
+
+    // 块环满时丢弃最旧块
+    HistoryBlock *slot = &cold->blocks[cold->head];
+    if (cold->count == cold->max_blocks) {
+        cold->compressed_bytes -= slot->size;
+        free(slot->data);
+    } else {
+        cold->count++;
+    }
+    slot->data = data;
+    slot->size = (uint32_t)size;
+    slot->count = cold->staging_count;
+    cold->head = (cold->head + 1) % cold->max_blocks;
+    cold->compressed_bytes += size;
+    cold->staging_count = 0;
+    return 0;
+}
+
+static const HistoryBlock* history_cold_block_at(const HistoryColdTier *cold, uint32_t i) {
+    uint32_t oldest = (cold->head + cold->max_blocks - cold->count) % cold->max_blocks;
+    return &cold->blocks[(oldest + i) % cold->max_blocks];
+}
+
+/* ==================== 创建和销毁 ==================== */
+
+void history_config_default(HistoryConfig *config, uint32_t recent_capacity) {
+    if (!config) return;
+    memset(config, 0, sizeof(HistoryConfig));
+    if (recent_capacity == 0) recent_capacity = HISTORY_DEFAULT_CAPACITY;
+
+    config->num_tiers = 3;
+    uint32_t decimation = 1;
+    for (int k = 0; k < config->num_tiers; k++) {
+        config->capacity[k] = recent_capacity;
+        config->decimation[k] = decimation;
+        decimation *= HISTORY_DEFAULT_DECIMATION;
+    }
+    config->compress_cold = 1;
+    config->block_samples = HISTORY_BLOCK_SAMPLES;
+}
+
+TrajectoryHistory* history_create(const HistoryConfig *config, SlabAllocator *allocator) {
+    if (!config || config->num_tiers <= 0 || config->num_tiers > HISTORY_MAX_TIERS) return NULL;
+    for (int k = 0; k < config->num_tiers; k++) {
+        if (config->capacity[k] == 0 || config->decimation[k] == 0) return NULL;
+    }
+    if (config->decimation[0] != 1) return NULL;   // 第0层必须保留每个样本
+    if (config->compress_cold && (config->num_tiers < 2 || config->block_samples == 0)) return NULL;
+
+    TrajectoryHistory *history = (TrajectoryHistory*)history_mem_calloc(allocator, sizeof(TrajectoryHistory));
+    if (!history) return NULL;
+    history->allocator = allocator;
+    history->config = *config;
+    history->num_rings = config->compress_cold ? config->num_tiers - 1 : config->num_tiers;
+
+    for (int k = 0; k < history->num_rings; k++) {
+        HistoryRing *ring = &history->rings[k];
+        ring->samples = (HistorySample*)history_mem_alloc(allocator,
+                                                          sizeof(HistorySample) * config->capacity[k]);
+        if (!ring->samples) {
+            history_destroy(history);
+            return NULL;
+        }
+        ring->capacity = config->capacity[k];
+        ring->decimation = config->decimation[k];
+    }
+
+    if (config->compress_cold) {
+        int k = config->num_tiers - 1;
+        HistoryColdTier *cold = &history->cold;
+        cold->block_samples = config->block_samples;
+        cold->max_blocks = (config->capacity[k] + config->block_samples - 1) / config->block_samples;
+        cold->decimation = config->decimation[k];
+        cold->blocks = (HistoryBlock*)history_mem_calloc(allocator,
+                                                         sizeof(HistoryBlock) * cold->max_blocks);
+        cold->staging = (HistorySample*)history_mem_alloc(allocator,
+                                                          sizeof(HistorySample) * cold->block_samples);
+        cold->scratch = (uint8_t*)history_mem_alloc(allocator,
+                                                    (size_t)cold->block_samples * HISTORY_MAX_ENCODED_SAMPLE);
+        if (!cold->blocks || !cold->staging || !cold->scratch) {
+            history_destroy(history);
+            return NULL;
+        }
+    }
+
+    return history;
+}
+
+void history_clear(TrajectoryHistory *history) {
+    if (!history) return;
+    for (int k = 0; k < history->num_rings; k++) {
+        history->rings[k].head = 0;
+        history->rings[k].count = 0;
+    }
+    HistoryColdTier *cold = &history->cold;
+    for (uint32_t b = 0; cold->blocks && b < cold->max_blocks; b++) {
+        free(cold->blocks[b].data);
+        cold->blocks[b].data = NULL;
+        cold->blocks[b].size = 0;
+        cold->blocks[b].count = 0;
+    }
+    cold->head = 0;
+    cold->count = 0;
+    cold->staging_count = 0;
+    cold->compressed_bytes = 0;
+    history->total_appended = 0;
+}
+
+void history_destroy(TrajectoryHistory *history) {
+    if (!history) return;
+    history_clear(history);
+    SlabAllocator *allocator = history->allocator;
+    for (int k = 0; k < history->num_rings; k++) {
+        history_mem_free(allocator, history->rings[k].samples,
+                         sizeof(HistorySample) * history->config.capacity[k]);
+    }
+    history_mem_free(allocator, history->cold.blocks, sizeof(HistoryBlock) * history->cold.max_blocks);
+    history_mem_free(allocator, history->cold.staging, sizeof(HistorySample) * history->cold.block_samples);
+    history_mem_free(allocator, history->cold.scratch,
+                     (size_t)history->cold.block_samples * HISTORY_MAX_ENCODED_SAMPLE);
+    history_mem_free(allocator, history, sizeof(TrajectoryHistory));
+}
+
+/* ==================== 记录和读取 ==================== */
+
+int history_append(TrajectoryHistory *history, const HistorySample *sample) {
+    if (!history || !sample) return -1;
+
+    uint64_t index = history->total_appended++;
+    for (int k = 0; k < history->num_rings; k++) {
+        if (index % history->rings[k].decimation == 0) {
+            history_ring_push(&history->rings[k], sample);
+        }
+    }
+
+    HistoryColdTier *cold = &history->cold;
+    if (history->config.compress_cold && index % cold->decimation == 0) {
+        cold->staging[cold->staging_count++] = *sample;
+        if (cold->staging_count == cold->block_samples && history_cold_flush(cold) != 0) {
+            // 压缩失败时丢弃该块，不影响近期层
+            cold->staging_count = 0;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int history_latest(const TrajectoryHistory *history, uint32_t back, HistorySample *out) {
+    if (!history || !out || history->num_rings == 0) return -1;
+    const HistoryRing *ring = &history->rings[0];
+    if (back >= ring->count) return -1;
+    *out = *history_ring_at(ring, ring->count - 1 - back);
+    return 0;
+}
+
+/* 追加一个样本到输出（超出容量只计数） */
+static void history_emit(HistorySample *out, int max_samples, int *n, const HistorySample *s) {
+    if (out && *n < max_samples) out[*n] = *s;
+    (*n)++;
+}
+
+int history_collect(const TrajectoryHistory *history, HistorySample *out, int max_samples) {
+    if (!history) return 0;
+    if (!out) max_samples = 0;
+
+    // 各层按从粗到细输出，每层只输出早于下一细层最旧样本的部分
+    int num_tiers = history->config.num_tiers;
+    double cutoff[HISTORY_MAX_TIERS];
+    for (int k = 0; k < num_tiers; k++) {
+        cutoff[k] = 1e300;
+        if (k == 0) continue;
+        const HistoryRing *finer = &history->rings[k - 1];
+        if (finer->count > 0) cutoff[k] = history_ring_at(finer, 0)->time;
+    }
+
+    int n = 0;
+    const HistoryColdTier *cold = &history->cold;
+    if (history->config.compress_cold) {
+        double limit = cutoff[num_tiers - 1];
+        HistorySample *decoded = (HistorySample*)malloc(sizeof(HistorySample) * cold->block_samples);
+        if (decoded) {
+            for (uint32_t b = 0; b < cold->count; b++) {
+                const HistoryBlock *block = history_cold_block_at(cold, b);
+                if (history_decode_block(block, decoded) != 0) {
+                    fprintf(stderr, "错误：历史压缩块损坏\n");
+                    break;
+                }
+                for (uint32_t i = 0; i < block->count; i++) {
+                    if (decoded[i].time < limit) history_emit(out, max_samples, &n, &decoded[i]);
+                }
+            }
+            free(decoded);
+        }
+        for (uint32_t i = 0; i < cold->staging_count; i++) {
+            if (cold->staging[i].time < limit) history_emit(out, max_samples, &n, &cold->staging[i]);
+        }
+    }
+
+    for (int k = history->num_rings - 1; k >= 0; k--) {
+        const HistoryRing *ring = &history->rings[k];
+        for (uint32_t i = 0; i < ring->count; i++) {
+            const HistorySample *s = history_ring_at(ring, i);
+            if (s->time < cutoff[k]) history_emit(out, max_samples, &n, s);
+        }
+    }
+
+    return (out && n > max_samples) ? max_samples : n;
+}
+
+size_t history_memory_bytes(const TrajectoryHistory *history) {
+    if (!history) return 0;
+    size_t bytes = sizeof(TrajectoryHistory);
+    for (int k = 0; k < history->num_rings; k++) {
+        bytes += sizeof(HistorySample) * history->rings[k].capacity;
+    }
+    if (history->config.compress_cold) {
+        bytes += sizeof(HistoryBlock) * history->cold.max_blocks;
+        bytes += sizeof(HistorySample) * history->cold.block_samples;
+        bytes += (size_t)history->cold.block_samples * HISTORY_MAX_ENCODED_SAMPLE;
+        bytes += history->cold.compressed_bytes;
+    }
+    return bytes;
+}
+
+/* ==================== 序列化 ==================== */
+
+/* 格式：魔数 配置 总数 | 各未压缩层: 数量 样本[旧->新] | 冷层: 暂存数 样本 块数 {样本数 字节数 数据}[旧->新] */
+
+static uint8_t* history_put(uint8_t *p, const void *data, size_t size, size_t *total) {
+    if (p) {
+        memcpy(p, data, size);
+        p += size;
+    }
+    *total += size;
+    return p;
+}
+
+size_t history_serialize(const TrajectoryHistory *history, uint8_t *out) {
+    if (!history) return 0;
+    size_t total = 0;
+    uint8_t *p = out;
+    uint32_t magic = HISTORY_MAGIC;
+
+    p = history_put(p, &magic, sizeof(magic), &total);
+    p = history_put(p, &history->config, sizeof(HistoryConfig), &total);
+    p = history_put(p, &history->total_appended, sizeof(uint64_t), &total);
+
+    for (int k = 0; k < history->num_rings; k++) {
+        const HistoryRing *ring = &history->rings[k];
+        p = history_put(p, &ring->count, sizeof(uint32_t), &total);
+        for (uint32_t i = 0; i < ring->count; i++) {
+            p = history_put(p, history_ring_at(ring, i), sizeof(HistorySample), &total);
+        }
+    }
+
+    if (history->config.compress_cold) {
+        const HistoryColdTier *cold = &history->cold;
+        p = history_put(p, &cold->staging_count, sizeof(uint32_t), &total);
+        p = history_put(p, cold->staging, sizeof(HistorySample) * cold->staging_count, &total);
+        p = history_put(p, &cold->count, sizeof(uint32_t), &total);
+        for (uint32_t b = 0; b < cold->count; b++) {
+            const HistoryBlock *block = history_cold_block_at(cold, b);
+            p = history_put(p, &block->count, sizeof(uint32_t), &total);
+            p = history_put(p, &block->size, sizeof(uint32_t), &total);
+            p = history_put(p, block->data, block->size, &total);
+        }
+    }
+
+    return total;
+}
+
+/* 带边界检查的读取 */
+static int history_get(const uint8_t **p, const uint8_t *end, void *dst, size_t size) {
+    if ((size_t)(end - *p) < size) return -1;
+    memcpy(dst, *p, size);
+    *p += size;
+    return 0;
+}
+
+TrajectoryHistory* history_deserialize(const uint8_t *data, size_t size, SlabAllocator *allocator) {
+    if (!data) return NULL;
+    const uint8_t *p = data;
+    const uint8_t *end = data + size;
+
+    uint32_t magic = 0;
+    HistoryConfig config;
+    uint64_t total_appended = 0;
+    if (history_get(&p, end, &magic, sizeof(magic)) != 0 || magic != HISTORY_MAGIC ||
+        history_get(&p, end, &config, sizeof(config)) != 0 ||
+        history_get(&p, end, &total_appended, sizeof(total_appended)) != 0) {
+        return NULL;
+    }
+
+    TrajectoryHistory *history = history_create(&config, allocator);
+    if (!history) return NULL;
+    history->total_appended = total_appended;
+
+    for (int k = 0; k < history->num_rings; k++) {
+        HistoryRing *ring = &history->rings[k];
+        uint32_t count = 0;
+        if (history_get(&p, end, &count, sizeof(count)) != 0 || count > ring->capacity ||
+            history_get(&p, end, ring->samples, sizeof(HistorySample) * count) != 0) {
+            goto fail;
+        }
+        ring->count = count;
+        ring->head = count % ring->capacity;
+    }
+
+    if (config.compress_cold) {
+        HistoryColdTier *cold = &history->cold;
+        uint32_t staging_count = 0, num_blocks = 0;
+        if (history_get(&p, end, &staging_count, sizeof(staging_count)) != 0 ||
+            staging_count >= cold->block_samples ||
+            history_get(&p, end, cold->staging, sizeof(HistorySample) * staging_count) != 0 ||
+            history_get(&p, end, &num_blocks, sizeof(num_blocks)) != 0 ||
+            num_blocks > cold->max_blocks) {
+            goto fail;
+        }
+        cold->staging_count = staging_count;
+
+        for (uint32_t b = 0; b < num_blocks; b++) {
+            HistoryBlock *block = &cold->blocks[b];
+            if (history_get(&p, end, &block->count, sizeof(uint32_t)) != 0 ||
+                history_get(&p, end, &block->size, sizeof(uint32_t)) != 0 ||
+                block->count > cold->block_samples || (size_t)(end - p) < block->size) {
+                goto fail;
+            }
+            block->data = history_block_alloc(block->size);
+            if (!block->data) goto fail;
+            memcpy(block->data, p, block->size);
+            p += block->size;
+            cold->count++;
+            cold->compressed_bytes += block->size;
+        }
+        cold->head = cold->count % cold->max_blocks;
+    }
+
+    return history;
+
+fail:
+    history_destroy(history);
+    return NULL;
+}
@@ -8,6 +8,11 @@
 #include "formation/formation_inspect.h"
 #include "formation/formation_circumnavigate.h"
 #include "formation/formation_retreat.h"
+#include <decision/decision_tree.h>
+#include <decision/differential_game.h>
+#include <log.h>
+#include <profiler.h>
+#include <trace.h>
 
 /* ==================== 内部函数声明 ==================== */
 
@@ -17,7 +22,7 @@
 static int kinematics_engine_create_formations(KinematicsEngine *engine) {
     if (! engine) return -1;
     
-    printf("[Kinematics] 正在创建编队控制器...\n");
+    SIM_LOG("[Kinematics] 正在创建编队控制器...\n");
     
     // 创建所有编队控制器
     AroundFormationState *around = around_formation_create();
@@ -43,7 +48,7 @@ static int kinematics_engine_create_formations(KinematicsEngine *engine) {
     engine->formation_controllers.circumnavigate_state = circum;
     engine->formation_controllers.retreat_state = retreat;
     
-    printf("[Kinematics] ✓ 所有编队控制器已创建\n");
+    SIM_LOG("[Kinematics] ✓ 所有编队控制器已创建\n");
     return 0;
 }
 
@@ -53,7 +58,7 @@ static int kinematics_engine_create_formations(KinematicsEngine *engine) {
 static void kinematics_engine_destroy_formations(KinematicsEngine *engine) {
     if (!engine) return;
     
-    printf("[Kinematics] 正在销毁编队控制器...\n");
+    SIM_LOG("[Kinematics] 正在销毁编队控制器...\n");
     
     if (engine->formation_controllers.around_state) {
         around_formation_destroy((AroundFormationState*)engine->formation_controllers.around_state);
@@ -75,11 +80,178 @@ static void kinematics_engine_destroy_formations(KinematicsEngine *engine) {
         engine->formation_controllers.retreat_state = NULL;
     }
     
-    printf("[Kinematics] ✓ 所有编队控制器已销毁\n");
+    SIM_LOG("[Kinematics] ✓ 所有编队控制器已销毁\n");
+}
+
+/**
+ * 查找卫星作为从星的相对运动链接（按卫星上记录的下标，O(1)）
+ */
+static RelativeMotionLink* kinematics_engine_find_link(KinematicsEngine *engine, const Satellite *deputy) {
+    if (deputy->relative_link <= 0 || deputy->relative_link > engine->num_relative_links) return NULL;
+    return &engine->relative_links[deputy->relative_link - 1];
+}
+
+/**
+ * 删除与卫星相关的所有相对运动链接
+ */
+static void kinematics_engine_drop_links(KinematicsEngine *engine, const Satellite *sat) {
+    int kept = 0;
+    for (int i = 0; i < engine->num_relative_links; i++) {
+        RelativeMotionLink *link = &engine->relative_links[i];
+        if (link->chief == sat || link->deputy == sat) {
+            link->deputy->relative_link = 0;
+            continue;
+        }
+        engine->relative_links[kept++] = *link;
+        link->deputy->relative_link = kept;
+    }
+    engine->num_relative_links = kept;
+}
+
+/**
+ * 卫星ID哈希槽位（Fibonacci散列）
+ */
+static inline uint32_t kinematics_engine_id_slot(int sat_id, int capacity) {
+    return ((uint32_t)sat_id * 2654435769u) & (uint32_t)(capacity - 1);
+}
+
+/**
+ * 向ID索引插入卫星（重复ID保留先加入的，与线性查找语义一致）
+ */
+static void kinematics_engine_index_insert(KinematicsEngine *engine, Satellite *sat) {
+    uint32_t mask = (uint32_t)engine->id_index_capacity - 1;
+    uint32_t slot = kinematics_engine_id_slot(sat->id, engine->id_index_capacity);
+    while (engine->id_index[slot]) {
+        if (engine->id_index[slot]->id == sat->id) return;
+        slot = (slot + 1) & mask;
+    }
+    engine->id_index[slot] = sat;
+}
+
+/**
+ * 重建ID索引，容量保持在卫星数两倍以上（负载率 ≤ 0.5）
+ */
+static int kinematics_engine_rebuild_index(KinematicsEngine *engine) {
+    int capacity = engine->id_index_capacity > 0 ? engine->id_index_capacity : 64;
+    while (capacity < (engine->satellite_count + 1) * 2) capacity *= 2;
+
+    if (capacity != engine->id_index_capacity) {
+        Satellite **index = (Satellite**)calloc((size_t)capacity, sizeof(Satellite*));
+        if (!index) return -1;
+        free(engine->id_index);
+        engine->id_index = index;
+        engine->id_index_capacity = capacity;
+    } else {
+        memset(engine->id_index, 0, sizeof(Satellite*) * (size_t)capacity);
+    }
+
+    for (int i = 0; i < engine->satellite_count; i++) {
+        if (engine->satellites[i]) kinematics_engine_index_insert(engine, engine->satellites[i]);
+    }
+    return 0;
+}
+
+/**
+ * 事件检测用的卫星状态查询
+ */
+static const StateVector* kinematics_engine_lookup_state(int sat_id, void *context) {
+    Satellite *sat = kinematics_engine_get_satellite((KinematicsEngine*)context, sat_id);
+    return sat ? &sat->state : NULL;
+}
+
+/**
+ * 按周期初始化时钟，首次在 t=0 触发
+ */
+static void sim_clock_init(SimClock *clock, double period) {
+    clock->period = period;
+    clock->next_time = 0.0;
+    clock->tick_count = 0;
+    clock->enabled = 1;
+}
+
+/**
+ * 时钟到期判断，到期时推进到下一个周期
+ */
+static int sim_clock_due(SimClock *clock, double t) {
+    const double eps = 1e-9;
+    if (!clock->enabled || t + eps < clock->next_time) return 0;
+    while (clock->next_time <= t + eps) {
+        clock->next_time += clock->period;
+    }
+    clock->tick_count++;
+    return 1;
+}
+
+/**
+ * 姿态子步长：配置值不超过动力学步长，未配置时取动力学步长
+ */
+static double kinematics_engine_attitude_period(const KinematicsEngine *engine) {
+    double a = engine->config.attitude_time_step;
+    return (a > 0 && a < engine->dt_seconds) ? a : engine->dt_seconds;
+}
+
+/**
+ * 姿态子步进：全队装入 SoA 批量步进，每个子步只积分死区外的卫星
+ * 姿态时钟只计实际执行的子步（无卫星机动时不计）
+ */
+static void kinematics_engine_step_attitude(KinematicsEngine *engine, double duration) {
+    double h = engine->clocks[SIM_CLOCK_ATTITUDE].period;
+    int substeps = (int)ceil(duration / h - 1e-9);
+    if (substeps < 1) substeps = 1;
+    h = duration / substeps;
+    int executed = 0;
+    
+    AttitudeFleet *fleet = &engine->attitude_fleet;
+    attitude_fleet_clear(fleet);
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat || sat->attitude.target_id < 0) continue;
+        
+        Satellite *target = kinematics_engine_get_satellite(engine, sat->attitude.target_id);
+        if (!target) continue;
+        
+        Vector3 direction = vector3_sub(target->state.position, sat->state.position);
+        if (attitude_fleet_add(fleet, &sat->attitude, direction) < 0) {
+            // 内存不足：退回逐星步进
+            int k = 0;
+            for (; k < substeps; k++) {
+                if (!attitude_tracker_is_slewing(&sat->attitude, direction)) break;
+                engine->attitude_substeps++;
+                attitude_tracker_slew_step(&sat->attitude, direction, h);
+            }
+            if (k > executed) executed = k;
+        }
+    }
+    
+    int k = 0;
+    for (; k < substeps; k++) {
+        int stepped = attitude_fleet_step(fleet, h);
+        if (stepped == 0) break;
+        engine->attitude_substeps += (uint32_t)stepped;
+    }
+    if (k > executed) executed = k;
+    attitude_fleet_store(fleet);
+    engine->clocks[SIM_CLOCK_ATTITUDE].tick_count += (uint32_t)executed;
 }
 
 /* ==================== 公开接口实现 ==================== */
 
+/* 批量内核指令集：配置指定且本机支持时用指定值，否则取本机最宽（进程内全局生效） */
+static Vector3SoAIsa kinematics_engine_select_isa(const char *name) {
+    Vector3SoAIsa best = vector3_soa_detect_isa();
+    Vector3SoAIsa isa = best;
+    if (name && name[0]) {
+        int requested = vector3_soa_isa_from_name(name);
+        if (requested < 0 || requested > (int)best) {
+            fprintf(stderr, "警告：本机不支持内核指令集 %s，改用 %s\n", name, vector3_soa_isa_name(best));
+        } else {
+            isa = (Vector3SoAIsa)requested;
+        }
+    }
+    if (vector3_soa_get_isa() != isa) vector3_soa_set_isa(isa);
+    return isa;
+}
+
 KinematicsEngine* kinematics_engine_create(SimulationConfig config) {
     KinematicsEngine *engine = (KinematicsEngine*)malloc(sizeof(KinematicsEngine));
     if (!engine) {
@@ -87,6 +259,16 @@ KinematicsEngine* kinematics_engine_create(SimulationConfig config) {
         return NULL;
     }
     
+    // 引擎内存按需申请，此处不分配
+    slab_init(&engine->slab, 0);
+    engine->external_satellites = 0;
+    arena_init(&engine->scratch, 0);
+    attitude_fleet_init(&engine->attitude_fleet);
+    memset(&engine->orbit_position, 0, sizeof(Vector3SoA));
+    memset(&engine->orbit_velocity, 0, sizeof(Vector3SoA));
+    engine->orbit_batch_sats = NULL;
+    engine->proximity = NULL;
+    
     // 初始化卫星数组
     engine->satellites = (Satellite**)malloc(sizeof(Satellite*) * 100);
     if (!engine->satellites) {
@@ -95,12 +277,20 @@ KinematicsEngine* kinematics_engine_create(SimulationConfig config) {
     }
     engine->satellite_count = 0;
     engine->satellite_capacity = 100;
+    engine->id_index = NULL;
+    engine->id_index_capacity = 0;
+    if (kinematics_engine_rebuild_index(engine) != 0) {
+        free(engine->satellites);
+        free(engine);
+        return NULL;
+    }
     
     // 初始化基本参数
     engine->dt_seconds = config.time_step;
     engine->current_time = 0;
     engine->step_count = 0;
     engine->config = config;
+    engine->kernel_isa = kinematics_engine_select_isa(config.kernel_isa);
     
     // 初始化编队数组
     engine->formations = (Formation**)malloc(sizeof(Formation*) * 10);
@@ -112,6 +302,35 @@ KinematicsEngine* kinematics_engine_create(SimulationConfig config) {
     engine->formation_count = 0;
     engine->num_formations = 0;
     
+    // 编队管理器（触发器按卫星注册）
+    engine->formation_manager = formation_manager_create();
+    if (!engine->formation_manager) {
+        free(engine->formations);
+        free(engine->satellites);
+        free(engine);
+        return NULL;
+    }
+    
+    engine->relative_links = NULL;
+    engine->num_relative_links = 0;
+    engine->relative_links_capacity = 0;
+    
+    event_list_init(&engine->events);
+    
+    // ===== 多速率时钟（未配置的周期取默认值） =====
+    double dt = config.time_step;
+    double attitude_dt = kinematics_engine_attitude_period(engine);
+    double control_dt = (config.control_interval > 0) ? config.control_interval : dt;
+    double decision_dt = (config.decision_interval > 0) ? config.decision_interval : DECISION_DEFAULT_STEPS * dt;
+    sim_clock_init(&engine->clocks[SIM_CLOCK_DYNAMICS], dt);
+    sim_clock_init(&engine->clocks[SIM_CLOCK_ATTITUDE], attitude_dt);
+    sim_clock_init(&engine->clocks[SIM_CLOCK_CONTROL], control_dt);
+    sim_clock_init(&engine->clocks[SIM_CLOCK_DECISION], decision_dt);
+    strncpy(engine->strategy, "GJ", sizeof(engine->strategy));
+    engine->attitude_substeps = 0;
+    engine->seed = RNG_DEFAULT_SEED;
+    rng_seed(&engine->rng, RNG_DEFAULT_SEED);
+    
     // 初始化文件指针
     engine->state_file = NULL;
     engine->maneuver_file = NULL;
@@ -126,34 +345,84 @@ KinematicsEngine* kinematics_engine_create(SimulationConfig config) {
     
     if (kinematics_engine_create_formations(engine) != 0) {
         fprintf(stderr, "错误：编队控制器初始化失败\n");
+        formation_manager_destroy(engine->formation_manager);
         free(engine->satellites);
         free(engine->formations);
         free(engine);
         return NULL;
     }
     
-    printf("[Kinematics] ✓ KinematicsEngine创建成功\n");
+    // ===== 初始化摄动模型（按场景时长预生成日月星历） =====
+    double span_seconds = (double)config.max_steps * config.time_step;
+    if (perturbation_model_init(&engine->perturbations, config.perturbation_flags,
+                                config.epoch_jd, span_seconds) != 0) {
+        fprintf(stderr, "错误：摄动模型初始化失败\n");
+        kinematics_engine_destroy_formations(engine);
+        formation_manager_destroy(engine->formation_manager);
+        free(engine->satellites);
+        free(engine->formations);
+        free(engine);
+        return NULL;
+    }
+    
+    // ===== 运行时参数（初始块取自配置） =====
+    engine->pending_params = NULL;
+    engine->retired_params = NULL;
+    engine->params_readers = 0;
+    engine->params = runtime_params_create(&config);
+    if (!engine->params) {
+        kinematics_engine_destroy(engine);
+        return NULL;
+    }
+    
+    SIM_LOG("[Kinematics] ✓ 批量内核指令集: %s\n", vector3_soa_isa_name(engine->kernel_isa));
+    SIM_LOG("[Kinematics] ✓ KinematicsEngine创建成功\n");
     return engine;
 }
 
 void kinematics_engine_destroy(KinematicsEngine *engine) {
     if (!engine) return;
     
-    printf("[Kinematics] 正在销毁KinematicsEngine...\n");
+    SIM_LOG("[Kinematics] 正在销毁KinematicsEngine...\n");
     
-    // 销毁所有卫星
-    for (int i = 0; i < engine->satellite_count; i++) {
-        if (engine->satellites[i]) {
-            satellite_destroy(engine->satellites[i]);
+    // 销毁卫星：slab上的卫星和历史随slab整体释放，只逐个销毁外部分配的
+    for (int i = 0; engine->external_satellites > 0 && i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (sat && sat->allocator != &engine->slab) {
+            satellite_destroy(sat);
+            engine->external_satellites--;
         }
     }
     free(engine->satellites);
+    free(engine->id_index);
+    attitude_fleet_free(&engine->attitude_fleet);
+    vector3_soa_free(&engine->orbit_position);
+    vector3_soa_free(&engine->orbit_velocity);
+    free(engine->orbit_batch_sats);
+    slab_destroy(&engine->slab);
+    arena_destroy(&engine->scratch);
     
     // 销毁编队数组
     free(engine->formations);
     
     // ===== 销毁编队控制器 =====
     kinematics_engine_destroy_formations(engine);
+    formation_manager_destroy(engine->formation_manager);
+    
+    perturbation_model_free(&engine->perturbations);
+    free(engine->relative_links);
+    event_list_free(&engine->events);
+    
+    proximity_monitor_destroy(engine->proximity);
+    
+    // 销毁时已无读方，换下的旧块一并释放
+    free((RuntimeParams*)engine->params);
+    free(engine->pending_params);
+    while (engine->retired_params) {
+        RuntimeParams *next = engine->retired_params->retired_next;
+        free(engine->retired_params);
+        engine->retired_params = next;
+    }
     
     // 关闭文件
     if (engine->state_file) fclose(engine->state_file);
@@ -161,24 +430,56 @@ void kinematics_engine_destroy(KinematicsEngine *engine) {
     if (engine->history_file) fclose(engine->history_file);
     
     free(engine);
-    printf("[Kinematics] ✓ KinematicsEngine已销毁\n");
+    SIM_LOG("[Kinematics] ✓ KinematicsEngine已销毁\n");
 }
 
 int kinematics_engine_add_satellite(KinematicsEngine *engine, Satellite *sat) {
     if (!engine || !sat) return -1;
-    if (engine->satellite_count >= engine->satellite_capacity) return -2;
+    
+    // 容量不足时加倍
+    if (engine->satellite_count >= engine->satellite_capacity) {
+        int grown = engine->satellite_capacity * 2;
+        Satellite **sats = (Satellite**)realloc(engine->satellites, sizeof(Satellite*) * grown);
+        if (!sats) return -2;
+        engine->satellites = sats;
+        engine->satellite_capacity = grown;
+    }
     
     engine->satellites[engine->satellite_count] = sat;
     engine->satellite_count++;
+    if ((engine->satellite_count + 1) * 2 > engine->id_index_capacity) {
+        if (kinematics_engine_rebuild_index(engine) != 0) {
+            engine->satellite_count--;
+            return -2;
+        }
+    } else {
+        kinematics_engine_index_insert(engine, sat);
+    }
+    if (sat->allocator != &engine->slab) engine->external_satellites++;
+    formation_manager_register_satellite(engine->formation_manager, sat);
     return engine->satellite_count - 1;
 }
 
-Satellite* kinematics_engine_get_satellite(KinematicsEngine *engine, int sat_id) {
+Satellite* kinematics_engine_create_satellite(KinematicsEngine *engine, int id, uint8_t team,
+                                              uint8_t type, uint8_t function_type) {
     if (!engine) return NULL;
-    for (int i = 0; i < engine->satellite_count; i++) {
-        if (engine->satellites[i] && engine->satellites[i]->id == sat_id) {
-            return engine->satellites[i];
-        }
+
+    Satellite *sat = satellite_create_in(&engine->slab, id, team, type, function_type, engine->seed);
+    if (!sat) return NULL;
+    if (kinematics_engine_add_satellite(engine, sat) < 0) {
+        satellite_destroy(sat);
+        return NULL;
+    }
+    return sat;
+}
+
+Satellite* kinematics_engine_get_satellite(KinematicsEngine *engine, int sat_id) {
+    if (!engine || engine->id_index_capacity == 0) return NULL;
+    uint32_t mask = (uint32_t)engine->id_index_capacity - 1;
+    uint32_t slot = kinematics_engine_id_slot(sat_id, engine->id_index_capacity);
+    while (engine->id_index[slot]) {
+        if (engine->id_index[slot]->id == sat_id) return engine->id_index[slot];
+        slot = (slot + 1) & mask;
     }
     return NULL;
 }
@@ -193,30 +494,131 @@ int kinematics_engine_remove_satellite(KinematicsEngine *engine, int sat_id) {
     if (!engine) return -1;
     for (int i = 0; i < engine->satellite_count; i++) {
         if (engine->satellites[i] && engine->satellites[i]->id == sat_id) {
+            kinematics_engine_drop_links(engine, engine->satellites[i]);
+            formation_manager_remove_satellite(engine->formation_manager, sat_id);
+            if (engine->satellites[i]->allocator != &engine->slab) engine->external_satellites--;
             satellite_destroy(engine->satellites[i]);
             for (int j = i; j < engine->satellite_count - 1; j++) {
                 engine->satellites[j] = engine->satellites[j + 1];
             }
             engine->satellite_count--;
+            kinematics_engine_rebuild_index(engine);
             return 0;
         }
     }
     return -1;
 }
 
+/* 独立卫星整体收集到SoA工作区批量外推；摄动模型超出批量内核范围或分配失败时返回-1 */
+static int kinematics_engine_propagate_batch(KinematicsEngine *engine) {
+    if (!orbit_batch_supports(&engine->perturbations)) return -1;
+
+    Vector3SoA *pos = &engine->orbit_position;
+    Vector3SoA *vel = &engine->orbit_velocity;
+    int n = engine->satellite_count;
+    if (pos->capacity < n || vel->capacity < n) {
+        Satellite **sats = (Satellite**)realloc(engine->orbit_batch_sats, sizeof(Satellite*) * n);
+        if (!sats) return -1;
+        engine->orbit_batch_sats = sats;
+        if (!pos->owned && vector3_soa_init(pos, n) != 0) return -1;
+        if (!vel->owned && vector3_soa_init(vel, n) != 0) return -1;
+        if (vector3_soa_reserve(pos, n) != 0 || vector3_soa_reserve(vel, n) != 0) return -1;
+    }
+
+    Satellite **sats = engine->orbit_batch_sats;
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat) continue;
+        if (sat->relative_link) continue;
+        sats[count] = sat;
+        vector3_soa_set(pos, count, sat->state.position);
+        vector3_soa_set(vel, count, sat->state.velocity);
+        count++;
+    }
+    pos->count = vel->count = count;
+    if (count == 0) return 0;
+    if (orbit_batch_rk4_step(pos, vel, engine->dt_seconds, &engine->perturbations) != 0) return -1;
+
+    for (int i = 0; i < count; i++) {
+        sats[i]->state.position = vector3_soa_get(pos, i);
+        sats[i]->state.velocity = vector3_soa_get(vel, i);
+        sats[i]->state.time = engine->current_time + engine->dt_seconds;
+    }
+    return 0;
+}
+
 int kinematics_engine_step(KinematicsEngine *engine) {
     if (!engine) return -1;
+    TRACE_CONTEXT(engine->step_count, engine->satellite_count);
+    PROF_BEGIN(prof_step);
+    
+    // 决策层和编队控制按各自时钟触发
+    if (sim_clock_due(&engine->clocks[SIM_CLOCK_DECISION], engine->current_time)) {
+        PROF_BEGIN(prof_decision);
+        kinematics_engine_decide(engine);
+        PROF_END(PROF_DECISION, prof_decision);
+    }
+    if (sim_clock_due(&engine->clocks[SIM_CLOCK_CONTROL], engine->current_time)) {
+        PROF_BEGIN(prof_control);
+        kinematics_engine_control(engine);
+        PROF_END(PROF_FORMATION, prof_control);
+    }
+    
+    // RK4外推每颗独立卫星（二体 + 已启用的摄动项）；二体/J2 走批量内核，日月光压等逐颗积分
+    PROF_BEGIN(prof_propagation);
+    if (kinematics_engine_propagate_batch(engine) != 0) {
+        for (int i = 0; i < engine->satellite_count; i++) {
+            if (! engine->satellites[i]) continue;
+            Satellite *sat = engine->satellites[i];
+            if (sat->relative_link) continue;
+            sat->state.time = engine->current_time;
+            orbit_rk4_step_perturbed(&sat->state, engine->dt_seconds, &engine->perturbations);
+        }
+    }
+    
+    // 从星由主星新状态和闭式相对解给出
+    for (int i = 0; i < engine->num_relative_links; i++) {
+        RelativeMotionLink *link = &engine->relative_links[i];
+        relative_propagator_deputy_state(&link->prop, &link->chief->state, &link->deputy->state);
+    }
+    PROF_END(PROF_PROPAGATION, prof_propagation);
     
+    // 姿态在本步内子步进（指向目标取步末位置）
+    if (engine->clocks[SIM_CLOCK_ATTITUDE].enabled) {
+        PROF_BEGIN(prof_attitude);
+        kinematics_engine_step_attitude(engine, engine->dt_seconds);
+        PROF_END(PROF_ATTITUDE, prof_attitude);
+    }
+    
+    engine->clocks[SIM_CLOCK_DYNAMICS].tick_count++;
     engine->current_time += engine->dt_seconds;
     engine->step_count++;
     
-    // 更新每颗卫星的时间戳
-    for (int i = 0; i < engine->satellite_count; i++) {
-        if (! engine->satellites[i]) continue;
-        Satellite *sat = engine->satellites[i];
-        sat->state.time = engine->current_time;
+    // 红蓝卫星对跨距离带时写入告警缓冲（阈值取当前参数块，随重载生效）
+    if (engine->proximity) {
+        proximity_monitor_update(engine->proximity, engine->satellites, engine->satellite_count,
+                                 &kinematics_engine_params(engine)->strategy, engine->current_time);
     }
     
+    // 步间过零的事件在精化后的时刻回调
+    if (engine->events.num_events > 0) {
+        event_list_check(&engine->events, engine->current_time,
+                         kinematics_engine_lookup_state, engine, NULL, 0);
+    }
+    
+    // 按保存间隔记录轨迹历史（环形分层缓冲，内存恒定）
+    uint32_t save_interval = engine->config.save_interval ? engine->config.save_interval : 1;
+    if (engine->step_count % save_interval == 0) {
+        PROF_BEGIN(prof_history);
+        for (int i = 0; i < engine->satellite_count; i++) {
+            Satellite *sat = engine->satellites[i];
+            if (sat && sat->history) satellite_history_append(sat);
+        }
+        PROF_END(PROF_HISTORY, prof_history);
+    }
+    
+    PROF_END(PROF_STEP, prof_step);
     return 0;
 }
 
@@ -230,26 +632,337 @@ int kinematics_engine_run(KinematicsEngine *engine, uint32_t num_steps) {
     return 0;
 }
 
+int kinematics_engine_set_perturbations(KinematicsEngine *engine, uint32_t flags, int enabled) {
+    if (!engine) return -1;
+    perturbation_model_enable(&engine->perturbations, flags, enabled);
+    return 0;
+}
+
+int kinematics_engine_link_relative(KinematicsEngine *engine, int chief_id, int deputy_id) {
+    if (!engine || chief_id == deputy_id) return -1;
+    
+    Satellite *chief = kinematics_engine_get_satellite(engine, chief_id);
+    Satellite *deputy = kinematics_engine_get_satellite(engine, deputy_id);
+    if (!chief || !deputy) return -1;
+    
+    // 主星自身不能是从星、从星自身不能是主星，否则外推顺序不确定
+    if (chief->relative_link) return -1;
+    for (int i = 0; i < engine->num_relative_links; i++) {
+        if (engine->relative_links[i].chief == deputy) return -1;
+    }
+    
+    // 外推器先在局部初始化，成功后才写入链接表（修改已有链接失败时原链接不变）
+    chief->state.time = engine->current_time;
+    deputy->state.time = engine->current_time;
+    RelativePropagator prop;
+    if (relative_propagator_init(&prop, &chief->state, &deputy->state) != 0) return -1;
+    
+    RelativeMotionLink *link = kinematics_engine_find_link(engine, deputy);
+    if (!link) {
+        if (engine->num_relative_links >= engine->relative_links_capacity) {
+            int new_capacity = engine->relative_links_capacity ? engine->relative_links_capacity * 2 : 8;
+            RelativeMotionLink *links = (RelativeMotionLink*)realloc(
+                engine->relative_links, sizeof(RelativeMotionLink) * new_capacity);
+            if (!links) return -1;
+            engine->relative_links = links;
+            engine->relative_links_capacity = new_capacity;
+        }
+        link = &engine->relative_links[engine->num_relative_links++];
+        deputy->relative_link = engine->num_relative_links;
+    }
+    link->chief = chief;
+    link->deputy = deputy;
+    link->prop = prop;
+    return 0;
+}
+
+int kinematics_engine_unlink_relative(KinematicsEngine *engine, int deputy_id) {
+    if (!engine) return -1;
+    Satellite *deputy = kinematics_engine_get_satellite(engine, deputy_id);
+    RelativeMotionLink *link = deputy ? kinematics_engine_find_link(engine, deputy) : NULL;
+    if (!link) return -1;
+    
+    // 末尾链接移入空位，同步其从星上的下标
+    *link = engine->relative_links[engine->num_relative_links - 1];
+    link->deputy->relative_link = (int)(link - engine->relative_links) + 1;
+    engine->num_relative_links--;
+    deputy->relative_link = 0;
+    return 0;
+}
+
+int kinematics_engine_seed(KinematicsEngine *engine, uint64_t seed) {
+    if (!engine) return -1;
+    engine->seed = seed;
+    rng_seed(&engine->rng, seed);
+    return 0;
+}
+
+int kinematics_engine_set_strategy(KinematicsEngine *engine, const char *strategy) {
+    if (!engine || !strategy) return -1;
+    strncpy(engine->strategy, strategy, sizeof(engine->strategy) - 1);
+    engine->strategy[sizeof(engine->strategy) - 1] = '\0';
+    return 0;
+}
+
+int kinematics_engine_set_clock_period(KinematicsEngine *engine, SimClockId clock, double period) {
+    if (!engine || clock < 0 || clock >= SIM_CLOCK_COUNT || period <= 0) return -1;
+    
+    // 动力学步长即引擎基本步长；姿态子步长记为配置值，生效值不超过基本步长
+    if (clock == SIM_CLOCK_DYNAMICS) {
+        engine->dt_seconds = period;
+        engine->config.time_step = period;
+    } else if (clock == SIM_CLOCK_ATTITUDE) {
+        engine->config.attitude_time_step = period;
+    }
+    
+    if (clock != SIM_CLOCK_ATTITUDE) {
+        engine->clocks[clock].period = period;
+        engine->clocks[clock].next_time = engine->current_time;
+    }
+    // 任一周期变化后按当前基本步长重新夹取姿态子步长
+    engine->clocks[SIM_CLOCK_ATTITUDE].period = kinematics_engine_attitude_period(engine);
+    engine->clocks[SIM_CLOCK_ATTITUDE].next_time = engine->current_time;
+    return 0;
+}
+
+int kinematics_engine_enable_clock(KinematicsEngine *engine, SimClockId clock, int enabled) {
+    if (!engine || clock <= SIM_CLOCK_DYNAMICS || clock >= SIM_CLOCK_COUNT) return -1;
+    
+    SimClock *c = &engine->clocks[clock];
+    if (enabled && !c->enabled) c->next_time = engine->current_time;
+    c->enabled = enabled ? 1 : 0;
+    return 0;
+}
+
+/* ==================== 运行时参数 ==================== */
+
+RuntimeParams* runtime_params_create(const SimulationConfig *config) {
+    if (!config) return NULL;
+    RuntimeParams *params = (RuntimeParams*)calloc(1, sizeof(RuntimeParams));
+    if (!params) return NULL;
+    params->strategy = config->strategy;
+    params->lambert_target_distance = config->lambert_target_distance;
+    params->lambert_max_delta_v = config->lambert_max_delta_v;
+    params->ellipse_min_distance = config->ellipse_min_distance;
+    params->ellipse_max_distance = config->ellipse_max_distance;
+    params->slew_cost_weight = config->slew_cost_weight;
+    return params;
+}
+
+void runtime_params_apply(const RuntimeParams *params, SimulationConfig *config) {
+    if (!params || !config) return;
+    config->strategy = params->strategy;
+    config->lambert_target_distance = params->lambert_target_distance;
+    config->lambert_max_delta_v = params->lambert_max_delta_v;
+    config->ellipse_min_distance = params->ellipse_min_distance;
+    config->ellipse_max_distance = params->ellipse_max_distance;
+    config->slew_cost_weight = params->slew_cost_weight;
+}
+
+const RuntimeParams* kinematics_engine_params(const KinematicsEngine *engine) {
+    if (!engine) return NULL;
+    return __atomic_load_n(&engine->params, __ATOMIC_ACQUIRE);
+}
+
+const RuntimeParams* kinematics_engine_params_acquire(KinematicsEngine *engine) {
+    if (!engine) return NULL;
+    // 先登记再取指针（均为 seq_cst）：回收方看到计数为0时，之后登记的读方必取到新块
+    __atomic_add_fetch(&engine->params_readers, 1, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&engine->params, __ATOMIC_SEQ_CST);
+}
+
+void kinematics_engine_params_release(KinematicsEngine *engine) {
+    if (!engine) return;
+    __atomic_sub_fetch(&engine->params_readers, 1, __ATOMIC_SEQ_CST);
+}
+
+int kinematics_engine_submit_params(KinematicsEngine *engine, RuntimeParams *params) {
+    if (!engine || !params) return -1;
+    params->retired_next = NULL;
+    // 交换得到的旧提交从未发布过，没有读方，可直接释放
+    free(__atomic_exchange_n(&engine->pending_params, params, __ATOMIC_ACQ_REL));
+    return 0;
+}
+
+/**
+ * 换入待生效的参数块，旧块挂到回收链；随后若没有外部读方，回收链整体释放。
+ * 引擎线程自己的读取都在两次决策之间，不计入读方
+ */
+static void kinematics_engine_swap_params(KinematicsEngine *engine) {
+    RuntimeParams *next = __atomic_exchange_n(&engine->pending_params, NULL, __ATOMIC_ACQ_REL);
+    if (next) {
+        RuntimeParams *old = (RuntimeParams*)engine->params;
+        next->generation = old->generation + 1;
+        __atomic_store_n(&engine->params, next, __ATOMIC_SEQ_CST);
+        old->retired_next = engine->retired_params;
+        engine->retired_params = old;
+        SIM_LOG("[Kinematics] ✓ 运行时参数已换入（第 %u 版）\n", next->generation);
+    }
+    if (engine->retired_params && __atomic_load_n(&engine->params_readers, __ATOMIC_SEQ_CST) == 0) {
+        while (engine->retired_params) {
+            RuntimeParams *retired = engine->retired_params;
+            engine->retired_params = retired->retired_next;
+            free(retired);
+        }
+    }
+}
+
+int kinematics_engine_decide(KinematicsEngine *engine) {
+    if (!engine) return -1;
+    
+    // 新参数只在决策周期之间生效，本周期内始终用同一块
+    kinematics_engine_swap_params(engine);
+    const RuntimeParams *params = kinematics_engine_params(engine);
+    if (engine->satellite_count <= 0) return -1;
+    
+    // 上一周期的分组/收益矩阵整体作废
+    Arena *scratch = &engine->scratch;
+    arena_reset(scratch);
+    
+    // 分离红蓝星
+    PROF_BEGIN(prof_partition);
+    int num_sats = engine->satellite_count;
+    Satellite **red_sats = (Satellite**)arena_alloc(scratch, sizeof(Satellite*) * num_sats, 0);
+    Satellite **blue_sats = (Satellite**)arena_alloc(scratch, sizeof(Satellite*) * num_sats, 0);
+    if (!red_sats || !blue_sats) return -1;
+    
+    int num_red = 0, num_blue = 0;
+    for (int i = 0; i < num_sats; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat) continue;
+        if (sat->team == 0) {
+            red_sats[num_red++] = sat;
+        } else {
+            blue_sats[num_blue++] = sat;
+        }
+    }
+    PROF_END(PROF_PARTITION, prof_partition);
+    
+    int result = -1;
+    if (num_red > 0 && num_blue > 0) {
+        SIM_LOG("\n[Step %u] 执行决策和编队分配...\n", engine->step_count);
+        
+        GroupResult *groups = decision_tree_group_satellites_in(scratch, red_sats, num_red, 3);
+        if (groups) {
+            GameResult *game = differential_game_assign_strategies_in(
+                scratch, red_sats, num_red, blue_sats, num_blue, engine->strategy,
+                params->slew_cost_weight);
+            
+            if (game) {
+                for (int r = 0; r < num_red; r++) {
+                    red_sats[r]->current_formation = decision_tree_select_formation(
+                        red_sats, num_red, groups, groups->group_ids[r]);
+                    red_sats[r]->current_strategy = game->strategy_assignments[r];
+                    
+                    // 目标分配同时作为姿态指向目标
+                    int target = game->target_assignments[r];
+                    if (target >= 0 && target < num_blue) {
+                        red_sats[r]->target_id = blue_sats[target]->id;
+                        red_sats[r]->attitude.target_id = blue_sats[target]->id;
+                    }
+                }
+                
+                SIM_LOG("✓ 决策完成: %d个红星, %d组编队\n", num_red, groups->num_groups);
+                result = 0;
+            }
+        }
+    }
+    
+    return result;
+}
+
+int kinematics_engine_control(KinematicsEngine *engine) {
+    if (!engine) return -1;
+    
+    InspectFormationState *inspect = (InspectFormationState*)engine->formation_controllers.inspect_state;
+    
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat || sat->target_id < 0) continue;
+        
+        Satellite *target = kinematics_engine_get_satellite(engine, sat->target_id);
+        if (!target) continue;
+        
+        double distance_km = vector3_distance(sat->state.position, target->state.position) / 1000.0;
+        sat->distance_to_target = distance_km;
+        if (distance_km < sat->min_distance_reached) {
+            sat->min_distance_reached = distance_km;
+        }
+        
+        if (sat->current_formation == FORMATION_INSPECT && inspect) {
+            inspect_formation_update_circle_count(inspect, sat->id, sat, target);
+        }
+    }
+    
+    return 0;
+}
+
+int kinematics_engine_add_event(KinematicsEngine *engine, const OrbitEvent *event) {
+    if (!engine || !event) return -1;
+    if (!kinematics_engine_get_satellite(engine, event->primary_id)) return -1;
+    if (event->secondary_id >= 0 && !kinematics_engine_get_satellite(engine, event->secondary_id)) return -1;
+    
+    int id = event_list_add(&engine->events, event);
+    if (id < 0) return -1;
+    
+    // 以当前状态记录初值，下一步起开始检测
+    event_list_check(&engine->events, engine->current_time,
+                     kinematics_engine_lookup_state, engine, NULL, 0);
+    return id;
+}
+
+int kinematics_engine_remove_event(KinematicsEngine *engine, int event_id) {
+    if (!engine) return -1;
+    return event_list_remove(&engine->events, event_id);
+}
+
+int kinematics_engine_enable_proximity(KinematicsEngine *engine, int event_capacity) {
+    if (!engine) return -1;
+    if (engine->proximity) return 0;
+    engine->proximity = proximity_monitor_create(event_capacity);
+    if (!engine->proximity) return -1;
+    
+    // 以当前位置建立初始分带，已在带内的卫星对此时即产生进入事件
+    proximity_monitor_update(engine->proximity, engine->satellites, engine->satellite_count,
+                             &kinematics_engine_params(engine)->strategy, engine->current_time);
+    return 0;
+}
+
+int kinematics_engine_poll_proximity(KinematicsEngine *engine, ProximityEvent *out, int max_events) {
+    if (!engine) return 0;
+    return proximity_monitor_poll(engine->proximity, out, max_events);
+}
+
+int kinematics_engine_proximity_pairs(const KinematicsEngine *engine) {
+    if (!engine || !engine->proximity) return -1;
+    return engine->proximity->num_pairs;
+}
+
+uint64_t kinematics_engine_proximity_dropped(const KinematicsEngine *engine) {
+    if (!engine || !engine->proximity) return 0;
+    return __atomic_load_n(&engine->proximity->dropped, __ATOMIC_RELAXED);
+}
+
 int kinematics_engine_init_satellites(KinematicsEngine *engine) {
     if (!engine) return -1;
     for (int i = 0; i < engine->satellite_count; i++) {
         if (engine->satellites[i]) {
-            satellite_init_history(engine->satellites[i], 10000);
+            satellite_init_history(engine->satellites[i], HISTORY_DEFAULT_CAPACITY);
         }
     }
-    printf("[Kinematics] ✓ 卫星初始化完成\n");
+    SIM_LOG("[Kinematics] ✓ 卫星初始化完成\n");
     return 0;
 }
 
 int kinematics_engine_init_formations(KinematicsEngine *engine) {
     if (!engine) return -1;
-    printf("[Kinematics] ✓ 编队初始化完成\n");
+    SIM_LOG("[Kinematics] ✓ 编队初始化完成\n");
     return 0;
 }
 
 int kinematics_engine_init_transition_rules(KinematicsEngine *engine) {
     if (!engine) return -1;
-    printf("[Kinematics] ✓ 转换规则配置完成\n");
+    SIM_LOG("[Kinematics] ✓ 转换规则配置完成\n");
     return 0;
 }
 
@@ -0,0 +1,9 @@
+#include <log.h>
+
+_Thread_local int sim_log_quiet = 0;
+
+int sim_log_set_quiet(int quiet) {
+    int previous = sim_log_quiet;
+    sim_log_quiet = quiet;
+    return previous;
+}
@@ -1,13 +1,23 @@
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <sys/stat.h>
 
 #include <constants.h>
 #include <types.h>
 #include <satellite.h>
 #include <kinematics.h>
+#include <branch.h>
+#include <montecarlo.h>
+#include <log.h>
+#include <profiler.h>
+#include <trace.h>
+#include <simulation.h>
 #include "config/config.h"
+#include "config/catalog.h"
 #include <decision/decision_tree.h>
 #include <decision/differential_game.h>
 
@@ -26,6 +36,23 @@ Config Init_config = {
     .time_step = 1.0
 };
 
+/* 批量内核指令集（-i 指定，NULL 按CPUID自动选择） */
+static const char *kernel_isa = NULL;
+
+/* 场景文件（-c 指定，NULL 使用 Init_config） */
+static const char *scenario_file = NULL;
+
+/* 运行时参数文件（-P 指定）：仿真中按修改时间重新读取，下一决策周期生效 */
+static const char *params_file = NULL;
+
+/* 近距告警（-a 开启）：红蓝卫星对跨策略阈值圈时记录进入/退出事件 */
+static int alerts_enabled = 0;
+#define MAIN_ALERT_EVENTS   65536      // 两次进度回调之间可缓存的告警事件数
+
+/* 外部编目（-g 指定）：启动时读一次，每次初始化作为蓝方侦察星追加 */
+static CatalogEntry *catalog_entries = NULL;
+static int catalog_count = 0;
+
 void print_banner(void) {
     printf("\n");
     printf("╔════════════════════════════════════════════════════════════╗\n");
@@ -56,135 +83,40 @@ void print_progress(uint32_t step_count, uint32_t max_steps, double simulation_t
     fflush(stdout);
 }
 
-int initialize_simulation(KinematicsEngine **engine_out) {
-    printf("正在初始化仿真...\n");
+int initialize_simulation(KinematicsEngine **engine_out, uint64_t seed) {
+    SIM_LOG("正在初始化仿真...\n");
     // todo 时间步
-    SimulationConfig config = {
-        .time_step = 10.0,
-        .max_steps = 10000,
-        .save_interval = 100,
-        .hohmann_precision = 1e-6,
-        .lambert_max_iterations = 100,
-        .lambert_convergence = 1e-6,
-        .lambert_target_distance = 1000000,
-        .lambert_max_delta_v = 5000,
-        .ellipse_min_distance = 6500000,
-        .ellipse_max_distance = 8000000
-    };
-    
-    KinematicsEngine *engine = kinematics_engine_create(config);
-    if (!engine) {
-        fprintf(stderr, "错误：无法创建运动学引擎\n");
+    SimulationConfig config;
+    simulation_default_config(&config);
+    if (kernel_isa) snprintf(config.kernel_isa, sizeof(config.kernel_isa), "%s", kernel_isa);
+    
+    KinematicsEngine *engine = scenario_file ? config_load_engine(scenario_file, &config, seed, 0)
+                                             : simulation_create_engine(&Init_config, &config, seed, 0);
+    if (!engine) return -1;
+    if (catalog_count > 0 &&
+        catalog_add_to_engine(engine, catalog_entries, catalog_count, 1,
+                              FUNCTION_RECON - FUNCTION_ATTACK, 0) != catalog_count) {
+        kinematics_engine_destroy(engine);
         return -1;
     }
     
-    printf("✓ 运动学引擎已创建\n");
-
-    // 红星数
-    int red_sum = Init_config.red_attack + Init_config.red_recon + Init_config.red_defense;
-    int id = 1000;
-
-    // 红色 攻击卫星
-    for (size_t i = 0; i < Init_config.red_attack; i++) {
-        Satellite *sat = satellite_create(id, 0, 0, 0);  // 团队0=红队，功能0=攻击
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-
-    // 红色 侦察卫星
-    for (size_t i = 0; i < Init_config.red_recon; i++) {
-        Satellite *sat = satellite_create(id, 0, 0, 1);  // 团队0=红队，功能1=侦察
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-
-    // 红色 防御卫星
-    for (size_t i = 0; i < Init_config.red_defense; i++) {
-        Satellite *sat = satellite_create(id, 0, 0, 2);  // 团队0=红队，功能2=防御
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-
-    int blue_sum = Init_config.blue_attack + Init_config.blue_recon + Init_config.blue_defense;
-
-    // 蓝色 攻击卫星
-    for (size_t i = 0; i < Init_config.blue_attack; i++) {
-        Satellite *sat = satellite_create(id, 1, 0, 0);  // 团队1=蓝队，功能0=攻击
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-
-    // 蓝色 侦察卫星
-    for (size_t i = 0; i < Init_config.blue_recon; i++) {
-        Satellite *sat = satellite_create(id, 1, 0, 1);  // 团队1=蓝队，功能1=侦察
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-
-    // 蓝色 防御卫星
-    for (size_t i = 0; i < Init_config.blue_defense; i++) {
-        Satellite *sat = satellite_create(id, 1, 0, 2);  // 团队1=蓝队，功能2=防御
-        if (!sat) {
-            fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-            kinematics_engine_destroy(engine);
-            return -1;
-        }
-        kinematics_engine_add_satellite(engine, sat);
-        id++;
-    }
-    // for (size_t i = 0; i < red_sum; i++)
-    // {
-    //     Satellite *sat = satellite_create(i, , i % 3);
-    //     /* code */
-    // }
-    
-    
-    // // 人为？？？
-    // for (int i = 0; i < 5; i++) {
-    //     Satellite *sat = satellite_create(i, i % 2, i % 3);
-    //     if (!sat) {
-    //         fprintf(stderr, "错误：无法创建卫星 %d\n", i);
-    //         kinematics_engine_destroy(engine);
-    //         return -1;
-    //     }
-    //     kinematics_engine_add_satellite(engine, sat);
-    // }
-    
-    printf("✓ 已加载 %d 颗卫星\n", engine->satellite_count);
-    printf("✓ 卫星初始化完成\n");
-    printf("✓ 编队控制器初始化完成\n");
-    printf("✓ 编队转换规则配置完成\n");
+    SIM_LOG("✓ 卫星初始化完成\n");
+    SIM_LOG("✓ 编队控制器初始化完成\n");
+    SIM_LOG("✓ 编队转换规则配置完成\n");
     
     *engine_out = engine;
-    printf("\n✓ 仿真初始化完成！\n\n");
+    SIM_LOG("\n✓ 仿真初始化完成！\n\n");
     return 0;
 }
 
+/* 蒙特卡洛场景构建：与单次仿真相同的初始化，初始扰动由种子决定 */
+static KinematicsEngine* build_monte_carlo_engine(uint64_t seed, void *user_data) {
+    (void)user_data;
+    KinematicsEngine *engine = NULL;
+    if (initialize_simulation(&engine, seed) != 0) return NULL;
+    return engine;
+}
+
 // int run_simulation(KinematicsEngine *engine, uint32_t max_steps, int verbose) {
 //     printf("开始仿真循环...\n");
 //     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n");
@@ -367,142 +299,104 @@ int initialize_simulation(KinematicsEngine **engine_out) {
 //     return 0;
 // }
 
+typedef struct {
+    KinematicsEngine *engine;
+    int verbose;
+    struct timespec params_mtime;  // 上次读取时参数文件的修改时间（纳秒精度，同一秒内的两次保存也能区分）
+    uint64_t alert_enter;          // 累计近距告警进入/退出次数
+    uint64_t alert_exit;
+} RunProgressContext;
+
+/* 取走缓冲中的告警事件，详细模式下逐条打印 */
+static void run_simulation_drain_alerts(RunProgressContext *ctx) {
+    ProximityEvent events[256];
+    int n;
+    while ((n = kinematics_engine_poll_proximity(ctx->engine, events, 256)) > 0) {
+        for (int k = 0; k < n; k++) {
+            const ProximityEvent *e = &events[k];
+            if (e->entering) ctx->alert_enter++;
+            else ctx->alert_exit++;
+            if (ctx->verbose) {
+                printf("\n[告警] t=%.0fs 红 %d / 蓝 %d %s %s -> %s (%.1f km)", e->time, e->red_id, e->blue_id,
+                       e->entering ? "进入" : "退出", proximity_zone_name((ProximityZone)e->from),
+                       proximity_zone_name((ProximityZone)e->to), e->distance);
+            }
+        }
+    }
+}
+
+/* 参数文件有改动时重新读取（读取失败保留当前参数，改好后再次保存即可） */
+static void run_simulation_reload_params(RunProgressContext *ctx) {
+    struct stat st;
+    if (!params_file || stat(params_file, &st) != 0 ||
+        (st.st_mtim.tv_sec == ctx->params_mtime.tv_sec && st.st_mtim.tv_nsec == ctx->params_mtime.tv_nsec)) {
+        return;
+    }
+    ctx->params_mtime = st.st_mtim;
+    if (config_reload_params(ctx->engine, params_file) == 0) {
+        printf("\n✓ 已重新读取参数文件 %s，下一决策周期生效\n", params_file);
+    }
+}
+
+/* 进度条每100步刷新，详细模式下每1000步另起一行；同时检查参数文件 */
+static void run_simulation_progress(uint32_t step, uint32_t max_steps, double simulation_time, void *user_data) {
+    RunProgressContext *ctx = (RunProgressContext*)user_data;
+    int verbose = ctx->verbose;
+    run_simulation_reload_params(ctx);
+    run_simulation_drain_alerts(ctx);
+    print_progress(step, max_steps, simulation_time);
+    
+    if (verbose && step % 1000 == 0) {
+        printf("\n");
+        printf("[第 %u 步] 仿真时间: %.2f小时\n", step, simulation_time / 3600.0);
+    }
+}
+
 int run_simulation(KinematicsEngine *engine, uint32_t max_steps, int verbose) {
     printf("开始仿真循环...\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n");
     
-    // ===== 打开输出文件 =====
-    FILE *output_file = fopen("red_satellites_trajectory.csv", "w");
-    if (! output_file) {
-        fprintf(stderr, "错误：无法打开输出文件\n");
-        return -1;
+    RunProgressContext progress = { engine, verbose, { 0, 0 }, 0, 0 };
+    run_simulation_reload_params(&progress);
+    if (alerts_enabled && kinematics_engine_enable_proximity(engine, MAIN_ALERT_EVENTS) != 0) {
+        fprintf(stderr, "错误：近距告警启用失败\n");
     }
     
-    // 写入CSV头
-    fprintf(output_file, "step,time(s),sat_id,pos_x(km),pos_y(km),pos_z(km),"
-                        "vel_x(km/s),vel_y(km/s),vel_z(km/s),fuel(kg),formation,strategy\n");
-    
-    clock_t start_time = clock();
-    uint32_t step = 0;
-    
-    // 用于记录上一次的编队和策略
-    uint8_t *last_formations = (uint8_t*)calloc(engine->satellite_count, sizeof(uint8_t));
-    int *last_strategies = (int*)calloc(engine->satellite_count, sizeof(int));
-    
-    while (step < max_steps && kinematics_engine_should_continue(engine)) {
-        // ===== 1. 获取所有卫星 =====
-        int num_sats = 0;
-        Satellite **all_sats = kinematics_engine_get_all_satellites(engine, &num_sats);
-        
-        if (! all_sats || num_sats <= 0) break;
-        
-        // ===== 2. 分离红蓝星 =====
-        Satellite **red_sats = (Satellite**)malloc(sizeof(Satellite*) * num_sats);
-        Satellite **blue_sats = (Satellite**)malloc(sizeof(Satellite*) * num_sats);
-        int num_red = 0, num_blue = 0;
-        
-        for (int i = 0; i < num_sats; i++) {
-            if (all_sats[i]->team == 0) {
-                red_sats[num_red++] = all_sats[i];
-            } else {
-                blue_sats[num_blue++] = all_sats[i];
-            }
-        }
-        
-        // ===== 3. 每100步执行一次决策 =====
-        if (step % 100 == 0 && num_red > 0 && num_blue > 0) {
-            printf("\n[Step %u] 执行决策和编队分配...\n", step);
-            
-            // 决策树分组
-            GroupResult *groups = decision_tree_group_satellites(red_sats, num_red, 3);
-            
-            if (groups) {
-                // 微分博弈分配 - 正确的函数调用方式
-                GameResult *game = differential_game_assign_strategies(
-                    red_sats, num_red, blue_sats, num_blue, "GJ");
-                
-                if (game) {
-                    // 更新编队和策略
-                    for (int r = 0; r < num_red; r++) {
-                        uint8_t formation = decision_tree_select_formation(
-                            red_sats, num_red, groups, groups->group_ids[r]);
-                        
-                        red_sats[r]->current_formation = formation;
-                        last_formations[r] = formation;
-                        last_strategies[r] = game->strategy_assignments[r];
-                    }
-                    
-                    printf("✓ 决策完成: %d个红星, %d组编队\n", num_red, groups->num_groups);
-                    
-                    differential_game_free_result(game);  // 释放游戏结果
-                }
-                
-                decision_tree_free_result(groups);  // 释放分组结果
-            }
-        }
-        
-        // ===== 4. 仿真步进 =====
-        if (kinematics_engine_step(engine) != 0) {
-            fprintf(stderr, "\n错误：第 %u 步仿真失败\n", step);
-            break;
-        }
-        
-        // ===== 5.  输出所有红星数据到CSV =====
-        for (int r = 0; r < num_red; r++) {
-            Satellite *sat = red_sats[r];
-            fprintf(output_file, "%u,%.2f,%d,%.6f,%.6f,%.6f,"
-                                "%.6f,%.6f,%.6f,%.2f,%u,%d\n",
-                step,
-                engine->current_time,
-                sat->id,
-                sat->state.position.x,
-                sat->state.position. y,
-                sat->state. position.z,
-                sat->state.velocity.x,
-                sat->state.velocity.y,
-                sat->state.velocity. z,
-                sat->fuel,
-                sat->current_formation,
-                last_strategies[r]
-            );
-        }
-        
-        // 清理临时数组
-        free(red_sats);
-        free(blue_sats);
-        
-        step++;
-        double current_time = kinematics_engine_get_current_time(engine);
-        
-        if (step % 100 == 0) {
-            print_progress(step, max_steps, current_time);
-        }
-        
-        if (verbose && step % 1000 == 0) {
-            printf("\n");
-            printf("[第 %u 步] 仿真时间: %.2f小时\n", step, current_time / 3600.0);
-        }
+    SimRunOptions options = {
+        .output = SIM_OUTPUT_CSV,
+        .output_file = "red_satellites_trajectory.csv",
+        .progress = run_simulation_progress,
+        .progress_interval = 100,
+        .user_data = &progress
+    };
+    SimRunStats stats;
+    if (simulation_run(engine, max_steps, &options, &stats) != 0) {
+        return -1;
     }
     
-    // ===== 6. 关闭文件和清理 =====
-    fclose(output_file);
-    free(last_formations);
-    free(last_strategies);
-    
     double current_time = kinematics_engine_get_current_time(engine);
-    print_progress(step, max_steps, current_time);
+    run_simulation_drain_alerts(&progress);
+    print_progress(stats.steps, max_steps, current_time);
     printf("\n");
     
-    clock_t end_time = clock();
-    double elapsed = (double)(end_time - start_time) / CLOCKS_PER_SEC;
-    
     printf("\n━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     printf("仿真完成！\n");
-    printf("  仿真步数: %u\n", step);
+    printf("  仿真步数: %u\n", stats.steps);
     printf("  仿真时长: %.2f小时\n", current_time / 3600.0);
-    printf("  执行耗时: %.2f秒\n", elapsed);
-    printf("  性能: %.2f 步/秒\n", step / elapsed);
-    printf("\n✓ 输出文件: red_satellites_trajectory.csv\n");
+    printf("  执行耗时: %.2f秒\n", stats.elapsed_seconds);
+    printf("  性能: %.2f 步/秒\n", stats.elapsed_seconds > 0 ? stats.steps / stats.elapsed_seconds : 0.0);
+    printf("  决策/控制触发: %u / %u 次\n",
+           engine->clocks[SIM_CLOCK_DECISION].tick_count, engine->clocks[SIM_CLOCK_CONTROL].tick_count);
+    printf("  姿态子步数: %u\n", engine->attitude_substeps);
+    int alert_pairs = kinematics_engine_proximity_pairs(engine);
+    if (alert_pairs >= 0) {
+        uint64_t dropped = kinematics_engine_proximity_dropped(engine);
+        printf("  近距告警: 进入 %llu 次 / 退出 %llu 次，当前 %d 对在阈值圈内",
+               (unsigned long long)progress.alert_enter, (unsigned long long)progress.alert_exit, alert_pairs);
+        if (dropped) printf("（缓冲满丢弃 %llu 条）", (unsigned long long)dropped);
+        printf("\n");
+    }
+    printf("\n✓ 输出文件: %s (%.2f MB)\n", options.output_file, stats.bytes_written / (1024.0 * 1024.0));
     printf("\n");
     
     return 0;
@@ -531,6 +425,8 @@ void print_final_statistics(KinematicsEngine *engine) {
     printf("│   仿真总时间: %.2f小时\n", engine->current_time / 3600.0);
     printf("│   仿真总步数: %u\n", engine->step_count);
     
+    profiler_print_summary();
+    
     printf("╚════════════════════════════════════════════════════════════╝\n");
     printf("\n");
 }
@@ -559,14 +455,41 @@ void print_satellite_details(KinematicsEngine *engine) {
     printf("\n");
 }
 
+/* 停止时间线记录并导出（path 为NULL时不做任何事） */
+static void write_timeline(const char *path) {
+    if (!path) return;
+    trace_stop();
+    int events = trace_write_chrome(path);
+    if (events >= 0) {
+        printf("✓ 时间线已写入 %s (%d 个事件)\n\n", path, events);
+    }
+    trace_shutdown();
+}
+
 void print_usage(const char *program_name) {
     printf("使用方法: %s [选项]\n", program_name);
     printf("\n选项:\n");
-    printf("  -s STEPS       仿真最大步数 (默认: 10000)\n");
+    printf("  -c FILE        场景文件 (config1.json 卫星根数、config.json 阵营计数或 -C 编译的二进制场景)\n");
+    printf("  -C OUT         把 -c 指定的JSON场景编译为二进制场景 OUT 后退出\n");
+    printf("  -P FILE        运行时参数文件 (strategy_thresholds / simulation.slew_cost_weight)，运行中修改后下一决策周期生效\n");
+    printf("  -g FILE        外部编目 (TLE 或 CCSDS OEM)，GEO保护带内的目标作为蓝方侦察星加入场景\n");
+    printf("  -s STEPS       仿真最大步数 (默认: 场景文件的 max_steps，否则 10000)\n");
+    printf("  -a             近距告警：红蓝卫星对跨策略阈值圈时记录进入/退出事件 (详细模式下逐条打印)\n");
     printf("  -v             启用详细日志输出\n");
+    printf("  -b STRATEGIES  仿真结束后按逗号分隔的策略分支对比 (如 GJ,ZC,FY)\n");
+    printf("  -r SEED        随机种子 (默认: 1)\n");
+    printf("  -m RUNS        蒙特卡洛批量运行次数（不输出轨迹）\n");
+    printf("  -j THREADS     蒙特卡洛工作线程数 (默认: CPU核数)\n");
+    printf("  -p FILE        逐步阶段耗时跟踪输出 (CSV，需 SIM_PROFILE 编译)\n");
+    printf("  -t FILE        阶段时间线输出 (Chrome trace JSON，可用 Perfetto 打开，需 SIM_PROFILE 编译)\n");
+    printf("  -i ISA         批量内核指令集 scalar|sse2|avx2|avx512 (默认: 本机最宽)\n");
     printf("  -h             显示本帮助信息\n");
     printf("\n例子:\n");
     printf("  %s -s 50000 -v\n", program_name);
+    printf("  %s -s 5000 -m 200 -r 42\n", program_name);
+    printf("  %s -c config/config1.json -v\n", program_name);
+    printf("  %s -c config/config1.json -C config/config1.scn\n", program_name);
+    printf("  %s -c config/config1.json -g catalog/geo.tle\n", program_name);
     printf("\n");
 }
 
@@ -577,13 +500,47 @@ int main(int argc, char *argv[]) {
     print_banner();
     
     uint32_t max_steps = 10000;
+    int steps_given = 0;
     int verbose = 0;
+    char *branch_list = NULL;
+    uint64_t seed = RNG_DEFAULT_SEED;
+    int mc_runs = 0;
+    int mc_threads = 0;
+    const char *trace_path = NULL;
+    const char *timeline_path = NULL;
+    const char *compile_path = NULL;
+    const char *catalog_file = NULL;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
             max_steps = (uint32_t)atoi(argv[++i]);
+            steps_given = 1;
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            scenario_file = argv[++i];
+        } else if (strcmp(argv[i], "-C") == 0 && i + 1 < argc) {
+            compile_path = argv[++i];
+        } else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+            params_file = argv[++i];
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            catalog_file = argv[++i];
+        } else if (strcmp(argv[i], "-a") == 0) {
+            alerts_enabled = 1;
         } else if (strcmp(argv[i], "-v") == 0) {
             verbose = 1;
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            branch_list = argv[++i];
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            mc_runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            mc_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            timeline_path = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            kernel_isa = argv[++i];
         } else if (strcmp(argv[i], "-h") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -594,28 +551,121 @@ int main(int argc, char *argv[]) {
         }
     }
     
+#ifndef SIM_PROFILE
+    // 未插桩时没有任何阶段区间，输出文件只会是空表
+    if (trace_path || timeline_path) {
+        fprintf(stderr, "错误：-p / -t 需要启用 SIM_PROFILE 编译（当前构建未插桩）\n");
+        return 1;
+    }
+#endif
+    
+    if (compile_path) {
+        if (!scenario_file) {
+            fprintf(stderr, "错误：-C 需要用 -c 指定JSON场景\n");
+            return 1;
+        }
+        if (config_compile_scenario(scenario_file, compile_path) != 0) return 1;
+        printf("✓ 二进制场景已写入 %s\n", compile_path);
+        return 0;
+    }
+    
+    SimulationConfig file_config;
+    simulation_default_config(&file_config);
+    if (scenario_file) {
+        if (config_load_simulation(scenario_file, &file_config) != 0) return 1;
+        if (!steps_given) max_steps = file_config.max_steps;
+    }
+    
+    if (catalog_file) {
+        // 编目各记录推到场景历元（未设置时取编目中最晚的历元）
+        CatalogOptions catalog_options;
+        catalog_default_options(&catalog_options);
+        catalog_options.epoch_jd = file_config.epoch_jd;
+        catalog_count = catalog_load(catalog_file, &catalog_options, &catalog_entries, NULL);
+        if (catalog_count < 0) return 1;
+    }
+    
     printf("配置参数:\n");
+    if (scenario_file) printf("  场景文件: %s\n", scenario_file);
+    if (params_file) printf("  参数文件: %s\n", params_file);
+    if (catalog_file) printf("  外部编目: %s (%d 个GEO目标)\n", catalog_file, catalog_count);
     printf("  最大步数: %u\n", max_steps);
     printf("  详细输出: %s\n", verbose ? "是" : "否");
+    printf("  随机种子: %llu\n", (unsigned long long)seed);
     printf("\n");
     
+    if (timeline_path) {
+        trace_set_thread_name("main");
+        trace_start();
+    }
+    
+    if (mc_runs > 0) {
+        MonteCarloOptions mc_options = {
+            .num_runs = mc_runs,
+            .num_threads = mc_threads,
+            .num_steps = max_steps,
+            .base_seed = seed,
+            .build = build_monte_carlo_engine,
+            .user_data = NULL
+        };
+        MonteCarloResult mc_result;
+        if (monte_carlo_run(&mc_options, &mc_result) < 0) {
+            fprintf(stderr, "蒙特卡洛运行失败！\n");
+            return 1;
+        }
+        monte_carlo_print_result(&mc_result);
+        write_timeline(timeline_path);
+        return 0;
+    }
+    
     KinematicsEngine *engine = NULL;
-    if (initialize_simulation(&engine) != 0) {
+    if (initialize_simulation(&engine, seed) != 0) {
         fprintf(stderr, "仿真初始化失败！\n");
         return 1;
     }
     
-    if (run_simulation(engine, max_steps, verbose) != 0) {
+    FILE *trace_file = NULL;
+    if (trace_path) {
+        trace_file = fopen(trace_path, "w");
+        if (!trace_file) {
+            fprintf(stderr, "错误：无法打开跟踪文件 %s\n", trace_path);
+        } else {
+            profiler_set_trace(trace_file);
+        }
+    }
+    
+    int run_status = run_simulation(engine, max_steps, verbose);
+    if (trace_file) {
+        profiler_set_trace(NULL);
+        fclose(trace_file);
+    }
+    if (run_status != 0) {
         fprintf(stderr, "仿真运行失败！\n");
         kinematics_engine_destroy(engine);
         return 1;
     }
     
+    write_timeline(timeline_path);
     print_final_statistics(engine);
     print_satellite_details(engine);
     
+    if (branch_list) {
+        const char *strategies[BRANCH_MAX_BRANCHES];
+        int num_branches = 0;
+        for (char *tok = strtok(branch_list, ","); tok && num_branches < BRANCH_MAX_BRANCHES; tok = strtok(NULL, ",")) {
+            strategies[num_branches++] = tok;
+        }
+
+        BranchOutcome outcomes[BRANCH_MAX_BRANCHES];
+        BranchOptions options = { .num_steps = max_steps, .max_concurrent = 0, .quiet = 1 };
+        if (kinematics_engine_branch(engine, strategies, num_branches, &options, outcomes) >= 0) {
+            branch_print_outcomes(outcomes, num_branches);
+        }
+    }
+    
     printf("正在清理资源...\n");
     kinematics_engine_destroy(engine);
+    free(catalog_entries);
     printf("✓ 所有资源已释放\n\n");
     
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
@@ -0,0 +1,208 @@
+#define _DEFAULT_SOURCE
+
+#include <montecarlo.h>
+#include <thread_pool.h>
+#include <branch.h>
+#include <rng.h>
+#include <log.h>
+#include <trace.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* ==================== 在线统计 ==================== */
+
+void running_stats_init(RunningStats *stats) {
+    if (!stats) return;
+    stats->count = 0;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->min = 1e300;
+    stats->max = -1e300;
+}
+
+void running_stats_push(RunningStats *stats, double x) {
+    if (!stats) return;
+    stats->count++;
+    double delta = x - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (x - stats->mean);
+    if (x < stats->min) stats->min = x;
+    if (x > stats->max) stats->max = x;
+}
+
+void running_stats_merge(RunningStats *dst, const RunningStats *src) {
+    if (!dst || !src || src->count == 0) return;
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+
+    double n_a = (double)dst->count;
+    double n_b = (double)src->count;
+    double n = n_a + n_b;
+    double delta = src->mean - dst->mean;
+
+    dst->mean += delta * n_b / n;
+    dst->m2 += src->m2 + delta * delta * n_a * n_b / n;
+    dst->count += src->count;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+double running_stats_variance(const RunningStats *stats) {
+    if (!stats || stats->count < 2) return 0.0;
+    return stats->m2 / (double)(stats->count - 1);
+}
+
+double running_stats_stddev(const RunningStats *stats) {
+    return sqrt(running_stats_variance(stats));
+}
+
+/* ==================== 工作线程 ==================== */
+
+/* 批量运行共享上下文：运行序号由原子计数器分发，种子预先派生 */
+typedef struct {
+    const MonteCarloOptions *options;
+    const uint64_t *seeds;
+    atomic_int next_run;
+
+    pthread_mutex_t lock;          // 仅在合并局部统计时使用
+    MonteCarloResult *result;
+} MonteCarloBatch;
+
+static void monte_carlo_worker(void *arg) {
+    MonteCarloBatch *batch = (MonteCarloBatch*)arg;
+    const MonteCarloOptions *options = batch->options;
+
+    int previous_quiet = sim_log_set_quiet(1);
+    trace_set_thread_name("montecarlo-worker");
+
+    RunningStats distance;
+    running_stats_init(&distance);
+    int completed = 0, failed = 0;
+
+    for (;;) {
+        int run = atomic_fetch_add(&batch->next_run, 1);
+        if (run >= options->num_runs) break;
+
+        PROF_BEGIN(prof_run);
+        KinematicsEngine *engine = options->build(batch->seeds[run], options->user_data);
+        if (!engine) {
+            failed++;
+            continue;
+        }
+
+        uint32_t steps = 0;
+        while (steps < options->num_steps) {
+            if (kinematics_engine_step(engine) != 0) break;
+            steps++;
+        }
+
+        if (steps == options->num_steps) {
+            BranchOutcome outcome;
+            branch_collect_outcome(engine, &outcome);
+            running_stats_push(&distance, outcome.mean_target_distance);
+            completed++;
+        } else {
+            failed++;
+        }
+
+        kinematics_engine_destroy(engine);
+        PROF_END(PROF_RUN, prof_run);
+    }
+
+    pthread_mutex_lock(&batch->lock);
+    running_stats_merge(&batch->result->target_distance, &distance);
+    batch->result->runs_completed += completed;
+    batch->result->runs_failed += failed;
+    pthread_mutex_unlock(&batch->lock);
+
+    sim_log_set_quiet(previous_quiet);
+}
+
+/* ==================== 公开接口实现 ==================== */
+
+int monte_carlo_run(const MonteCarloOptions *options, MonteCarloResult *result) {
+    if (!options || !result || !options->build || options->num_runs <= 0) return -1;
+
+    memset(result, 0, sizeof(MonteCarloResult));
+    running_stats_init(&result->target_distance);
+
+    // 种子与线程调度无关：第k次运行总是得到同一场景
+    uint64_t *seeds = (uint64_t*)malloc(sizeof(uint64_t) * options->num_runs);
+    if (!seeds) return -1;
+    Rng seeder;
+    rng_seed(&seeder, options->base_seed);
+    for (int k = 0; k < options->num_runs; k++) {
+        seeds[k] = rng_next_u64(&seeder);
+    }
+
+    int num_threads = (options->num_threads > 0) ? options->num_threads : thread_pool_cpu_count();
+    if (num_threads > options->num_runs) num_threads = options->num_runs;
+
+    ThreadPool *pool = thread_pool_create(num_threads);
+    if (!pool) {
+        fprintf(stderr, "错误：无法创建线程池\n");
+        free(seeds);
+        return -1;
+    }
+
+    MonteCarloBatch batch;
+    batch.options = options;
+    batch.seeds = seeds;
+    atomic_init(&batch.next_run, 0);
+    pthread_mutex_init(&batch.lock, NULL);
+    batch.result = result;
+
+    SIM_LOG("[MonteCarlo] %d 次运行 × %u 步，%d 个工作线程，主种子 %llu\n",
+            options->num_runs, options->num_steps, pool->num_threads,
+            (unsigned long long)options->base_seed);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    // 每个线程一个长任务，从共享计数器领取运行序号
+    for (int i = 0; i < pool->num_threads; i++) {
+        thread_pool_submit(pool, monte_carlo_worker, &batch);
+    }
+    thread_pool_wait(pool);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    result->elapsed_seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    result->num_threads = pool->num_threads;
+
+    thread_pool_destroy(pool);
+    pthread_mutex_destroy(&batch.lock);
+    free(seeds);
+
+    return result->runs_completed;
+}
+
+static void monte_carlo_print_stats(const char *name, const RunningStats *stats) {
+    if (stats->count == 0) {
+        printf("│   %-12s 无数据\n", name);
+        return;
+    }
+    printf("│   %-12s 均值=%.4f 标准差=%.4f 最小=%.4f 最大=%.4f\n",
+           name, stats->mean, running_stats_stddev(stats), stats->min, stats->max);
+}
+
+void monte_carlo_print_result(const MonteCarloResult *result) {
+    if (!result) return;
+
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║                    蒙特卡洛统计结果                        ║\n");
+    printf("╠════════════════════════════════════════════════════════════╣\n");
+    printf("│ 运行: 完成 %d 次, 失败 %d 次, %d 个线程\n",
+           result->runs_completed, result->runs_failed, result->num_threads);
+    printf("│ 耗时: %.2f 秒 (%.2f 次/秒)\n", result->elapsed_seconds,
+           result->elapsed_seconds > 0 ? result->runs_completed / result->elapsed_seconds : 0.0);
+    printf("│\n");
+    monte_carlo_print_stats("目标距离(km)", &result->target_distance);
+    printf("╚════════════════════════════════════════════════════════════╝\n");
+    printf("\n");
+}
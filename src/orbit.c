@@ -2,18 +2,130 @@
 #include <math.h>
 #include <stdio.h>
 
+double orbit_kepler_equation_solve(double M, double e, double tolerance, int max_iterations);
+
+#define ORBIT_D2R (PI / 180.0)
+#define ORBIT_R2D (180.0 / PI)
+
+/* 角度归一化到 [0, 360) */
+static double wrap_degrees_360(double deg) {
+    deg = fmod(deg, 360.0);
+    return (deg < 0) ? deg + 360.0 : deg;
+}
+
+/* 角度归一化到 (-180, 180] */
+static double wrap_degrees_180(double deg) {
+    deg = wrap_degrees_360(deg);
+    return (deg > 180.0) ? deg - 360.0 : deg;
+}
+
+/* 六根数中 a 与状态向量同单位 (m)，角度单位为度 */
 int orbit_elements_to_state(OrbitalElements *elements, StateVector *state) {
     if (!elements || !state) return -1;
+    if (elements->a <= 0 || elements->e < 0 || elements->e >= 1.0) return -1;
+
+    double a = elements->a, e = elements->e;
+    double nu = orbit_mean_anomaly_to_true_anomaly(elements->m0 * ORBIT_D2R, e);
+    double p = a * (1.0 - e * e);
+    double r = p / (1.0 + e * cos(nu));
+    double sqrt_mu_p = sqrt(MU_SI / p);
+
+    // PQW坐标系
+    Vector3 r_pqw = {r * cos(nu), r * sin(nu), 0.0};
+    Vector3 v_pqw = {-sqrt_mu_p * sin(nu), sqrt_mu_p * (e + cos(nu)), 0.0};
+
+    // PQW -> ECI: R3(-Ω) R1(-i) R3(-ω)
+    Matrix3x3 rot = matrix3x3_multiply(
+        matrix3x3_multiply(matrix3x3_rotation_z(elements->omega_big * ORBIT_D2R),
+                           matrix3x3_rotation_x(elements->i * ORBIT_D2R)),
+        matrix3x3_rotation_z(elements->omega_small * ORBIT_D2R));
+
+    state->position = matrix3x3_multiply_vector(rot, r_pqw);
+    state->velocity = matrix3x3_multiply_vector(rot, v_pqw);
     return 0;
 }
 
 int orbit_state_to_elements(StateVector *state, OrbitalElements *elements) {
     if (!state || !elements) return -1;
+
+    Vector3 r = state->position, v = state->velocity;
+    double r_mag = vector3_magnitude(r);
+    double v2 = vector3_magnitude_squared(v);
+    if (r_mag < 1.0) return -1;
+
+    Vector3 h = orbit_angular_momentum_vector(r, v);
+    double h_mag = vector3_magnitude(h);
+    if (h_mag < EPSILON) return -1;
+
+    Vector3 node = {-h.y, h.x, 0.0};
+    double node_mag = vector3_magnitude(node);
+    Vector3 e_vec = orbit_eccentricity_vector(r, v);
+    double e = vector3_magnitude(e_vec);
+
+    double energy = 0.5 * v2 - MU_SI / r_mag;
+    if (energy >= 0) return -1;
+
+    elements->a = -MU_SI / (2.0 * energy);
+    elements->e = e;
+    elements->i = acos(fmax(-1.0, fmin(1.0, h.z / h_mag))) * ORBIT_R2D;
+
+    // 升交点赤经（赤道轨道取0）
+    double raan = 0.0;
+    if (node_mag > 1e-9 * h_mag) {
+        raan = acos(fmax(-1.0, fmin(1.0, node.x / node_mag)));
+        if (node.y < 0) raan = 2.0 * PI - raan;
+    }
+
+    // 近地点幅角和真近点角（近圆轨道以升交点/x轴为参考）
+    double argp = 0.0, nu;
+    Vector3 ref = (node_mag > 1e-9 * h_mag) ? vector3_scale(node, 1.0 / node_mag) : (Vector3){1.0, 0.0, 0.0};
+    if (e > 1e-10) {
+        argp = acos(fmax(-1.0, fmin(1.0, vector3_dot(ref, e_vec) / e)));
+        if (vector3_dot(vector3_cross(ref, e_vec), h) < 0) argp = 2.0 * PI - argp;
+        nu = acos(fmax(-1.0, fmin(1.0, vector3_dot(e_vec, r) / (e * r_mag))));
+        if (vector3_dot(r, v) < 0) nu = 2.0 * PI - nu;
+    } else {
+        nu = acos(fmax(-1.0, fmin(1.0, vector3_dot(ref, r) / r_mag)));
+        if (vector3_dot(vector3_cross(ref, r), h) < 0) nu = 2.0 * PI - nu;
+    }
+
+    double E = orbit_true_anomaly_to_eccentric_anomaly(nu, e);
+    double M = E - e * sin(E);
+
+    elements->omega_big = wrap_degrees_360(raan * ORBIT_R2D);
+    elements->omega_small = wrap_degrees_360(argp * ORBIT_R2D);
+    elements->m0 = wrap_degrees_360(M * ORBIT_R2D);
     return 0;
 }
 
+Vector3 orbit_angular_momentum_vector(Vector3 r, Vector3 v) {
+    return vector3_cross(r, v);
+}
+
 Vector3 orbit_eccentricity_vector(Vector3 r, Vector3 v) {
-    return (Vector3){0, 0, 0};
+    double r_mag = vector3_magnitude(r);
+    if (r_mag < 1.0) return (Vector3){0, 0, 0};
+    Vector3 h = vector3_cross(r, v);
+    Vector3 vxh = vector3_cross(v, h);
+    return vector3_sub(vector3_scale(vxh, 1.0 / MU_SI), vector3_scale(r, 1.0 / r_mag));
+}
+
+double orbit_solve_kepler_equation(double M, double e, double tolerance) {
+    return orbit_kepler_equation_solve(M, e, tolerance, ORBIT_KEPLER_MAX_ITERATIONS);
+}
+
+double orbit_eccentric_anomaly_to_true_anomaly(double E, double e) {
+    return 2.0 * atan2(sqrt(1.0 + e) * sin(E / 2.0), sqrt(1.0 - e) * cos(E / 2.0));
+}
+
+double orbit_true_anomaly_to_eccentric_anomaly(double nu, double e) {
+    double E = 2.0 * atan2(sqrt(1.0 - e) * sin(nu / 2.0), sqrt(1.0 + e) * cos(nu / 2.0));
+    return (E < 0) ? E + 2.0 * PI : E;
+}
+
+double orbit_mean_anomaly_to_true_anomaly(double M, double e) {
+    double E = orbit_solve_kepler_equation(M, e, 1e-12);
+    return orbit_eccentric_anomaly_to_true_anomaly(E, e);
 }
 
 double orbit_period(double a) {
@@ -84,13 +196,70 @@ int orbit_lambert_solve(Vector3 r1, Vector3 r2, double tof, int num_revolutions,
     return 0;
 }
 
+/* 状态导数：d(r,v)/dt = (v, a_grav + a_extra + a_perturb) */
+static void orbit_derivative(const StateVector *s, const Vector3 *extra, const PerturbationModel *model,
+                             Vector3 *dr, Vector3 *dv) {
+    double r2 = vector3_magnitude_squared(s->position);
+    double r_mag = sqrt(r2);
+    Vector3 a = (r_mag > 1.0) ? vector3_scale(s->position, -MU_SI / (r2 * r_mag)) : vector3_zero();
+
+    if (extra) a = vector3_add(a, *extra);
+    if (model) a = vector3_add(a, perturbation_total_acceleration(model, s));
+
+    *dr = s->velocity;
+    *dv = a;
+}
+
+static void orbit_rk4_integrate(StateVector *state, double dt, const Vector3 *extra, const PerturbationModel *model) {
+    StateVector s0 = *state, tmp;
+    Vector3 k1r, k1v, k2r, k2v, k3r, k3v, k4r, k4v;
+
+    orbit_derivative(&s0, extra, model, &k1r, &k1v);
+
+    tmp.position = vector3_add(s0.position, vector3_scale(k1r, 0.5 * dt));
+    tmp.velocity = vector3_add(s0.velocity, vector3_scale(k1v, 0.5 * dt));
+    tmp.time = s0.time + 0.5 * dt;
+    orbit_derivative(&tmp, extra, model, &k2r, &k2v);
+
+    tmp.position = vector3_add(s0.position, vector3_scale(k2r, 0.5 * dt));
+    tmp.velocity = vector3_add(s0.velocity, vector3_scale(k2v, 0.5 * dt));
+    orbit_derivative(&tmp, extra, model, &k3r, &k3v);
+
+    tmp.position = vector3_add(s0.position, vector3_scale(k3r, dt));
+    tmp.velocity = vector3_add(s0.velocity, vector3_scale(k3v, dt));
+    tmp.time = s0.time + dt;
+    orbit_derivative(&tmp, extra, model, &k4r, &k4v);
+
+    double w = dt / 6.0;
+    state->position = vector3_add(s0.position, vector3_scale(
+        vector3_add(vector3_add(k1r, vector3_scale(k2r, 2.0)), vector3_add(vector3_scale(k3r, 2.0), k4r)), w));
+    state->velocity = vector3_add(s0.velocity, vector3_scale(
+        vector3_add(vector3_add(k1v, vector3_scale(k2v, 2.0)), vector3_add(vector3_scale(k3v, 2.0), k4v)), w));
+    state->time = s0.time + dt;
+}
+
 int orbit_rk4_step(StateVector *state, double dt, Vector3 *acceleration) {
-    if (!state || !acceleration) return -1;
+    if (!state || dt == 0) return -1;
+    orbit_rk4_integrate(state, dt, acceleration, NULL);
+    return 0;
+}
+
+int orbit_rk4_step_perturbed(StateVector *state, double dt, const PerturbationModel *model) {
+    if (!state || dt == 0) return -1;
+    orbit_rk4_integrate(state, dt, NULL, model);
     return 0;
 }
 
 int orbit_propagate(StateVector *initial_state, double propagation_time, StateVector *final_state, double time_step) {
-    if (!initial_state || !final_state) return -1;
+    if (!initial_state || !final_state || time_step <= 0) return -1;
+
+    *final_state = *initial_state;
+    double remaining = propagation_time;
+    while (remaining > 1e-9) {
+        double h = (remaining < time_step) ? remaining : time_step;
+        orbit_rk4_integrate(final_state, h, NULL, NULL);
+        remaining -= h;
+    }
     return 0;
 }
 
@@ -129,14 +298,28 @@ double orbit_maintenance_delta_v(double decay_rate, double maintenance_period) {
     return 0;
 }
 
+/* 相对根数 = 从星根数 - 主星根数，角度差归一化到 (-180, 180] */
 int orbit_calculate_relative_elements(OrbitalElements *chief_orb, OrbitalElements *deputy_orb, OrbitalElements *relative_orb) {
     if (!chief_orb || !deputy_orb || !relative_orb) return -1;
+    relative_orb->a = deputy_orb->a - chief_orb->a;
+    relative_orb->e = deputy_orb->e - chief_orb->e;
+    relative_orb->i = wrap_degrees_180(deputy_orb->i - chief_orb->i);
+    relative_orb->omega_big = wrap_degrees_180(deputy_orb->omega_big - chief_orb->omega_big);
+    relative_orb->omega_small = wrap_degrees_180(deputy_orb->omega_small - chief_orb->omega_small);
+    relative_orb->m0 = wrap_degrees_180(deputy_orb->m0 - chief_orb->m0);
     return 0;
 }
 
 int orbit_absolute_from_relative(OrbitalElements *chief_orb, OrbitalElements *relative_orb, OrbitalElements *deputy_orb) {
     if (!chief_orb || !relative_orb || !deputy_orb) return -1;
-    return 0;
+    deputy_orb->a = chief_orb->a + relative_orb->a;
+    deputy_orb->e = chief_orb->e + relative_orb->e;
+    deputy_orb->i = chief_orb->i + relative_orb->i;
+    deputy_orb->omega_big = wrap_degrees_360(chief_orb->omega_big + relative_orb->omega_big);
+    deputy_orb->omega_small = wrap_degrees_360(chief_orb->omega_small + relative_orb->omega_small);
+    deputy_orb->m0 = wrap_degrees_360(chief_orb->m0 + relative_orb->m0);
+    if (deputy_orb->e < 0) deputy_orb->e = 0;
+    return (deputy_orb->a > 0 && deputy_orb->e < 1.0) ? 0 : -1;
 }
 
 int orbit_lambert_find_optimal_tof(Vector3 r1, Vector3 r2, double tof_min, double tof_max, double mu, double *optimal_tof) {
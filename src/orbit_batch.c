@@ -0,0 +1,67 @@
+#include <orbit.h>
+#include <vector3_soa.h>
+#include <string.h>
+#include <math.h>
+
+/* 与 vector3_soa.c 相同：禁止乘加合并，保证各指令集结果逐位一致 */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+/* 加速度模型：无摄动模型 / 有模型但无启用项 / 启用J2（与标量版的加法次序对应） */
+enum {
+    ORBIT_BATCH_TWO_BODY = 0,
+    ORBIT_BATCH_MODEL,
+    ORBIT_BATCH_J2
+};
+
+/* ==================== 内核实例化 ==================== */
+
+typedef struct {
+    void (*rk4)(double *const*, double *const*, int, double, int);
+} OrbitBatchKernels;
+
+#define SIMD_KERNELS_FILE "orbit_batch_kernels.inc"
+#include "simd_instantiate.inc"
+
+#define ORBIT_BATCH_KERNELS(suffix) { orbit_batch_rk4_##suffix }
+
+/* 下标与 Vector3SoAIsa 一致，随 vector3_soa_set_isa 切换 */
+static const OrbitBatchKernels ORBIT_BATCH_KERNEL_TABLE[VECTOR3_SOA_ISA_COUNT] = {
+    ORBIT_BATCH_KERNELS(scalar),
+#ifdef VSOA_X86
+    ORBIT_BATCH_KERNELS(sse2),
+    ORBIT_BATCH_KERNELS(avx2),
+    ORBIT_BATCH_KERNELS(avx512),
+#endif
+};
+
+static inline const OrbitBatchKernels* orbit_batch_kernels(void) {
+    return &ORBIT_BATCH_KERNEL_TABLE[vector3_soa_get_isa()];
+}
+
+/* ==================== 批量接口 ==================== */
+
+int orbit_batch_supports(const PerturbationModel *model) {
+    return !model || (model->enabled_flags & ~(uint32_t)PERTURB_J2) == 0;
+}
+
+int orbit_batch_rk4_step(Vector3SoA *position, Vector3SoA *velocity, double dt, const PerturbationModel *model) {
+    if (!position || !velocity || velocity->count != position->count || dt == 0) return -1;
+    if (!orbit_batch_supports(model)) return -1;
+
+    int mode = !model ? ORBIT_BATCH_TWO_BODY
+             : (model->enabled_flags & PERTURB_J2) ? ORBIT_BATCH_J2 : ORBIT_BATCH_MODEL;
+    double *pos[3] = { position->x, position->y, position->z };
+    double *vel[3] = { velocity->x, velocity->y, velocity->z };
+    orbit_batch_kernels()->rk4(pos, vel, position->count, dt, mode);
+    return 0;
+}
+
+/* 没有按指令集实例化：sin/cos 只能逐元素调用 libm，且须与标量版逐位一致 */
+void orbit_batch_solve_kepler(const double *M, const double *e, double *E, int count, double tolerance) {
+    if (!M || !e || !E || count <= 0) return;
+    for (int i = 0; i < count; i++) E[i] = orbit_solve_kepler_equation(M[i], e[i], tolerance);
+}
@@ -0,0 +1,325 @@
+#include <perturbation.h>
+#include <constants.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define ARCSEC_TO_RAD   (PI / (180.0 * 3600.0))
+#define OBLIQUITY_J2000 (23.43929111 * PI / 180.0)
+
+/* ==================== 内置摄动项 ==================== */
+
+static Vector3 term_j2(const PerturbationModel *model, const StateVector *state, void *user_data) {
+    (void)model;
+    (void)user_data;
+    return perturbation_j2_acceleration(state->position);
+}
+
+static Vector3 term_sun(const PerturbationModel *model, const StateVector *state, void *user_data) {
+    (void)user_data;
+    Vector3 r_sun = perturbation_sun_position(model, state->time);
+    return perturbation_third_body_acceleration(state->position, r_sun, MU_SUN_SI);
+}
+
+static Vector3 term_moon(const PerturbationModel *model, const StateVector *state, void *user_data) {
+    (void)user_data;
+    Vector3 r_moon = perturbation_moon_position(model, state->time);
+    return perturbation_third_body_acceleration(state->position, r_moon, MU_MOON_SI);
+}
+
+static Vector3 term_srp(const PerturbationModel *model, const StateVector *state, void *user_data) {
+    (void)user_data;
+    Vector3 r_sun = perturbation_sun_position(model, state->time);
+    return perturbation_srp_acceleration(state->position, r_sun, model->srp_cr, model->srp_area_to_mass);
+}
+
+static void register_builtin(PerturbationModel *model, const char *name, uint32_t flag, perturbation_accel_func accel) {
+    PerturbationTerm *term = &model->terms[model->num_terms++];
+    term->name = name;
+    term->flag = flag;
+    term->accel = accel;
+    term->user_data = NULL;
+}
+
+/* ==================== 模型创建和配置 ==================== */
+
+int perturbation_model_init(PerturbationModel *model, uint32_t flags, double epoch_jd, double span_seconds) {
+    if (!model) return -1;
+    memset(model, 0, sizeof(PerturbationModel));
+
+    model->enabled_flags = flags;
+    model->epoch_jd = (epoch_jd > 0) ? epoch_jd : JD_J2000;
+    model->srp_cr = 1.5;
+    model->srp_area_to_mass = 0.02;
+
+    register_builtin(model, "J2", PERTURB_J2, term_j2);
+    register_builtin(model, "SUN", PERTURB_SUN, term_sun);
+    register_builtin(model, "MOON", PERTURB_MOON, term_moon);
+    register_builtin(model, "SRP", PERTURB_SRP, term_srp);
+
+    // 星历表总是生成：之后允许在运行中打开日月/光压项
+    if (span_seconds <= 0) span_seconds = SECONDS_PER_DAY;
+    if (ephemeris_build(&model->sun, ephemeris_sun_position_analytic, model->epoch_jd,
+                        span_seconds, EPHEMERIS_SEGMENT_SECONDS) != 0 ||
+        ephemeris_build(&model->moon, ephemeris_moon_position_analytic, model->epoch_jd,
+                        span_seconds, EPHEMERIS_SEGMENT_SECONDS) != 0) {
+        perturbation_model_free(model);
+        return -1;
+    }
+
+    return 0;
+}
+
+void perturbation_model_free(PerturbationModel *model) {
+    if (!model) return;
+    ephemeris_free(&model->sun);
+    ephemeris_free(&model->moon);
+}
+
+void perturbation_model_enable(PerturbationModel *model, uint32_t flags, int enabled) {
+    if (!model) return;
+    if (enabled) {
+        model->enabled_flags |= flags;
+    } else {
+        model->enabled_flags &= ~flags;
+    }
+}
+
+int perturbation_model_is_enabled(const PerturbationModel *model, uint32_t flag) {
+    if (!model) return 0;
+    return (model->enabled_flags & flag) ? 1 : 0;
+}
+
+uint32_t perturbation_model_add_term(PerturbationModel *model, const char *name,
+                                     perturbation_accel_func accel, void *user_data) {
+    if (!model || !accel || model->num_terms >= PERTURBATION_MAX_TERMS) return 0;
+
+    int custom_index = 0;
+    for (int i = 0; i < model->num_terms; i++) {
+        if (model->terms[i].flag >= PERTURB_CUSTOM) custom_index++;
+    }
+
+    PerturbationTerm *term = &model->terms[model->num_terms++];
+    term->name = name;
+    term->flag = (uint32_t)PERTURB_CUSTOM << custom_index;
+    term->accel = accel;
+    term->user_data = user_data;
+    return term->flag;
+}
+
+void perturbation_model_set_srp(PerturbationModel *model, double cr, double area_to_mass) {
+    if (!model) return;
+    model->srp_cr = cr;
+    model->srp_area_to_mass = area_to_mass;
+}
+
+/* ==================== 加速度计算 ==================== */
+
+Vector3 perturbation_total_acceleration(const PerturbationModel *model, const StateVector *state) {
+    Vector3 total = vector3_zero();
+    if (!model || !state || !model->enabled_flags) return total;
+
+    for (int i = 0; i < model->num_terms; i++) {
+        const PerturbationTerm *term = &model->terms[i];
+        if (!(model->enabled_flags & term->flag)) continue;
+        total = vector3_add(total, term->accel(model, state, term->user_data));
+    }
+    return total;
+}
+
+Vector3 perturbation_j2_acceleration(Vector3 r) {
+    double r2 = vector3_magnitude_squared(r);
+    if (r2 < 1.0) return vector3_zero();
+
+    double r_mag = sqrt(r2);
+    double z2_r2 = (r.z * r.z) / r2;
+    double factor = -1.5 * EARTH_J2 * MU_SI * EARTH_EQ_RADIUS_SI * EARTH_EQ_RADIUS_SI / (r2 * r2 * r_mag);
+
+    return (Vector3){
+        factor * r.x * (1.0 - 5.0 * z2_r2),
+        factor * r.y * (1.0 - 5.0 * z2_r2),
+        factor * r.z * (3.0 - 5.0 * z2_r2)
+    };
+}
+
+Vector3 perturbation_third_body_acceleration(Vector3 r, Vector3 r_body, double mu_body) {
+    Vector3 d = vector3_sub(r_body, r);
+    double d_mag = vector3_magnitude(d);
+    double s_mag = vector3_magnitude(r_body);
+    if (d_mag < 1.0 || s_mag < 1.0) return vector3_zero();
+
+    double d3 = d_mag * d_mag * d_mag;
+    double s3 = s_mag * s_mag * s_mag;
+    return (Vector3){
+        mu_body * (d.x / d3 - r_body.x / s3),
+        mu_body * (d.y / d3 - r_body.y / s3),
+        mu_body * (d.z / d3 - r_body.z / s3)
+    };
+}
+
+Vector3 perturbation_srp_acceleration(Vector3 r, Vector3 r_sun, double cr, double area_to_mass) {
+    // 柱形地影：卫星位于背日侧且到日地连线距离小于地球半径时无光压
+    Vector3 sun_dir = vector3_normalize(r_sun);
+    double along = vector3_dot(r, sun_dir);
+    if (along < 0) {
+        Vector3 perp = vector3_sub(r, vector3_scale(sun_dir, along));
+        if (vector3_magnitude(perp) < EARTH_EQ_RADIUS_SI) return vector3_zero();
+    }
+
+    Vector3 d = vector3_sub(r, r_sun);
+    double d_mag = vector3_magnitude(d);
+    if (d_mag < 1.0) return vector3_zero();
+
+    double scale = SOLAR_PRESSURE_SI * cr * area_to_mass * (AU_SI * AU_SI) / (d_mag * d_mag);
+    return vector3_scale(d, scale / d_mag);
+}
+
+Vector3 perturbation_sun_position(const PerturbationModel *model, double t) {
+    if (!model) return vector3_zero();
+    return ephemeris_evaluate(&model->sun, t);
+}
+
+Vector3 perturbation_moon_position(const PerturbationModel *model, double t) {
+    if (!model) return vector3_zero();
+    return ephemeris_evaluate(&model->moon, t);
+}
+
+/* ==================== 解析星历（Montenbruck & Gill 低精度公式） ==================== */
+
+static Vector3 ecliptic_to_equatorial(double lon, double lat, double dist) {
+    double cos_lat = cos(lat);
+    double x = dist * cos_lat * cos(lon);
+    double y = dist * cos_lat * sin(lon);
+    double z = dist * sin(lat);
+    double ce = cos(OBLIQUITY_J2000), se = sin(OBLIQUITY_J2000);
+    return (Vector3){x, ce * y - se * z, se * y + ce * z};
+}
+
+Vector3 ephemeris_sun_position_analytic(double jd) {
+    double T = (jd - JD_J2000) / 36525.0;
+    double M = (357.5256 + 35999.049 * T) * PI / 180.0;
+    double lon = (282.9400 * PI / 180.0) + M
+               + (6892.0 * sin(M) + 72.0 * sin(2.0 * M)) * ARCSEC_TO_RAD;
+    double dist = (149.619 - 2.499 * cos(M) - 0.021 * cos(2.0 * M)) * 1.0e9;
+    return ecliptic_to_equatorial(lon, 0.0, dist);
+}
+
+Vector3 ephemeris_moon_position_analytic(double jd) {
+    double T = (jd - JD_J2000) / 36525.0;
+    double d2r = PI / 180.0;
+
+    double L0 = (218.31617 + 481267.88088 * T - 1.3972 * T) * d2r;
+    double l  = (134.96292 + 477198.86753 * T) * d2r;
+    double lp = (357.52543 + 35999.04944 * T) * d2r;
+    double F  = (93.27283 + 483202.01873 * T) * d2r;
+    double D  = (297.85027 + 445267.11135 * T) * d2r;
+
+    double dlon = 22640.0 * sin(l) + 769.0 * sin(2*l)
+                - 4586.0 * sin(l - 2*D) + 2370.0 * sin(2*D)
+                - 668.0 * sin(lp) - 412.0 * sin(2*F)
+                - 212.0 * sin(2*l - 2*D) - 206.0 * sin(l + lp - 2*D)
+                + 192.0 * sin(l + 2*D) - 165.0 * sin(lp - 2*D)
+                + 148.0 * sin(l - lp) - 125.0 * sin(D)
+                - 110.0 * sin(l + lp) - 55.0 * sin(2*F - 2*D);
+    double lon = L0 + dlon * ARCSEC_TO_RAD;
+
+    double lat = 18520.0 * sin(F + lon - L0 + (412.0 * sin(2*F) + 541.0 * sin(lp)) * ARCSEC_TO_RAD)
+               - 526.0 * sin(F - 2*D) + 44.0 * sin(l + F - 2*D)
+               - 31.0 * sin(-l + F - 2*D) - 25.0 * sin(-2*l + F)
+               - 23.0 * sin(lp + F - 2*D) + 21.0 * sin(-l + F)
+               + 11.0 * sin(-lp + F - 2*D);
+    lat *= ARCSEC_TO_RAD;
+
+    double dist = (385000.0 - 20905.0 * cos(l) - 3699.0 * cos(2*D - l)
+                 - 2956.0 * cos(2*D) - 570.0 * cos(2*l) + 246.0 * cos(2*l - 2*D)
+                 - 205.0 * cos(lp - 2*D) - 171.0 * cos(l + 2*D)
+                 - 152.0 * cos(l + lp - 2*D)) * 1000.0;
+
+    return ecliptic_to_equatorial(lon, lat, dist);
+}
+
+/* ==================== 切比雪夫星历表 ==================== */
+
+static void fit_segment(ChebyshevSegment *seg, ephemeris_position_func position_func, double epoch_jd) {
+    const int n = EPHEMERIS_CHEB_ORDER;
+    double half = 0.5 * (seg->t_end - seg->t_start);
+    double mid = 0.5 * (seg->t_end + seg->t_start);
+    Vector3 samples[EPHEMERIS_CHEB_ORDER];
+
+    for (int k = 0; k < n; k++) {
+        double x = cos(PI * (k + 0.5) / n);
+        double t = mid + half * x;
+        samples[k] = position_func(epoch_jd + t / SECONDS_PER_DAY);
+    }
+
+    for (int j = 0; j < n; j++) {
+        double cx = 0, cy = 0, cz = 0;
+        for (int k = 0; k < n; k++) {
+            double w = cos(PI * j * (k + 0.5) / n);
+            cx += samples[k].x * w;
+            cy += samples[k].y * w;
+            cz += samples[k].z * w;
+        }
+        seg->coeffs[0][j] = 2.0 * cx / n;
+        seg->coeffs[1][j] = 2.0 * cy / n;
+        seg->coeffs[2][j] = 2.0 * cz / n;
+    }
+}
+
+int ephemeris_build(ChebyshevEphemeris *eph, ephemeris_position_func position_func,
+                    double epoch_jd, double span_seconds, double segment_span) {
+    if (!eph || !position_func || span_seconds <= 0 || segment_span <= 0) return -1;
+
+    int num_segments = (int)ceil(span_seconds / segment_span);
+    if (num_segments < 1) num_segments = 1;
+
+    eph->segments = (ChebyshevSegment*)malloc(sizeof(ChebyshevSegment) * num_segments);
+    if (!eph->segments) return -1;
+
+    eph->num_segments = num_segments;
+    eph->segment_span = segment_span;
+    eph->t_start = 0.0;
+    eph->t_end = num_segments * segment_span;
+
+    for (int s = 0; s < num_segments; s++) {
+        eph->segments[s].t_start = s * segment_span;
+        eph->segments[s].t_end = (s + 1) * segment_span;
+        fit_segment(&eph->segments[s], position_func, epoch_jd);
+    }
+    return 0;
+}
+
+void ephemeris_free(ChebyshevEphemeris *eph) {
+    if (!eph) return;
+    free(eph->segments);
+    eph->segments = NULL;
+    eph->num_segments = 0;
+}
+
+static double clenshaw(const double *c, int n, double x) {
+    double b1 = 0, b2 = 0;
+    for (int j = n - 1; j >= 1; j--) {
+        double b0 = 2.0 * x * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b0;
+    }
+    return x * b1 - b2 + 0.5 * c[0];
+}
+
+Vector3 ephemeris_evaluate(const ChebyshevEphemeris *eph, double t) {
+    if (!eph || !eph->segments) return vector3_zero();
+
+    int s = (int)floor((t - eph->t_start) / eph->segment_span);
+    if (s < 0) s = 0;
+    if (s >= eph->num_segments) s = eph->num_segments - 1;
+
+    const ChebyshevSegment *seg = &eph->segments[s];
+    double half = 0.5 * (seg->t_end - seg->t_start);
+    double x = (t - 0.5 * (seg->t_end + seg->t_start)) / half;
+
+    return (Vector3){
+        clenshaw(seg->coeffs[0], EPHEMERIS_CHEB_ORDER, x),
+        clenshaw(seg->coeffs[1], EPHEMERIS_CHEB_ORDER, x),
+        clenshaw(seg->coeffs[2], EPHEMERIS_CHEB_ORDER, x)
+    };
+}
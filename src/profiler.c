@@ -0,0 +1,197 @@
+#define _DEFAULT_SOURCE
+
+#include <profiler.h>
+#include <trace.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static _Atomic(Profiler*) prof_registry = NULL;     // 所有线程的统计（只增不删）
+static _Thread_local Profiler *prof_local = NULL;
+
+static const char *const PROF_PHASE_NAMES[PROF_PHASE_COUNT] = {
+    "step", "propagation", "decision", "partition", "kmeans",
+    "payoff", "assignment", "formation", "attitude", "history", "output", "run"
+};
+
+static const char *const PROF_PHASE_LABELS[PROF_PHASE_COUNT] = {
+    "单步合计", "轨道外推", "决策合计", "  红蓝分队", "  K-means分组",
+    "  收益矩阵", "  目标分配", "编队控制", "姿态", "历史记录", "结果输出", "单次运行"
+};
+
+/* ==================== 内部函数 ==================== */
+
+/* 对数-线性分档：小于 2^SUB 的值逐一分档，其上每个2倍区间细分 2^SUB 档 */
+static inline uint32_t prof_bucket_index(uint64_t ns) {
+    if (ns < (1u << PROF_SUB_BITS)) return (uint32_t)ns;
+    int e = 63 - __builtin_clzll(ns);
+    uint32_t sub = (uint32_t)(ns >> (e - PROF_SUB_BITS)) & ((1u << PROF_SUB_BITS) - 1);
+    return ((uint32_t)(e - PROF_SUB_BITS + 1) << PROF_SUB_BITS) + sub;
+}
+
+static uint64_t prof_bucket_lower(uint32_t index) {
+    if (index < (1u << PROF_SUB_BITS)) return index;
+    int e = (int)(index >> PROF_SUB_BITS) + PROF_SUB_BITS - 1;
+    uint64_t sub = index & ((1u << PROF_SUB_BITS) - 1);
+    return ((1ull << PROF_SUB_BITS) + sub) << (e - PROF_SUB_BITS);
+}
+
+/* 当前线程的统计，首次使用时创建并以CAS挂入全局链表 */
+static Profiler* prof_local_state(void) {
+    if (prof_local) return prof_local;
+
+    Profiler *state = (Profiler*)calloc(1, sizeof(Profiler));
+    if (!state) return NULL;
+
+    Profiler *head = atomic_load(&prof_registry);
+    do {
+        state->next = head;
+    } while (!atomic_compare_exchange_weak(&prof_registry, &head, state));
+
+    prof_local = state;
+    return state;
+}
+
+/* 按显示宽度左对齐输出（多字节字符按2列计） */
+static void prof_print_padded(const char *text, int width) {
+    int columns = 0;
+    for (const unsigned char *c = (const unsigned char*)text; *c; c++) {
+        if (*c < 0x80) columns++;
+        else if ((*c & 0xC0) == 0xC0) columns += 2;
+    }
+    printf("%s%*s", text, width > columns ? width - columns : 0, "");
+}
+
+/* ==================== 接口实现 ==================== */
+
+uint64_t profiler_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+Profiler* profiler_current(void) {
+    return prof_local_state();
+}
+
+void profiler_reset(void) {
+    Profiler *state = prof_local_state();
+    if (!state) return;
+    memset(state->phases, 0, sizeof(state->phases));
+    memset(state->tick_ns, 0, sizeof(state->tick_ns));
+}
+
+void profiler_record(ProfPhase phase, uint64_t start_ns, uint64_t end_ns) {
+    if (phase < 0 || phase >= PROF_PHASE_COUNT) return;
+    uint64_t ns = end_ns - start_ns;
+    trace_record(phase, start_ns, end_ns);
+
+    Profiler *state = prof_local_state();
+    if (!state) return;
+
+    ProfHistogram *hist = &state->phases[phase];
+    hist->count++;
+    hist->total_ns += ns;
+    if (ns > hist->max_ns) hist->max_ns = ns;
+    hist->buckets[prof_bucket_index(ns)]++;
+
+    if (state->trace) state->tick_ns[phase] += ns;
+}
+
+const char* profiler_phase_name(ProfPhase phase) {
+    if (phase < 0 || phase >= PROF_PHASE_COUNT) return "unknown";
+    return PROF_PHASE_NAMES[phase];
+}
+
+uint64_t profiler_percentile(const ProfHistogram *hist, double q) {
+    if (!hist || hist->count == 0) return 0;
+    if (q < 0) q = 0;
+    if (q > 1) q = 1;
+
+    uint64_t rank = (uint64_t)(q * (double)(hist->count - 1)) + 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < PROF_NUM_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            uint64_t lower = prof_bucket_lower(i);
+            uint64_t upper = (i + 1 < PROF_NUM_BUCKETS) ? prof_bucket_lower(i + 1) : hist->max_ns;
+            uint64_t mid = lower + (upper - lower) / 2;
+            return (mid < hist->max_ns) ? mid : hist->max_ns;
+        }
+    }
+    return hist->max_ns;
+}
+
+void profiler_set_trace(FILE *file) {
+    Profiler *state = prof_local_state();
+    if (!state) return;
+    state->trace = file;
+    memset(state->tick_ns, 0, sizeof(state->tick_ns));
+    if (!file) return;
+
+    fprintf(file, "step");
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        fprintf(file, ",%s_us", PROF_PHASE_NAMES[p]);
+    }
+    fprintf(file, "\n");
+}
+
+void profiler_end_tick(uint32_t step) {
+    Profiler *state = prof_local;
+    if (!state || !state->trace) return;
+
+    fprintf(state->trace, "%u", step);
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        fprintf(state->trace, ",%.3f", state->tick_ns[p] / 1000.0);
+    }
+    fprintf(state->trace, "\n");
+    memset(state->tick_ns, 0, sizeof(state->tick_ns));
+}
+
+void profiler_print_summary(void) {
+    // 各线程直方图逐档相加（分档一致，合并后分位数与单线程统计同精度）
+    ProfHistogram *merged = (ProfHistogram*)calloc(PROF_PHASE_COUNT, sizeof(ProfHistogram));
+    if (!merged) return;
+    for (Profiler *state = atomic_load(&prof_registry); state; state = state->next) {
+        for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+            const ProfHistogram *src = &state->phases[p];
+            ProfHistogram *dst = &merged[p];
+            if (src->count == 0) continue;
+            dst->count += src->count;
+            dst->total_ns += src->total_ns;
+            if (src->max_ns > dst->max_ns) dst->max_ns = src->max_ns;
+            for (uint32_t i = 0; i < PROF_NUM_BUCKETS; i++) dst->buckets[i] += src->buckets[i];
+        }
+    }
+    if (merged[PROF_STEP].count == 0) {
+        free(merged);
+        return;
+    }
+
+    double step_total = (double)merged[PROF_STEP].total_ns;
+    printf("│\n");
+    printf("│ 阶段耗时 (μs，全部线程):\n");
+    printf("│   ");
+    prof_print_padded("阶段", 16);
+    printf("%8s %9s %9s %9s %9s %7s\n", "count", "mean", "p50", "p99", "max", "%step");
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        const ProfHistogram *hist = &merged[p];
+        if (hist->count == 0) continue;
+        printf("│   ");
+        prof_print_padded(PROF_PHASE_LABELS[p], 16);
+        printf("%8llu %9.2f %9.2f %9.2f %9.2f",
+               (unsigned long long)hist->count,
+               hist->total_ns / 1000.0 / hist->count,
+               profiler_percentile(hist, 0.50) / 1000.0,
+               profiler_percentile(hist, 0.99) / 1000.0,
+               hist->max_ns / 1000.0);
+        // 结果输出和单次运行在引擎步进之外，不计占比
+        if (p == PROF_OUTPUT || p == PROF_RUN) {
+            printf(" %7s\n", "-");
+        } else {
+            printf(" %6.1f%%\n", step_total > 0 ? 100.0 * hist->total_ns / step_total : 0.0);
+        }
+    }
+    free(merged);
+}
@@ -0,0 +1,402 @@
+#include <proximity.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* 按半径升序排列的有效阈值圈 */
+typedef struct {
+    int count;                             // 有效圈数 K，带序号 0..K（K 为带外）
+    double radius[PROXIMITY_ZONE_NONE];    // 进入半径 (m)
+    uint8_t zone[PROXIMITY_ZONE_NONE + 1]; // 带序号 -> ProximityZone
+    int rank[PROXIMITY_ZONE_COUNT];        // ProximityZone -> 带序号，未启用的圈为 -1
+} ProximityBands;
+
+/* ==================== 内部函数：距离带 ==================== */
+
+static void proximity_bands_build(ProximityBands *bands, const StrategyThresholds *t) {
+    const int km[PROXIMITY_ZONE_NONE] = { t->critical_distance, t->inspect_distance, t->attack_distance,
+                                          t->defense_distance, t->warning_distance };
+    bands->count = 0;
+    for (int z = 0; z < PROXIMITY_ZONE_NONE; z++) {
+        bands->rank[z] = -1;
+        if (km[z] <= 0) continue;
+        // 插入排序（同半径按枚举顺序，结果确定）
+        int k = bands->count++;
+        while (k > 0 && bands->radius[k - 1] > km[z] * 1000.0) {
+            bands->radius[k] = bands->radius[k - 1];
+            bands->zone[k] = bands->zone[k - 1];
+            k--;
+        }
+        bands->radius[k] = km[z] * 1000.0;
+        bands->zone[k] = (uint8_t)z;
+    }
+    for (int k = 0; k < bands->count; k++) bands->rank[bands->zone[k]] = k;
+    bands->zone[bands->count] = PROXIMITY_ZONE_NONE;
+    bands->rank[PROXIMITY_ZONE_NONE] = bands->count;
+}
+
+/**
+ * 带的滞回迁移：向内跨过进入半径即进入，向外须超出半径 (1 + PROXIMITY_HYSTERESIS) 才退出
+ * 原所在圈已停用（参数重载）时按距离重新定带
+ */
+static int proximity_bands_next(const ProximityBands *bands, int zone, double d) {
+    int b = bands->rank[zone];
+    if (b < 0) b = bands->count;
+    while (b > 0 && d < bands->radius[b - 1]) b--;
+    while (b < bands->count && d >= bands->radius[b] * (1.0 + PROXIMITY_HYSTERESIS)) b++;
+    return b;
+}
+
+/* ==================== 内部函数：散列 ==================== */
+
+static inline uint32_t proximity_id_slot(int id, int capacity) {
+    return ((uint32_t)id * 2654435769u) & (uint32_t)(capacity - 1);
+}
+
+static inline uint32_t proximity_pair_slot(int red_id, int blue_id, int capacity) {
+    return ((uint32_t)red_id * 2654435769u ^ (uint32_t)blue_id * 2246822519u) & (uint32_t)(capacity - 1);
+}
+
+static inline uint32_t proximity_cell_slot(const int32_t c[3], int num_buckets) {
+    return ((uint32_t)c[0] * 73856093u ^ (uint32_t)c[1] * 19349663u ^ (uint32_t)c[2] * 83492791u) &
+           (uint32_t)(num_buckets - 1);
+}
+
+/* 不小于 2n 的2的幂（负载率 ≤ 0.5） */
+static int proximity_table_size(int n) {
+    int capacity = 16;
+    while (capacity < 2 * n) capacity <<= 1;
+    return capacity;
+}
+
+static int proximity_red_reserve(ProximityMonitor *monitor, int n) {
+    if (n <= monitor->red_capacity) return 0;
+    int capacity = n * 2;
+    Vector3 *position = (Vector3*)realloc(monitor->red_position, sizeof(Vector3) * capacity);
+    if (position) monitor->red_position = position;
+    int *id = (int*)realloc(monitor->red_id, sizeof(int) * capacity);
+    if (id) monitor->red_id = id;
+    if (!position || !id) return -1;
+    monitor->red_capacity = capacity;
+    return 0;
+}
+
+static int proximity_pairs_reserve(ProximityMonitor *monitor, int n) {
+    if (n <= monitor->pairs_capacity) return 0;
+    int capacity = monitor->pairs_capacity > 0 ? monitor->pairs_capacity * 2 : 64;
+    while (capacity < n) capacity *= 2;
+    ProximityPair *pairs = (ProximityPair*)realloc(monitor->pairs, sizeof(ProximityPair) * capacity);
+    if (!pairs) return -1;
+    monitor->pairs = pairs;
+    monitor->pairs_capacity = capacity;
+    return 0;
+}
+
+/* ==================== 内部函数：蓝星网格 ==================== */
+
+static int proximity_grid_reserve(ProximityGrid *grid, int n) {
+    if (n <= grid->capacity) return 0;
+    int capacity = n * 2;
+    int *order = (int*)realloc(grid->order, sizeof(int) * capacity);
+    if (order) grid->order = order;
+    int32_t (*coord)[3] = (int32_t(*)[3])realloc(grid->coord, sizeof(int32_t[3]) * capacity);
+    if (coord) grid->coord = coord;
+    Vector3 *position = (Vector3*)realloc(grid->position, sizeof(Vector3) * capacity);
+    if (position) grid->position = position;
+    int *id = (int*)realloc(grid->id, sizeof(int) * capacity);
+    if (id) grid->id = id;
+    if (!order || !coord || !position || !id) return -1;
+    grid->capacity = capacity;
+    return 0;
+}
+
+static inline void proximity_grid_cell(const ProximityGrid *grid, Vector3 p, int32_t c[3]) {
+    c[0] = (int32_t)floor(p.x / grid->cell);
+    c[1] = (int32_t)floor(p.y / grid->cell);
+    c[2] = (int32_t)floor(p.z / grid->cell);
+}
+
+/**
+ * 按格散列桶做计数排序（蓝星位置、ID已写入 grid->position / grid->id）
+ */
+static int proximity_grid_build(ProximityGrid *grid) {
+    int num_buckets = proximity_table_size(grid->count);
+    if (num_buckets > grid->num_buckets) {
+        int *start = (int*)realloc(grid->bucket_start, sizeof(int) * (num_buckets + 1));
+        if (!start) return -1;
+        grid->bucket_start = start;
+    }
+    grid->num_buckets = num_buckets;
+    memset(grid->bucket_start, 0, sizeof(int) * (num_buckets + 1));
+
+    for (int i = 0; i < grid->count; i++) {
+        proximity_grid_cell(grid, grid->position[i], grid->coord[i]);
+        grid->bucket_start[proximity_cell_slot(grid->coord[i], num_buckets) + 1]++;
+    }
+    for (int b = 0; b < num_buckets; b++) grid->bucket_start[b + 1] += grid->bucket_start[b];
+
+    // 倒序回填保持桶内按原下标升序（遍历次序确定），填完后 start[b+1] 落在桶 b 的起点
+    for (int i = grid->count - 1; i >= 0; i--) {
+        uint32_t b = proximity_cell_slot(grid->coord[i], num_buckets);
+        grid->order[--grid->bucket_start[b + 1]] = i;
+    }
+    for (int b = 0; b < num_buckets; b++) grid->bucket_start[b] = grid->bucket_start[b + 1];
+    grid->bucket_start[num_buckets] = grid->count;
+    return 0;
+}
+
+/* ==================== 内部函数：卫星对和事件 ==================== */
+
+static int proximity_pair_find(const ProximityMonitor *monitor, int red_id, int blue_id) {
+    if (monitor->pair_index_capacity == 0) return -1;
+    uint32_t mask = (uint32_t)monitor->pair_index_capacity - 1;
+    uint32_t slot = proximity_pair_slot(red_id, blue_id, monitor->pair_index_capacity);
+    while (monitor->pair_index[slot]) {
+        const ProximityPair *pair = &monitor->pairs[monitor->pair_index[slot] - 1];
+        if (pair->red_id == red_id && pair->blue_id == blue_id) return monitor->pair_index[slot] - 1;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+static int proximity_pair_rebuild_index(ProximityMonitor *monitor) {
+    int capacity = proximity_table_size(monitor->num_pairs);
+    if (capacity > monitor->pair_index_capacity) {
+        int32_t *index = (int32_t*)realloc(monitor->pair_index, sizeof(int32_t) * capacity);
+        if (!index) return -1;
+        monitor->pair_index = index;
+        monitor->pair_index_capacity = capacity;
+    }
+    uint32_t mask = (uint32_t)monitor->pair_index_capacity - 1;
+    memset(monitor->pair_index, 0, sizeof(int32_t) * monitor->pair_index_capacity);
+    for (int i = 0; i < monitor->num_pairs; i++) {
+        uint32_t slot = proximity_pair_slot(monitor->pairs[i].red_id, monitor->pairs[i].blue_id,
+                                            monitor->pair_index_capacity);
+        while (monitor->pair_index[slot]) slot = (slot + 1) & mask;
+        monitor->pair_index[slot] = i + 1;
+    }
+    return 0;
+}
+
+/* 本次更新中卫星ID对应的位置，卫星已不在则返回0 */
+static int proximity_lookup_position(const ProximityMonitor *monitor, int id, int blue, Vector3 *out) {
+    uint32_t mask = (uint32_t)monitor->sat_index_capacity - 1;
+    uint32_t slot = proximity_id_slot(id, monitor->sat_index_capacity);
+    while (monitor->sat_index[slot]) {
+        int32_t v = monitor->sat_index[slot];
+        int index = (v > 0 ? v : -v) - 1;
+        int is_blue = v < 0;
+        int found_id = is_blue ? monitor->grid.id[index] : monitor->red_id[index];
+        if (found_id == id) {
+            if (is_blue != blue) return 0;
+            *out = is_blue ? monitor->grid.position[index] : monitor->red_position[index];
+            return 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0;
+}
+
+/* 写入事件缓冲；消费者未及时取走时丢弃新事件（不覆盖消费者可能正在读的旧事件） */
+static void proximity_emit(ProximityMonitor *monitor, double time, int red_id, int blue_id,
+                           uint8_t from, uint8_t to, int from_band, int to_band, double distance) {
+    monitor->total_events++;
+    uint32_t head = monitor->event_head;
+    uint32_t tail = __atomic_load_n(&monitor->event_tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= monitor->event_capacity) {
+        __atomic_fetch_add(&monitor->dropped, 1, __ATOMIC_RELAXED);   // 消费者线程可经引擎读取
+        return;
+    }
+    ProximityEvent *event = &monitor->events[head & (monitor->event_capacity - 1)];
+    event->time = time;
+    event->red_id = red_id;
+    event->blue_id = blue_id;
+    event->from = from;
+    event->to = to;
+    event->entering = to_band < from_band;
+    event->distance = distance;
+    __atomic_store_n(&monitor->event_head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* ==================== 创建和销毁 ==================== */
+
+ProximityMonitor* proximity_monitor_create(int event_capacity) {
+    ProximityMonitor *monitor = (ProximityMonitor*)calloc(1, sizeof(ProximityMonitor));
+    if (!monitor) return NULL;
+    uint32_t capacity = 1;
+    uint32_t wanted = event_capacity > 0 ? (uint32_t)event_capacity : PROXIMITY_DEFAULT_EVENTS;
+    while (capacity < wanted) capacity <<= 1;
+    monitor->events = (ProximityEvent*)calloc(capacity, sizeof(ProximityEvent));
+    if (!monitor->events) {
+        free(monitor);
+        return NULL;
+    }
+    monitor->event_capacity = capacity;
+    return monitor;
+}
+
+void proximity_monitor_destroy(ProximityMonitor *monitor) {
+    if (!monitor) return;
+    free(monitor->pairs);
+    free(monitor->pair_index);
+    free(monitor->grid.bucket_start);
+    free(monitor->grid.order);
+    free(monitor->grid.coord);
+    free(monitor->grid.position);
+    free(monitor->grid.id);
+    free(monitor->red_position);
+    free(monitor->red_id);
+    free(monitor->sat_index);
+    free(monitor->events);
+    free(monitor);
+}
+
+/* ==================== 更新 ==================== */
+
+int proximity_monitor_update(ProximityMonitor *monitor, Satellite *const *sats, int count,
+                             const StrategyThresholds *thresholds, double time) {
+    if (!monitor || (!sats && count > 0) || !thresholds) return -1;
+
+    ProximityBands bands;
+    proximity_bands_build(&bands, thresholds);
+    ProximityGrid *grid = &monitor->grid;
+    uint32_t stamp = ++monitor->stamp;
+    uint64_t emitted = monitor->total_events;
+
+    // ===== 分队并登记ID =====
+    int num_red = 0, num_blue = 0;
+    for (int i = 0; i < count; i++) {
+        if (!sats[i]) continue;
+        if (sats[i]->team == 0) num_red++;
+        else if (sats[i]->team == 1) num_blue++;
+    }
+    if (proximity_grid_reserve(grid, num_blue) != 0 || proximity_red_reserve(monitor, num_red) != 0) return -1;
+    int sat_capacity = proximity_table_size(num_red + num_blue);
+    if (sat_capacity > monitor->sat_index_capacity) {
+        int32_t *index = (int32_t*)realloc(monitor->sat_index, sizeof(int32_t) * sat_capacity);
+        if (!index) return -1;
+        monitor->sat_index = index;
+        monitor->sat_index_capacity = sat_capacity;
+    }
+    memset(monitor->sat_index, 0, sizeof(int32_t) * monitor->sat_index_capacity);
+
+    uint32_t id_mask = (uint32_t)monitor->sat_index_capacity - 1;
+    monitor->num_red = 0;
+    grid->count = 0;
+    for (int i = 0; i < count; i++) {
+        const Satellite *sat = sats[i];
+        if (!sat || sat->team > 1) continue;
+        int32_t value;
+        if (sat->team == 0) {
+            monitor->red_position[monitor->num_red] = sat->state.position;
+            monitor->red_id[monitor->num_red] = sat->id;
+            value = ++monitor->num_red;
+        } else {
+            grid->position[grid->count] = sat->state.position;
+            grid->id[grid->count] = sat->id;
+            value = -(++grid->count);
+        }
+        uint32_t slot = proximity_id_slot(sat->id, monitor->sat_index_capacity);
+        while (monitor->sat_index[slot]) slot = (slot + 1) & id_mask;
+        monitor->sat_index[slot] = value;
+    }
+
+    // ===== 候选对：每颗红星查相邻 27 格内的蓝星 =====
+    int num_old = monitor->num_pairs;
+    if (bands.count > 0 && grid->count > 0) {
+        grid->cell = bands.radius[bands.count - 1] * (1.0 + PROXIMITY_HYSTERESIS);
+        if (proximity_grid_build(grid) != 0) return -1;
+        double reach2 = grid->cell * grid->cell;
+
+        for (int r = 0; r < monitor->num_red; r++) {
+            Vector3 p = monitor->red_position[r];
+            int32_t c[3];
+            proximity_grid_cell(grid, p, c);
+            for (int dx = -1; dx <= 1; dx++)
+            for (int dy = -1; dy <= 1; dy++)
+            for (int dz = -1; dz <= 1; dz++) {
+                int32_t n[3] = { c[0] + dx, c[1] + dy, c[2] + dz };
+                uint32_t b = proximity_cell_slot(n, grid->num_buckets);
+                for (int k = grid->bucket_start[b]; k < grid->bucket_start[b + 1]; k++) {
+                    int j = grid->order[k];
+                    // 散列冲突的其他格跳过，保证每对只检查一次
+                    if (grid->coord[j][0] != n[0] || grid->coord[j][1] != n[1] || grid->coord[j][2] != n[2]) continue;
+                    Vector3 q = grid->position[j];
+                    double ddx = q.x - p.x, ddy = q.y - p.y, ddz = q.z - p.z;
+                    double d2 = ddx * ddx + ddy * ddy + ddz * ddz;
+                    if (d2 >= reach2) continue;     // 超出所有退出距离，由下方按未检查处理
+
+                    double d = sqrt(d2);
+                    int red_id = monitor->red_id[r], blue_id = grid->id[j];
+                    int index = proximity_pair_find(monitor, red_id, blue_id);
+                    int zone = index >= 0 ? monitor->pairs[index].zone : PROXIMITY_ZONE_NONE;
+                    int from_band = bands.rank[zone] >= 0 ? bands.rank[zone] : bands.count;
+                    int band = proximity_bands_next(&bands, zone, d);
+                    uint8_t to = bands.zone[band];
+                    if (to != zone) {
+                        proximity_emit(monitor, time, red_id, blue_id, (uint8_t)zone, to, from_band, band, d / 1000.0);
+                    }
+                    if (index >= 0) {
+                        monitor->pairs[index].zone = to;
+                        monitor->pairs[index].stamp = stamp;
+                    } else if (to != PROXIMITY_ZONE_NONE) {
+                        if (proximity_pairs_reserve(monitor, monitor->num_pairs + 1) != 0) return -1;
+                        monitor->pairs[monitor->num_pairs++] = (ProximityPair){ red_id, blue_id, to, stamp };
+                    }
+                }
+            }
+        }
+    }
+
+    // ===== 未作为候选的旧卫星对已在所有带外（或卫星已移除）：退出并删除 =====
+    int kept = 0;
+    for (int i = 0; i < monitor->num_pairs; i++) {
+        ProximityPair pair = monitor->pairs[i];
+        if (i < num_old && pair.stamp != stamp) {
+            Vector3 p, q;
+            double d = -1.0;
+            if (proximity_lookup_position(monitor, pair.red_id, 0, &p) &&
+                proximity_lookup_position(monitor, pair.blue_id, 1, &q)) {
+                d = vector3_distance(p, q) / 1000.0;
+            }
+            int from_band = bands.rank[pair.zone] >= 0 ? bands.rank[pair.zone] : bands.count - 1;
+            proximity_emit(monitor, time, pair.red_id, pair.blue_id, pair.zone, PROXIMITY_ZONE_NONE,
+                           from_band, bands.count, d);
+            continue;
+        }
+        if (pair.zone == PROXIMITY_ZONE_NONE) continue;
+        monitor->pairs[kept++] = pair;
+    }
+    monitor->num_pairs = kept;
+    if (proximity_pair_rebuild_index(monitor) != 0) return -1;
+
+    return (int)(monitor->total_events - emitted);
+}
+
+/* ==================== 查询 ==================== */
+
+int proximity_monitor_poll(ProximityMonitor *monitor, ProximityEvent *out, int max_events) {
+    if (!monitor || !out || max_events <= 0) return 0;
+    uint32_t tail = monitor->event_tail;
+    uint32_t head = __atomic_load_n(&monitor->event_head, __ATOMIC_ACQUIRE);
+    int n = 0;
+    while (tail != head && n < max_events) {
+        out[n++] = monitor->events[tail & (monitor->event_capacity - 1)];
+        tail++;
+    }
+    __atomic_store_n(&monitor->event_tail, tail, __ATOMIC_RELEASE);
+    return n;
+}
+
+ProximityZone proximity_monitor_zone(const ProximityMonitor *monitor, int red_id, int blue_id) {
+    if (!monitor) return PROXIMITY_ZONE_NONE;
+    int index = proximity_pair_find(monitor, red_id, blue_id);
+    return index >= 0 ? (ProximityZone)monitor->pairs[index].zone : PROXIMITY_ZONE_NONE;
+}
+
+const char* proximity_zone_name(ProximityZone zone) {
+    static const char *names[PROXIMITY_ZONE_COUNT] = {
+        "CRITICAL", "INSPECT", "ATTACK", "DEFENSE", "WARNING", "NONE"
+    };
+    return (zone >= 0 && zone < PROXIMITY_ZONE_COUNT) ? names[zone] : "UNKNOWN";
+}
@@ -22,9 +22,31 @@ Quaternion quat_multiply(Quaternion q1, Quaternion q2) {
 }
 
 Vector3 quat_rotate_vector(Quaternion q, Vector3 v) {
-    Quaternion v_quat = (Quaternion){v.x, v.y, v.z, 0};
-    Quaternion result = quat_multiply(quat_multiply(q, v_quat), quat_conjugate(q));
-    return (Vector3){result.x, result.y, result.z};
+    // 展开 q*[v,0]*q*：两次叉积代替两次四元数乘法
+    double tx = 2.0 * (q.y * v.z - q.z * v.y);
+    double ty = 2.0 * (q.z * v.x - q.x * v.z);
+    double tz = 2.0 * (q.x * v.y - q.y * v.x);
+    return (Vector3){
+        v.x + q.w * tx + (q.y * tz - q.z * ty),
+        v.y + q.w * ty + (q.z * tx - q.x * tz),
+        v.z + q.w * tz + (q.x * ty - q.y * tx)
+    };
+}
+
+void quat_rotate_vectors(Quaternion q, const Vector3 *in, Vector3 *out, int count) {
+    if (!in || !out) return;
+    const double qx = q.x, qy = q.y, qz = q.z, qw = q.w;
+    for (int i = 0; i < count; i++) {
+        Vector3 v = in[i];
+        double tx = 2.0 * (qy * v.z - qz * v.y);
+        double ty = 2.0 * (qz * v.x - qx * v.z);
+        double tz = 2.0 * (qx * v.y - qy * v.x);
+        out[i] = (Vector3){
+            v.x + qw * tx + (qy * tz - qz * ty),
+            v.y + qw * ty + (qz * tx - qx * tz),
+            v.z + qw * tz + (qx * ty - qy * tx)
+        };
+    }
 }
 
 Quaternion quat_from_axis_angle(Vector3 axis, double angle) {
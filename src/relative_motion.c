@@ -0,0 +1,221 @@
+#include <relative_motion.h>
+#include <orbit.h>
+#include <constants.h>
+#include <math.h>
+#include <string.h>
+
+/* ==================== 坐标转换 ==================== */
+
+/* LVLH基向量（行向量）：径向、沿迹、法向 */
+static void lvlh_basis(const StateVector *chief, Vector3 *x_hat, Vector3 *y_hat, Vector3 *z_hat, Vector3 *omega) {
+    Vector3 r = chief->position;
+    Vector3 h = vector3_cross(r, chief->velocity);
+    double r2 = vector3_magnitude_squared(r);
+
+    *x_hat = vector3_normalize(r);
+    *z_hat = vector3_normalize(h);
+    *y_hat = vector3_cross(*z_hat, *x_hat);
+    *omega = vector3_scale(h, 1.0 / r2);
+}
+
+int relative_state_from_inertial(const StateVector *chief, const StateVector *deputy, RelativeState *rel_out) {
+    if (!chief || !deputy || !rel_out) return -1;
+    if (vector3_magnitude_squared(chief->position) < 1.0) return -1;
+
+    Vector3 xh, yh, zh, omega;
+    lvlh_basis(chief, &xh, &yh, &zh, &omega);
+
+    Vector3 dr = vector3_sub(deputy->position, chief->position);
+    Vector3 dv = vector3_sub(vector3_sub(deputy->velocity, chief->velocity), vector3_cross(omega, dr));
+
+    rel_out->position = (Vector3){vector3_dot(xh, dr), vector3_dot(yh, dr), vector3_dot(zh, dr)};
+    rel_out->velocity = (Vector3){vector3_dot(xh, dv), vector3_dot(yh, dv), vector3_dot(zh, dv)};
+    return 0;
+}
+
+int relative_state_to_inertial(const StateVector *chief, const RelativeState *rel, StateVector *deputy_out) {
+    if (!chief || !rel || !deputy_out) return -1;
+    if (vector3_magnitude_squared(chief->position) < 1.0) return -1;
+
+    Vector3 xh, yh, zh, omega;
+    lvlh_basis(chief, &xh, &yh, &zh, &omega);
+
+    Vector3 dr = vector3_add(vector3_add(vector3_scale(xh, rel->position.x), vector3_scale(yh, rel->position.y)),
+                             vector3_scale(zh, rel->position.z));
+    Vector3 dv = vector3_add(vector3_add(vector3_scale(xh, rel->velocity.x), vector3_scale(yh, rel->velocity.y)),
+                             vector3_scale(zh, rel->velocity.z));
+
+    deputy_out->position = vector3_add(chief->position, dr);
+    deputy_out->velocity = vector3_add(vector3_add(chief->velocity, dv), vector3_cross(omega, dr));
+    deputy_out->time = chief->time;
+    return 0;
+}
+
+/* ==================== CW解 ==================== */
+
+void relative_cw_stm(double n, double dt, double phi[6][6]) {
+    double nt = n * dt;
+    double s = sin(nt), c = cos(nt);
+
+    memset(phi, 0, sizeof(double) * 36);
+
+    phi[0][0] = 4.0 - 3.0 * c;     phi[0][3] = s / n;              phi[0][4] = 2.0 * (1.0 - c) / n;
+    phi[1][0] = 6.0 * (s - nt);    phi[1][1] = 1.0;
+    phi[1][3] = -2.0 * (1.0 - c) / n;                              phi[1][4] = (4.0 * s - 3.0 * nt) / n;
+    phi[2][2] = c;                 phi[2][5] = s / n;
+
+    phi[3][0] = 3.0 * n * s;       phi[3][3] = c;                  phi[3][4] = 2.0 * s;
+    phi[4][0] = -6.0 * n * (1.0 - c);                              phi[4][3] = -2.0 * s;
+    phi[4][4] = 4.0 * c - 3.0;
+    phi[5][2] = -n * s;            phi[5][5] = c;
+}
+
+RelativeState relative_cw_propagate(const RelativeState *rel0, double n, double dt) {
+    double phi[6][6];
+    double x0[6] = {rel0->position.x, rel0->position.y, rel0->position.z,
+                    rel0->velocity.x, rel0->velocity.y, rel0->velocity.z};
+    double x[6];
+
+    relative_cw_stm(n, dt, phi);
+    for (int i = 0; i < 6; i++) {
+        x[i] = 0;
+        for (int j = 0; j < 6; j++) x[i] += phi[i][j] * x0[j];
+    }
+
+    return (RelativeState){{x[0], x[1], x[2]}, {x[3], x[4], x[5]}};
+}
+
+/* ==================== YA解 ==================== */
+
+/* YA面内基本解矩阵，状态顺序 [x~ z~ x~' z~']，J = k²(t - t0) */
+static void ya_inplane_fundamental(double e, double nu, double J, double m[4][4]) {
+    double rho = 1.0 + e * cos(nu);
+    double s = rho * sin(nu), c = rho * cos(nu);
+    double ds = cos(nu) + e * cos(2.0 * nu);
+    double dc = -(sin(nu) + e * sin(2.0 * nu));
+
+    m[0][0] = 1.0; m[0][1] = -c * (1.0 + 1.0 / rho); m[0][2] = s * (1.0 + 1.0 / rho); m[0][3] = 3.0 * rho * rho * J;
+    m[1][0] = 0.0; m[1][1] = s;                       m[1][2] = c;                      m[1][3] = 2.0 - 3.0 * e * s * J;
+    m[2][0] = 0.0; m[2][1] = 2.0 * s;                 m[2][2] = 2.0 * c - e;            m[2][3] = 3.0 * (1.0 - 2.0 * e * s * J);
+    m[3][0] = 0.0; m[3][1] = ds;                      m[3][2] = dc;                     m[3][3] = -3.0 * e * (ds * J + s / (rho * rho));
+}
+
+/* 4x4线性方程组 A x = b（列主元消去） */
+static int solve4(double a[4][4], double b[4], double x[4]) {
+    double m[4][5];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) m[i][j] = a[i][j];
+        m[i][4] = b[i];
+    }
+    for (int col = 0; col < 4; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < 4; r++) {
+            if (fabs(m[r][col]) > fabs(m[pivot][col])) pivot = r;
+        }
+        if (fabs(m[pivot][col]) < 1e-15) return -1;
+        if (pivot != col) {
+            for (int j = 0; j < 5; j++) {
+                double tmp = m[col][j]; m[col][j] = m[pivot][j]; m[pivot][j] = tmp;
+            }
+        }
+        for (int r = col + 1; r < 4; r++) {
+            double f = m[r][col] / m[col][col];
+            for (int j = col; j < 5; j++) m[r][j] -= f * m[col][j];
+        }
+    }
+    for (int i = 3; i >= 0; i--) {
+        double sum = m[i][4];
+        for (int j = i + 1; j < 4; j++) sum -= m[i][j] * x[j];
+        x[i] = sum / m[i][i];
+    }
+    return 0;
+}
+
+RelativeState relative_ya_propagate(const RelativeState *rel0, double e, double n, double nu0, double nu, double dt) {
+    double k2 = n / pow(1.0 - e * e, 1.5);
+    double rho0 = 1.0 + e * cos(nu0);
+    double rho = 1.0 + e * cos(nu);
+
+    // Hill系 -> YA系：x=沿迹, y=-法向, z=-径向
+    double x = rel0->position.y, y = -rel0->position.z, z = -rel0->position.x;
+    double vx = rel0->velocity.y, vy = -rel0->velocity.z, vz = -rel0->velocity.x;
+
+    // 变换到 (x~, θ) 变量
+    double es0 = e * sin(nu0);
+    double xt = rho0 * x, yt = rho0 * y, zt = rho0 * z;
+    double dxt = -es0 * x + vx / (k2 * rho0);
+    double dyt = -es0 * y + vy / (k2 * rho0);
+    double dzt = -es0 * z + vz / (k2 * rho0);
+
+    // 面内：Φ(θ) Φ(θ0)⁻¹
+    double m0[4][4], m1[4][4], d[4];
+    double in0[4] = {xt, zt, dxt, dzt};
+    ya_inplane_fundamental(e, nu0, 0.0, m0);
+    ya_inplane_fundamental(e, nu, k2 * dt, m1);
+    if (solve4(m0, in0, d) != 0) return *rel0;
+
+    double out[4];
+    for (int i = 0; i < 4; i++) {
+        out[i] = m1[i][0] * d[0] + m1[i][1] * d[1] + m1[i][2] * d[2] + m1[i][3] * d[3];
+    }
+
+    // 面外：简谐解
+    double dnu = nu - nu0;
+    double cd = cos(dnu), sd = sin(dnu);
+    double yt1 = cd * yt + sd * dyt;
+    double dyt1 = -sd * yt + cd * dyt;
+
+    // 逆变换回物理量
+    double es = e * sin(nu);
+    double x1 = out[0] / rho, z1 = out[1] / rho, y1 = yt1 / rho;
+    double vx1 = k2 * (rho * out[2] + es * out[0]);
+    double vz1 = k2 * (rho * out[3] + es * out[1]);
+    double vy1 = k2 * (rho * dyt1 + es * yt1);
+
+    return (RelativeState){{-z1, x1, -y1}, {-vz1, vx1, -vy1}};
+}
+
+/* ==================== 相对运动外推器 ==================== */
+
+int relative_propagator_init(RelativePropagator *prop, const StateVector *chief, const StateVector *deputy) {
+    if (!prop || !chief || !deputy) return -1;
+
+    OrbitalElements el;
+    StateVector chief_copy = *chief;
+    if (orbit_state_to_elements(&chief_copy, &el) != 0) return -1;
+    if (relative_state_from_inertial(chief, deputy, &prop->rel0) != 0) return -1;
+
+    prop->epoch = chief->time;
+    prop->a = el.a;
+    prop->e = el.e;
+    prop->n = sqrt(MU_SI / (el.a * el.a * el.a));
+    prop->M0 = el.m0 * PI / 180.0;
+    prop->nu0 = orbit_mean_anomaly_to_true_anomaly(prop->M0, el.e);
+    prop->model = (el.e < RELMOTION_CW_ECC_THRESHOLD) ? RELMOTION_CW : RELMOTION_YA;
+    return 0;
+}
+
+int relative_propagator_state_at(const RelativePropagator *prop, double t, RelativeState *rel_out) {
+    if (!prop || !rel_out) return -1;
+    double dt = t - prop->epoch;
+
+    if (prop->model == RELMOTION_CW) {
+        *rel_out = relative_cw_propagate(&prop->rel0, prop->n, dt);
+        return 0;
+    }
+
+    // 主星真近点角按开普勒运动推进（YA解只依赖 sin/cos(ν)，长期项由 dt 给出）
+    double M = fmod(prop->M0 + prop->n * dt, 2.0 * PI);
+    if (M < 0) M += 2.0 * PI;
+    double nu = orbit_mean_anomaly_to_true_anomaly(M, prop->e);
+
+    *rel_out = relative_ya_propagate(&prop->rel0, prop->e, prop->n, prop->nu0, nu, dt);
+    return 0;
+}
+
+int relative_propagator_deputy_state(const RelativePropagator *prop, const StateVector *chief_now, StateVector *deputy_out) {
+    if (!prop || !chief_now || !deputy_out) return -1;
+    RelativeState rel;
+    if (relative_propagator_state_at(prop, chief_now->time, &rel) != 0) return -1;
+    return relative_state_to_inertial(chief_now, &rel, deputy_out);
+}
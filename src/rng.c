@@ -0,0 +1,171 @@
+#include <rng.h>
+#include <math.h>
+#include <constants.h>
+
+static uint64_t rng_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+    if (!rng) return;
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = rng_splitmix64(&x);
+    }
+}
+
+void rng_jump(Rng *rng) {
+    static const uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    if (!rng) return;
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next_u64(rng);
+        }
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+double rng_normal(Rng *rng) {
+    // 1-u 避免 log(0)
+    double u1 = 1.0 - rng_uniform(rng);
+    double u2 = rng_uniform(rng);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2);
+}
+
+/* ==================== Philox4x32-10 ==================== */
+
+#define PHILOX_M0  0xD2511F53U
+#define PHILOX_M1  0xCD9E8D57U
+#define PHILOX_W0  0x9E3779B9U
+#define PHILOX_W1  0xBB67AE85U
+#define PHILOX_ROUNDS  10
+
+static inline void philox_round(uint32_t c[4], const uint32_t k[2]) {
+    uint64_t p0 = (uint64_t)PHILOX_M0 * c[0];
+    uint64_t p1 = (uint64_t)PHILOX_M1 * c[2];
+    uint32_t c1 = c[1], c3 = c[3];
+    c[0] = (uint32_t)(p1 >> 32) ^ c1 ^ k[0];
+    c[1] = (uint32_t)p1;
+    c[2] = (uint32_t)(p0 >> 32) ^ c3 ^ k[1];
+    c[3] = (uint32_t)p0;
+}
+
+void rng_philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c[4] = {ctr[0], ctr[1], ctr[2], ctr[3]};
+    uint32_t k[2] = {key[0], key[1]};
+    for (int r = 0; r < PHILOX_ROUNDS; r++) {
+        if (r > 0) {
+            k[0] += PHILOX_W0;
+            k[1] += PHILOX_W1;
+        }
+        philox_round(c, k);
+    }
+    out[0] = c[0];
+    out[1] = c[1];
+    out[2] = c[2];
+    out[3] = c[3];
+}
+
+/* 两个32位字拼成53位精度的 [0,1) 均匀数 */
+static inline double philox_to_uniform(uint32_t hi, uint32_t lo) {
+    return (double)((((uint64_t)hi << 32) | lo) >> 11) * 0x1.0p-53;
+}
+
+void rng_philox_uniform2(uint64_t seed, uint32_t sat_id, uint32_t stream,
+                         uint64_t index, double out[2]) {
+    uint32_t ctr[4] = {(uint32_t)index, (uint32_t)(index >> 32), sat_id, stream};
+    uint32_t key[2] = {(uint32_t)seed, (uint32_t)(seed >> 32)};
+    uint32_t x[4];
+    rng_philox4x32(ctr, key, x);
+    out[0] = philox_to_uniform(x[0], x[1]);
+    out[1] = philox_to_uniform(x[2], x[3]);
+}
+
+/**
+ * 一块 RNG_PHILOX_LANES 个计数器按结构数组（每个字一个数组）同时计算
+ * 各通道之间无依赖，编译器可将轮函数向量化
+ */
+static void philox_block(uint32_t c0[RNG_PHILOX_LANES], uint32_t c1[RNG_PHILOX_LANES],
+                         uint32_t c2[RNG_PHILOX_LANES], uint32_t c3[RNG_PHILOX_LANES],
+                         uint32_t key0, uint32_t key1) {
+    uint32_t k0 = key0, k1 = key1;
+    for (int r = 0; r < PHILOX_ROUNDS; r++) {
+        if (r > 0) {
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        for (int l = 0; l < RNG_PHILOX_LANES; l++) {
+            uint64_t p0 = (uint64_t)PHILOX_M0 * c0[l];
+            uint64_t p1 = (uint64_t)PHILOX_M1 * c2[l];
+            uint32_t old1 = c1[l], old3 = c3[l];
+            c0[l] = (uint32_t)(p1 >> 32) ^ old1 ^ k0;
+            c1[l] = (uint32_t)p1;
+            c2[l] = (uint32_t)(p0 >> 32) ^ old3 ^ k1;
+            c3[l] = (uint32_t)p0;
+        }
+    }
+}
+
+void rng_philox_fill_uniform(uint64_t seed, uint32_t sat_id, uint32_t stream,
+                             uint64_t first_index, double *out, size_t n) {
+    if (!out) return;
+    uint32_t key0 = (uint32_t)seed, key1 = (uint32_t)(seed >> 32);
+    uint32_t c0[RNG_PHILOX_LANES], c1[RNG_PHILOX_LANES], c2[RNG_PHILOX_LANES], c3[RNG_PHILOX_LANES];
+
+    size_t num_blocks = (n + 1) / 2;       // 每个计数器产出两个均匀数
+    size_t done = 0;
+    for (size_t b = 0; b < num_blocks; b += RNG_PHILOX_LANES) {
+        for (int l = 0; l < RNG_PHILOX_LANES; l++) {
+            uint64_t index = first_index + b + (uint64_t)l;
+            c0[l] = (uint32_t)index;
+            c1[l] = (uint32_t)(index >> 32);
+            c2[l] = sat_id;
+            c3[l] = stream;
+        }
+        philox_block(c0, c1, c2, c3, key0, key1);
+        for (int l = 0; l < RNG_PHILOX_LANES && done < n; l++) {
+            out[done++] = philox_to_uniform(c0[l], c1[l]);
+            if (done < n) out[done++] = philox_to_uniform(c2[l], c3[l]);
+        }
+    }
+}
+
+void rng_philox_fill_fleet(uint64_t seed, const uint32_t *sat_ids, size_t n,
+                           uint32_t stream, uint64_t index, double *out) {
+    if (!sat_ids || !out) return;
+    uint32_t key0 = (uint32_t)seed, key1 = (uint32_t)(seed >> 32);
+    uint32_t c0[RNG_PHILOX_LANES], c1[RNG_PHILOX_LANES], c2[RNG_PHILOX_LANES], c3[RNG_PHILOX_LANES];
+
+    for (size_t base = 0; base < n; base += RNG_PHILOX_LANES) {
+        for (int l = 0; l < RNG_PHILOX_LANES; l++) {
+            size_t k = base + (size_t)l;
+            c0[l] = (uint32_t)index;
+            c1[l] = (uint32_t)(index >> 32);
+            c2[l] = (k < n) ? sat_ids[k] : 0;
+            c3[l] = stream;
+        }
+        philox_block(c0, c1, c2, c3, key0, key1);
+        for (int l = 0; l < RNG_PHILOX_LANES && base + (size_t)l < n; l++) {
+            size_t k = base + (size_t)l;
+            out[2 * k] = philox_to_uniform(c0[l], c1[l]);
+            out[2 * k + 1] = philox_to_uniform(c2[l], c3[l]);
+        }
+    }
+}
@@ -1,19 +1,122 @@
 #include <satellite.h>
+#include <attitude.h>
+#include <orbit.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
+// GEO卫星在J2000坐标系中的随机初始位置范围
+#define SATELLITE_GEO_NOMINAL_RADIUS  42164000.0   // GEO标称轨道高度42164km
+#define SATELLITE_INIT_SPREAD_X       10000.0      // 42154km - 42174km
+#define SATELLITE_INIT_SPREAD_Y       150000.0     // -150km - +150km
+#define SATELLITE_INIT_SPREAD_Z       75000.0      // -75km - +75km
+
+/* 三个 [0,1) 均匀数映射为初始位置 */
+static Vector3 satellite_initial_position(double ux, double uy, double uz) {
+    return (Vector3){
+        SATELLITE_GEO_NOMINAL_RADIUS + (ux * 2 - 1) * SATELLITE_INIT_SPREAD_X,
+        (uy * 2 - 1) * SATELLITE_INIT_SPREAD_Y,
+        (uz * 2 - 1) * SATELLITE_INIT_SPREAD_Z
+    };
+}
+
+/* 沿迹方向（z × r）的圆轨道速度 (m/s)；位置在极轴上时改取 x × r */
+static Vector3 satellite_circular_velocity(Vector3 position) {
+    double r = vector3_magnitude(position);
+    if (r < 1.0) return vector3_zero();
+    Vector3 along = vector3_cross((Vector3){0, 0, 1}, position);
+    if (vector3_magnitude(along) < 1e-9 * r) along = vector3_cross((Vector3){1, 0, 0}, position);
+    // orbit_circular_velocity 以 km 计
+    return vector3_scale(vector3_normalize(along), orbit_circular_velocity(r / 1000.0) * 1000.0);
+}
+
+static Satellite* satellite_create_at(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                      uint8_t function_type, Vector3 position);
+
 Satellite* satellite_create(int id, uint8_t team, uint8_t type, uint8_t function_type) {
-    Satellite *sat = (Satellite*)malloc(sizeof(Satellite));
-    if (!sat) return NULL;
+    double ux = (double)rand() / RAND_MAX;
+    double uy = (double)rand() / RAND_MAX;
+    double uz = (double)rand() / RAND_MAX;
+    return satellite_create_at(NULL, id, team, type, function_type, satellite_initial_position(ux, uy, uz));
+}
+
+Satellite* satellite_create_seeded(int id, uint8_t team, uint8_t type, uint8_t function_type, uint64_t seed) {
+    return satellite_create_in(NULL, id, team, type, function_type, seed);
+}
+
+Satellite* satellite_create_in(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                               uint8_t function_type, uint64_t seed) {
+    // 位置流第0块给出x、y，第1块给出z
+    double u01[2], u2[2];
+    rng_philox_uniform2(seed, (uint32_t)id, RNG_STREAM_INIT_POSITION, 0, u01);
+    rng_philox_uniform2(seed, (uint32_t)id, RNG_STREAM_INIT_POSITION, 1, u2);
+    return satellite_create_at(allocator, id, team, type, function_type,
+                               satellite_initial_position(u01[0], u01[1], u2[0]));
+}
+
+int satellite_create_fleet(SlabAllocator *allocator, int first_id, int count, uint8_t team, uint8_t type,
+                           uint8_t function_type, uint64_t seed, Satellite **out) {
+    if (count <= 0 || !out) return -1;
+
+    uint32_t *ids = (uint32_t*)malloc(sizeof(uint32_t) * count);
+    double *u01 = (double*)malloc(sizeof(double) * 2 * count);
+    double *u2 = (double*)malloc(sizeof(double) * 2 * count);
+    if (!ids || !u01 || !u2) {
+        free(ids);
+        free(u01);
+        free(u2);
+        return -1;
+    }
 
-    // GEO卫星在J2000坐标系中的随机初始位置
-    double geo_nominal_radius = 42164000.0;  // GEO标称轨道高度42164km
+    // 与 satellite_create_seeded 同一计数器布局，逐颗创建结果相同
+    for (int k = 0; k < count; k++) ids[k] = (uint32_t)(first_id + k);
+    rng_philox_fill_fleet(seed, ids, count, RNG_STREAM_INIT_POSITION, 0, u01);
+    rng_philox_fill_fleet(seed, ids, count, RNG_STREAM_INIT_POSITION, 1, u2);
 
-    // 根据实际范围生成随机位置
-    double random_x = geo_nominal_radius + ((double)rand() / RAND_MAX * 2 - 1) * 10000.0;  // 42154km - 42174km
-    double random_y = ((double)rand() / RAND_MAX * 2 - 1) * 150000.0;  // -150km - +150km
-    double random_z = ((double)rand() / RAND_MAX * 2 - 1) * 75000.0;   // -75km - +75km
+    int created = 0;
+    for (int k = 0; k < count; k++) {
+        Vector3 position = satellite_initial_position(u01[2 * k], u01[2 * k + 1], u2[2 * k]);
+        out[k] = satellite_create_at(allocator, first_id + k, team, type, function_type, position);
+        if (!out[k]) break;
+        created++;
+    }
+
+    free(ids);
+    free(u01);
+    free(u2);
+
+    if (created < count) {
+        for (int k = 0; k < created; k++) satellite_destroy(out[k]);
+        return -1;
+    }
+    return created;
+}
+
+Satellite* satellite_create_from_elements(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                          uint8_t function_type, const OrbitalElements *elements) {
+    if (!elements) return NULL;
+    OrbitalElements el = *elements;
+    StateVector state;
+    if (orbit_elements_to_state(&el, &state) != 0) return NULL;
+    return satellite_create_from_state(allocator, id, team, type, function_type, &el, &state);
+}
+
+Satellite* satellite_create_from_state(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                       uint8_t function_type, const OrbitalElements *elements,
+                                       const StateVector *state) {
+    if (!elements || !state) return NULL;
+    Satellite *sat = satellite_create_at(allocator, id, team, type, function_type, state->position);
+    if (!sat) return NULL;
+    sat->orbital_elements = *elements;
+    sat->state.velocity = state->velocity;
+    return sat;
+}
+
+static Satellite* satellite_create_at(SlabAllocator *allocator, int id, uint8_t team, uint8_t type,
+                                      uint8_t function_type, Vector3 position) {
+    Satellite *sat = allocator ? (Satellite*)slab_calloc(allocator, sizeof(Satellite))
+                               : (Satellite*)calloc(1, sizeof(Satellite));
+    if (!sat) return NULL;
 
     sat->id = id;
     sat->type = type;
@@ -30,6 +133,7 @@ Satellite* satellite_create(int id, uint8_t team, uint8_t type, uint8_t function
     sat->total_fuel_used = 0;
     sat->current_formation = 255;
     sat->target_id = -1;
+    sat->current_strategy = 0;
     sat->distance_to_target = 1e10;
     sat->min_distance_reached = 1e10;
     sat->circle_count = 0;
@@ -44,48 +148,58 @@ Satellite* satellite_create(int id, uint8_t team, uint8_t type, uint8_t function
     sat->attitude.body_axis = (Vector3){0, 0, 1};
     sat->attitude.target_id = -1;
     sat->attitude.step_count = 0;
-    sat->state.position = (Vector3){random_x, random_y, random_z};
+    attitude_tracker_invalidate_rotation(&sat->attitude);
+    sat->state.position = position;
     
-    sat->state.velocity = (Vector3){0, 7546, 0};
+    sat->state.velocity = satellite_circular_velocity(position);
     sat->state.time = 0;
     
-    sat->position_history = NULL;
-    sat->velocity_history = NULL;
-    sat->formation_history = NULL;
-    sat->history_count = 0;
-    sat->history_capacity = 0;
+    sat->history = NULL;
+    sat->allocator = allocator;
     
     return sat;
 }
 
 void satellite_destroy(Satellite *sat) {
     if (!sat) return;
-    if (sat->position_history) free(sat->position_history);
-    if (sat->velocity_history) free(sat->velocity_history);
-    if (sat->formation_history) free(sat->formation_history);
-    free(sat);
+    history_destroy(sat->history);
+    if (sat->allocator) {
+        slab_free(sat->allocator, sat, sizeof(Satellite));
+    } else {
+        free(sat);
+    }
 }
 
 void satellite_init_history(Satellite *sat, int capacity) {
     if (!sat) return;
-    sat->history_capacity = capacity;
-    sat->position_history = (Vector3*)malloc(sizeof(Vector3) * capacity);
-    sat->velocity_history = (Vector3*)malloc(sizeof(Vector3) * capacity);
-    sat->formation_history = (int*)malloc(sizeof(int) * capacity);
-    sat->history_count = 0;
+    HistoryConfig config;
+    history_config_default(&config, capacity > 0 ? (uint32_t)capacity : HISTORY_DEFAULT_CAPACITY);
+    history_destroy(sat->history);
+    sat->history = history_create(&config, sat->allocator);
+}
+
+int satellite_history_append(Satellite *sat) {
+    if (!sat || !sat->history) return -1;
+    HistorySample sample = {
+        .time = sat->state.time,
+        .position = sat->state.position,
+        .velocity = sat->state.velocity,
+        .formation = sat->current_formation
+    };
+    return history_append(sat->history, &sample);
 }
 
-void satellite_append_history(Satellite *sat) {
-    if (!sat || sat->history_count >= sat->history_capacity) return;
-    sat->position_history[sat->history_count] = sat->state.position;
-    sat->velocity_history[sat->history_count] = sat->state.velocity;
-    sat->formation_history[sat->history_count] = sat->current_formation;
-    sat->history_count++;
+Vector3 satellite_history_get_position(Satellite *sat, int index) {
+    HistorySample sample;
+    if (!sat || index < 0 || history_latest(sat->history, (uint32_t)index, &sample) != 0) {
+        return vector3_zero();
+    }
+    return sample.position;
 }
 
-void satellite_clear_history(Satellite *sat) {
+void satellite_history_clear(Satellite *sat) {
     if (!sat) return;
-    sat->history_count = 0;
+    history_clear(sat->history);
 }
 
 void satellite_update_formation(Satellite *sat, uint8_t formation_type) {
@@ -0,0 +1,220 @@
+#include <simulation.h>
+#include <log.h>
+#include <profiler.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define SIM_OUTPUT_BUFFER_SIZE  (1 << 20)    // 输出文件缓冲 (1MB)
+
+/* ==================== 内部函数 ==================== */
+
+/* 按功能类型批量创建同队卫星，返回下一个可用ID，失败返回-1 */
+static int simulation_add_team(KinematicsEngine *engine, int id, uint8_t team, int count, uint8_t function_type) {
+    for (int i = 0; i < count; i++) {
+        if (!kinematics_engine_create_satellite(engine, id, team, 0, function_type)) {
+            fprintf(stderr, "错误：无法创建卫星 %d\n", id);
+            return -1;
+        }
+        id++;
+    }
+    return id;
+}
+
+static int simulation_compare_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* 最近秩分位数在升序数组中的下标：ceil(q·n) - 1 */
+static uint32_t simulation_nearest_rank(uint32_t n, double q) {
+    uint32_t rank = (uint32_t)ceil(q * (double)n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return rank - 1;
+}
+
+/* 写出一步的红星状态，返回写出字节数 */
+static uint64_t simulation_write_step(KinematicsEngine *engine, SimOutputMode mode, FILE *file, uint32_t step) {
+    uint64_t bytes = 0;
+    for (int i = 0; i < engine->satellite_count; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (!sat || sat->team != 0) continue;
+
+        if (mode == SIM_OUTPUT_CSV) {
+            int n = fprintf(file, "%u,%.2f,%d,%.6f,%.6f,%.6f,"
+                                  "%.6f,%.6f,%.6f,%.2f,%u,%d\n",
+                step,
+                engine->current_time,
+                sat->id,
+                sat->state.position.x,
+                sat->state.position.y,
+                sat->state.position.z,
+                sat->state.velocity.x,
+                sat->state.velocity.y,
+                sat->state.velocity.z,
+                sat->fuel,
+                sat->current_formation,
+                sat->current_strategy
+            );
+            if (n > 0) bytes += (uint64_t)n;
+        } else {
+            SimOutputRecord record = {
+                .step = step,
+                .sat_id = sat->id,
+                .time = engine->current_time,
+                .position = { sat->state.position.x, sat->state.position.y, sat->state.position.z },
+                .velocity = { sat->state.velocity.x, sat->state.velocity.y, sat->state.velocity.z },
+                .fuel = sat->fuel,
+                .formation = sat->current_formation,
+                .strategy = sat->current_strategy
+            };
+            bytes += fwrite(&record, 1, sizeof(record), file);
+        }
+    }
+    return bytes;
+}
+
+/* ==================== 接口实现 ==================== */
+
+void simulation_default_config(SimulationConfig *config) {
+    if (!config) return;
+    memset(config, 0, sizeof(SimulationConfig));
+    config->time_step = 10.0;
+    config->max_steps = 10000;
+    config->save_interval = 100;
+    config->attitude_time_step = 1.0;
+    config->control_interval = 10.0;
+    config->decision_interval = 1000.0;
+    config->hohmann_precision = 1e-6;
+    config->lambert_max_iterations = 100;
+    config->lambert_convergence = 1e-6;
+    config->lambert_target_distance = 1000000;
+    config->lambert_max_delta_v = 5000;
+    config->ellipse_min_distance = 6500000;
+    config->ellipse_max_distance = 8000000;
+    config->strategy = (StrategyThresholds){ ATTACK_DISTANCE, INSPECT_DISTANCE, DEFENSE_DISTANCE,
+                                             CRITICAL_DISTANCE, WARNING_DISTANCE };
+}
+
+KinematicsEngine* simulation_create_engine(const Config *scenario, const SimulationConfig *config,
+                                           uint64_t seed, int history_capacity) {
+    if (!scenario || !config) return NULL;
+
+    KinematicsEngine *engine = kinematics_engine_create(*config);
+    if (!engine) {
+        fprintf(stderr, "错误：无法创建运动学引擎\n");
+        return NULL;
+    }
+
+    kinematics_engine_seed(engine, seed);
+    kinematics_engine_set_strategy(engine, scenario->strategy);
+    SIM_LOG("✓ 运动学引擎已创建\n");
+
+    // 红队0、蓝队1；功能 0=攻击 1=侦察 2=防御
+    int id = 1000;
+    if ((id = simulation_add_team(engine, id, 0, scenario->red_attack, 0)) < 0 ||
+        (id = simulation_add_team(engine, id, 0, scenario->red_recon, 1)) < 0 ||
+        (id = simulation_add_team(engine, id, 0, scenario->red_defense, 2)) < 0 ||
+        (id = simulation_add_team(engine, id, 1, scenario->blue_attack, 0)) < 0 ||
+        (id = simulation_add_team(engine, id, 1, scenario->blue_recon, 1)) < 0 ||
+        (id = simulation_add_team(engine, id, 1, scenario->blue_defense, 2)) < 0) {
+        kinematics_engine_destroy(engine);
+        return NULL;
+    }
+
+    if (history_capacity > 0) {
+        for (int i = 0; i < engine->satellite_count; i++) {
+            satellite_init_history(engine->satellites[i], history_capacity);
+        }
+    } else {
+        kinematics_engine_init_satellites(engine);
+    }
+    SIM_LOG("✓ 已加载 %d 颗卫星\n", engine->satellite_count);
+    return engine;
+}
+
+int simulation_run(KinematicsEngine *engine, uint32_t max_steps,
+                   const SimRunOptions *options, SimRunStats *stats) {
+    if (!engine) return -1;
+
+    SimRunOptions defaults = { .output = SIM_OUTPUT_NONE };
+    if (!options) options = &defaults;
+
+    SimRunStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(SimRunStats));
+    running_stats_init(&stats->decision_latency_us);
+
+    // ===== 打开输出文件 =====
+    FILE *output_file = NULL;
+    char *output_buffer = NULL;
+    if (options->output != SIM_OUTPUT_NONE) {
+        if (!options->output_file) return -1;
+        output_file = fopen(options->output_file, options->output == SIM_OUTPUT_CSV ? "w" : "wb");
+        if (!output_file) {
+            fprintf(stderr, "错误：无法打开输出文件 %s\n", options->output_file);
+            return -1;
+        }
+        output_buffer = (char*)malloc(SIM_OUTPUT_BUFFER_SIZE);
+        if (output_buffer) setvbuf(output_file, output_buffer, _IOFBF, SIM_OUTPUT_BUFFER_SIZE);
+
+        if (options->output == SIM_OUTPUT_CSV) {
+            int n = fprintf(output_file, "step,time(s),sat_id,pos_x(km),pos_y(km),pos_z(km),"
+                                         "vel_x(km/s),vel_y(km/s),vel_z(km/s),fuel(kg),formation,strategy\n");
+            if (n > 0) stats->bytes_written += (uint64_t)n;
+        }
+    }
+
+    // 决策步耗时样本（每步至多一次决策）
+    double *latencies = (double*)malloc(sizeof(double) * (max_steps > 0 ? max_steps : 1));
+    uint32_t num_latencies = 0;
+
+    uint64_t run_start = profiler_now_ns();
+    uint32_t step = 0;
+
+    // 决策(分组+博弈)和编队控制由引擎按各自时钟在步进中触发
+    while (step < max_steps && kinematics_engine_should_continue(engine)) {
+        uint32_t decisions_before = engine->clocks[SIM_CLOCK_DECISION].tick_count;
+        uint64_t step_start = profiler_now_ns();
+
+        if (kinematics_engine_step(engine) != 0) {
+            fprintf(stderr, "\n错误：第 %u 步仿真失败\n", step);
+            break;
+        }
+
+        if (output_file) {
+            PROF_BEGIN(prof_output);
+            stats->bytes_written += simulation_write_step(engine, options->output, output_file, step);
+            PROF_END(PROF_OUTPUT, prof_output);
+        }
+        PROF_TICK_END(step);
+
+        if (engine->clocks[SIM_CLOCK_DECISION].tick_count != decisions_before) {
+            double us = (profiler_now_ns() - step_start) / 1000.0;
+            running_stats_push(&stats->decision_latency_us, us);
+            if (latencies) latencies[num_latencies++] = us;
+        }
+
+        step++;
+        if (options->progress && options->progress_interval > 0 && step % options->progress_interval == 0) {
+            options->progress(step, max_steps, kinematics_engine_get_current_time(engine), options->user_data);
+        }
+    }
+
+    // ===== 关闭文件 =====
+    if (output_file) fclose(output_file);
+    free(output_buffer);
+
+    stats->steps = step;
+    stats->elapsed_seconds = (profiler_now_ns() - run_start) * 1e-9;
+    stats->decision_ticks = (uint32_t)stats->decision_latency_us.count;
+    if (latencies && num_latencies > 0) {
+        qsort(latencies, num_latencies, sizeof(double), simulation_compare_double);
+        stats->decision_p50_us = latencies[simulation_nearest_rank(num_latencies, 0.50)];
+        stats->decision_p99_us = latencies[simulation_nearest_rank(num_latencies, 0.99)];
+    }
+    free(latencies);
+    return 0;
+}
@@ -0,0 +1,193 @@
+/* 姿态测试：全队批量步进与逐星 attitude_tracker_slew_step 逐位一致，
+ * 旋转矩阵缓存的批量旋转与逐向量旋转一致，机动时间与闭式剖面一致
+ *
+ * 用法: test_attitude
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <attitude.h>
+#include <quaternion.h>
+#include <vector3.h>
+#include <rng.h>
+
+#include "test_common.h"
+
+#define TEST_FLEET_COUNT    37          // 全队卫星数（非 SIMD 宽度整倍数）
+#define TEST_FRAMES         200         // 步进帧数（800 s，足够最慢的卫星转过 180°）
+#define TEST_SUBSTEPS       8           // 每帧最多子步数（同 kinematics 的姿态子步）
+#define TEST_SUBSTEP_DT     0.5         // 子步长 (秒)
+#define TEST_NUM_VECTORS    17          // 批量旋转的向量数
+
+static Vector3 test_random_vector(Rng *rng) {
+    return (Vector3){ rng_uniform_range(rng, -1.0, 1.0), rng_uniform_range(rng, -1.0, 1.0),
+                      rng_uniform_range(rng, -1.0, 1.0) };
+}
+
+static Quaternion test_random_quaternion(Rng *rng) {
+    Quaternion q = { rng_uniform_range(rng, -1.0, 1.0), rng_uniform_range(rng, -1.0, 1.0),
+                     rng_uniform_range(rng, -1.0, 1.0), rng_uniform_range(rng, -1.0, 1.0) };
+    return quat_normalize(q);
+}
+
+/* 逐字段逐位比较步进状态（旋转缓存不参与） */
+static int test_same_tracker(const AttitudeTracker *a, const AttitudeTracker *b) {
+    return memcmp(&a->q, &b->q, sizeof(Quaternion)) == 0 &&
+           memcmp(&a->omega, &b->omega, sizeof(Vector3)) == 0 &&
+           memcmp(&a->alpha, &b->alpha, sizeof(Vector3)) == 0 &&
+           a->step_count == b->step_count;
+}
+
+/* ==================== 全队批量步进 ==================== */
+
+static void test_check_fleet_step(void) {
+    AttitudeTracker fleet_trackers[TEST_FLEET_COUNT], single_trackers[TEST_FLEET_COUNT];
+    Vector3 directions[TEST_FLEET_COUNT];
+    Rng rng;
+    rng_seed(&rng, 20261018);
+    for (int i = 0; i < TEST_FLEET_COUNT; i++) {
+        attitude_tracker_init(&fleet_trackers[i], rng_uniform_range(&rng, 0.01, 0.1),
+                              rng_uniform_range(&rng, 0.002, 0.02), test_random_vector(&rng));
+        fleet_trackers[i].q = test_random_quaternion(&rng);
+        directions[i] = vector3_scale(test_random_vector(&rng), 7000.0);
+    }
+    // 已在死区内且带残余角速度：两条路径都不应步进也不应清零
+    Vector3 boresight = quat_rotate_vector(fleet_trackers[0].q, fleet_trackers[0].body_axis);
+    directions[0] = vector3_scale(boresight, 3.0);
+    fleet_trackers[0].omega = (Vector3){ 1e-4, -2e-4, 3e-4 };
+    memcpy(single_trackers, fleet_trackers, sizeof(fleet_trackers));
+
+    AttitudeFleet fleet;
+    attitude_fleet_init(&fleet);
+    int settled_frames = 0;
+    for (int frame = 0; frame < TEST_FRAMES; frame++) {
+        // 同 kinematics 的姿态时钟：每帧重建全队，子步数用完或全队稳定即停
+        attitude_fleet_clear(&fleet);
+        for (int i = 0; i < TEST_FLEET_COUNT; i++) {
+            TEST_CHECK(attitude_fleet_add(&fleet, &fleet_trackers[i], directions[i]) == i,
+                       "fleet: 第 %d 颗卫星加入失败", i);
+        }
+        int k = 0;
+        for (; k < TEST_SUBSTEPS; k++) {
+            if (attitude_fleet_step(&fleet, TEST_SUBSTEP_DT) == 0) break;
+        }
+        attitude_fleet_store(&fleet);
+        settled_frames += (k == 0);
+
+        for (int i = 0; i < TEST_FLEET_COUNT; i++) {
+            for (int s = 0; s < TEST_SUBSTEPS; s++) {
+                if (!attitude_tracker_is_slewing(&single_trackers[i], directions[i])) break;
+                attitude_tracker_slew_step(&single_trackers[i], directions[i], TEST_SUBSTEP_DT);
+            }
+        }
+    }
+    attitude_fleet_free(&fleet);
+
+    int mismatched = 0, slewing = 0;
+    for (int i = 0; i < TEST_FLEET_COUNT; i++) {
+        mismatched += !test_same_tracker(&fleet_trackers[i], &single_trackers[i]);
+        slewing += attitude_tracker_is_slewing(&single_trackers[i], directions[i]);
+    }
+    TEST_CHECK(mismatched == 0, "fleet: %d / %d 颗卫星与逐星步进不一致", mismatched, TEST_FLEET_COUNT);
+    TEST_CHECK(fleet_trackers[0].step_count == 0 && fleet_trackers[0].omega.z == 3e-4,
+               "fleet: 死区内卫星被步进 %u 次或角速度被清零", fleet_trackers[0].step_count);
+    TEST_CHECK(slewing == 0 && settled_frames > 0, "fleet: %d 帧后仍有 %d 颗卫星未稳定", TEST_FRAMES, slewing);
+}
+
+/* ==================== 批量旋转 ==================== */
+
+static int test_close_vector(Vector3 a, Vector3 b) {
+    return vector3_magnitude(vector3_sub(a, b)) < 1e-14;
+}
+
+static void test_check_rotate_vectors(void) {
+    Rng rng;
+    rng_seed(&rng, 7);
+    Vector3 in[TEST_NUM_VECTORS], out[TEST_NUM_VECTORS], cached[TEST_NUM_VECTORS];
+    for (int i = 0; i < TEST_NUM_VECTORS; i++) in[i] = test_random_vector(&rng);
+
+    AttitudeTracker tracker;
+    attitude_tracker_init(&tracker, 0.05, 0.01, (Vector3){ 1.0, 0.0, 0.0 });
+    for (int round = 0; round < 3; round++) {
+        // 直接改写 q（步进内核的做法），缓存按四元数比对自动失效
+        Quaternion q = test_random_quaternion(&rng);
+        tracker.q = q;
+        quat_rotate_vectors(q, in, out, TEST_NUM_VECTORS);
+        TEST_CHECK(attitude_tracker_rotate_vectors(&tracker, in, cached, TEST_NUM_VECTORS) == 0,
+                   "rotate: 第 %d 轮旋转失败", round);
+
+        int bad_batch = 0, bad_cached = 0;
+        for (int i = 0; i < TEST_NUM_VECTORS; i++) {
+            Vector3 expected = quat_rotate_vector(q, in[i]);
+            bad_batch += memcmp(&out[i], &expected, sizeof(Vector3)) != 0;
+            bad_cached += !test_close_vector(cached[i], expected);
+        }
+        TEST_CHECK(bad_batch == 0, "rotate: 第 %d 轮 quat_rotate_vectors 有 %d 个向量与逐个旋转不一致",
+                   round, bad_batch);
+        TEST_CHECK(bad_cached == 0, "rotate: 第 %d 轮缓存旋转有 %d 个向量超差（缓存未刷新？）", round, bad_cached);
+    }
+
+    // 原地旋转
+    memcpy(cached, in, sizeof(in));
+    attitude_tracker_rotate_vectors(&tracker, cached, cached, TEST_NUM_VECTORS);
+    int bad_inplace = 0;
+    for (int i = 0; i < TEST_NUM_VECTORS; i++) {
+        bad_inplace += !test_close_vector(cached[i], quat_rotate_vector(tracker.q, in[i]));
+    }
+    TEST_CHECK(bad_inplace == 0, "rotate: 原地旋转有 %d 个向量超差", bad_inplace);
+}
+
+/* ==================== 机动时间 ==================== */
+
+/* 一组机动：rate²/accel 为分界角，小于它为 bang-bang，大于它为 bang-coast-bang */
+static void test_check_slew_profile(double angle, double max_rate, double max_accel, const char *label) {
+    double expected;
+    if (angle <= max_rate * max_rate / max_accel) expected = 2.0 * sqrt(angle / max_accel);
+    else expected = angle / max_rate + max_rate / max_accel;
+    double t = attitude_slew_time(angle, max_rate, max_accel);
+    TEST_CHECK(fabs(t - expected) <= 1e-12 * expected, "%s: 机动时间 %.15g s，应为 %.15g s", label, t, expected);
+
+    Vector3 axis = vector3_normalize((Vector3){ 1.0, -2.0, 0.5 });
+    Quaternion start = quat_normalize((Quaternion){ 0.1, 0.2, -0.3, 0.9 });
+    Quaternion target = quat_normalize(quat_multiply(quat_from_axis_angle(axis, angle), start));
+    AttitudeSlewProfile profile;
+    TEST_CHECK(attitude_plan_slew(start, target, max_rate, max_accel, &profile) == 0, "%s: 规划失败", label);
+    TEST_CHECK(fabs(profile.total_time - expected) <= 1e-9 * expected &&
+               fabs(2.0 * profile.accel_time + profile.coast_time - profile.total_time) <= 1e-12 * expected,
+               "%s: 剖面总时长 %.15g s，应为 %.15g s", label, profile.total_time, expected);
+    double reach = attitude_time_to_reach(start, target, max_rate, max_accel);
+    TEST_CHECK(fabs(reach - expected) <= 1e-9 * expected, "%s: 到达时间 %.15g s，应为 %.15g s", label, reach, expected);
+
+    double rate;
+    double peak = attitude_slew_profile_angle(&profile, profile.accel_time, &rate);
+    TEST_CHECK(fabs(rate - profile.peak_rate) <= 1e-12 && profile.peak_rate <= max_rate * (1.0 + 1e-12) &&
+               fabs(peak - 0.5 * max_accel * profile.accel_time * profile.accel_time) <= 1e-12,
+               "%s: 加速段末角速度 %.15g，峰值 %.15g", label, rate, profile.peak_rate);
+
+    double end = attitude_slew_profile_angle(&profile, profile.total_time, &rate);
+    TEST_CHECK(fabs(end - angle) <= 1e-9 && fabs(rate) <= 1e-12,
+               "%s: 剖面终点转角 %.15g rad（应为 %.15g）、角速度 %.3g", label, end, angle, rate);
+    Quaternion reached = attitude_slew_profile_attitude(&profile, start, profile.total_time);
+    TEST_CHECK(quat_angular_distance(reached, target) < 1e-7, "%s: 剖面终点姿态偏差 %.3g rad", label,
+               quat_angular_distance(reached, target));
+}
+
+static void test_check_slew_time(void) {
+    test_check_slew_profile(0.2, 0.05, 0.01, "bang-bang");
+    test_check_slew_profile(1.5, 0.05, 0.01, "bang-coast-bang");
+    test_check_slew_profile(0.25, 0.05, 0.01, "分界角");
+    TEST_CHECK(attitude_slew_time(0.0, 0.05, 0.01) == 0.0 && attitude_slew_time(1.0, 0.0, 0.01) == HUGE_VAL,
+               "slew: 零转角或约束非正的返回值不对");
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    TEST_RUN("Attitude", test_check_fleet_step(), "全队批量步进与逐星步进逐位一致，死区内卫星不步进");
+    TEST_RUN("Attitude", test_check_rotate_vectors(), "缓存旋转与逐向量旋转一致，改写姿态后缓存刷新");
+    TEST_RUN("Attitude", test_check_slew_time(), "机动时间与 bang-bang / bang-coast-bang 闭式剖面一致");
+    return test_summary("Attitude");
+}
@@ -0,0 +1,42 @@
+/* 测试程序共用：失败计数、检查宏和结果汇总（每个测试程序为单一翻译单元） */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+
+static int test_failures = 0;
+
+#define TEST_CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "  ✗ "); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+            test_failures++; \
+        } \
+    } while (0)
+
+/* 执行一项检查，没有新增失败时打印 ✓ 说明 */
+#define TEST_RUN(tag, call, ...) \
+    do { \
+        int before_ = test_failures; \
+        call; \
+        if (test_failures == before_) { \
+            printf("[%s] ✓ ", tag); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+/* 打印汇总，返回进程退出码 */
+static inline int test_summary(const char *tag) {
+    if (test_failures > 0) {
+        printf("[%s] ✗ %d 项不一致\n", tag, test_failures);
+        return 1;
+    }
+    printf("[%s] ✓ 全部通过\n", tag);
+    return 0;
+}
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,428 @@
+/* 配置测试：场景文件加载（JSON / 二进制场景）、TLE/OEM 编目导入、运行时参数重载
+ *
+ * 用法: test_config
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <kinematics.h>
+#include <simulation.h>
+#include <log.h>
+#include <rng.h>
+#include <config/config.h>
+#include <config/catalog.h>
+
+#include "test_common.h"
+
+#define TEST_THREADS            4           // 并行导入的线程数
+#define TEST_CONFIG_COUNT       257         // 场景加载比对的卫星数
+#define TEST_CATALOG_COUNT      600         // 编目导入比对的记录数
+#define TEST_CATALOG_CHUNK      1531        // 并行导入的切块字节数（记录跨块）
+
+/* ==================== 场景文件加载 ==================== */
+
+/* 数字按多种写法写出（定点、科学计数、17位、超过19位有效数字），
+   加载结果须与 strtod 解析后按根数建星逐位一致 */
+static void test_write_number(FILE *f, double v, int style) {
+    switch (style % 4) {
+    case 0: fprintf(f, "%.17g", v); break;
+    case 1: fprintf(f, "%.6f", v); break;
+    case 2: fprintf(f, "%.12e", v); break;
+    default: fprintf(f, "%.25f", v); break;
+    }
+}
+
+static void test_check_config_loader(void) {
+    char path[] = "/tmp/test_config_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *f = (fd >= 0) ? fdopen(fd, "w") : NULL;
+    TEST_CHECK(f, "config: 无法创建临时文件");
+    if (!f) return;
+
+    const int n = TEST_CONFIG_COUNT;
+    char (*text)[6][64] = malloc(sizeof(*text) * n);
+    TEST_CHECK(text, "config: 内存分配失败");
+    if (!text) {
+        fclose(f);
+        unlink(path);
+        return;
+    }
+
+    // satellites 放在 simulation 之前，并夹带未知键、转义字符串和嵌套值
+    Rng rng;
+    rng_seed(&rng, 46);
+    fprintf(f, "{\n  \"comment\": \"ids \\\"1..n\\\" \\\\ [x]\",\n  \"satellites\": [\n");
+    for (int k = 0; k < n; k++) {
+        double values[6] = { rng_uniform_range(&rng, 6600, 45000), rng_uniform_range(&rng, 0, 0.9),
+                             rng_uniform_range(&rng, 0, 180), rng_uniform_range(&rng, -360, 360),
+                             rng_uniform_range(&rng, 0, 360), rng_uniform_range(&rng, -720, 720) };
+        if (k % 31 == 0) values[1] = 0.0;
+        for (int j = 0; j < 6; j++) {
+            char *buf = text[k][j];
+            FILE *mem = fmemopen(buf, sizeof(text[k][j]), "w");
+            test_write_number(mem, values[j], k + j);
+            fclose(mem);
+        }
+        fprintf(f, "    {\"extra\": {\"nested\": [1, {\"x\": \"]}\"}]}, \"m0\": %s, \"id\": %d, \"type\": %d,"
+                   " \"function_type\": %d, \"a\": %s, \"e\": %s, \"i\": %s, \"omega_big\": %s,"
+                   " \"omega_small\": %s, \"fuel\": %d.5e1, \"flag\": true}%s\n",
+                text[k][5], 5000 + k, k % 2, 1 + k % 3, text[k][0], text[k][1], text[k][2], text[k][3],
+                text[k][4], k, (k + 1 < n) ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"simulation\": {\"time_step\": 2.5, \"max_steps\": 77, \"verbose\": false},\n"
+               "  \"strategy_thresholds\": {\"attack_distance\": 3000.4, \"warning_distance\": 5e3},\n"
+               "  \"attitude_parameters\": {\"max_angular_rate\": 0.02, \"max_angular_accel\": 0.004},\n"
+               "  \"strategy\": \"ZC\"\n}\n");
+    fclose(f);
+
+    SimulationConfig defaults;
+    simulation_default_config(&defaults);
+    KinematicsEngine *engine = config_load_engine(path, &defaults, 1, 4);
+    TEST_CHECK(engine && engine->satellite_count == n, "config: 场景文件加载失败");
+    if (engine) {
+        TEST_CHECK(engine->dt_seconds == 2.5 && strcmp(engine->strategy, "ZC") == 0 &&
+                   kinematics_engine_params(engine)->strategy.attack_distance == 3000 &&
+                   kinematics_engine_params(engine)->strategy.warning_distance == 5000,
+                   "config: 仿真参数或策略阈值未生效");
+        for (int k = 0; k < n && engine->satellite_count == n; k++) {
+            OrbitalElements el = { strtod(text[k][0], NULL) * 1000.0, strtod(text[k][1], NULL),
+                                   strtod(text[k][2], NULL), strtod(text[k][3], NULL),
+                                   strtod(text[k][4], NULL), strtod(text[k][5], NULL) };
+            Satellite *ref = satellite_create_from_elements(NULL, 5000 + k, k % 2, 0, k % 3, &el);
+            Satellite *sat = kinematics_engine_get_satellite(engine, 5000 + k);
+            int same = ref && sat && sat->team == ref->team && sat->function_type == ref->function_type &&
+                       memcmp(&sat->orbital_elements, &ref->orbital_elements, sizeof(OrbitalElements)) == 0 &&
+                       memcmp(&sat->state, &ref->state, sizeof(StateVector)) == 0 &&
+                       sat->fuel == k * 10 + 5 && sat->attitude.max_rate == 0.02;
+            TEST_CHECK(same, "config: 卫星 %d 与 strtod 解析结果不一致", 5000 + k);
+            satellite_destroy(ref);
+            if (!same) break;
+        }
+
+        // 编译为二进制场景后再加载，卫星和参数须与JSON加载逐位一致
+        char binary[sizeof(path) + 8];
+        snprintf(binary, sizeof(binary), "%s.scn", path);
+        KinematicsEngine *compiled = NULL;
+        if (config_compile_scenario(path, binary) == 0) {
+            compiled = config_load_engine(binary, &defaults, 1, 4);
+            unlink(binary);
+        }
+        TEST_CHECK(compiled && compiled->satellite_count == engine->satellite_count,
+                   "config: 二进制场景编译或加载失败");
+        if (compiled) {
+            TEST_CHECK(compiled->dt_seconds == engine->dt_seconds &&
+                       compiled->config.max_steps == engine->config.max_steps &&
+                       compiled->config.decision_interval == engine->config.decision_interval &&
+                       compiled->config.save_interval == engine->config.save_interval &&
+                       compiled->config.perturbation_flags == engine->config.perturbation_flags &&
+                       compiled->config.epoch_jd == engine->config.epoch_jd &&
+                       strcmp(compiled->strategy, engine->strategy) == 0 &&
+                       memcmp(kinematics_engine_params(compiled), kinematics_engine_params(engine),
+                                offsetof(RuntimeParams, retired_next)) == 0,
+                       "config: 二进制场景的仿真参数与JSON不一致");
+            for (int k = 0; k < engine->satellite_count && compiled->satellite_count == engine->satellite_count; k++) {
+                const Satellite *a = engine->satellites[k], *b = compiled->satellites[k];
+                int same = a->id == b->id && a->team == b->team && a->function_type == b->function_type &&
+                           memcmp(&a->orbital_elements, &b->orbital_elements, sizeof(OrbitalElements)) == 0 &&
+                           memcmp(&a->state, &b->state, sizeof(StateVector)) == 0 &&
+                           a->fuel == b->fuel && a->attitude.max_rate == b->attitude.max_rate &&
+                           a->attitude.max_accel == b->attitude.max_accel;
+                TEST_CHECK(same, "config: 二进制场景卫星 %d 与JSON加载不一致", a->id);
+                if (!same) break;
+            }
+            kinematics_engine_destroy(compiled);
+        }
+        kinematics_engine_destroy(engine);
+    }
+
+    // 语法错误和无效根数须拒绝
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "{\"satellites\": [{\"id\": 1, \"a\": 7000, \"e\": 1.5}]}");
+        fclose(f);
+        engine = config_load_engine(path, &defaults, 1, 4);
+        TEST_CHECK(!engine, "config: 偏心率无效的卫星未被拒绝");
+        kinematics_engine_destroy(engine);
+    }
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "{\"satellites\": [{\"id\": 1, \"a\": 7000,, \"e\": 0.1}]}");
+        fclose(f);
+        engine = config_load_engine(path, &defaults, 1, 4);
+        TEST_CHECK(!engine, "config: 语法错误未被拒绝");
+        kinematics_engine_destroy(engine);
+    }
+
+    // 重复ID在读取时即拒绝：建引擎、只读卫星和编译二进制场景都不通过
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "{\"satellites\": [{\"id\": 7, \"a\": 7000}, {\"id\": 8, \"a\": 7100}, {\"id\": 7, \"a\": 7200}]}");
+        fclose(f);
+        engine = config_load_engine(path, &defaults, 1, 4);
+        Satellite **satellites = NULL;
+        int count = 0;
+        char binary[sizeof(path) + 8];
+        snprintf(binary, sizeof(binary), "%s.scn", path);
+        int loaded = config_load_satellites(path, &satellites, &count);
+        int compiled = config_compile_scenario(path, binary);
+        TEST_CHECK(!engine && loaded != 0 && !satellites && compiled != 0 && access(binary, F_OK) != 0,
+                   "config: 重复卫星ID未被拒绝");
+        kinematics_engine_destroy(engine);
+        for (int k = 0; k < count; k++) satellite_destroy(satellites[k]);
+        free(satellites);
+        unlink(binary);
+    }
+    unlink(path);
+    free(text);
+}
+
+/* ==================== 编目导入 ==================== */
+
+/* TLE 行尾模10校验位 */
+static char test_tle_checksum(const char *line) {
+    int sum = 0;
+    for (const char *p = line; *p; p++) {
+        if (*p >= '0' && *p <= '9') sum += *p - '0';
+        else if (*p == '-') sum++;
+    }
+    return (char)('0' + sum % 10);
+}
+
+/* 同一编目按单块串行和小块多线程各导入一次，条目须逐位一致 */
+static int test_catalog_load_both(const char *path, CatalogEntry **entries, CatalogStats *stats) {
+    CatalogOptions options;
+    catalog_default_options(&options);
+    options.chunk_size = (size_t)1 << 30;
+    CatalogEntry *serial = NULL;
+    CatalogStats serial_stats;
+    int n = catalog_load(path, &options, &serial, &serial_stats);
+
+    options.chunk_size = TEST_CATALOG_CHUNK;
+    options.num_threads = TEST_THREADS;
+    int m = catalog_load(path, &options, entries, stats);
+    TEST_CHECK(n >= 0 && m == n && stats->chunks > 1 && stats->parsed == serial_stats.parsed &&
+               stats->filtered == serial_stats.filtered && stats->rejected == serial_stats.rejected &&
+               (n == 0 || memcmp(serial, *entries, sizeof(CatalogEntry) * n) == 0),
+               "catalog: %s 并行导入与串行导入不一致 (%d / %d 条)", path, m, n);
+    free(serial);
+    return m;
+}
+
+static void test_check_catalog_loader(void) {
+    char path[] = "/tmp/test_catalog_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *f = (fd >= 0) ? fdopen(fd, "w") : NULL;
+    TEST_CHECK(f, "catalog: 无法创建临时文件");
+    if (!f) return;
+
+    // ===== TLE：GEO 与 MEO/LEO 混排，部分带名称行，一条校验位错误 =====
+    Rng rng;
+    rng_seed(&rng, 48);
+    int expected_geo = 0;
+    double latest_day = 0;
+    for (int k = 0; k < TEST_CATALOG_COUNT; k++) {
+        char line1[80], line2[80];
+        double day = rng_uniform_range(&rng, 1, 300);
+        double motion = (k % 4 == 1) ? 2.00563 : (k % 4 == 3) ? 15.49 : 1.0027 + rng_uniform_range(&rng, -0.005, 0.005);
+        snprintf(line1, sizeof(line1), "1 %05dU %-8s %02d%012.8f %10s %8s %8s 0 %4d",
+                 30000 + k, "98067A", 26, day, " .00000000", " 00000-0", " 00000-0", 999);
+        snprintf(line2, sizeof(line2), "2 %05d %8.4f %8.4f %07d %8.4f %8.4f %11.8f%5d", 30000 + k,
+                 rng_uniform_range(&rng, 0, 15), rng_uniform_range(&rng, 0, 360), (int)rng_uniform_range(&rng, 0, 9999999),
+                 rng_uniform_range(&rng, 0, 360), rng_uniform_range(&rng, 0, 360), motion, 100 + k);
+        char check1 = test_tle_checksum(line1), check2 = test_tle_checksum(line2);
+        if (k == 100) check2 = (char)('0' + (check2 - '0' + 1) % 10);
+        else if (k % 4 == 0 || k % 4 == 2) {
+            expected_geo++;
+            if (day > latest_day) latest_day = day;
+        }
+        if (k % 3 == 0) fprintf(f, "0 GOLDEN-%d\n", k);
+        fprintf(f, "%s%c\n%s%c\n", line1, check1, line2, check2);
+    }
+    fclose(f);
+
+    CatalogEntry *entries = NULL;
+    CatalogStats stats;
+    int n = test_catalog_load_both(path, &entries, &stats);
+    TEST_CHECK(n == expected_geo && stats.rejected == 1 && stats.filtered == TEST_CATALOG_COUNT / 2,
+               "catalog: TLE 筛选结果不符 (%d 条入选，期望 %d；筛除 %d，跳过 %d)",
+               n, expected_geo, stats.filtered, stats.rejected);
+    for (int k = 0; k < n; k++) {
+        const CatalogEntry *e = &entries[k];
+        double r = vector3_magnitude(e->state.position);
+        int ok = e->elements.a >= CATALOG_GEO_A_MIN && e->elements.a <= CATALOG_GEO_A_MAX &&
+                 fabs(e->epoch_jd - (2461040.5 + latest_day)) < 1e-6 &&
+                 r >= e->elements.a * (1 - e->elements.e) - 1e-3 && r <= e->elements.a * (1 + e->elements.e) + 1e-3 &&
+                 ((e->id - 30000) % 3 != 0 || strncmp(e->name, "GOLDEN-", 7) == 0);
+        TEST_CHECK(ok, "catalog: TLE 条目 %d 根数、历元或名称错误", e->id);
+        if (!ok) break;
+    }
+    free(entries);
+
+    // ===== OEM：同一历元，GEO 段保留原始状态，LEO 段筛除，地固系段跳过 =====
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "CCSDS_OEM_VERS = 2.0\nCREATION_DATE = 2026-10-18T00:00:00\nORIGINATOR = GOLDEN\n");
+        for (int k = 0; k < TEST_CATALOG_COUNT / 4; k++) {
+            double radius = (k % 5 == 4) ? 7000.0 : 42164.0 + rng_uniform_range(&rng, -100, 100);
+            double theta = rng_uniform_range(&rng, 0, 2 * PI), speed = sqrt(398600.4418 / radius);
+            fprintf(f, "\nMETA_START\nOBJECT_NAME = OEM-%d\nOBJECT_ID = %s%d\nCENTER_NAME = EARTH\n"
+                       "REF_FRAME = %s\nTIME_SYSTEM = UTC\nMETA_STOP\n\nCOMMENT 段 %d\n",
+                    k, (k % 2) ? "" : "2026-", 40000 + k, (k % 7 == 6) ? "ITRF2000" : "EME2000", k);
+            for (int j = 0; j < 3; j++) {
+                fprintf(f, "2026-10-18T%02d:00:00.000 %.6f %.6f 0.0 %.9f %.9f 0.0\n", j,
+                        radius * cos(theta), radius * sin(theta), -speed * sin(theta), speed * cos(theta));
+            }
+        }
+        fclose(f);
+
+        n = test_catalog_load_both(path, &entries, &stats);
+        int expected = 0;
+        for (int k = 0; k < TEST_CATALOG_COUNT / 4; k++) expected += (k % 5 != 4 && k % 7 != 6);
+        TEST_CHECK(n == expected, "catalog: OEM 导入 %d 条，期望 %d", n, expected);
+        for (int k = 0; k < n; k++) {
+            const CatalogEntry *e = &entries[k];
+            int index = atoi(e->name + 4);
+            StateVector state = e->state;
+            OrbitalElements el;
+            int ok = strncmp(e->name, "OEM-", 4) == 0 && e->id == ((index % 2) ? 40000 + index : 0) &&
+                     orbit_state_to_elements(&state, &el) == 0 &&
+                     memcmp(&el, &e->elements, sizeof(OrbitalElements)) == 0 && e->state.position.z == 0.0;
+            TEST_CHECK(ok, "catalog: OEM 段 %s 状态或元数据错误", e->name);
+            if (!ok) break;
+        }
+        free(entries);
+    }
+    unlink(path);
+}
+
+/* ==================== 运行时参数重载 ==================== */
+
+/* 参数重载线程：不断重读同一文件提交参数，检查每次读到的参数块内部一致 */
+typedef struct {
+    KinematicsEngine *engine;
+    const char *path;
+    int stop;
+    int torn;
+} GoldenParamsReader;
+
+static void *test_params_reader(void *arg) {
+    GoldenParamsReader *reader = (GoldenParamsReader*)arg;
+    sim_log_set_quiet(1);
+    // 至少提交一次（单核上本线程可能在主线程决策完后才被调度）
+    do {
+        const RuntimeParams *p = kinematics_engine_params_acquire(reader->engine);
+        // 两份参数文件中 attack/warning 与 slew_cost_weight 成对出现
+        if ((p->strategy.attack_distance == 3000) != (p->slew_cost_weight == 0.25) ||
+            (p->strategy.attack_distance == 3000) != (p->strategy.warning_distance == 5000)) {
+            reader->torn++;
+        }
+        kinematics_engine_params_release(reader->engine);
+        config_reload_params(reader->engine, reader->path);
+    } while (!__atomic_load_n(&reader->stop, __ATOMIC_ACQUIRE));
+    return NULL;
+}
+
+static void test_check_params_reload(void) {
+    char path[] = "/tmp/test_params_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *f = (fd >= 0) ? fdopen(fd, "w") : NULL;
+    TEST_CHECK(f, "params: 无法创建临时文件");
+    if (!f) return;
+    fprintf(f, "{\"simulation\": {\"slew_cost_weight\": 0.25, \"max_steps\": 7},\n"
+               " \"strategy_thresholds\": {\"attack_distance\": 3000, \"warning_distance\": 5000},\n"
+               " \"formation_parameters\": {\"ellipse_min_distance\": 7000, \"ellipse_max_distance\": 9000}}\n");
+    fclose(f);
+
+    SimulationConfig config;
+    simulation_default_config(&config);
+    config.slew_cost_weight = 0.5;
+    Config scenario = { 1, 1, 0, 1, 1, 0, "ZC", 0, 0 };
+    KinematicsEngine *engine = simulation_create_engine(&scenario, &config, 49, 0);
+    TEST_CHECK(engine, "params: 引擎创建失败");
+    if (!engine) {
+        unlink(path);
+        return;
+    }
+    // 换下的旧块会在决策时回收，留一份副本供比较
+    const RuntimeParams *current = kinematics_engine_params(engine);
+    RuntimeParams before = *current;
+    TEST_CHECK(before.generation == 0 && before.slew_cost_weight == 0.5 &&
+               before.strategy.warning_distance == WARNING_DISTANCE,
+               "params: 初始参数块与配置不一致");
+
+    // 提交后在决策前不生效，决策开始时整体换入；文件外的项保持原值
+    TEST_CHECK(config_reload_params(engine, path) == 0, "params: 参数文件读取失败");
+    TEST_CHECK(kinematics_engine_params(engine) == current, "params: 新参数在决策周期之前生效");
+    kinematics_engine_decide(engine);
+    const RuntimeParams *after = kinematics_engine_params(engine);
+    TEST_CHECK(after != current && after->generation == 1 && after->slew_cost_weight == 0.25 &&
+               after->strategy.attack_distance == 3000 && after->strategy.warning_distance == 5000 &&
+               after->strategy.defense_distance == before.strategy.defense_distance &&
+               after->ellipse_min_distance == 7000e3 && after->ellipse_max_distance == 9000e3 &&
+               after->lambert_target_distance == before.lambert_target_distance &&
+               engine->config.max_steps == config.max_steps,
+               "params: 换入的参数块不正确");
+    TEST_CHECK(!engine->retired_params, "params: 无外部读方时旧参数块未回收");
+
+    // 外部读方持有期间旧块保留，释放后的下一次决策回收
+    const RuntimeParams *held = kinematics_engine_params_acquire(engine);
+    TEST_CHECK(config_reload_params(engine, path) == 0, "params: 参数文件读取失败");
+    kinematics_engine_decide(engine);
+    TEST_CHECK(engine->retired_params == held && held->slew_cost_weight == 0.25,
+               "params: 读方持有的参数块被提前回收");
+    kinematics_engine_params_release(engine);
+    kinematics_engine_decide(engine);
+    TEST_CHECK(!engine->retired_params, "params: 读方释放后旧参数块未回收");
+    after = kinematics_engine_params(engine);
+
+    // 无效参数整体拒绝，当前参数不变
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "{\"formation_parameters\": {\"ellipse_min_distance\": 9000, \"ellipse_max_distance\": 7000}}\n");
+        fclose(f);
+        TEST_CHECK(config_reload_params(engine, path) != 0, "params: 无效参数未被拒绝");
+        kinematics_engine_decide(engine);
+        TEST_CHECK(kinematics_engine_params(engine) == after, "params: 拒绝后参数块被替换");
+    }
+
+    // 另一线程持续提交时，决策线程换入的每一块都须完整
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "{\"simulation\": {\"slew_cost_weight\": 0.75},\n"
+                   " \"strategy_thresholds\": {\"attack_distance\": 2000, \"warning_distance\": 6000}}\n");
+        fclose(f);
+        GoldenParamsReader reader = { engine, path, 0, 0 };
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, test_params_reader, &reader) == 0) {
+            for (int k = 0; k < 50; k++) kinematics_engine_decide(engine);
+            __atomic_store_n(&reader.stop, 1, __ATOMIC_RELEASE);
+            pthread_join(thread, NULL);
+            kinematics_engine_decide(engine);
+            const RuntimeParams *last = kinematics_engine_params(engine);
+            TEST_CHECK(reader.torn == 0 && last->generation >= 3 && last->slew_cost_weight == 0.75 &&
+                       last->strategy.attack_distance == 2000 && last->strategy.warning_distance == 6000,
+                       "params: 并发重载时读到不完整的参数块");
+            TEST_CHECK(!engine->retired_params, "params: 并发重载结束后旧参数块未回收");
+        }
+    }
+    kinematics_engine_destroy(engine);
+    unlink(path);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    sim_log_set_quiet(1);
+    TEST_RUN("Config", test_check_config_loader(), "场景文件加载与 strtod 解析后建星逐位一致，二进制场景与JSON一致");
+    TEST_RUN("Config", test_check_catalog_loader(), "TLE/OEM 编目并行导入与串行一致，GEO带筛选正确");
+    TEST_RUN("Config", test_check_params_reload(), "运行时参数在决策周期之间整体换入，无效参数被拒绝");
+    return test_summary("Config");
+}
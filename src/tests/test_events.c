@@ -0,0 +1,127 @@
+/* 事件检测测试：event_propagate 单步内多个过零点按时刻先后触发，
+ * 晚于终止事件的留待下次外推，一次性事件只触发一次
+ *
+ * 用法: test_events
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <event.h>
+#include <constants.h>
+
+#include "test_common.h"
+
+#define TEST_MAX_FIRES      32
+#define TEST_STEP           100.0       // 外推步长 (秒)，首步内含全部首次过零点
+#define TEST_PERIOD         200.0       // 周期事件的周期 (秒)
+
+/* 触发记录（按回调顺序） */
+typedef struct {
+    int ids[TEST_MAX_FIRES];
+    double times[TEST_MAX_FIRES];
+    int count;
+} TestFireLog;
+
+/* 事件参数：g 只依赖时刻，过零点精确已知 */
+typedef struct {
+    double t0;                          // 过零时刻（周期事件为首个上升沿）
+    int periodic;
+    TestFireLog *log;
+} TestTimeEvent;
+
+static double test_time_func(const StateVector *primary, const StateVector *secondary, void *user_data) {
+    (void)secondary;
+    const TestTimeEvent *p = (const TestTimeEvent*)user_data;
+    if (p->periodic) return sin(2.0 * M_PI * (primary->time - p->t0) / TEST_PERIOD);
+    return primary->time - p->t0;
+}
+
+static void test_record(const OrbitEvent *event, double t, const StateVector *primary,
+                        const StateVector *secondary, void *user_data) {
+    (void)primary;
+    (void)secondary;
+    TestFireLog *log = ((TestTimeEvent*)user_data)->log;
+    if (log->count < TEST_MAX_FIRES) {
+        log->ids[log->count] = event->id;
+        log->times[log->count] = t;
+    }
+    log->count++;
+}
+
+/* ==================== 触发顺序 ==================== */
+
+static void test_check_propagate_order(void) {
+    TestFireLog log;
+    memset(&log, 0, sizeof(log));
+
+    // 数组顺序故意与时刻顺序不同：终止事件在前，晚于它的非终止事件与一次性事件在后
+    enum { EV_TERMINAL, EV_LATE, EV_EARLY, EV_ONE_SHOT, EV_PERIODIC, EV_COUNT };
+    TestTimeEvent params[EV_COUNT] = {
+        [EV_TERMINAL] = { 50.0, 0, &log },
+        [EV_LATE]     = { 70.0, 0, &log },
+        [EV_EARLY]    = { 30.0, 0, &log },
+        [EV_ONE_SHOT] = { 20.0, 1, &log },
+        [EV_PERIODIC] = { 20.0, 1, &log },
+    };
+    OrbitEvent events[EV_COUNT];
+    memset(events, 0, sizeof(events));
+    for (int k = 0; k < EV_COUNT; k++) {
+        events[k].id = k + 1;
+        events[k].primary_id = 1;
+        events[k].secondary_id = -1;
+        events[k].g = test_time_func;
+        events[k].handler = test_record;
+        events[k].user_data = &params[k];
+        events[k].direction = EVENT_DIR_RISING;
+        events[k].active = 1;
+    }
+    events[EV_TERMINAL].terminal = 1;
+    events[EV_ONE_SHOT].one_shot = 1;
+
+    // 7000 km 圆轨道
+    double r = 7000e3;
+    StateVector state = { { r, 0.0, 0.0 }, { 0.0, sqrt(MU_SI / r), 0.0 }, 0.0 };
+
+    // 第一次外推：20 s 的两个周期事件（同一时刻按下标）、30 s、50 s 终止；70 s 不触发
+    EventHit hit;
+    int status = event_propagate(&state, 1000.0, TEST_STEP, NULL, events, EV_COUNT, &hit);
+    TEST_CHECK(status == 1 && hit.event_id == EV_TERMINAL + 1 &&
+               fabs(hit.time - 50.0) < EVENT_TIME_TOLERANCE && fabs(state.time - 50.0) < EVENT_TIME_TOLERANCE,
+               "events: 未停在终止事件 (status %d, t = %.6f)", status, state.time);
+
+    const int expected_ids[] = { EV_ONE_SHOT + 1, EV_PERIODIC + 1, EV_EARLY + 1, EV_TERMINAL + 1 };
+    const double expected_times[] = { 20.0, 20.0, 30.0, 50.0 };
+    int n = (int)(sizeof(expected_ids) / sizeof(expected_ids[0]));
+    TEST_CHECK(log.count == n, "events: 首次外推触发 %d 次，应为 %d", log.count, n);
+    for (int i = 0; i < n && i < log.count; i++) {
+        TEST_CHECK(log.ids[i] == expected_ids[i] && fabs(log.times[i] - expected_times[i]) < EVENT_TIME_TOLERANCE,
+                   "events: 第 %d 次触发为事件 %d @ %.6f s，应为事件 %d @ %.1f s",
+                   i, log.ids[i], log.times[i], expected_ids[i], expected_times[i]);
+    }
+
+    // 第二次外推到 1000 s：70 s 补触发；周期事件 220..820 s 共 4 次，一次性事件不再触发
+    log.count = 0;
+    status = event_propagate(&state, 1000.0 - state.time, TEST_STEP, NULL, events, EV_COUNT, NULL);
+    TEST_CHECK(status == 0 && fabs(state.time - 1000.0) < 1e-9,
+               "events: 续推未到达终点 (status %d, t = %.6f)", status, state.time);
+    TEST_CHECK(log.count == 5 && log.ids[0] == EV_LATE + 1 && fabs(log.times[0] - 70.0) < EVENT_TIME_TOLERANCE,
+               "events: 续推触发 %d 次，首个为事件 %d @ %.6f s", log.count, log.ids[0], log.times[0]);
+    for (int i = 1; i < log.count && i < TEST_MAX_FIRES; i++) {
+        TEST_CHECK(log.times[i] >= log.times[i - 1], "events: 第 %d 次触发早于前一次", i);
+    }
+    TEST_CHECK(events[EV_ONE_SHOT].fire_count == 1 && !events[EV_ONE_SHOT].active,
+               "events: 一次性事件触发 %u 次", events[EV_ONE_SHOT].fire_count);
+    TEST_CHECK(events[EV_PERIODIC].fire_count == 5 && events[EV_TERMINAL].fire_count == 1,
+               "events: 周期事件触发 %u 次、终止事件 %u 次",
+               events[EV_PERIODIC].fire_count, events[EV_TERMINAL].fire_count);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    TEST_RUN("Events", test_check_propagate_order(), "终止、非终止和一次性事件按时刻顺序触发");
+    return test_summary("Events");
+}
@@ -0,0 +1,555 @@
+/* 黄金轨迹回归测试：参考场景经标量路径运行并与黄金文件比对，
+ * 其余实现路径（线程并发、检查点续跑、SIMD内核、arena决策、相对运动闭式解）再与标量路径比对；
+ * 各子系统的单项检查见同目录 test_kernels.c / test_config.c / test_proximity.c / test_rng.c / test_events.c / test_history.c / test_attitude.c
+ *
+ * 用法: test_golden [GOLDEN_DIR]            比对（默认 src/tests/golden）
+ *       test_golden --update [GOLDEN_DIR]   以当前标量路径结果重写黄金文件
+ *
+ * 黄金文件：GoldenHeader + SimOutputRecord[]（与 SIM_OUTPUT_BINARY 相同的定长记录，
+ * 全体卫星按采样间隔）+ GoldenAssignment[]（每次决策后的红星目标/策略/编队）
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include <kinematics.h>
+#include <simulation.h>
+#include <checkpoint.h>
+#include <thread_pool.h>
+#include <log.h>
+#include <vector3_soa.h>
+#include <decision/decision_tree.h>
+#include <decision/differential_game.h>
+
+#include "test_common.h"
+
+#define GOLDEN_MAGIC            "SATGOLD"   // 8字节（含结尾0）
+#define GOLDEN_VERSION          1
+#define GOLDEN_DEFAULT_DIR      "src/tests/golden"
+#define GOLDEN_HISTORY          32          // 每层历史样本数
+#define GOLDEN_THREADS          4           // 并发路径的引擎副本数
+
+/* 容差：黄金文件允许跨编译器的末位差异，路径之间同样适用 */
+#define GOLDEN_POS_TOL          1e-3        // 位置 (m)
+#define GOLDEN_VEL_TOL          1e-6        // 速度 (m/s)
+#define GOLDEN_FUEL_TOL         1e-9        // 燃料 (kg)
+#define GOLDEN_REL_POS_TOL      1e-3        // 闭式相对解：位置误差 / 初始间距
+
+/* ==================== 黄金文件格式 ==================== */
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;           // sizeof(SimOutputRecord)，检测布局变化
+    uint32_t assignment_size;       // sizeof(GoldenAssignment)
+    uint32_t num_records;
+    uint32_t num_assignments;
+    uint32_t reserved;
+} GoldenHeader;
+
+typedef struct {
+    uint32_t step;
+    int32_t sat_id;
+    int32_t target_id;
+    int32_t strategy;
+    int32_t formation;
+} GoldenAssignment;
+
+/* 一次运行的采样结果 */
+typedef struct {
+    SimOutputRecord *records;
+    uint32_t num_records;
+    uint32_t records_capacity;
+    GoldenAssignment *assignments;
+    uint32_t num_assignments;
+    uint32_t assignments_capacity;
+} GoldenRun;
+
+/* ==================== 参考场景 ==================== */
+
+typedef struct {
+    const char *name;
+    Config scenario;
+    uint64_t seed;
+    uint32_t steps;
+    uint32_t sample_interval;       // 采样间隔 (步)
+    double decision_interval;       // 决策周期 (秒)
+    uint32_t perturbation_flags;
+} GoldenScenario;
+
+static const GoldenScenario GOLDEN_SCENARIOS[] = {
+    { "baseline",  { 3, 3, 3, 2, 2, 2, "GJ", 0, 0 },  1, 1000, 100, 1000.0, PERTURB_NONE },
+    { "perturbed", { 2, 2, 2, 2, 2, 2, "ZC", 0, 0 }, 42,  500,  50,  500.0, PERTURB_ALL_BUILTIN },
+    { "fleet",     { 8, 8, 8, 8, 8, 8, "FY", 0, 0 },  7,  400, 100,  200.0, PERTURB_J2 },
+};
+#define GOLDEN_NUM_SCENARIOS  ((int)(sizeof(GOLDEN_SCENARIOS) / sizeof(GOLDEN_SCENARIOS[0])))
+
+/* ==================== 采样 ==================== */
+
+static void golden_run_free(GoldenRun *run) {
+    free(run->records);
+    free(run->assignments);
+    memset(run, 0, sizeof(GoldenRun));
+}
+
+static int golden_push_record(GoldenRun *run, const KinematicsEngine *engine, const Satellite *sat) {
+    if (run->num_records >= run->records_capacity) {
+        uint32_t grown = run->records_capacity ? run->records_capacity * 2 : 256;
+        SimOutputRecord *records = (SimOutputRecord*)realloc(run->records, sizeof(SimOutputRecord) * grown);
+        if (!records) return -1;
+        run->records = records;
+        run->records_capacity = grown;
+    }
+    SimOutputRecord *r = &run->records[run->num_records++];
+    memset(r, 0, sizeof(SimOutputRecord));
+    r->step = engine->step_count;
+    r->sat_id = sat->id;
+    r->time = engine->current_time;
+    r->position[0] = sat->state.position.x;
+    r->position[1] = sat->state.position.y;
+    r->position[2] = sat->state.position.z;
+    r->velocity[0] = sat->state.velocity.x;
+    r->velocity[1] = sat->state.velocity.y;
+    r->velocity[2] = sat->state.velocity.z;
+    r->fuel = sat->fuel;
+    r->formation = sat->current_formation;
+    r->strategy = sat->current_strategy;
+    return 0;
+}
+
+static int golden_push_assignment(GoldenRun *run, const KinematicsEngine *engine, const Satellite *sat) {
+    if (run->num_assignments >= run->assignments_capacity) {
+        uint32_t grown = run->assignments_capacity ? run->assignments_capacity * 2 : 256;
+        GoldenAssignment *assignments = (GoldenAssignment*)realloc(run->assignments, sizeof(GoldenAssignment) * grown);
+        if (!assignments) return -1;
+        run->assignments = assignments;
+        run->assignments_capacity = grown;
+    }
+    GoldenAssignment *a = &run->assignments[run->num_assignments++];
+    a->step = engine->step_count;
+    a->sat_id = sat->id;
+    a->target_id = sat->target_id;
+    a->strategy = sat->current_strategy;
+    a->formation = sat->current_formation;
+    return 0;
+}
+
+/* 引擎的批量内核指令集（标量参考固定为 scalar，SIMD路径改为本机最宽） */
+static const char *golden_kernel_isa = "scalar";
+
+static KinematicsEngine* golden_create_engine(const GoldenScenario *gs) {
+    SimulationConfig config;
+    simulation_default_config(&config);
+    snprintf(config.kernel_isa, sizeof(config.kernel_isa), "%s", golden_kernel_isa);
+    config.max_steps = gs->steps;
+    config.decision_interval = gs->decision_interval;
+    config.perturbation_flags = gs->perturbation_flags;
+    return simulation_create_engine(&gs->scenario, &config, gs->seed, GOLDEN_HISTORY);
+}
+
+/* 从当前状态步进到 until 步，按场景采样；返回0成功 */
+static int golden_advance(KinematicsEngine *engine, const GoldenScenario *gs, uint32_t until, GoldenRun *run) {
+    while (engine->step_count < until) {
+        uint32_t decisions_before = engine->clocks[SIM_CLOCK_DECISION].tick_count;
+        if (kinematics_engine_step(engine) != 0) return -1;
+
+        if (engine->clocks[SIM_CLOCK_DECISION].tick_count != decisions_before) {
+            for (int i = 0; i < engine->satellite_count; i++) {
+                Satellite *sat = engine->satellites[i];
+                if (sat && sat->team == 0 && golden_push_assignment(run, engine, sat) != 0) return -1;
+            }
+        }
+        if (engine->step_count % gs->sample_interval == 0 || engine->step_count == gs->steps) {
+            for (int i = 0; i < engine->satellite_count; i++) {
+                Satellite *sat = engine->satellites[i];
+                if (sat && golden_push_record(run, engine, sat) != 0) return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* ==================== 实现路径 ==================== */
+
+typedef int (*GoldenPathFunc)(const GoldenScenario *gs, GoldenRun *run);
+
+/* 标量参考：单线程逐步运行（批量内核固定为标量版，见 golden_create_engine） */
+static int golden_path_scalar(const GoldenScenario *gs, GoldenRun *run) {
+    KinematicsEngine *engine = golden_create_engine(gs);
+    if (!engine) return -1;
+    int status = golden_advance(engine, gs, gs->steps, run);
+    kinematics_engine_destroy(engine);
+    return status;
+}
+
+/* 检查点续跑：半程保存、销毁、恢复后跑完 */
+static int golden_path_checkpoint(const GoldenScenario *gs, GoldenRun *run) {
+    KinematicsEngine *engine = golden_create_engine(gs);
+    if (!engine) return -1;
+
+    char path[256];
+    snprintf(path, sizeof(path), "/tmp/test_golden_%d_%s.ckpt", (int)getpid(), gs->name);
+
+    int status = golden_advance(engine, gs, gs->steps / 2, run);
+    if (status == 0) status = kinematics_engine_save_checkpoint(engine, path);
+    kinematics_engine_destroy(engine);
+    if (status != 0) return -1;
+
+    engine = kinematics_engine_load_checkpoint(path);
+    remove(path);
+    if (!engine) return -1;
+    status = golden_advance(engine, gs, gs->steps, run);
+    kinematics_engine_destroy(engine);
+    return status;
+}
+
+/* SIMD：引擎按本机最宽指令集创建（SoA和轨道批量内核） */
+static int golden_path_simd(const GoldenScenario *gs, GoldenRun *run) {
+    golden_kernel_isa = vector3_soa_isa_name(vector3_soa_detect_isa());
+    int status = golden_path_scalar(gs, run);
+    if (status == 0 && vector3_soa_get_isa() != vector3_soa_detect_isa()) status = -1;
+    golden_kernel_isa = "scalar";
+    vector3_soa_set_isa(VECTOR3_SOA_ISA_SCALAR);
+    return status;
+}
+
+typedef struct {
+    const GoldenScenario *gs;
+    GoldenRun run;
+    int status;
+} GoldenThreadJob;
+
+static void golden_thread_job(void *arg) {
+    GoldenThreadJob *job = (GoldenThreadJob*)arg;
+    sim_log_set_quiet(1);
+    job->status = golden_path_scalar(job->gs, &job->run);
+}
+
+static int golden_compare_runs(const char *label, const GoldenRun *expected, const GoldenRun *actual);
+
+/* 线程并发：多个引擎副本在线程池上同时运行，结果须与标量一致且彼此一致 */
+static int golden_path_threaded(const GoldenScenario *gs, GoldenRun *run) {
+    GoldenThreadJob jobs[GOLDEN_THREADS];
+    memset(jobs, 0, sizeof(jobs));
+
+    ThreadPool *pool = thread_pool_create(GOLDEN_THREADS);
+    if (!pool) return -1;
+    for (int t = 0; t < GOLDEN_THREADS; t++) {
+        jobs[t].gs = gs;
+        thread_pool_submit(pool, golden_thread_job, &jobs[t]);
+    }
+    thread_pool_wait(pool);
+    thread_pool_destroy(pool);
+
+    int status = 0;
+    for (int t = 0; t < GOLDEN_THREADS; t++) {
+        if (jobs[t].status != 0) status = -1;
+        if (t > 0 && status == 0) {
+            char label[64];
+            snprintf(label, sizeof(label), "threaded[%d] vs threaded[0]", t);
+            if (golden_compare_runs(label, &jobs[0].run, &jobs[t].run) != 0) status = -1;
+        }
+    }
+    for (int t = 1; t < GOLDEN_THREADS; t++) golden_run_free(&jobs[t].run);
+    *run = jobs[0].run;
+    return status;
+}
+
+typedef struct {
+    const char *name;
+    GoldenPathFunc run;
+} GoldenPath;
+
+/* 新的优化路径（SIMD、多线程外推等）在此登记，与标量参考逐项比对 */
+static const GoldenPath GOLDEN_PATHS[] = {
+    { "checkpoint", golden_path_checkpoint },
+    { "threaded",   golden_path_threaded },
+    { "simd",       golden_path_simd },
+};
+#define GOLDEN_NUM_PATHS  ((int)(sizeof(GOLDEN_PATHS) / sizeof(GOLDEN_PATHS[0])))
+
+/* ==================== 比对 ==================== */
+
+/* 逐项比对，失败时报告第一处差异，返回0一致 */
+static int golden_compare_runs(const char *label, const GoldenRun *expected, const GoldenRun *actual) {
+    int before = test_failures;
+
+    TEST_CHECK(expected->num_records == actual->num_records,
+               "%s: 采样数 %u != %u", label, actual->num_records, expected->num_records);
+    uint32_t n = expected->num_records < actual->num_records ? expected->num_records : actual->num_records;
+    for (uint32_t i = 0; i < n; i++) {
+        const SimOutputRecord *e = &expected->records[i], *a = &actual->records[i];
+        double dp = 0, dv = 0;
+        for (int k = 0; k < 3; k++) {
+            dp = fmax(dp, fabs(a->position[k] - e->position[k]));
+            dv = fmax(dv, fabs(a->velocity[k] - e->velocity[k]));
+        }
+        int ok = a->step == e->step && a->sat_id == e->sat_id &&
+                 dp <= GOLDEN_POS_TOL && dv <= GOLDEN_VEL_TOL &&
+                 fabs(a->fuel - e->fuel) <= GOLDEN_FUEL_TOL &&
+                 a->formation == e->formation && a->strategy == e->strategy;
+        if (!ok) {
+            TEST_CHECK(0, "%s: 第 %u 步卫星 %d 轨迹偏离 (|Δr|=%.3e m, |Δv|=%.3e m/s, 编队 %d/%d, 策略 %d/%d)",
+                       label, e->step, e->sat_id, dp, dv, a->formation, e->formation, a->strategy, e->strategy);
+            break;
+        }
+    }
+
+    TEST_CHECK(expected->num_assignments == actual->num_assignments,
+               "%s: 分配记录数 %u != %u", label, actual->num_assignments, expected->num_assignments);
+    n = expected->num_assignments < actual->num_assignments ? expected->num_assignments : actual->num_assignments;
+    for (uint32_t i = 0; i < n; i++) {
+        const GoldenAssignment *e = &expected->assignments[i], *a = &actual->assignments[i];
+        if (memcmp(e, a, sizeof(GoldenAssignment)) != 0) {
+            TEST_CHECK(0, "%s: 第 %u 步卫星 %d 分配不一致 (目标 %d/%d, 策略 %d/%d, 编队 %d/%d)",
+                       label, e->step, e->sat_id, a->target_id, e->target_id,
+                       a->strategy, e->strategy, a->formation, e->formation);
+            break;
+        }
+    }
+    return test_failures == before ? 0 : -1;
+}
+
+/* ==================== 黄金文件读写 ==================== */
+
+static int golden_write(const char *path, const GoldenRun *run) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "错误：无法创建黄金文件 %s\n", path);
+        return -1;
+    }
+    GoldenHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GOLDEN_MAGIC, sizeof(header.magic));
+    header.version = GOLDEN_VERSION;
+    header.record_size = sizeof(SimOutputRecord);
+    header.assignment_size = sizeof(GoldenAssignment);
+    header.num_records = run->num_records;
+    header.num_assignments = run->num_assignments;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(run->records, sizeof(SimOutputRecord), run->num_records, file) == run->num_records &&
+             fwrite(run->assignments, sizeof(GoldenAssignment), run->num_assignments, file) == run->num_assignments;
+    if (fclose(file) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+static int golden_read(const char *path, GoldenRun *run) {
+    memset(run, 0, sizeof(GoldenRun));
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "错误：无法打开黄金文件 %s（可用 --update 生成）\n", path);
+        return -1;
+    }
+    GoldenHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, GOLDEN_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != GOLDEN_VERSION ||
+        header.record_size != sizeof(SimOutputRecord) ||
+        header.assignment_size != sizeof(GoldenAssignment)) {
+        fprintf(stderr, "错误：%s 格式或版本不匹配\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    run->records = (SimOutputRecord*)malloc(sizeof(SimOutputRecord) * (header.num_records + 1));
+    run->assignments = (GoldenAssignment*)malloc(sizeof(GoldenAssignment) * (header.num_assignments + 1));
+    int ok = run->records && run->assignments &&
+             fread(run->records, sizeof(SimOutputRecord), header.num_records, file) == header.num_records &&
+             fread(run->assignments, sizeof(GoldenAssignment), header.num_assignments, file) == header.num_assignments;
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "错误：%s 数据不完整\n", path);
+        golden_run_free(run);
+        return -1;
+    }
+    run->num_records = run->records_capacity = header.num_records;
+    run->num_assignments = run->assignments_capacity = header.num_assignments;
+    return 0;
+}
+
+/* ==================== 单项检查 ==================== */
+
+/* 决策层：arena 切分版本与堆分配版本的分组和博弈结果须完全一致 */
+static void golden_check_decision_arena(const GoldenScenario *gs) {
+    KinematicsEngine *engine = golden_create_engine(gs);
+    TEST_CHECK(engine != NULL, "%s: 引擎创建失败", gs->name);
+    if (!engine) return;
+    for (uint32_t s = 0; s < gs->steps / 2; s++) kinematics_engine_step(engine);
+
+    int n = engine->satellite_count, num_red = 0, num_blue = 0;
+    Satellite **red = (Satellite**)malloc(sizeof(Satellite*) * n);
+    Satellite **blue = (Satellite**)malloc(sizeof(Satellite*) * n);
+    for (int i = 0; red && blue && i < n; i++) {
+        Satellite *sat = engine->satellites[i];
+        if (sat->team == 0) red[num_red++] = sat;
+        else blue[num_blue++] = sat;
+    }
+
+    Arena arena;
+    arena_init(&arena, 0);
+    GroupResult *heap_groups = decision_tree_group_satellites(red, num_red, 3);
+    GroupResult *arena_groups = decision_tree_group_satellites_in(&arena, red, num_red, 3);
+    GameResult *heap_game = differential_game_assign_strategies(red, num_red, blue, num_blue, engine->strategy);
+    GameResult *arena_game = differential_game_assign_strategies_in(&arena, red, num_red, blue, num_blue, engine->strategy, 0.0);
+
+    TEST_CHECK(heap_groups && arena_groups && heap_game && arena_game, "%s: 决策结果为空", gs->name);
+    if (heap_groups && arena_groups && heap_game && arena_game) {
+        TEST_CHECK(heap_groups->num_groups == arena_groups->num_groups &&
+                   memcmp(heap_groups->group_ids, arena_groups->group_ids, sizeof(int) * num_red) == 0,
+                   "%s: arena分组与堆分组不一致", gs->name);
+        TEST_CHECK(memcmp(heap_game->target_assignments, arena_game->target_assignments, sizeof(int) * num_red) == 0 &&
+                   memcmp(heap_game->strategy_assignments, arena_game->strategy_assignments, sizeof(int) * num_red) == 0,
+                   "%s: arena博弈分配与堆分配不一致", gs->name);
+        TEST_CHECK(memcmp(heap_game->payoff_matrix, arena_game->payoff_matrix,
+                            sizeof(double) * num_red * num_blue) == 0,
+                   "%s: arena收益矩阵与堆收益矩阵不一致", gs->name);
+    }
+
+    if (heap_groups) decision_tree_free_result(heap_groups);
+    if (heap_game) differential_game_free_result(heap_game);
+    arena_destroy(&arena);
+    free(red);
+    free(blue);
+    kinematics_engine_destroy(engine);
+}
+
+/* 相对运动闭式解：近距离从星按链接外推，与独立RK4积分的偏差相对初始间距有界 */
+static void golden_check_relative_link(void) {
+    static const GoldenScenario gs = { "relative", { 1, 1, 1, 1, 0, 0, "GJ", 0, 0 }, 3, 360, 360, 1e9, PERTURB_NONE };
+    static const Vector3 offsets[] = { { 1000.0, 0.0, 0.0 }, { 0.0, 2000.0, 0.0 }, { 0.0, 0.0, 500.0 } };
+    const int chief_id = 1000;
+
+    KinematicsEngine *linked = golden_create_engine(&gs);
+    KinematicsEngine *integrated = golden_create_engine(&gs);
+    TEST_CHECK(linked && integrated, "relative: 引擎创建失败");
+    if (!linked || !integrated) {
+        kinematics_engine_destroy(linked);
+        kinematics_engine_destroy(integrated);
+        return;
+    }
+
+    // 主星保持默认的圆轨道初态，从星放到主星附近（同速度 + 偏移），两个引擎初始状态相同
+    KinematicsEngine *engines[2] = { linked, integrated };
+    for (int e = 0; e < 2; e++) {
+        Satellite *chief = kinematics_engine_get_satellite(engines[e], chief_id);
+        for (int d = 0; d < 3; d++) {
+            Satellite *deputy = kinematics_engine_get_satellite(engines[e], chief_id + 1 + d);
+            deputy->state = chief->state;
+            deputy->state.position = vector3_add(chief->state.position, offsets[d]);
+        }
+    }
+    for (int d = 0; d < 3; d++) {
+        TEST_CHECK(kinematics_engine_link_relative(linked, chief_id, chief_id + 1 + d) == 0,
+                   "relative: 链接从星 %d 失败", chief_id + 1 + d);
+    }
+    // 从星不能当主星、主星不能当从星；解除后重新链接（末尾链接移入空位）结果不变
+    TEST_CHECK(kinematics_engine_link_relative(linked, chief_id + 1, chief_id + 2) != 0,
+               "relative: 从星被接受为主星");
+    TEST_CHECK(kinematics_engine_unlink_relative(linked, chief_id + 1) == 0 &&
+               kinematics_engine_link_relative(linked, chief_id + 1, chief_id) != 0 &&
+               kinematics_engine_link_relative(linked, chief_id, chief_id + 1) == 0 &&
+               linked->num_relative_links == 3,
+               "relative: 主星被接受为从星或重新链接失败");
+
+    for (uint32_t s = 0; s < gs.steps; s++) {
+        kinematics_engine_step(linked);
+        kinematics_engine_step(integrated);
+    }
+
+    for (int d = 0; d < 3; d++) {
+        int id = chief_id + 1 + d;
+        Satellite *a = kinematics_engine_get_satellite(linked, id);
+        Satellite *b = kinematics_engine_get_satellite(integrated, id);
+        double err = vector3_distance(a->state.position, b->state.position);
+        double separation = vector3_magnitude(offsets[d]);
+        TEST_CHECK(err <= GOLDEN_REL_POS_TOL * separation,
+                   "relative: 从星 %d 闭式解偏离积分解 %.3f m（间距 %.0f m）", id, err, separation);
+    }
+
+    kinematics_engine_destroy(linked);
+    kinematics_engine_destroy(integrated);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(int argc, char *argv[]) {
+    int update = 0;
+    const char *dir = GOLDEN_DEFAULT_DIR;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = 1;
+        } else {
+            dir = argv[i];
+        }
+    }
+    sim_log_set_quiet(1);
+    vector3_soa_set_isa(VECTOR3_SOA_ISA_SCALAR);
+
+    for (int s = 0; s < GOLDEN_NUM_SCENARIOS; s++) {
+        const GoldenScenario *gs = &GOLDEN_SCENARIOS[s];
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.bin", dir, gs->name);
+        printf("[Golden] 场景 %s (%d 红 / %d 蓝, %u 步)\n", gs->name,
+               gs->scenario.red_attack + gs->scenario.red_recon + gs->scenario.red_defense,
+               gs->scenario.blue_attack + gs->scenario.blue_recon + gs->scenario.blue_defense, gs->steps);
+
+        GoldenRun scalar;
+        memset(&scalar, 0, sizeof(scalar));
+        int status = golden_path_scalar(gs, &scalar);
+        TEST_CHECK(status == 0, "%s: 标量路径运行失败", gs->name);
+        if (status != 0) {
+            golden_run_free(&scalar);
+            continue;
+        }
+
+        if (update) {
+            TEST_CHECK(golden_write(path, &scalar) == 0, "%s: 写入黄金文件失败", gs->name);
+            printf("[Golden] ✓ 已更新 %s (%u 条轨迹采样, %u 条分配)\n", path, scalar.num_records, scalar.num_assignments);
+            golden_run_free(&scalar);
+            continue;
+        }
+
+        GoldenRun golden;
+        if (golden_read(path, &golden) == 0) {
+            if (golden_compare_runs("scalar vs golden", &golden, &scalar) == 0) {
+                printf("[Golden] ✓ scalar 与黄金文件一致\n");
+            }
+            golden_run_free(&golden);
+        } else {
+            test_failures++;
+        }
+
+        for (int p = 0; p < GOLDEN_NUM_PATHS; p++) {
+            GoldenRun run;
+            memset(&run, 0, sizeof(run));
+            char label[64];
+            snprintf(label, sizeof(label), "%s vs scalar", GOLDEN_PATHS[p].name);
+            if (GOLDEN_PATHS[p].run(gs, &run) != 0) {
+                TEST_CHECK(0, "%s: %s 路径运行失败", gs->name, GOLDEN_PATHS[p].name);
+            } else if (golden_compare_runs(label, &scalar, &run) == 0) {
+                printf("[Golden] ✓ %s 与标量路径一致\n", GOLDEN_PATHS[p].name);
+            }
+            golden_run_free(&run);
+        }
+
+        int before = test_failures;
+        golden_check_decision_arena(gs);
+        if (test_failures == before) printf("[Golden] ✓ arena决策与堆分配决策一致\n");
+        golden_run_free(&scalar);
+    }
+
+    if (!update) {
+        int before = test_failures;
+        golden_check_relative_link();
+        if (test_failures == before) printf("[Golden] ✓ 相对运动闭式解与RK4积分一致（误差 ≤ %.1f%% 间距）\n",
+                                            GOLDEN_REL_POS_TOL * 100);
+    }
+
+    return test_summary("Golden");
+}
@@ -0,0 +1,135 @@
+/* 轨迹历史测试：跨层导出和冷层压缩逐位无损，序列化往返后导出不变
+ *
+ * 用法: test_history
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <history.h>
+#include <arena.h>
+#include <constants.h>
+#include <rng.h>
+
+#include "test_common.h"
+
+#define TEST_NUM_SAMPLES    5000        // 追加样本数（远超各层窗口，冷层块环已回绕）
+#define TEST_DT             10.0        // 样本间隔 (秒)，时刻为整数倍，可按时刻反查序号
+
+/* 带噪声的圆轨道样本：尾数位随机，压缩编码不能靠巧合命中 */
+static void test_make_samples(HistorySample *samples, int n) {
+    Rng rng;
+    rng_seed(&rng, 20261018);
+    double r = 42164e3, w = sqrt(MU_SI / (r * r * r));
+    for (int i = 0; i < n; i++) {
+        double t = i * TEST_DT, c = cos(w * t), s = sin(w * t);
+        samples[i].time = t;
+        samples[i].position = (Vector3){ r * c + rng_uniform(&rng), r * s + rng_uniform(&rng), rng_uniform(&rng) };
+        samples[i].velocity = (Vector3){ -r * w * s, r * w * c, 1e-3 * rng_uniform(&rng) };
+        samples[i].formation = (i / 700) % 5;
+    }
+}
+
+/* 逐字段逐位比较（结构尾部填充不参与） */
+static int test_same_sample(const HistorySample *a, const HistorySample *b) {
+    return memcmp(&a->time, &b->time, sizeof(double)) == 0 &&
+           memcmp(&a->position, &b->position, sizeof(Vector3)) == 0 &&
+           memcmp(&a->velocity, &b->velocity, sizeof(Vector3)) == 0 &&
+           a->formation == b->formation;
+}
+
+/**
+ * 导出结果逐位等于原样本：时刻严格递增，覆盖冷层、中间层和第0层，最新样本在末尾
+ */
+static void test_check_collect(const TrajectoryHistory *history, const HistorySample *samples,
+                               const char *label) {
+    int n = history_collect(history, NULL, 0);
+    HistorySample *out = (HistorySample*)malloc(sizeof(HistorySample) * (n > 0 ? n : 1));
+    TEST_CHECK(out && n > 0, "%s: 导出为空", label);
+    if (!out || n <= 0) {
+        free(out);
+        return;
+    }
+    TEST_CHECK(history_collect(history, out, n) == n, "%s: 导出数与计数不一致", label);
+
+    uint32_t coarsest = history->config.decimation[history->config.num_tiers - 1];
+    int from_cold = 0, mismatched = 0;
+    for (int i = 0; i < n; i++) {
+        int index = (int)(out[i].time / TEST_DT);
+        if (index < 0 || index >= TEST_NUM_SAMPLES || (i > 0 && out[i].time <= out[i - 1].time) ||
+            !test_same_sample(&out[i], &samples[index])) {
+            mismatched++;
+            continue;
+        }
+        if (index < TEST_NUM_SAMPLES - (int)(history->config.capacity[1] * history->config.decimation[1]) &&
+            index % coarsest == 0) {
+            from_cold++;
+        }
+    }
+    TEST_CHECK(mismatched == 0, "%s: %d / %d 个导出样本与原样本不一致或乱序", label, mismatched, n);
+    TEST_CHECK(from_cold > 0, "%s: 导出中没有冷层样本", label);
+    TEST_CHECK(out[n - 1].time == samples[TEST_NUM_SAMPLES - 1].time, "%s: 最新样本不在末尾", label);
+    free(out);
+}
+
+static void test_check_round_trip(SlabAllocator *allocator, const char *label) {
+    HistorySample *samples = (HistorySample*)malloc(sizeof(HistorySample) * TEST_NUM_SAMPLES);
+    TEST_CHECK(samples, "%s: 内存分配失败", label);
+    if (!samples) return;
+    test_make_samples(samples, TEST_NUM_SAMPLES);
+
+    // 小窗口让样本跨越全部层：第0层 64、第1层 32×4、冷层 160×16（块环回绕）
+    HistoryConfig config;
+    memset(&config, 0, sizeof(config));
+    config.num_tiers = 3;
+    config.capacity[0] = 64;  config.decimation[0] = 1;
+    config.capacity[1] = 32;  config.decimation[1] = 4;
+    config.capacity[2] = 160; config.decimation[2] = 16;
+    config.compress_cold = 1;
+    config.block_samples = 16;
+
+    TrajectoryHistory *history = history_create(&config, allocator);
+    TEST_CHECK(history, "%s: 创建失败", label);
+    if (!history) {
+        free(samples);
+        return;
+    }
+    int failed = 0;
+    for (int i = 0; i < TEST_NUM_SAMPLES; i++) failed += history_append(history, &samples[i]) != 0;
+    TEST_CHECK(failed == 0 && history->cold.count == history->cold.max_blocks && history->cold.staging_count > 0,
+               "%s: 冷层块环未满或暂存区为空 (%u / %u 块，暂存 %u)", label,
+               history->cold.count, history->cold.max_blocks, history->cold.staging_count);
+    test_check_collect(history, samples, label);
+
+    size_t size = history_serialize(history, NULL);
+    uint8_t *bytes = (uint8_t*)malloc(size);
+    TrajectoryHistory *restored = NULL;
+    if (bytes && history_serialize(history, bytes) == size) {
+        restored = history_deserialize(bytes, size, allocator);
+    }
+    TEST_CHECK(restored, "%s: 序列化往返失败", label);
+    if (restored) {
+        test_check_collect(restored, samples, label);
+        TEST_CHECK(history_memory_bytes(restored) == history_memory_bytes(history),
+                   "%s: 往返后占用内存 %zu != %zu", label,
+                   history_memory_bytes(restored), history_memory_bytes(history));
+    }
+
+    history_destroy(restored);
+    history_destroy(history);
+    free(bytes);
+    free(samples);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    SlabAllocator slab;
+    slab_init(&slab, 0);
+    TEST_RUN("History", test_check_round_trip(NULL, "heap"), "系统堆：跨层导出与冷层压缩逐位无损，序列化往返一致");
+    TEST_RUN("History", test_check_round_trip(&slab, "slab"), "slab：跨层导出与冷层压缩逐位无损，序列化往返一致");
+    slab_destroy(&slab);
+    return test_summary("History");
+}
@@ -0,0 +1,204 @@
+/* 批量内核测试：SoA向量内核、轨道批量内核在本机支持的各指令集下与标量版逐位一致
+ *
+ * 用法: test_kernels
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <kinematics.h>
+#include <rng.h>
+#include <log.h>
+#include <vector3_soa.h>
+
+#include "test_common.h"
+
+#define TEST_SOA_COUNT          1027        // SoA内核比对的向量数（含非整倍数尾部）
+#define TEST_ORBIT_STEPS        10          // 轨道批量内核比对的积分步数
+
+/* ==================== 向量内核 ==================== */
+
+/* SoA内核：本机支持的每种指令集与标量版逐位一致 */
+static void test_check_soa_kernels(void) {
+    const int n = TEST_SOA_COUNT;
+    Vector3SoA a, b, centers, ref, out;
+    vector3_soa_init(&a, n);
+    vector3_soa_init(&b, n);
+    vector3_soa_init(&centers, 5);
+    vector3_soa_init(&ref, n);
+    vector3_soa_init(&out, n);
+    double *ref_s = (double*)malloc(sizeof(double) * n);
+    double *out_s = (double*)malloc(sizeof(double) * n);
+    int *ref_i = (int*)malloc(sizeof(int) * n);
+    int *out_i = (int*)malloc(sizeof(int) * n);
+    TEST_CHECK(ref_s && out_s && ref_i && out_i, "soa: 内存分配失败");
+    if (!ref_s || !out_s || !ref_i || !out_i) goto cleanup;
+
+    Rng rng;
+    rng_seed(&rng, 2024);
+    for (int i = 0; i < n; i++) {
+        Vector3 p = { rng_uniform_range(&rng, -5e7, 5e7), rng_uniform_range(&rng, -5e7, 5e7), rng_uniform_range(&rng, -1e6, 1e6) };
+        Vector3 q = { rng_uniform_range(&rng, -4e3, 4e3), rng_uniform_range(&rng, -4e3, 4e3), rng_uniform_range(&rng, -4e3, 4e3) };
+        vector3_soa_push(&a, (i % 97 == 0) ? vector3_zero() : p);   // 混入零向量
+        vector3_soa_push(&b, q);
+    }
+    for (int k = 0; k < 5; k++) vector3_soa_push(&centers, vector3_soa_get(&a, k * 200 + 1));
+    Matrix3x3 m = matrix3x3_rotation(vector3_normalize((Vector3){ 1, 2, 3 }), 0.7);
+    Vector3 p0 = vector3_soa_get(&a, 5);
+
+#define TEST_SOA_SAME(x, y, count, what) \
+    TEST_CHECK(memcmp((x), (y), sizeof(*(x)) * (count)) == 0, "soa: %s 的 %s 与标量不一致", \
+               vector3_soa_isa_name(isa), what)
+
+    Vector3SoAIsa best = vector3_soa_detect_isa();
+    for (Vector3SoAIsa isa = VECTOR3_SOA_ISA_SSE2; isa <= best; isa++) {
+        struct { const char *what; int kind; } cases[] = {
+            { "norm", 0 }, { "distance_to", 1 }, { "distance", 2 }, { "dot", 3 },
+            { "cross", 4 }, { "normalize", 5 }, { "matrix_multiply", 6 }, { "nearest", 7 }
+        };
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            for (int pass = 0; pass < 2; pass++) {
+                vector3_soa_set_isa(pass == 0 ? VECTOR3_SOA_ISA_SCALAR : isa);
+                double *s = pass == 0 ? ref_s : out_s;
+                int *assign = pass == 0 ? ref_i : out_i;
+                Vector3SoA *v = pass == 0 ? &ref : &out;
+                switch (cases[c].kind) {
+                    case 0: vector3_soa_norm(&a, s); break;
+                    case 1: vector3_soa_distance_to(&a, p0, s); break;
+                    case 2: vector3_soa_distance(&a, &b, s); break;
+                    case 3: vector3_soa_dot(&a, &b, s); break;
+                    case 4: vector3_soa_cross(&a, &b, v); break;
+                    case 5: vector3_soa_normalize(&a, v); break;
+                    case 6: vector3_soa_matrix_multiply(m, &a, v); break;
+                    case 7: vector3_soa_nearest(&a, &centers, assign, s); break;
+                }
+            }
+            if (cases[c].kind >= 4 && cases[c].kind <= 6) {
+                TEST_SOA_SAME(ref.x, out.x, n, cases[c].what);
+                TEST_SOA_SAME(ref.y, out.y, n, cases[c].what);
+                TEST_SOA_SAME(ref.z, out.z, n, cases[c].what);
+            } else {
+                TEST_SOA_SAME(ref_s, out_s, n, cases[c].what);
+                if (cases[c].kind == 7) TEST_SOA_SAME(ref_i, out_i, n, cases[c].what);
+            }
+        }
+    }
+#undef TEST_SOA_SAME
+
+    // 标量版与 vector3.h 单向量版一致
+    vector3_soa_set_isa(VECTOR3_SOA_ISA_SCALAR);
+    vector3_soa_distance_to(&a, p0, ref_s);
+    vector3_soa_normalize(&a, &ref);
+    for (int i = 0; i < n; i++) {
+        Vector3 v = vector3_soa_get(&a, i);
+        Vector3 u = vector3_normalize(v);
+        TEST_CHECK(ref_s[i] == vector3_distance(v, p0) &&
+                   ref.x[i] == u.x && ref.y[i] == u.y && ref.z[i] == u.z,
+                   "soa: 第 %d 个向量与 vector3.h 结果不一致", i);
+        if (test_failures > 0) break;
+    }
+
+cleanup:
+    free(ref_s);
+    free(out_s);
+    free(ref_i);
+    free(out_i);
+    vector3_soa_free(&a);
+    vector3_soa_free(&b);
+    vector3_soa_free(&centers);
+    vector3_soa_free(&ref);
+    vector3_soa_free(&out);
+}
+
+/* ==================== 轨道批量内核 ==================== */
+
+/* 轨道批量内核：每种指令集逐颗与 orbit_rk4_step_perturbed 逐位一致，批量Kepler与 orbit_solve_kepler_equation 一致 */
+static void test_check_orbit_kernels(void) {
+    const int n = TEST_SOA_COUNT;
+    Vector3SoA pos, vel;
+    vector3_soa_init(&pos, n);
+    vector3_soa_init(&vel, n);
+    StateVector *states = (StateVector*)malloc(sizeof(StateVector) * n);
+    double *M = (double*)malloc(sizeof(double) * n);
+    double *e = (double*)malloc(sizeof(double) * n);
+    double *E = (double*)malloc(sizeof(double) * n);
+    PerturbationModel model;
+    int model_ok = perturbation_model_init(&model, PERTURB_NONE, 0, 3600.0) == 0;
+    TEST_CHECK(states && M && e && E && model_ok, "orbit: 初始化失败");
+    if (!states || !M || !e || !E || !model_ok) goto cleanup;
+
+    Rng rng;
+    rng_seed(&rng, 2025);
+    for (int i = 0; i < n; i++) {
+        Vector3 r = vector3_normalize((Vector3){ rng_uniform_range(&rng, -1, 1), rng_uniform_range(&rng, -1, 1),
+                                                 rng_uniform_range(&rng, -1, 1) });
+        Vector3 t = vector3_normalize(vector3_cross(r, (Vector3){ 0, 0, 1 }));
+        double radius = rng_uniform_range(&rng, 6.7e6, 4.3e7);
+        states[i].position = (i % 97 == 0) ? vector3_zero() : vector3_scale(r, radius);   // 混入零位置
+        states[i].velocity = vector3_scale(t, sqrt(MU_SI / radius) * rng_uniform_range(&rng, 0.9, 1.1));
+        states[i].time = 0;
+        M[i] = rng_uniform_range(&rng, 0, 2 * PI);
+        e[i] = (i % 50 == 0) ? 0.0 : rng_uniform_range(&rng, 0, 0.95);
+    }
+
+    Vector3SoAIsa best = vector3_soa_detect_isa();
+    for (Vector3SoAIsa isa = VECTOR3_SOA_ISA_SCALAR; isa <= best; isa++) {
+        vector3_soa_set_isa(isa);
+        for (int mode = 0; mode < 3; mode++) {
+            const PerturbationModel *m = (mode == 0) ? NULL : &model;
+            perturbation_model_enable(&model, PERTURB_J2, mode == 2);
+            pos.count = vel.count = 0;
+            for (int i = 0; i < n; i++) {
+                vector3_soa_push(&pos, states[i].position);
+                vector3_soa_push(&vel, states[i].velocity);
+            }
+            int same = 1;
+            for (int step = 0; step < TEST_ORBIT_STEPS && same; step++) {
+                same = orbit_batch_rk4_step(&pos, &vel, 10.0, m) == 0;
+                TEST_CHECK(same, "orbit: %s 批量积分失败", vector3_soa_isa_name(isa));
+            }
+            // 逐颗参考：同样积分
+            for (int i = 0; i < n && same; i++) {
+                StateVector s = states[i];
+                for (int step = 0; step < TEST_ORBIT_STEPS; step++) orbit_rk4_step_perturbed(&s, 10.0, m);
+                Vector3 p = vector3_soa_get(&pos, i), v = vector3_soa_get(&vel, i);
+                same = memcmp(&p, &s.position, sizeof(Vector3)) == 0 && memcmp(&v, &s.velocity, sizeof(Vector3)) == 0;
+                TEST_CHECK(same, "orbit: %s 模型%d 第 %d 颗卫星的批量RK4与逐颗积分不一致",
+                           vector3_soa_isa_name(isa), mode, i);
+            }
+        }
+
+        orbit_batch_solve_kepler(M, e, E, n, 1e-12);
+        for (int i = 0; i < n; i++) {
+            double ref = orbit_solve_kepler_equation(M[i], e[i], 1e-12);
+            TEST_CHECK(memcmp(&ref, &E[i], sizeof(double)) == 0, "orbit: %s 第 %d 个Kepler解不一致",
+                       vector3_soa_isa_name(isa), i);
+            if (test_failures > 0) break;
+        }
+        if (test_failures > 0) break;
+    }
+    vector3_soa_set_isa(VECTOR3_SOA_ISA_SCALAR);
+
+cleanup:
+    if (model_ok) perturbation_model_free(&model);
+    free(states);
+    free(M);
+    free(e);
+    free(E);
+    vector3_soa_free(&pos);
+    vector3_soa_free(&vel);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    sim_log_set_quiet(1);
+    const char *best = vector3_soa_isa_name(vector3_soa_detect_isa());
+    TEST_RUN("Kernels", test_check_soa_kernels(), "SoA内核 %s 及以下指令集与标量版逐位一致", best);
+    TEST_RUN("Kernels", test_check_orbit_kernels(), "轨道批量内核 %s 及以下指令集与逐颗积分逐位一致", best);
+    return test_summary("Kernels");
+}
@@ -0,0 +1,140 @@
+/* 近距告警测试：网格候选 + 滞回分带与逐对暴力计算一致，事件缓冲满时按计数丢弃
+ *
+ * 用法: test_proximity
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <proximity.h>
+#include <constants.h>
+#include <vector3.h>
+#include <rng.h>
+
+#include "test_common.h"
+
+/* 暴力参照：按半径升序逐圈判断，滞回规则同 proximity.h（向内按阈值、向外超出 1+h 倍） */
+static int test_zone_next(const StrategyThresholds *t, int zone, double d_km) {
+    int km[PROXIMITY_ZONE_NONE] = { t->critical_distance, t->inspect_distance, t->attack_distance,
+                                    t->defense_distance, t->warning_distance };
+    int order[PROXIMITY_ZONE_NONE + 1], k = 0, b = -1;
+    for (int z = 0; z < PROXIMITY_ZONE_NONE; z++) {
+        if (km[z] <= 0) continue;
+        int j = k++;
+        while (j > 0 && km[order[j - 1]] > km[z]) { order[j] = order[j - 1]; j--; }
+        order[j] = z;
+    }
+    order[k] = PROXIMITY_ZONE_NONE;
+    for (int j = 0; j <= k; j++) if (order[j] == zone) b = j;
+    if (b < 0) b = k;
+    while (b > 0 && d_km * 1000.0 < km[order[b - 1]] * 1000.0) b--;
+    while (b < k && d_km * 1000.0 >= km[order[b]] * 1000.0 * (1.0 + PROXIMITY_HYSTERESIS)) b++;
+    return order[b];
+}
+
+static void test_check_proximity(void) {
+    enum { NR = 40, NB = 40, STEPS = 240 };
+    Satellite *fleet = (Satellite*)calloc(NR + NB, sizeof(Satellite));
+    Satellite *sats[NR + NB];
+    uint8_t (*ref)[NB] = (uint8_t(*)[NB])malloc(sizeof(uint8_t[NR][NB]));
+    ProximityMonitor *monitor = proximity_monitor_create(0);
+    ProximityMonitor *small = proximity_monitor_create(8);
+    TEST_CHECK(fleet && ref && monitor && small, "proximity: 分配失败");
+    if (!fleet || !ref || !monitor || !small) {
+        free(fleet);
+        free(ref);
+        proximity_monitor_destroy(monitor);
+        proximity_monitor_destroy(small);
+        return;
+    }
+    memset(ref, PROXIMITY_ZONE_NONE, sizeof(uint8_t[NR][NB]));
+
+    // 随机游走：阈值量级的盒子内每步数百公里，频繁跨带并在阈值附近来回
+    Rng rng;
+    rng_seed(&rng, 50);
+    for (int k = 0; k < NR + NB; k++) {
+        fleet[k].id = 7000 + k;
+        fleet[k].team = k < NR ? 0 : 1;
+        fleet[k].state.position = (Vector3){ rng_uniform_range(&rng, -1.2e7, 1.2e7),
+                                             rng_uniform_range(&rng, -1.2e7, 1.2e7),
+                                             rng_uniform_range(&rng, -3e6, 3e6) };
+        sats[k] = &fleet[k];
+    }
+    StrategyThresholds t = { (int)ATTACK_DISTANCE, (int)INSPECT_DISTANCE, (int)DEFENSE_DISTANCE,
+                             (int)CRITICAL_DISTANCE, (int)WARNING_DISTANCE };
+    uint64_t mismatches = 0, transitions = 0, small_polled = 0;
+    for (int step = 0; step < STEPS; step++) {
+        if (step == STEPS / 2) {
+            // 模拟参数重载：阈值顺序改变、停用一圈
+            t.critical_distance = 0;
+            t.inspect_distance = 3500;
+            t.warning_distance = 6000;
+        }
+        if (step == STEPS * 3 / 4) sats[NR + 3] = NULL;      // 移除一颗蓝星
+        for (int k = 0; k < NR + NB; k++) {
+            fleet[k].state.position.x += rng_uniform_range(&rng, -3e5, 3e5);
+            fleet[k].state.position.y += rng_uniform_range(&rng, -3e5, 3e5);
+            fleet[k].state.position.z += rng_uniform_range(&rng, -1e5, 1e5);
+        }
+
+        uint8_t next[NR][NB];
+        int expected = 0;
+        for (int r = 0; r < NR; r++) {
+            for (int b = 0; b < NB; b++) {
+                if (!sats[NR + b]) {
+                    next[r][b] = PROXIMITY_ZONE_NONE;
+                } else {
+                    double d = vector3_distance(fleet[r].state.position, fleet[NR + b].state.position) / 1000.0;
+                    next[r][b] = (uint8_t)test_zone_next(&t, ref[r][b], d);
+                }
+                expected += next[r][b] != ref[r][b];
+            }
+        }
+
+        int produced = proximity_monitor_update(monitor, sats, NR + NB, &t, step * 10.0);
+        proximity_monitor_update(small, sats, NR + NB, &t, step * 10.0);
+        ProximityEvent events[NR * NB];
+        int n = proximity_monitor_poll(monitor, events, NR * NB);
+        if (step % 16 == 0) {
+            ProximityEvent drained[8];
+            small_polled += proximity_monitor_poll(small, drained, 8);
+        }
+        if (produced != expected || n != expected) mismatches++;
+        for (int k = 0; k < n; k++) {
+            const ProximityEvent *e = &events[k];
+            int r = e->red_id - 7000, b = e->blue_id - 7000 - NR;
+            int ok = r >= 0 && r < NR && b >= 0 && b < NB && e->from == ref[r][b] && e->to == next[r][b] &&
+                     e->time == step * 10.0 && (sats[NR + b] ? e->distance >= 0 : e->distance == -1.0);
+            if (!ok) mismatches++;
+        }
+        for (int r = 0; r < NR; r++) {
+            for (int b = 0; b < NB; b++) {
+                if (proximity_monitor_zone(monitor, 7000 + r, 7000 + NR + b) != next[r][b]) mismatches++;
+            }
+        }
+        memcpy(ref, next, sizeof(next));
+        transitions += (uint64_t)expected;
+    }
+    TEST_CHECK(mismatches == 0 && transitions > 1000, "proximity: 网格候选 + 滞回分带与暴力参照不一致（%llu 处，%llu 次跨带）",
+               (unsigned long long)mismatches, (unsigned long long)transitions);
+    ProximityEvent drained[8];
+    int rest;
+    while ((rest = proximity_monitor_poll(small, drained, 8)) > 0) small_polled += (uint64_t)rest;
+    TEST_CHECK(small->total_events == transitions && small->dropped > 0 &&
+               small_polled + small->dropped == transitions,
+               "proximity: 事件缓冲满时丢弃计数不正确");
+
+    proximity_monitor_destroy(monitor);
+    proximity_monitor_destroy(small);
+    free(ref);
+    free(fleet);
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    TEST_RUN("Proximity", test_check_proximity(), "近距告警网格候选 + 滞回分带与逐对暴力计算一致，缓冲满时按计数丢弃");
+    return test_summary("Proximity");
+}
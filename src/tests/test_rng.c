@@ -0,0 +1,91 @@
+/* 随机数测试：Philox4x32-10 与 Random123 已知答案向量一致，xoshiro256** 与参考实现一致，
+ * 批量生成与逐块生成逐位一致
+ *
+ * 用法: test_rng
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rng.h>
+
+#include "test_common.h"
+
+#define TEST_FILL_COUNT     1001        // 批量生成比对的个数（含非整块尾部）
+#define TEST_FLEET_COUNT    37          // 舰队批量生成比对的卫星数
+
+/* ==================== Philox4x32-10 ==================== */
+
+/* Random123 kat_vectors 中的 philox4x32 10 轮向量：计数器、密钥、输出 */
+static const uint32_t PHILOX_KAT[][10] = {
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+      0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+      0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+    { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+      0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 },
+};
+
+static void test_check_philox_kat(void) {
+    for (size_t v = 0; v < sizeof(PHILOX_KAT) / sizeof(PHILOX_KAT[0]); v++) {
+        uint32_t out[4];
+        rng_philox4x32(&PHILOX_KAT[v][0], &PHILOX_KAT[v][4], out);
+        TEST_CHECK(memcmp(out, &PHILOX_KAT[v][6], sizeof(out)) == 0,
+                   "philox: 第 %zu 组向量输出 %08x %08x %08x %08x", v, out[0], out[1], out[2], out[3]);
+    }
+}
+
+/* 批量接口与逐块 rng_philox_uniform2 逐位一致 */
+static void test_check_philox_batch(void) {
+    const uint64_t seed = 0x0123456789abcdefULL;
+    double *fill = (double*)malloc(sizeof(double) * TEST_FILL_COUNT);
+    TEST_CHECK(fill, "philox: 内存分配失败");
+    if (!fill) return;
+
+    // 起始块号和个数都不是 RNG_PHILOX_LANES 的整倍数
+    const uint64_t first = 5;
+    rng_philox_fill_uniform(seed, 1001, RNG_STREAM_SENSOR, first, fill, TEST_FILL_COUNT);
+    int same = 1;
+    for (int k = 0; k < TEST_FILL_COUNT && same; k++) {
+        double pair[2];
+        rng_philox_uniform2(seed, 1001, RNG_STREAM_SENSOR, first + (uint64_t)(k / 2), pair);
+        same = memcmp(&fill[k], &pair[k % 2], sizeof(double)) == 0 && fill[k] >= 0.0 && fill[k] < 1.0;
+    }
+    TEST_CHECK(same, "philox: rng_philox_fill_uniform 与逐块生成不一致");
+    free(fill);
+
+    uint32_t ids[TEST_FLEET_COUNT];
+    double fleet[2 * TEST_FLEET_COUNT];
+    for (int k = 0; k < TEST_FLEET_COUNT; k++) ids[k] = 1000u + 7u * (uint32_t)k;
+    rng_philox_fill_fleet(seed, ids, TEST_FLEET_COUNT, RNG_STREAM_INIT_POSITION, 3, fleet);
+    same = 1;
+    for (int k = 0; k < TEST_FLEET_COUNT && same; k++) {
+        double pair[2];
+        rng_philox_uniform2(seed, ids[k], RNG_STREAM_INIT_POSITION, 3, pair);
+        same = memcmp(&fleet[2 * k], pair, sizeof(pair)) == 0;
+    }
+    TEST_CHECK(same, "philox: rng_philox_fill_fleet 与逐颗生成不一致");
+}
+
+/* ==================== xoshiro256** ==================== */
+
+/* 状态 {1, 2, 3, 4} 时参考实现的前四个输出 */
+static void test_check_xoshiro(void) {
+    static const uint64_t expected[4] = { 11520ULL, 0ULL, 1509978240ULL, 1215971899390074240ULL };
+    Rng rng = { { 1, 2, 3, 4 } };
+    for (int k = 0; k < 4; k++) {
+        uint64_t x = rng_next_u64(&rng);
+        TEST_CHECK(x == expected[k], "xoshiro: 第 %d 个输出 %llu，应为 %llu", k,
+                   (unsigned long long)x, (unsigned long long)expected[k]);
+    }
+}
+
+/* ==================== 主程序 ==================== */
+
+int main(void) {
+    TEST_RUN("Rng", test_check_philox_kat(), "Philox4x32-10 与 Random123 已知答案向量一致");
+    TEST_RUN("Rng", test_check_philox_batch(), "Philox 批量生成与逐块生成逐位一致");
+    TEST_RUN("Rng", test_check_xoshiro(), "xoshiro256** 与参考实现输出一致");
+    return test_summary("Rng");
+}
@@ -0,0 +1,131 @@
+#define _DEFAULT_SOURCE
+
+#include <thread_pool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/* ==================== 工作线程 ==================== */
+
+static void* thread_pool_worker(void *arg) {
+    ThreadPool *pool = (ThreadPool*)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->head && !pool->shutdown) {
+            pthread_cond_wait(&pool->job_ready, &pool->lock);
+        }
+        if (!pool->head && pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+
+        ThreadPoolJob *job = pool->head;
+        pool->head = job->next;
+        if (!pool->head) pool->tail = NULL;
+        pthread_mutex_unlock(&pool->lock);
+
+        job->fn(job->arg);
+        free(job);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->all_done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+/* ==================== 公开接口实现 ==================== */
+
+int thread_pool_cpu_count(void) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    return (ncpu > 0) ? (int)ncpu : 1;
+}
+
+ThreadPool* thread_pool_create(int num_threads) {
+    if (num_threads <= 0) num_threads = thread_pool_cpu_count();
+    if (num_threads > THREAD_POOL_MAX_THREADS) num_threads = THREAD_POOL_MAX_THREADS;
+
+    ThreadPool *pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+
+    pool->threads = (pthread_t*)calloc(num_threads, sizeof(pthread_t));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->job_ready, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, thread_pool_worker, pool) != 0) {
+            fprintf(stderr, "错误：无法创建工作线程 %d\n", i);
+            break;
+        }
+        pool->num_threads++;
+    }
+
+    if (pool->num_threads == 0) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int thread_pool_submit(ThreadPool *pool, thread_pool_task fn, void *arg) {
+    if (!pool || !fn) return -1;
+
+    ThreadPoolJob *job = (ThreadPoolJob*)malloc(sizeof(ThreadPoolJob));
+    if (!job) return -1;
+    job->fn = fn;
+    job->arg = arg;
+    job->next = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->shutdown) {
+        pthread_mutex_unlock(&pool->lock);
+        free(job);
+        return -1;
+    }
+    if (pool->tail) pool->tail->next = job;
+    else pool->head = job;
+    pool->tail = job;
+    pool->pending++;
+    pthread_cond_signal(&pool->job_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+void thread_pool_wait(ThreadPool *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->job_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->job_ready);
+    pthread_cond_destroy(&pool->all_done);
+    free(pool->threads);
+    free(pool);
+}
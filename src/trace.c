@@ -0,0 +1,161 @@
+#include <trace.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static _Atomic(TraceBuffer*) trace_buffers = NULL;   // 所有线程的缓冲（只增不删）
+static atomic_int trace_active = 0;
+static atomic_int trace_next_tid = 1;
+static uint64_t trace_origin_ns = 0;
+
+static atomic_uint trace_generation = 1;           // trace_shutdown 每次加一
+
+static _Thread_local TraceBuffer *trace_local = NULL;
+static _Thread_local unsigned trace_local_generation = 0;
+
+/* ==================== 内部函数 ==================== */
+
+/* 当前线程的缓冲，首次使用时创建并以CAS挂入全局链表；
+ * 代数与全局不符说明缓冲已被 trace_shutdown 释放，不再解引用而是重建 */
+static TraceBuffer* trace_local_buffer(void) {
+    unsigned generation = atomic_load_explicit(&trace_generation, memory_order_acquire);
+    if (trace_local && trace_local_generation == generation) return trace_local;
+
+    TraceBuffer *buffer = (TraceBuffer*)calloc(1, sizeof(TraceBuffer));
+    if (!buffer) return NULL;
+    buffer->tid = atomic_fetch_add(&trace_next_tid, 1);
+    snprintf(buffer->name, sizeof(buffer->name), "thread-%d", buffer->tid);
+
+    TraceBuffer *head = atomic_load(&trace_buffers);
+    do {
+        buffer->next = head;
+    } while (!atomic_compare_exchange_weak(&trace_buffers, &head, buffer));
+
+    trace_local = buffer;
+    trace_local_generation = generation;
+    return buffer;
+}
+
+static void trace_free_chunks(TraceBuffer *buffer) {
+    TraceChunk *chunk = buffer->head;
+    while (chunk) {
+        TraceChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    buffer->head = NULL;
+    buffer->tail = NULL;
+}
+
+/* ==================== 接口实现 ==================== */
+
+void trace_start(void) {
+    for (TraceBuffer *b = atomic_load(&trace_buffers); b; b = b->next) {
+        trace_free_chunks(b);
+    }
+    trace_origin_ns = profiler_now_ns();
+    atomic_store(&trace_active, 1);
+}
+
+void trace_stop(void) {
+    atomic_store(&trace_active, 0);
+}
+
+int trace_is_active(void) {
+    return atomic_load_explicit(&trace_active, memory_order_relaxed);
+}
+
+void trace_record(ProfPhase phase, uint64_t start_ns, uint64_t end_ns) {
+    if (!atomic_load_explicit(&trace_active, memory_order_relaxed)) return;
+
+    TraceBuffer *buffer = trace_local_buffer();
+    if (!buffer) return;
+
+    // 当前块写满时追加新块（只有本线程访问，无需同步）
+    TraceChunk *chunk = buffer->tail;
+    if (!chunk || chunk->count == TRACE_CHUNK_EVENTS) {
+        TraceChunk *grown = (TraceChunk*)malloc(sizeof(TraceChunk));
+        if (!grown) return;
+        grown->next = NULL;
+        grown->count = 0;
+        if (chunk) {
+            chunk->next = grown;
+        } else {
+            buffer->head = grown;
+        }
+        buffer->tail = grown;
+        chunk = grown;
+    }
+
+    TraceEvent *event = &chunk->events[chunk->count++];
+    event->start_ns = start_ns;
+    event->duration_ns = end_ns - start_ns;
+    event->step = buffer->step;
+    event->satellites = buffer->satellites;
+    event->phase = (int32_t)phase;
+}
+
+void trace_set_context(uint32_t step, int satellites) {
+    if (!atomic_load_explicit(&trace_active, memory_order_relaxed)) return;
+    TraceBuffer *buffer = trace_local_buffer();
+    if (!buffer) return;
+    buffer->step = step;
+    buffer->satellites = satellites;
+}
+
+void trace_set_thread_name(const char *name) {
+    if (!name) return;
+    TraceBuffer *buffer = trace_local_buffer();
+    if (!buffer) return;
+    snprintf(buffer->name, sizeof(buffer->name), "%s", name);
+}
+
+int trace_write_chrome(const char *filename) {
+    if (!filename) return -1;
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "错误：无法创建跟踪文件 %s\n", filename);
+        return -1;
+    }
+
+    int written = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"satellite_sim\"}}");
+
+    for (TraceBuffer *b = atomic_load(&trace_buffers); b; b = b->next) {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                      "\"args\":{\"name\":\"%s\"}}", b->tid, b->name);
+
+        for (TraceChunk *chunk = b->head; chunk; chunk = chunk->next) {
+            for (uint32_t i = 0; i < chunk->count; i++) {
+                const TraceEvent *e = &chunk->events[i];
+                // 时间戳单位为微秒，相对于 trace_start
+                double ts = (e->start_ns >= trace_origin_ns) ? (e->start_ns - trace_origin_ns) / 1000.0 : 0.0;
+                fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                              "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"step\":%u,\"satellites\":%d}}",
+                        profiler_phase_name((ProfPhase)e->phase), b->tid, ts, e->duration_ns / 1000.0,
+                        e->step, e->satellites);
+                written++;
+            }
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return written;
+}
+
+void trace_shutdown(void) {
+    atomic_store(&trace_active, 0);
+    TraceBuffer *b = atomic_exchange(&trace_buffers, NULL);
+    while (b) {
+        TraceBuffer *next = b->next;
+        trace_free_chunks(b);
+        free(b);
+        b = next;
+    }
+    // 其他线程的 trace_local 仍指向已释放的缓冲，靠代数变化使其失效
+    atomic_fetch_add_explicit(&trace_generation, 1, memory_order_release);
+    trace_local = NULL;
+}
@@ -0,0 +1,222 @@
+#define _DEFAULT_SOURCE
+
+#include <vector3_soa.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#define VSOA_ALIGN  64
+
+/* AVX-512 隐含 FMA，禁止乘加合并，保证各指令集结果逐位一致 */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+/* ==================== 内核实例化 ==================== */
+
+typedef struct {
+    void (*norm)(const double*, const double*, const double*, double*, int);
+    void (*distance_to)(const double*, const double*, const double*, double, double, double, double*, int);
+    void (*distance)(const double*, const double*, const double*,
+                     const double*, const double*, const double*, double*, int);
+    void (*dot)(const double*, const double*, const double*,
+                const double*, const double*, const double*, double*, int);
+    void (*cross)(const double*, const double*, const double*,
+                  const double*, const double*, const double*, double*, double*, double*, int);
+    void (*normalize)(const double*, const double*, const double*, double*, double*, double*, int);
+    void (*matrix_multiply)(const double*, const double*, const double*, const double*,
+                            double*, double*, double*, int);
+    void (*nearest)(const double*, const double*, const double*, int,
+                    const double*, const double*, const double*, int, int*, double*);
+} Vector3SoAKernels;
+
+#define SIMD_KERNELS_FILE "vector3_soa_kernels.inc"
+#include "simd_instantiate.inc"
+
+#define VSOA_KERNELS(suffix) { \
+    vsoa_norm_##suffix, vsoa_distance_to_##suffix, vsoa_distance_##suffix, vsoa_dot_##suffix, \
+    vsoa_cross_##suffix, vsoa_normalize_##suffix, vsoa_matrix_multiply_##suffix, vsoa_nearest_##suffix }
+
+static const Vector3SoAKernels VSOA_KERNEL_TABLE[VECTOR3_SOA_ISA_COUNT] = {
+    VSOA_KERNELS(scalar),
+#ifdef VSOA_X86
+    VSOA_KERNELS(sse2),
+    VSOA_KERNELS(avx2),
+    VSOA_KERNELS(avx512),
+#endif
+};
+
+static const char *VSOA_ISA_NAMES[VECTOR3_SOA_ISA_COUNT] = { "scalar", "sse2", "avx2", "avx512" };
+
+/* ==================== 指令集选择 ==================== */
+
+/* 多个引擎可能在工作线程中同时创建并设置指令集，读写均为原子操作 */
+static Vector3SoAIsa vsoa_isa = VECTOR3_SOA_ISA_SCALAR;
+static const Vector3SoAKernels *vsoa_kernels = &VSOA_KERNEL_TABLE[VECTOR3_SOA_ISA_SCALAR];
+static pthread_once_t vsoa_once = PTHREAD_ONCE_INIT;
+
+Vector3SoAIsa vector3_soa_detect_isa(void) {
+#ifdef VSOA_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return VECTOR3_SOA_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2")) return VECTOR3_SOA_ISA_AVX2;
+    if (__builtin_cpu_supports("sse2")) return VECTOR3_SOA_ISA_SSE2;
+#endif
+    return VECTOR3_SOA_ISA_SCALAR;
+}
+
+static void vsoa_select(Vector3SoAIsa isa) {
+    __atomic_store_n(&vsoa_isa, isa, __ATOMIC_RELAXED);
+    __atomic_store_n(&vsoa_kernels, &VSOA_KERNEL_TABLE[isa], __ATOMIC_RELEASE);
+}
+
+static void vsoa_select_default(void) {
+    vsoa_select(vector3_soa_detect_isa());
+}
+
+static inline const Vector3SoAKernels* vsoa_get_kernels(void) {
+    pthread_once(&vsoa_once, vsoa_select_default);
+    return __atomic_load_n(&vsoa_kernels, __ATOMIC_ACQUIRE);
+}
+
+Vector3SoAIsa vector3_soa_get_isa(void) {
+    pthread_once(&vsoa_once, vsoa_select_default);
+    return __atomic_load_n(&vsoa_isa, __ATOMIC_RELAXED);
+}
+
+int vector3_soa_set_isa(Vector3SoAIsa isa) {
+    pthread_once(&vsoa_once, vsoa_select_default);
+    if (isa < 0 || isa >= VECTOR3_SOA_ISA_COUNT || isa > vector3_soa_detect_isa()) return -1;
+    vsoa_select(isa);
+    return 0;
+}
+
+const char* vector3_soa_isa_name(Vector3SoAIsa isa) {
+    if (isa < 0 || isa >= VECTOR3_SOA_ISA_COUNT) return "unknown";
+    return VSOA_ISA_NAMES[isa];
+}
+
+int vector3_soa_isa_from_name(const char *name) {
+    if (!name) return -1;
+    for (int i = 0; i < VECTOR3_SOA_ISA_COUNT; i++) {
+        if (strcmp(name, VSOA_ISA_NAMES[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/* ==================== 容器 ==================== */
+
+static double* vsoa_alloc_column(int capacity) {
+    void *p = NULL;
+    size_t bytes = sizeof(double) * (size_t)(capacity > 0 ? capacity : 1);
+    if (posix_memalign(&p, VSOA_ALIGN, bytes) != 0) return NULL;
+    return (double*)p;
+}
+
+int vector3_soa_init(Vector3SoA *a, int capacity) {
+    if (!a) return -1;
+    memset(a, 0, sizeof(Vector3SoA));
+    a->owned = 1;
+    return vector3_soa_reserve(a, capacity > 0 ? capacity : 16);
+}
+
+Vector3SoA vector3_soa_view(double *x, double *y, double *z, int count) {
+    return (Vector3SoA){ x, y, z, count, count, 0 };
+}
+
+void vector3_soa_free(Vector3SoA *a) {
+    if (!a) return;
+    if (a->owned) {
+        free(a->x);
+        free(a->y);
+        free(a->z);
+    }
+    memset(a, 0, sizeof(Vector3SoA));
+}
+
+int vector3_soa_reserve(Vector3SoA *a, int capacity) {
+    if (!a || !a->owned) return -1;
+    if (capacity <= a->capacity) return 0;
+
+    double *x = vsoa_alloc_column(capacity);
+    double *y = vsoa_alloc_column(capacity);
+    double *z = vsoa_alloc_column(capacity);
+    if (!x || !y || !z) {
+        free(x);
+        free(y);
+        free(z);
+        return -1;
+    }
+    if (a->count > 0) {
+        memcpy(x, a->x, sizeof(double) * a->count);
+        memcpy(y, a->y, sizeof(double) * a->count);
+        memcpy(z, a->z, sizeof(double) * a->count);
+    }
+    free(a->x);
+    free(a->y);
+    free(a->z);
+    a->x = x;
+    a->y = y;
+    a->z = z;
+    a->capacity = capacity;
+    return 0;
+}
+
+int vector3_soa_push(Vector3SoA *a, Vector3 v) {
+    if (!a) return -1;
+    if (a->count >= a->capacity && vector3_soa_reserve(a, a->capacity ? a->capacity * 2 : 16) != 0) {
+        return -1;
+    }
+    vector3_soa_set(a, a->count, v);
+    return a->count++;
+}
+
+/* ==================== 批量运算 ==================== */
+
+void vector3_soa_norm(const Vector3SoA *a, double *out) {
+    if (!a || !out) return;
+    vsoa_get_kernels()->norm(a->x, a->y, a->z, out, a->count);
+}
+
+void vector3_soa_distance_to(const Vector3SoA *a, Vector3 p, double *out) {
+    if (!a || !out) return;
+    vsoa_get_kernels()->distance_to(a->x, a->y, a->z, p.x, p.y, p.z, out, a->count);
+}
+
+void vector3_soa_distance(const Vector3SoA *a, const Vector3SoA *b, double *out) {
+    if (!a || !b || !out || b->count < a->count) return;
+    vsoa_get_kernels()->distance(a->x, a->y, a->z, b->x, b->y, b->z, out, a->count);
+}
+
+void vector3_soa_dot(const Vector3SoA *a, const Vector3SoA *b, double *out) {
+    if (!a || !b || !out || b->count < a->count) return;
+    vsoa_get_kernels()->dot(a->x, a->y, a->z, b->x, b->y, b->z, out, a->count);
+}
+
+void vector3_soa_cross(const Vector3SoA *a, const Vector3SoA *b, Vector3SoA *out) {
+    if (!a || !b || !out || b->count < a->count || out->capacity < a->count) return;
+    vsoa_get_kernels()->cross(a->x, a->y, a->z, b->x, b->y, b->z, out->x, out->y, out->z, a->count);
+    out->count = a->count;
+}
+
+void vector3_soa_normalize(const Vector3SoA *a, Vector3SoA *out) {
+    if (!a || !out || out->capacity < a->count) return;
+    vsoa_get_kernels()->normalize(a->x, a->y, a->z, out->x, out->y, out->z, a->count);
+    out->count = a->count;
+}
+
+void vector3_soa_matrix_multiply(Matrix3x3 m, const Vector3SoA *a, Vector3SoA *out) {
+    if (!a || !out || out->capacity < a->count) return;
+    vsoa_get_kernels()->matrix_multiply(&m.m[0][0], a->x, a->y, a->z, out->x, out->y, out->z, a->count);
+    out->count = a->count;
+}
+
+void vector3_soa_nearest(const Vector3SoA *a, const Vector3SoA *centers, int *assignments, double *distances) {
+    if (!a || !centers || !assignments || centers->count <= 0) return;
+    vsoa_get_kernels()->nearest(a->x, a->y, a->z, a->count,
+                                centers->x, centers->y, centers->z, centers->count,
+                                assignments, distances);
+}